@@ -98,10 +98,10 @@ if create_objects:
 
 	# Initialize with t=0 data
 	psi_t0 = psi(x, 0)
-	col_x.replaceValues(0, [float(xi) for xi in x])
-	col_real.replaceValues(0, [float(val.real) for val in psi_t0])
-	col_imag.replaceValues(0, [float(val.imag) for val in psi_t0])
-	col_prob.replaceValues(0, [float(abs(val)**2) for val in psi_t0])
+	col_x.replaceArray(0, x)
+	col_real.replaceArray(0, psi_t0.real)
+	col_imag.replaceArray(0, psi_t0.imag)
+	col_prob.replaceArray(0, np.abs(psi_t0)**2)
 
 	# === Create Worksheet ===
 	worksheet = Worksheet("Quantum Wave Packet")
@@ -198,9 +198,9 @@ else:
 
 # Reset to initial state (t=0) for animation
 psi_t0 = psi(x, 0)
-col_real.replaceValues(0, [float(val.real) for val in psi_t0])
-col_imag.replaceValues(0, [float(val.imag) for val in psi_t0])
-col_prob.replaceValues(0, [float(abs(val)**2) for val in psi_t0])
+col_real.replaceArray(0, psi_t0.real)
+col_imag.replaceArray(0, psi_t0.imag)
+col_prob.replaceArray(0, np.abs(psi_t0)**2)
 
 # === Animation Loop ===
 print("Starting wave packet evolution animation...")
@@ -212,10 +212,10 @@ for i in range(N_steps):
 	# Compute wave function at time t
 	psi_t = psi(x, t)
 
-	# Update column data
-	col_real.replaceValues(0, [float(val.real) for val in psi_t])
-	col_imag.replaceValues(0, [float(val.imag) for val in psi_t])
-	col_prob.replaceValues(0, [float(abs(val)**2) for val in psi_t])
+	# Update column data, the NumPy arrays are copied directly into the columns
+	col_real.replaceArray(0, psi_t.real)
+	col_imag.replaceArray(0, psi_t.imag)
+	col_prob.replaceArray(0, np.abs(psi_t)**2)
 
 	# Process Qt events to update the UI
 	QCoreApplication.processEvents()
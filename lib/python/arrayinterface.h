@@ -0,0 +1,424 @@
+/*
+	File                 : arrayinterface.h
+	Project              : LabPlot
+	Description          : Exchange of column and matrix data with NumPy via the array interface
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef ARRAYINTERFACE_H
+#define ARRAYINTERFACE_H
+
+#include "src/backend/core/column/Column.h"
+#include "src/backend/matrix/Matrix.h"
+
+#include <sbkpython.h>
+
+#include <KLocalizedString>
+
+#include <QVector>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/*
+ * The data of the columns and matrices is exchanged with NumPy via the array interface
+ * (https://numpy.org/doc/stable/reference/arrays.interface.html) which is available in the limited Python API
+ * used for the bindings, contrary to the buffer protocol.
+ *
+ * Reading: Column.array() and Matrix.columnArray() return an object providing a read-only view on the data
+ * of the column, numpy.asarray() creates an array without copying the data. The view holds a shallow copy of the
+ * implicitly shared QVector of the column, later modifications of the column detach the column from this copy
+ * and are not visible in the array.
+ *
+ * Writing: Column.replaceArray() and Matrix.setArray() copy the content of a NumPy array directly into the storage
+ * (one memcpy for columns), in one undoable step with one notification about the changed data.
+ */
+namespace ArrayInterface {
+
+template<typename T>
+QByteArray typeString() {
+	QByteArray str;
+	str += (Q_BYTE_ORDER == Q_LITTLE_ENDIAN) ? '<' : '>';
+	str += std::is_floating_point<T>::value ? 'f' : 'i';
+	str += QByteArray::number(static_cast<int>(sizeof(T)));
+	return str;
+}
+
+/*!
+ * creates an object providing the read-only array \c data with the shape \c rows (x \c cols for 2D arrays)
+ * via \c __array_interface__. The object holds a reference to \c owner, the Python object owning the data.
+ */
+template<typename T>
+PyObject* create(PyObject* owner, const T* data, Py_ssize_t rows, Py_ssize_t cols = -1) {
+	static const T empty{};
+	if (!data) // empty container
+		data = &empty;
+
+	PyObject* types = PyImport_ImportModule("types");
+	if (!types)
+		return nullptr;
+	PyObject* type = PyObject_GetAttrString(types, "SimpleNamespace");
+	Py_DECREF(types);
+	if (!type)
+		return nullptr;
+
+	PyObject* shape = (cols < 0) ? Py_BuildValue("(n)", rows) : Py_BuildValue("(nn)", rows, cols);
+	const auto& typestr = typeString<T>();
+	PyObject* interface = Py_BuildValue("{s:N,s:s,s:(NO),s:i}",
+										"shape",
+										shape,
+										"typestr",
+										typestr.constData(),
+										"data",
+										PyLong_FromVoidPtr(const_cast<T*>(data)),
+										Py_True, // read-only
+										"version",
+										3);
+	if (!interface) {
+		Py_DECREF(type);
+		return nullptr;
+	}
+
+	PyObject* args = PyTuple_New(0);
+	PyObject* kwargs = Py_BuildValue("{s:N,s:O}", "__array_interface__", interface, "owner", owner);
+	PyObject* result = kwargs ? PyObject_Call(type, args, kwargs) : nullptr;
+	Py_XDECREF(kwargs);
+	Py_DECREF(args);
+	Py_DECREF(type);
+	return result;
+}
+
+/*!
+ * checks that the values of the array \c object can be converted to the integer type \c T without overflows.
+ * Returns \c false and sets a Python exception otherwise, always \c true for floating point types.
+ */
+template<typename T>
+bool inRange(PyObject* object) {
+	if constexpr (std::is_floating_point<T>::value)
+		return true;
+	else {
+		PyObject* size = PyObject_GetAttrString(object, "size");
+		const Py_ssize_t count = size ? PyLong_AsSsize_t(size) : -1;
+		Py_XDECREF(size);
+		if (PyErr_Occurred())
+			return false;
+		if (count == 0) // min() and max() fail for empty arrays
+			return true;
+
+		PyObject* min = PyObject_CallMethod(object, "min", nullptr);
+		PyObject* max = PyObject_CallMethod(object, "max", nullptr);
+		PyObject* lowest = PyLong_FromLongLong(std::numeric_limits<T>::lowest());
+		PyObject* highest = PyLong_FromLongLong(std::numeric_limits<T>::max());
+		// comparisons with NaN are false, NaN values are rejected too
+		const bool rc = min && max && lowest && highest && PyObject_RichCompareBool(min, lowest, Py_GE) == 1
+			&& PyObject_RichCompareBool(max, highest, Py_LE) == 1;
+		Py_XDECREF(highest);
+		Py_XDECREF(lowest);
+		Py_XDECREF(max);
+		Py_XDECREF(min);
+		if (!rc && !PyErr_Occurred())
+			PyErr_SetString(PyExc_OverflowError, "the values of the array are out of the range of the integer type");
+		return rc;
+	}
+}
+
+/*!
+ * copies the content of the array \c object with \c dimensions dimensions into \c values.
+ * Arrays of a different type and non-contiguous arrays (views with strides, Fortran order) are converted
+ * to C-contiguous arrays with \c astype(). Values out of the range of integer types are rejected.
+ * The values are stored in \c values column by column, the rows of 2D arrays are the rows of the matrix.
+ * Returns \c false and sets a Python exception on errors.
+ */
+template<typename T>
+bool read(PyObject* object, int dimensions, QVector<QVector<T>>& values, bool converted = false) {
+	PyObject* interface = PyObject_GetAttrString(object, "__array_interface__");
+	if (!interface || !PyDict_Check(interface)) {
+		Py_XDECREF(interface);
+		PyErr_SetString(PyExc_TypeError, "a NumPy array is required");
+		return false;
+	}
+
+	// convert to a contiguous array of the type of the column or matrix if required
+	const auto& typestr = typeString<T>();
+	PyObject* type = PyDict_GetItemString(interface, "typestr"); // borrowed
+	PyObject* typeBytes = type ? PyUnicode_AsUTF8String(type) : nullptr;
+	const bool sameType = typeBytes && typestr == PyBytes_AsString(typeBytes);
+	Py_XDECREF(typeBytes);
+	PyObject* strides = PyDict_GetItemString(interface, "strides");
+	const bool contiguous = !strides || strides == Py_None;
+	if (!sameType || !contiguous) {
+		Py_DECREF(interface);
+		if (converted) {
+			PyErr_SetString(PyExc_TypeError, "failed to convert the array");
+			return false;
+		}
+		if (!sameType && !inRange<T>(object))
+			return false;
+
+		// order='C', the default 'K' keeps the memory layout of Fortran-ordered arrays
+		PyObject* astype = PyObject_GetAttrString(object, "astype");
+		PyObject* args = Py_BuildValue("(s)", typestr.constData());
+		PyObject* kwargs = Py_BuildValue("{s:s}", "order", "C");
+		PyObject* array = (astype && args && kwargs) ? PyObject_Call(astype, args, kwargs) : nullptr;
+		Py_XDECREF(kwargs);
+		Py_XDECREF(args);
+		Py_XDECREF(astype);
+		if (!array)
+			return false;
+		const bool rc = read(array, dimensions, values, true);
+		Py_DECREF(array);
+		return rc;
+	}
+
+	PyObject* data = PyDict_GetItemString(interface, "data");
+	PyObject* shape = PyDict_GetItemString(interface, "shape");
+	if (!data || !PyTuple_Check(data) || !shape || !PyTuple_Check(shape)) {
+		Py_DECREF(interface);
+		PyErr_SetString(PyExc_TypeError, "arrays exporting their data via the buffer protocol are not supported");
+		return false;
+	}
+
+	if (PyTuple_Size(shape) != dimensions) {
+		Py_DECREF(interface);
+		PyErr_Format(PyExc_ValueError, "array with %d dimension(s) required", dimensions);
+		return false;
+	}
+
+	const Py_ssize_t rows = PyLong_AsSsize_t(PyTuple_GetItem(shape, 0));
+	const Py_ssize_t cols = (dimensions == 2) ? PyLong_AsSsize_t(PyTuple_GetItem(shape, 1)) : 1;
+	const auto* ptr = static_cast<const T*>(PyLong_AsVoidPtr(PyTuple_GetItem(data, 0)));
+	Py_DECREF(interface);
+	if (PyErr_Occurred())
+		return false;
+
+	if (rows > std::numeric_limits<int>::max() || cols > std::numeric_limits<int>::max()) {
+		PyErr_SetString(PyExc_ValueError, "array too large");
+		return false;
+	}
+
+	values.resize(cols);
+	if (cols == 1) {
+		values[0].resize(rows);
+		if (rows > 0)
+			std::memcpy(values[0].data(), ptr, rows * sizeof(T));
+	} else {
+		// row-major array into column-major storage
+		for (Py_ssize_t col = 0; col < cols; ++col) {
+			auto& column = values[col];
+			column.resize(rows);
+			for (Py_ssize_t row = 0; row < rows; ++row)
+				column[row] = ptr[row * cols + col];
+		}
+	}
+
+	return true;
+}
+
+/*!
+ * creates an object providing the read-only array \c vector. The data is kept alive by a shallow copy of \c vector
+ * owned by the created object, the implicit sharing of QVector ensures that the data seen via the array
+ * is not modified or freed when the original vector is modified.
+ */
+template<typename T>
+PyObject* create(const QVector<T>& vector) {
+	auto* copy = new QVector<T>(vector); // no deep copy, the data is shared
+	PyObject* capsule = PyCapsule_New(copy, nullptr, [](PyObject* capsule) {
+		delete static_cast<QVector<T>*>(PyCapsule_GetPointer(capsule, nullptr));
+	});
+	if (!capsule) {
+		delete copy;
+		return nullptr;
+	}
+
+	PyObject* result = create(capsule, copy->constData(), copy->size());
+	Py_DECREF(capsule);
+	return result;
+}
+
+template<typename T>
+PyObject* columnArray(const Column* column) {
+	return create(*static_cast<const QVector<T>*>(column->data()));
+}
+
+/*!
+ * returns a read-only view on the data of the numeric column \c column.
+ */
+inline PyObject* columnArray(const Column* column) {
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+		return columnArray<double>(column);
+	case AbstractColumn::ColumnMode::Integer:
+		return columnArray<int>(column);
+	case AbstractColumn::ColumnMode::BigInt:
+		return columnArray<qint64>(column);
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	PyErr_SetString(PyExc_TypeError, "only numeric columns can be accessed as array");
+	return nullptr;
+}
+
+/*!
+ * replaces the values of \c column starting at row \c first (all values if \c first is negative)
+ * with the content of the array \c object.
+ */
+inline bool replaceColumnArray(Column* column, int first, PyObject* object) {
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double: {
+		QVector<QVector<double>> values;
+		if (!read(object, 1, values))
+			return false;
+		column->replaceValues(first, values.constFirst());
+		return true;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		QVector<QVector<int>> values;
+		if (!read(object, 1, values))
+			return false;
+		column->replaceInteger(first, values.constFirst());
+		return true;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		QVector<QVector<qint64>> values;
+		if (!read(object, 1, values))
+			return false;
+		column->replaceBigInt(first, values.constFirst());
+		return true;
+	}
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	PyErr_SetString(PyExc_TypeError, "only numeric columns can be set from an array");
+	return false;
+}
+
+/*!
+ * returns a read-only view on the column \c col of the numeric matrix \c matrix.
+ */
+inline PyObject* matrixColumnArray(const Matrix* matrix, int col) {
+	if (col < 0 || col >= matrix->columnCount()) {
+		PyErr_SetString(PyExc_IndexError, "column index out of range");
+		return nullptr;
+	}
+
+	switch (matrix->mode()) {
+	case AbstractColumn::ColumnMode::Double:
+		return create(static_cast<const QVector<QVector<double>>*>(matrix->data())->at(col));
+	case AbstractColumn::ColumnMode::Integer:
+		return create(static_cast<const QVector<QVector<int>>*>(matrix->data())->at(col));
+	case AbstractColumn::ColumnMode::BigInt:
+		return create(static_cast<const QVector<QVector<qint64>>*>(matrix->data())->at(col));
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	PyErr_SetString(PyExc_TypeError, "only numeric matrices can be accessed as array");
+	return nullptr;
+}
+
+template<typename T>
+PyObject* matrixArray(const Matrix* matrix) {
+	// the columns of the matrix are stored separately, copy them into one row-major array
+	const auto* data = static_cast<const QVector<QVector<T>>*>(matrix->data());
+	const Py_ssize_t rows = matrix->rowCount();
+	const Py_ssize_t cols = matrix->columnCount();
+	PyObject* bytes = PyBytes_FromStringAndSize(nullptr, rows * cols * sizeof(T));
+	if (!bytes)
+		return nullptr;
+
+	auto* ptr = reinterpret_cast<T*>(PyBytes_AsString(bytes));
+	for (Py_ssize_t col = 0; col < cols; ++col) {
+		const auto& column = data->at(col);
+		for (Py_ssize_t row = 0; row < rows; ++row)
+			ptr[row * cols + col] = column.at(row);
+	}
+
+	PyObject* result = create(bytes, ptr, rows, cols);
+	Py_DECREF(bytes);
+	return result;
+}
+
+/*!
+ * returns a read-only copy of the data of the numeric matrix \c matrix as 2D array (rows x columns).
+ */
+inline PyObject* matrixArray(const Matrix* matrix) {
+	switch (matrix->mode()) {
+	case AbstractColumn::ColumnMode::Double:
+		return matrixArray<double>(matrix);
+	case AbstractColumn::ColumnMode::Integer:
+		return matrixArray<int>(matrix);
+	case AbstractColumn::ColumnMode::BigInt:
+		return matrixArray<qint64>(matrix);
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	PyErr_SetString(PyExc_TypeError, "only numeric matrices can be accessed as array");
+	return nullptr;
+}
+
+template<typename T>
+bool setMatrixArray(Matrix* matrix, PyObject* object) {
+	auto* values = new QVector<QVector<T>>();
+	if (!read(object, 2, *values)) {
+		delete values;
+		return false;
+	}
+
+	const int cols = values->size();
+	const int rows = cols > 0 ? values->constFirst().size() : 0;
+	if (rows == 0 || cols == 0) {
+		delete values;
+		PyErr_SetString(PyExc_ValueError, "empty array");
+		return false;
+	}
+
+	matrix->beginMacro(i18n("%1: replace values", matrix->name()));
+	matrix->setDimensions(rows, cols);
+	matrix->setData(values); // takes the ownership
+	matrix->endMacro();
+	return true;
+}
+
+/*!
+ * replaces the content of the numeric matrix \c matrix with the 2D array \c object (rows x columns),
+ * the dimensions of the matrix are adjusted if required.
+ */
+inline bool setMatrixArray(Matrix* matrix, PyObject* object) {
+	switch (matrix->mode()) {
+	case AbstractColumn::ColumnMode::Double:
+		return setMatrixArray<double>(matrix, object);
+	case AbstractColumn::ColumnMode::Integer:
+		return setMatrixArray<int>(matrix, object);
+	case AbstractColumn::ColumnMode::BigInt:
+		return setMatrixArray<qint64>(matrix, object);
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	PyErr_SetString(PyExc_TypeError, "only numeric matrices can be set from an array");
+	return false;
+}
+}
+
+#endif
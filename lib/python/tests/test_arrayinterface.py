@@ -0,0 +1,108 @@
+# SPDX-FileCopyrightText: 2026 The LabPlot Team
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Tests for the exchange of column and matrix data with NumPy via the array interface.
+"""
+
+import unittest
+
+import numpy as np
+from PySide6.QtCore import QCoreApplication
+from pylabplot import *
+
+app = QCoreApplication.instance() or QCoreApplication()
+
+
+class ColumnArrayTest(unittest.TestCase):
+	def test_roundtrip(self):
+		for mode, dtype in ((AbstractColumn.ColumnMode.Double, np.float64),
+							(AbstractColumn.ColumnMode.Integer, np.int32),
+							(AbstractColumn.ColumnMode.BigInt, np.int64)):
+			column = Column("c", mode)
+			values = np.arange(10, dtype=dtype)
+			column.replaceArray(-1, values)
+			self.assertEqual(column.rowCount(), 10)
+
+			array = np.asarray(column.array())
+			self.assertEqual(array.dtype, dtype)
+			self.assertFalse(array.flags.writeable)
+			np.testing.assert_array_equal(array, values)
+
+	def test_conversion(self):
+		column = Column("c")
+		values = np.arange(20, dtype=np.int32)[::2] # strided and of a different type
+		column.replaceArray(-1, values)
+		np.testing.assert_array_equal(np.asarray(column.array()), values.astype(np.float64))
+
+	def test_integer_range(self):
+		column = Column("c", AbstractColumn.ColumnMode.Integer)
+		column.replaceArray(-1, np.array([-2**31, 2**31 - 1], dtype=np.int64))
+		np.testing.assert_array_equal(np.asarray(column.array()), [-2**31, 2**31 - 1])
+
+		# no silent truncation
+		for values in (np.array([1, 2**31], dtype=np.int64), np.array([1., np.nan])):
+			with self.assertRaises(OverflowError):
+				column.replaceArray(-1, values)
+		np.testing.assert_array_equal(np.asarray(column.array()), [-2**31, 2**31 - 1])
+
+	def test_modify_after_array(self):
+		column = Column("c")
+		column.replaceArray(-1, np.array([1., 2., 3.]))
+		array = np.asarray(column.array())
+
+		# the array keeps the data it was created with
+		column.setValueAt(0, 42.)
+		np.testing.assert_array_equal(array, [1., 2., 3.])
+		np.testing.assert_array_equal(np.asarray(column.array()), [42., 2., 3.])
+
+		column.replaceArray(-1, np.arange(1000, dtype=np.float64))
+		column.clear()
+		np.testing.assert_array_equal(array, [1., 2., 3.])
+
+	def test_column_deleted(self):
+		column = Column("c")
+		column.replaceArray(-1, np.array([1., 2., 3.]))
+		array = np.asarray(column.array())
+		del column
+		np.testing.assert_array_equal(array, [1., 2., 3.])
+
+	def test_text_column(self):
+		column = Column("c", AbstractColumn.ColumnMode.Text)
+		with self.assertRaises(TypeError):
+			column.array()
+
+
+class MatrixArrayTest(unittest.TestCase):
+	def test_roundtrip(self):
+		matrix = Matrix("m")
+		values = np.arange(12, dtype=np.float64).reshape(3, 4)
+		matrix.setArray(values)
+		self.assertEqual(matrix.rowCount(), 3)
+		self.assertEqual(matrix.columnCount(), 4)
+
+		np.testing.assert_array_equal(np.asarray(matrix.array()), values)
+		for col in range(4):
+			np.testing.assert_array_equal(np.asarray(matrix.columnArray(col)), values[:, col])
+
+		with self.assertRaises(IndexError):
+			matrix.columnArray(4)
+
+	def test_fortran_order(self):
+		matrix = Matrix("m")
+		values = np.asfortranarray(np.arange(12, dtype=np.float64).reshape(3, 4))
+		matrix.setArray(values)
+		np.testing.assert_array_equal(np.asarray(matrix.array()), values)
+
+	def test_modify_after_array(self):
+		matrix = Matrix("m")
+		matrix.setArray(np.ones((2, 2)))
+		column = np.asarray(matrix.columnArray(1))
+
+		matrix.setArray(np.zeros((5, 5)))
+		matrix.clear()
+		np.testing.assert_array_equal(column, [1., 1.])
+
+
+if __name__ == "__main__":
+	unittest.main()
@@ -667,6 +667,28 @@ QDateTime AbstractColumn::dateTimeAt(int /*row*/) const {
 	return {};
 }
 
+/**
+ * \brief Return the milliseconds since epoch of all rows if the column stores them in this form
+ *
+ * Empty cells contain std::numeric_limits<qint64>::min(). An empty span is returned
+ * if the values are not available in this form, dateTimeAt() has to be used in this case.
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+std::span<const qint64> AbstractColumn::dateTimeMSecs() const {
+	return {};
+}
+
+/**
+ * \brief Return the nanoseconds since epoch (UTC) of all rows if the column stores timestamps with nanosecond resolution
+ *
+ * Empty cells contain std::numeric_limits<qint64>::min(). An empty span is returned
+ * if the values are not available with nanosecond resolution.
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+std::span<const qint64> AbstractColumn::dateTimeNSecs() const {
+	return {};
+}
+
 /**
  * \brief Set the content of row 'row'
  *
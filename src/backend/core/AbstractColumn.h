@@ -15,6 +15,8 @@
 #include "backend/core/AbstractAspect.h"
 #include <QColor>
 
+#include <span>
+
 class AbstractColumnPrivate;
 class AbstractSimpleFilter;
 class QString;
@@ -185,6 +187,8 @@ public:
 	virtual QTime timeAt(int row) const;
 	virtual void setTimeAt(int row, QTime new_value);
 	virtual QDateTime dateTimeAt(int row) const;
+	virtual std::span<const qint64> dateTimeMSecs() const;
+	virtual std::span<const qint64> dateTimeNSecs() const;
 	virtual void setDateTimeAt(int row, const QDateTime& new_value);
 	virtual void replaceDateTimes(int first, const QVector<QDateTime>& new_values);
 
@@ -51,6 +51,9 @@ public:
 	void setNumberLocaleToDefault() {
 		m_useDefaultLocale = true;
 	}
+	QLocale numberLocale() const {
+		return m_useDefaultLocale ? QLocale() : m_numberLocale;
+	}
 
 	virtual int rowCount() const;
 	virtual int rowCount(double min, double max) const;
@@ -11,11 +11,14 @@
 	SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "backend/core/Project.h"
+#include "backend/core/ProjectDataContainer.h"
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnPrivate.h"
 #include "backend/lib/UndoStack.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
+#include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #ifndef SDK
 #include "backend/statistics/HypothesisTest.h"
@@ -50,6 +53,9 @@
 #include <QMenu>
 #include <QMimeData>
 #include <QThreadPool>
+#include <QtConcurrentMap>
+
+#include <functional>
 
 // required to parse Cantor and Jupyter files
 #ifdef HAVE_CANTOR_LIBS
@@ -151,6 +157,7 @@ public:
 
 	Project::DockVisibility dockVisibility{Project::DockVisibility::folderOnly};
 	bool aspectAddedSignalSuppressed{false};
+	bool deferWorksheetRetransform{false}; // retransform the worksheets after the load only when they're shown for the first time
 
 	static int m_versionNumber;
 	static int mXmlVersion;
@@ -158,6 +165,9 @@ public:
 
 	bool saveData{true}; // Save column and matrix data in the file. If false, the data gets not stored in the saved file
 	bool fileCompression{true};
+	bool saveBinaryData{false}; // Save the column data in a separate binary section of the file, see ProjectDataContainer
+	ProjectDataWriter* dataWriter{nullptr}; // writer for the binary data section, only set during the save
+	std::weak_ptr<ProjectDataReader> dataReader; // reader of the binary data section of the loaded file, alive as long as column data is pending
 	QDateTime modificationTime;
 	Project* const q;
 	QString fileName;
@@ -197,6 +207,7 @@ Project::Project()
 	setSaveCalculations(group.readEntry(QStringLiteral("SaveCalculations"), saveCalculations()));
 	setFileCompression(group.readEntry("Compressed", !group.readEntry("CompatibleSave", !fileCompression()))); // CompatibleSave was the old name
 	setSaveData(group.readEntry("SaveData", saveData()));
+	setSaveBinaryData(group.readEntry("SaveBinaryData", saveBinaryData()));
 
 	setUndoAware(true);
 	setIsLoading(false);
@@ -287,6 +298,7 @@ CLASS_D_ACCESSOR_IMPL(Project, QString, defaultDockWidgetState, DefaultDockWidge
 BASIC_D_READER_IMPL(Project, bool, saveCalculations, saveCalculations)
 BASIC_D_READER_IMPL(Project, bool, fileCompression, fileCompression)
 BASIC_D_READER_IMPL(Project, bool, saveData, saveData)
+BASIC_D_READER_IMPL(Project, bool, saveBinaryData, saveBinaryData)
 
 STD_SETTER_CMD_IMPL_S(Project, SetAuthor, QString, author)
 void Project::setAuthor(const QString& author) {
@@ -323,6 +335,13 @@ void Project::setSaveData(bool save) {
 	setProjectChanged(true);
 }
 
+void Project::setSaveBinaryData(bool binary) {
+	Q_D(Project);
+	// No Undo command, because we don't have this on the stack since it could be changed easily unintentionally
+	d->saveBinaryData = binary;
+	setProjectChanged(true);
+}
+
 void Project::setChanged(bool value) {
 	if (isLoading())
 		return;
@@ -347,6 +366,21 @@ bool Project::aspectAddedSignalSuppressed() const {
 	return d->aspectAddedSignalSuppressed;
 }
 
+/*!
+ * if \c value is \c true, the elements of the worksheets are not retransformed at the end of the project load.
+ * The retransform is done when the view of the worksheet is created for the first time, i.e. worksheets that are
+ * not shown don't cost anything during the load. Used in the GUI only, by default all worksheets are retransformed.
+ */
+void Project::setDeferWorksheetRetransform(bool value) {
+	Q_D(Project);
+	d->deferWorksheetRetransform = value;
+}
+
+bool Project::deferWorksheetRetransform() const {
+	Q_D(const Project);
+	return d->deferWorksheetRetransform;
+}
+
 /*!
  * \brief Project::updateDependencies
  * Notify that WorksheetElements are updated. This is required if the element
@@ -499,6 +533,7 @@ void Project::save(const QPixmap& thumbnail, QXmlStreamWriter* writer) {
 	writer->writeAttribute(QStringLiteral("saveCalculations"), QString::number(d->saveCalculations));
 	writer->writeAttribute(QStringLiteral("compressed"), QString::number(d->fileCompression));
 	writer->writeAttribute(QStringLiteral("saveData"), QString::number(d->saveData));
+	writer->writeAttribute(QStringLiteral("saveBinaryData"), QString::number(d->saveBinaryData));
 
 	// save the state of the content dock widgets
 	writer->writeAttribute(QStringLiteral("dockWidgetState"), d->dockWidgetState);
@@ -524,6 +559,58 @@ void Project::save(const QPixmap& thumbnail, QXmlStreamWriter* writer) {
 	save(writer);
 }
 
+/*!
+ * saves the project in the container format with the XML of the project and a separate
+ * binary section for the column data, see \c ProjectDataContainer.
+ * The data is written into the binary section by the columns during the save via \c dataWriter().
+ */
+bool Project::save(const QPixmap& thumbnail, ProjectDataWriter* dataWriter) {
+	Q_D(Project);
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	if (!dataWriter->begin())
+		return false;
+
+	QByteArray xml;
+	QBuffer buffer(&xml);
+	buffer.open(QIODevice::WriteOnly);
+	QXmlStreamWriter writer(&buffer);
+
+	d->dataWriter = dataWriter;
+	save(thumbnail, &writer);
+	d->dataWriter = nullptr;
+
+	return dataWriter->finish(xml);
+}
+
+/*!
+ * returns the writer for the binary data section of the project file while the project is being saved
+ * in the container format, \c nullptr otherwise.
+ */
+ProjectDataWriter* Project::dataWriter() const {
+	Q_D(const Project);
+	return d->dataWriter;
+}
+
+/*!
+ * reads the column data that is still pending in the binary data section of the loaded project file into memory
+ * and closes the file so it can be overwritten. This also covers the columns only referenced in the undo history.
+ * Returns \c false if the data couldn't be read.
+ */
+bool Project::releaseDataFile() {
+	Q_D(Project);
+	const auto dataReader = d->dataReader.lock();
+	if (!dataReader)
+		return true;
+
+	if (!dataReader->detach()) {
+		WARN(Q_FUNC_INFO << ", " << STDSTRING(dataReader->errorString()))
+		return false;
+	}
+
+	d->dataReader.reset();
+	return true;
+}
+
 /**
  * \brief Save as XML
  */
@@ -546,10 +633,23 @@ void Project::save(QXmlStreamWriter* writer) const {
 }
 
 bool Project::load(const QString& filename, bool preview) {
+	Q_D(Project);
 	setFileName(filename);
 	DEBUG(Q_FUNC_INFO << ", LOADING file " << STDSTRING(filename))
 	QIODevice* file;
-	if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive)) {
+	std::shared_ptr<ProjectDataReader> dataReader;
+	if (ProjectDataContainer::isContainer(filename)) {
+		DEBUG(Q_FUNC_INFO << ", project with binary data section")
+		// only the XML is read here, the data of the columns is read on demand
+		dataReader = std::make_shared<ProjectDataReader>();
+		if (!dataReader->open(filename)) {
+			KMessageBox::error(nullptr, dataReader->errorString(), i18n("Error opening project"));
+			return false;
+		}
+		auto* buffer = new QBuffer();
+		buffer->setData(dataReader->xml());
+		file = buffer;
+	} else if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive)) {
 		DEBUG(Q_FUNC_INFO << ", filename ends with .lml")
 
 		// check compression
@@ -601,6 +701,8 @@ bool Project::load(const QString& filename, bool preview) {
 
 	// parse XML
 	XmlStreamReader reader(file);
+	reader.setDataReader(dataReader);
+	d->dataReader = dataReader;
 	setIsLoading(true);
 	ProjectPrivate::mXmlVersion =
 		0; // set the version temporarily to 0, the actual project version will be read in the file, if available, and used in load() functions
@@ -846,21 +948,118 @@ bool Project::loadNotebook(const QString& filename) {
 }
 #endif
 
+/*!
+ * returns the analysis curves in \c curves sorted such that every curve comes after the analysis curves
+ * it takes its data from (source curve or result columns of another analysis curve).
+ */
+static QVector<XYAnalysisCurve*> sortedByDependencies(const QVector<XYAnalysisCurve*>& curves) {
+	QVector<XYAnalysisCurve*> sorted;
+	sorted.reserve(curves.size());
+	QSet<const XYAnalysisCurve*> visited;
+
+	auto source = [](const AbstractAspect* aspect) -> XYAnalysisCurve* {
+		return aspect ? dynamic_cast<XYAnalysisCurve*>(const_cast<AbstractAspect*>(aspect)) : nullptr;
+	};
+
+	std::function<void(XYAnalysisCurve*)> visit = [&](XYAnalysisCurve* curve) {
+		if (visited.contains(curve)) // already sorted or a cyclic dependency
+			return;
+
+		visited << curve;
+		QVector<XYAnalysisCurve*> dependencies;
+		if (curve->dataSourceType() == XYAnalysisCurve::DataSourceType::Curve)
+			dependencies << source(curve->dataSourceCurve());
+		else {
+			for (const auto* column : {curve->xDataColumn(), curve->yDataColumn(), curve->y2DataColumn()})
+				dependencies << source(column ? column->parentAspect() : nullptr);
+		}
+
+		for (auto* dependency : std::as_const(dependencies)) {
+			if (dependency && dependency != curve && curves.contains(dependency))
+				visit(dependency);
+		}
+
+		sorted << curve;
+	};
+
+	for (auto* curve : curves)
+		visit(curve);
+
+	return sorted;
+}
+
 void Project::retransformElements(AbstractAspect* aspect) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
 	bool hasChildren = aspect->childCount<AbstractAspect>();
+	auto* project = aspect->project();
+
+	// when the whole project is loaded in the GUI, the worksheets are retransformed when they're shown for the first time
+	QVector<Worksheet*> worksheets;
+	if (hasChildren && aspect->type() != AspectType::Worksheet && aspect->type() != AspectType::CartesianPlot)
+		worksheets = aspect->children<Worksheet>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden);
+	const bool deferRetransform = (aspect == project && project->deferWorksheetRetransform());
+
+	QVector<XYAnalysisCurve*> analysisCurves;
+	if (!project->saveCalculations())
+		analysisCurves = aspect->children<XYAnalysisCurve>(ChildIndexFlag::Recursive);
+
+	// read the data of the columns required for the recalculations and for the plots being retransformed
+	// in parallel, the data of the other columns is read on the first access
+	{
+		QVector<const Plot*> plots;
+		for (auto* curve : std::as_const(analysisCurves))
+			plots << curve;
+		QVector<const AbstractAspect*> parents;
+		if (aspect->type() == AspectType::Worksheet || aspect->inherits<WorksheetElement>())
+			parents << aspect;
+		else if (!deferRetransform) {
+			for (const auto* w : std::as_const(worksheets))
+				parents << w;
+		}
+		for (const auto* parent : std::as_const(parents)) {
+			for (const auto* plot : parent->children<Plot>(ChildIndexFlag::Recursive))
+				plots << plot;
+		}
+		if (auto* plot = aspect->castTo<Plot>())
+			plots << plot;
+
+		QVector<const ColumnPrivate*> pendingColumns;
+		for (const auto* column : project->children<Column>(ChildIndexFlag::Recursive)) {
+			if (!column->d->hasPendingData())
+				continue;
+			for (const auto* plot : std::as_const(plots)) {
+				if (plot->usingColumn(column, true)) {
+					pendingColumns << column->d;
+					break;
+				}
+			}
+		}
 
-	// recalculate all analysis curves if the results of the calculations were not saved in the project
-	if (!aspect->project()->saveCalculations()) {
-		for (auto* curve : aspect->children<XYAnalysisCurve>(ChildIndexFlag::Recursive))
-			curve->recalculate();
+		if (!pendingColumns.isEmpty()) {
+			DEBUG(Q_FUNC_INFO << ", reading the data of " << pendingColumns.size() << " columns")
+			QtConcurrent::blockingMap(pendingColumns, [](const ColumnPrivate* d) {
+				d->loadPendingData();
+			});
+		}
 	}
 
+	// recalculate all analysis curves if the results of the calculations were not saved in the project.
+	// the curves are recalculated in the order of their dependencies so every curve is calculated
+	// once and on the already calculated results of its source curve.
+	// large data sets are calculated concurrently in the background, the curves depending on them are
+	// started once the results of their source curves are available, wait for all of them here.
+	const auto& sortedCurves = sortedByDependencies(analysisCurves);
+	for (auto* curve : sortedCurves)
+		curve->recalculateAsync();
+	for (auto* curve : sortedCurves)
+		curve->waitForRecalculation();
+
 	// set "isLoading" to false for all worksheet elements
 	for (auto* child : aspect->children<WorksheetElement>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden))
 		child->setIsLoading(false);
 
 	// set "isLoading" to false for all columns
-	for (auto& column : aspect->project()->children<Column>(ChildIndexFlag::Recursive))
+	for (auto& column : project->children<Column>(ChildIndexFlag::Recursive))
 		column->setIsLoading(false);
 
 	// all data was read:
@@ -870,7 +1069,12 @@ void Project::retransformElements(AbstractAspect* aspect) {
 		for (auto* e : elements)
 			e->retransform();
 	} else if (hasChildren && aspect->type() != AspectType::CartesianPlot) {
-		for (const auto* w : aspect->children<Worksheet>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden)) {
+		for (auto* w : std::as_const(worksheets)) {
+			if (deferRetransform) {
+				w->setRetransformDeferred();
+				continue;
+			}
+
 			// retransform all elements in the worksheet (labels, images, plots)
 			// the plots will then recursive retransform the childs of them
 			const auto& elements = w->children<WorksheetElement>(ChildIndexFlag::IncludeHidden);
@@ -1368,6 +1572,7 @@ bool Project::readProjectAttributes(XmlStreamReader* reader) {
 
 	READ_INT_VALUE("compressed", fileCompression, bool);
 	READ_INT_VALUE("saveData", saveData, bool);
+	READ_INT_VALUE("saveBinaryData", saveBinaryData, bool);
 	READ_INT_VALUE("saveCalculations", saveCalculations, bool);
 
 	return true;
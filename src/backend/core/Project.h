@@ -16,6 +16,7 @@
 #include "backend/lib/macros.h"
 
 class Spreadsheet;
+class ProjectDataWriter;
 class ProjectPrivate;
 class UndoStack;
 
@@ -61,14 +62,20 @@ public:
 	CLASS_D_ACCESSOR_DECL(QString, defaultDockWidgetState, DefaultDockWidgetState)
 	BASIC_D_ACCESSOR_DECL(bool, fileCompression, FileCompression)
 	BASIC_D_ACCESSOR_DECL(bool, saveData, SaveData)
+	BASIC_D_ACCESSOR_DECL(bool, saveBinaryData, SaveBinaryData)
 
 	void setChanged(bool value = true) override;
 	void navigateTo(const QString& path);
 
 	void setSuppressAspectAddedSignal(bool);
 	bool aspectAddedSignalSuppressed() const;
+	void setDeferWorksheetRetransform(bool);
+	bool deferWorksheetRetransform() const;
 
 	void save(const QPixmap&, QXmlStreamWriter*);
+	bool save(const QPixmap&, ProjectDataWriter*);
+	ProjectDataWriter* dataWriter() const;
+	bool releaseDataFile();
 	bool load(XmlStreamReader*, bool preview) override;
 	bool load(const QString&, bool preview = false);
 #ifndef SDK
@@ -0,0 +1,405 @@
+/*
+	File                 : ProjectDataContainer.cpp
+	Project              : LabPlot
+	Description          : Container format storing the project XML and the binary column data
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/core/ProjectDataContainer.h"
+#include "backend/lib/macros.h"
+
+#include <KLocalizedString>
+
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+/*!
+ * \namespace ProjectDataContainer
+ * \brief Container format used for projects with a separate binary data section.
+ *
+ * The file starts with a header (magic "LPDC", format version, offset of the index),
+ * followed by the chunks of all blobs (column data and the project XML) and the index
+ * describing the chunks of every blob. Every blob is split into chunks of \c chunkSize bytes
+ * which are compressed independently (LZ4 if available, zlib otherwise) so they can be
+ * compressed and decompressed in parallel.
+ */
+namespace ProjectDataContainer {
+static const char magic[] = "LPDC";
+static const quint32 formatVersion = 1;
+static const qsizetype headerSize = 16; // magic, version, index offset
+static const qsizetype chunkSize = 4 * 1024 * 1024;
+
+bool isContainer(const QString& fileName) {
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	return file.read(4) == QByteArray(magic, 4);
+}
+
+static QByteArray compress(const QByteArray& data, Codec codec) {
+	switch (codec) {
+	case Codec::None:
+		return data;
+	case Codec::Zlib:
+		return qCompress(data, 1);
+	case Codec::LZ4: {
+#ifdef HAVE_LZ4
+		QByteArray result(LZ4_compressBound(data.size()), Qt::Uninitialized);
+		const int size = LZ4_compress_default(data.constData(), result.data(), data.size(), result.size());
+		result.resize(size);
+		return result;
+#else
+		return {};
+#endif
+	}
+	}
+
+	return {};
+}
+
+static bool decompress(const char* data, const Chunk& chunk, char* out) {
+	switch (chunk.codec) {
+	case Codec::None:
+		memcpy(out, data, chunk.size);
+		return true;
+	case Codec::Zlib: {
+		const auto& result = qUncompress(reinterpret_cast<const uchar*>(data), chunk.compressedSize);
+		if (result.size() != (qsizetype)chunk.size)
+			return false;
+		memcpy(out, result.constData(), chunk.size);
+		return true;
+	}
+	case Codec::LZ4:
+#ifdef HAVE_LZ4
+		return LZ4_decompress_safe(data, out, chunk.compressedSize, chunk.size) == (int)chunk.size;
+#else
+		return false;
+#endif
+	}
+
+	return false;
+}
+
+static QDataStream& operator<<(QDataStream& out, const Chunk& chunk) {
+	return out << chunk.offset << chunk.compressedSize << chunk.size << static_cast<quint8>(chunk.codec);
+}
+
+static QDataStream& operator>>(QDataStream& in, Chunk& chunk) {
+	quint8 codec;
+	in >> chunk.offset >> chunk.compressedSize >> chunk.size >> codec;
+	chunk.codec = static_cast<Codec>(codec);
+	return in;
+}
+}
+
+using namespace ProjectDataContainer;
+
+// ##############################################################################
+// ##############################  Writer  ######################################
+// ##############################################################################
+
+/*!
+ * \class ProjectDataWriter
+ * \brief Writes the project XML together with the binary data of the columns into \c device.
+ *
+ * The blobs are written to the device directly in \c addBlob() so the complete data
+ * of the project doesn't need to be kept in memory during the save.
+ */
+ProjectDataWriter::ProjectDataWriter(QIODevice* device, bool compress)
+	: m_device(device)
+	, m_compress(compress) {
+}
+
+/*!
+ * writes the header of the container, must be called before any blob is added.
+ */
+bool ProjectDataWriter::begin() {
+	if (!m_device->isOpen() && !m_device->open(QIODevice::WriteOnly)) {
+		m_error = i18n("Couldn't open the file for writing.");
+		return false;
+	}
+
+	QDataStream out(m_device);
+	out.writeRawData(magic, 4);
+	out << formatVersion << quint64(0); // the offset of the index is written in finish()
+	return out.status() == QDataStream::Ok;
+}
+
+/*!
+ * adds the content of \c data as a new blob to the container and returns its index that can be used
+ * to access it in \c ProjectDataReader::blob(). Returns -1 on errors.
+ */
+int ProjectDataWriter::addBlob(const QByteArray& data) {
+	Blob blob;
+	if (!writeBlob(data, blob))
+		return -1;
+
+	m_blobs << blob;
+	return m_blobs.size() - 1;
+}
+
+bool ProjectDataWriter::writeBlob(const QByteArray& data, Blob& blob) {
+	QVector<QByteArray> chunks;
+	for (qsizetype pos = 0; pos < data.size(); pos += chunkSize)
+		chunks << QByteArray::fromRawData(data.constData() + pos, std::min(chunkSize, data.size() - pos));
+
+	Codec codec = Codec::None;
+	if (m_compress) {
+#ifdef HAVE_LZ4
+		codec = Codec::LZ4;
+#else
+		codec = Codec::Zlib;
+#endif
+	}
+
+	// compress the chunks in parallel and write them sequentially
+	const auto& compressed = QtConcurrent::blockingMapped(chunks, [codec](const QByteArray& chunk) {
+		return compress(chunk, codec);
+	});
+
+	for (int i = 0; i < chunks.size(); ++i) {
+		Chunk chunk;
+		chunk.offset = m_device->pos();
+		chunk.size = chunks.at(i).size();
+		chunk.codec = codec;
+
+		// store the chunk uncompressed if the compression didn't help
+		auto chunkData = compressed.at(i);
+		if (chunkData.isEmpty() || chunkData.size() >= chunks.at(i).size()) {
+			chunkData = chunks.at(i);
+			chunk.codec = Codec::None;
+		}
+		chunk.compressedSize = chunkData.size();
+
+		if (m_device->write(chunkData) != chunkData.size()) {
+			m_error = i18n("Couldn't write the data to the file.");
+			return false;
+		}
+
+		blob << chunk;
+	}
+
+	return true;
+}
+
+/*!
+ * writes \c xml and the index of the blobs and finalizes the container.
+ */
+bool ProjectDataWriter::finish(const QByteArray& xml) {
+	Blob xmlBlob;
+	if (!writeBlob(xml, xmlBlob))
+		return false;
+
+	const quint64 indexOffset = m_device->pos();
+	QDataStream out(m_device);
+	out << static_cast<quint32>(m_blobs.size());
+	for (const auto& blob : std::as_const(m_blobs)) {
+		out << static_cast<quint32>(blob.size());
+		for (const auto& chunk : blob)
+			out << chunk;
+	}
+	out << static_cast<quint32>(xmlBlob.size());
+	for (const auto& chunk : xmlBlob)
+		out << chunk;
+
+	// update the offset of the index in the header
+	if (!m_device->seek(8)) {
+		m_error = i18n("Couldn't write the data to the file.");
+		return false;
+	}
+	out << indexOffset;
+
+	if (out.status() != QDataStream::Ok) {
+		m_error = i18n("Couldn't write the data to the file.");
+		return false;
+	}
+
+	return true;
+}
+
+QString ProjectDataWriter::errorString() const {
+	return m_error;
+}
+
+// ##############################################################################
+// ##############################  Reader  ######################################
+// ##############################################################################
+
+/*!
+ * \class ProjectDataReader
+ * \brief Provides access to the project XML and to the binary data of the columns stored in a project container.
+ *
+ * The file is kept open so the blobs can be read on demand, \c blob() can be called from different threads.
+ * Before the file is overwritten, \c detach() has to be called.
+ */
+bool ProjectDataReader::open(const QString& fileName) {
+	m_file.setFileName(fileName);
+	if (!m_file.open(QIODevice::ReadOnly)) {
+		m_error = i18n("Sorry. Could not open file for reading.");
+		return false;
+	}
+
+	QDataStream in(&m_file);
+	char fileMagic[4];
+	quint32 version;
+	quint64 indexOffset;
+	if (in.readRawData(fileMagic, 4) != 4 || memcmp(fileMagic, magic, 4) != 0) {
+		m_error = i18n("The file is not a valid LabPlot project.");
+		return false;
+	}
+
+	in >> version >> indexOffset;
+	if (version > formatVersion) {
+		m_error = i18n("The project was created with a newer version of LabPlot and cannot be opened.");
+		return false;
+	}
+
+	if (indexOffset < (quint64)headerSize || !m_file.seek(indexOffset)) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+
+	auto readBlob = [&in](Blob& blob) {
+		quint32 count;
+		in >> count;
+		blob.resize(count);
+		for (auto& chunk : blob)
+			in >> chunk;
+	};
+
+	quint32 count;
+	in >> count;
+	m_blobs.resize(count);
+	for (auto& blob : m_blobs)
+		readBlob(blob);
+	readBlob(m_xml);
+	m_blobRead.fill(false, m_blobs.size());
+
+	if (in.status() != QDataStream::Ok) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+
+	DEBUG(Q_FUNC_INFO << ", number of blobs: " << m_blobs.size())
+	return true;
+}
+
+QByteArray ProjectDataReader::xml() const {
+	return blob(-1);
+}
+
+/*!
+ * returns the decompressed content of the blob \c index, the XML of the project for \c index = -1.
+ * Returns an empty array on errors.
+ */
+QByteArray ProjectDataReader::blob(int index) const {
+	if (index >= m_blobs.size())
+		return {};
+
+	const auto& blob = (index < 0) ? m_xml : m_blobs.at(index);
+	const qsizetype size = std::accumulate(blob.cbegin(), blob.cend(), qsizetype(0), [](qsizetype sum, const Chunk& chunk) {
+		return sum + chunk.size;
+	});
+
+	// read the compressed chunks
+	QVector<QByteArray> compressed(blob.size());
+	{
+		QMutexLocker locker(&m_mutex);
+		if (index >= 0)
+			m_blobRead[index] = true;
+
+		if (!m_file.isOpen()) {
+			// the file was closed in detach(), the chunks of the blobs not read before are kept in memory
+			if (index < 0 || index >= m_detachedChunks.size() || m_detachedChunks.at(index).size() != blob.size())
+				return {};
+			compressed = std::exchange(m_detachedChunks[index], {});
+		} else {
+			for (int i = 0; i < blob.size(); ++i) {
+				const auto& chunk = blob.at(i);
+				if (!m_file.seek(chunk.offset))
+					return {};
+				compressed[i] = m_file.read(chunk.compressedSize);
+				if (compressed.at(i).size() != (qsizetype)chunk.compressedSize)
+					return {};
+			}
+		}
+	}
+
+	// decompress them in parallel
+	QByteArray result(size, Qt::Uninitialized);
+	QVector<qsizetype> offsets(blob.size());
+	qsizetype offset = 0;
+	for (int i = 0; i < blob.size(); ++i) {
+		offsets[i] = offset;
+		offset += blob.at(i).size;
+	}
+
+	QVector<int> indices(blob.size());
+	std::iota(indices.begin(), indices.end(), 0);
+	std::atomic<bool> ok{true};
+	char* out = result.data();
+	QtConcurrent::blockingMap(indices, [&](int i) {
+		if (!decompress(compressed.at(i).constData(), blob.at(i), out + offsets.at(i)))
+			ok = false;
+	});
+
+	if (!ok) {
+		WARN(Q_FUNC_INFO << ", failed to decompress the blob " << index)
+		return {};
+	}
+
+	return result;
+}
+
+int ProjectDataReader::blobCount() const {
+	return m_blobs.size();
+}
+
+/*!
+ * reads the compressed chunks of all blobs that were not requested via \c blob() yet into memory and closes the file
+ * so it can be overwritten or removed. The blobs are still available via \c blob() afterwards.
+ */
+bool ProjectDataReader::detach() {
+	QMutexLocker locker(&m_mutex);
+	if (!m_file.isOpen())
+		return true;
+
+	QVector<QVector<QByteArray>> detachedChunks(m_blobs.size());
+	for (int index = 0; index < m_blobs.size(); ++index) {
+		if (m_blobRead.at(index))
+			continue;
+
+		const auto& blob = m_blobs.at(index);
+		auto& chunks = detachedChunks[index];
+		chunks.resize(blob.size());
+		for (int i = 0; i < blob.size(); ++i) {
+			const auto& chunk = blob.at(i);
+			if (m_file.seek(chunk.offset))
+				chunks[i] = m_file.read(chunk.compressedSize);
+			if (chunks.at(i).size() != (qsizetype)chunk.compressedSize) {
+				m_error = i18n("Couldn't read the data from the file.");
+				return false;
+			}
+		}
+	}
+
+	m_detachedChunks = std::move(detachedChunks);
+	m_file.close();
+	return true;
+}
+
+QString ProjectDataReader::errorString() const {
+	return m_error;
+}
@@ -0,0 +1,72 @@
+/*
+	File                 : ProjectDataContainer.h
+	Project              : LabPlot
+	Description          : Container format storing the project XML and the binary column data
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef PROJECTDATACONTAINER_H
+#define PROJECTDATACONTAINER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+class QIODevice;
+
+namespace ProjectDataContainer {
+enum class Codec : quint8 { None, Zlib, LZ4 };
+
+struct Chunk {
+	quint64 offset{0};
+	quint32 compressedSize{0};
+	quint32 size{0};
+	Codec codec{Codec::None};
+};
+
+using Blob = QVector<Chunk>;
+
+bool isContainer(const QString& fileName);
+}
+
+class ProjectDataWriter {
+public:
+	explicit ProjectDataWriter(QIODevice*, bool compress = true);
+
+	bool begin();
+	int addBlob(const QByteArray&);
+	bool finish(const QByteArray& xml);
+	QString errorString() const;
+
+private:
+	bool writeBlob(const QByteArray&, ProjectDataContainer::Blob&);
+
+	QIODevice* m_device;
+	bool m_compress;
+	QVector<ProjectDataContainer::Blob> m_blobs;
+	QString m_error;
+};
+
+class ProjectDataReader {
+public:
+	bool open(const QString& fileName);
+	QByteArray xml() const;
+	QByteArray blob(int index) const;
+	int blobCount() const;
+	bool detach();
+	QString errorString() const;
+
+private:
+	mutable QFile m_file;
+	mutable QMutex m_mutex;
+	QVector<ProjectDataContainer::Blob> m_blobs;
+	mutable QVector<bool> m_blobRead; // blobs already requested via blob()
+	mutable QVector<QVector<QByteArray>> m_detachedChunks; // compressed chunks of the blobs not read yet, kept in memory after detach()
+	ProjectDataContainer::Blob m_xml;
+	QString m_error;
+};
+
+#endif
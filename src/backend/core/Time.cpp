@@ -1,5 +1,10 @@
 #include "Time.h"
 
+#include <QDateTime>
+#include <QTimeZone>
+
+#include <cmath>
+
 namespace DateTime {
 qint64 milliseconds(qint64 hour, qint64 minute, qint64 second, qint64 millisecond) {
 	qint64 value = millisecond;
@@ -34,4 +39,33 @@ DateTime dateTime(const qint64 value) {
 
 	return dt;
 }
+
+/*!
+ * formats the nanoseconds since epoch (UTC) \c nsecs with the QDateTime format \c format.
+ * In addition to the expressions supported by QDateTime, "zzzzzzzzz" is replaced by the fraction of the second
+ * with nanoseconds (9 digits) and "zzzzzz" with microseconds (6 digits).
+ */
+QString toString(qint64 nsecs, const QString& format) {
+	constexpr qint64 nsecsPerSec = 1000000000;
+	qint64 secs = nsecs / nsecsPerSec;
+	qint64 fraction = nsecs % nsecsPerSec;
+	if (fraction < 0) {
+		--secs;
+		fraction += nsecsPerSec;
+	}
+
+	QString f = format;
+	if (f.contains(QLatin1String("zzzzzz"))) {
+		f.replace(QLatin1String("zzzzzzzzz"), QStringLiteral("'%1'").arg(fraction, 9, 10, QLatin1Char('0')));
+		f.replace(QLatin1String("zzzzzz"), QStringLiteral("'%1'").arg(fraction / 1000, 6, 10, QLatin1Char('0')));
+	}
+
+	return QDateTime::fromMSecsSinceEpoch(secs * 1000 + fraction / 1000000, QTimeZone::UTC).toString(f);
+}
+
+//! formats the fractional milliseconds since epoch (UTC) \c msecs as used in the plots, see toString(qint64, const QString&)
+QString toString(double msecs, const QString& format) {
+	const double ms = std::floor(msecs);
+	return toString(qint64(ms) * 1000000 + std::llround((msecs - ms) * 1000000), format);
+}
 }
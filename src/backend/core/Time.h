@@ -1,7 +1,7 @@
 #ifndef LABPLOT_TIME_H
 #define LABPLOT_TIME_H
 
-#include <QtGlobal>
+#include <QString>
 
 namespace DateTime {
 struct DateTime {
@@ -16,6 +16,8 @@ struct DateTime {
 qint64 milliseconds(qint64 hour, qint64 minute, qint64 second, qint64 millisecond);
 qint64 createValue(qint64 year, qint64 month, qint64 day, qint64 hour, qint64 minute, qint64 second, qint64 millisecond);
 DateTime dateTime(const qint64 value);
+QString toString(qint64 nsecs, const QString& format);
+QString toString(double msecs, const QString& format);
 }
 
 #endif // LABPLOT_TIME_H
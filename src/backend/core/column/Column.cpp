@@ -14,8 +14,10 @@
 #include "backend/notebook/Notebook.h"
 #endif
 #include "backend/core/Project.h"
+#include "backend/core/ProjectDataContainer.h"
 #include "backend/core/column/ColumnPrivate.h"
 #include "backend/core/column/ColumnStringIO.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/core/column/columncommands.h"
 #include "backend/core/datatypes/DateTime2StringFilter.h"
 #include "backend/core/datatypes/Double2StringFilter.h"
@@ -28,6 +30,7 @@
 #include "backend/worksheet/plots/cartesian/Plot.h"
 #include "frontend/spreadsheet/SpreadsheetView.h"
 
+#include <cstring>
 #include <limits>
 
 #include <QActionGroup>
@@ -610,6 +613,28 @@ const QMap<QString, int>& Column::frequencies() const {
 	return d->frequencies();
 }
 
+/*!
+ * returns for every row the rank of its text in the sorted list of the distinct texts of the column
+ * or -1 for empty texts, comparing the ranks is equivalent to comparing the texts.
+ * Use this only when columnMode() is Text
+ */
+QVector<int> Column::textRanks() const {
+	return d->textRanks();
+}
+
+/*!
+ * switches the storage of the texts to the dictionary encoded representation (one integer code per row
+ * and every distinct text stored only once) if the column has few distinct values compared to the number of rows.
+ * The content of the column doesn't change. Returns \c true if the texts are stored dictionary encoded.
+ */
+bool Column::compactTexts() {
+	return d->compactTexts();
+}
+
+bool Column::isDictionaryEncoded() const {
+	return d->isDictionaryEncoded();
+}
+
 void Column::addValueLabel(const QString& value, const QString& label) {
 	d->addValueLabel(value, label);
 }
@@ -776,6 +801,15 @@ AbstractColumn::Properties Column::properties() const {
 	return d->properties;
 }
 
+/*!
+ * \brief Column::sortedIndex
+ * Returns the valid and not masked rows sorted by their values. Used to find the rows with values
+ * in a given range with a binary search if the column is not monotonic, the index is cached until the data is modified.
+ */
+const QVector<int>& Column::sortedIndex() const {
+	return d->sortedIndex();
+}
+
 const Column::ColumnStatistics& Column::statistics() const {
 	if (!d->available.statistics)
 		d->calculateStatistics();
@@ -942,6 +976,34 @@ QDateTime Column::dateTimeAt(int row) const {
 	return d->dateTimeAt(row);
 }
 
+std::span<const qint64> Column::dateTimeMSecs() const {
+	return d->dateTimeMSecs();
+}
+
+std::span<const qint64> Column::dateTimeNSecs() const {
+	return d->dateTimeNSecs();
+}
+
+/*!
+ * replaces the content of the column with the timestamps \c nsecs given as nanoseconds since epoch (UTC),
+ * std::numeric_limits<qint64>::min() is used for empty cells. The nanoseconds are kept until the column is modified.
+ * The change is not undoable, it's used by the import filters for high-resolution timestamps.
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+void Column::setDateTimeNSecs(const QVector<qint64>& nsecs) {
+	d->setDateTimeNSecs(nsecs);
+}
+
+/*!
+ * switches the storage of the date and time values to milliseconds since epoch (one 64-bit integer per row)
+ * if all values of the column have the same time representation. The content of the column doesn't change.
+ * Returns \c true if the values are stored as milliseconds since epoch.
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+bool Column::compactDateTimes() {
+	return d->compactDateTimes();
+}
+
 double Column::doubleAt(int row) const {
 	return d->doubleAt(row);
 }
@@ -1169,6 +1231,8 @@ void Column::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("designation"), QString::number(static_cast<int>(plotDesignation())));
 	writer->writeAttribute(QStringLiteral("mode"), QString::number(static_cast<int>(columnMode())));
 	writer->writeAttribute(QStringLiteral("width"), QString::number(width()));
+	if (saveData && d->dateTimeResolution() == DateTimeValues::Resolution::Nanoseconds)
+		writer->writeAttribute(QStringLiteral("resolution"), QStringLiteral("ns"));
 
 	// save the formula used to generate column values, if available
 	if (!formula().isEmpty()) {
@@ -1328,60 +1392,14 @@ void Column::save(QXmlStreamWriter* writer) const {
 
 	// data
 	if (saveData) {
-		switch (columnMode()) {
-		case ColumnMode::Double: {
-			const char* data = reinterpret_cast<const char*>(static_cast<QVector<double>*>(d->data())->constData());
-			size_t size = d->rowCount() * sizeof(double);
-			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
-			break;
-		}
-		case ColumnMode::Integer: {
-			const char* data = reinterpret_cast<const char*>(static_cast<QVector<int>*>(d->data())->constData());
-			size_t size = d->rowCount() * sizeof(int);
-			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
-			break;
-		}
-		case ColumnMode::BigInt: {
-			const char* data = reinterpret_cast<const char*>(static_cast<QVector<qint64>*>(d->data())->constData());
-			size_t size = d->rowCount() * sizeof(qint64);
-			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
-			break;
-		}
-		case ColumnMode::Text: {
-			// serialize text data using Base64 encoding with null separator
-			QByteArray bytes;
-			for (int i = 0; i < rowCount(); ++i) {
-				bytes.append(textAt(i).toUtf8());
-				bytes.append('\0');
-			}
-			bytes.removeLast(); // remove the last null character
-			writer->writeCharacters(QLatin1String(bytes.toBase64()));
-			break;
-		}
-		case ColumnMode::Month:
-		case ColumnMode::Day:
-		case ColumnMode::DateTime: {
-			// convert QDateTime values to milliseconds since epoch and serialize them using Base64 encoding
-			// Use std::numeric_limits<qint64>::min() as sentinel for invalid/empty DateTimes
-			QByteArray bytes;
-			for (int i = 0; i < rowCount(); ++i) {
-				auto dt = dateTimeAt(i);
-				qint64 msecs;
-				if (!dt.isValid()) {
-					msecs = std::numeric_limits<qint64>::min(); // Sentinel for empty cells
-				} else {
-					// If DateTime is not in UTC, convert it to UTC preserving the date/time values
-					// This ensures DateTimes created without explicit UTC timezone are treated consistently
-					if (dt.timeZone() != QTimeZone::UTC)
-						dt = QDateTime(dt.date(), dt.time(), QTimeZone::UTC);
-					msecs = dt.toMSecsSinceEpoch();
-				}
-				bytes.append(reinterpret_cast<const char*>(&msecs), sizeof(qint64));
-			}
-			writer->writeCharacters(QLatin1String(bytes.toBase64()));
-			break;
-		}
-		}
+		auto* dataWriter = project() ? project()->dataWriter() : nullptr;
+		if (dataWriter && rowCount() > 0) {
+			// the project is saved with a separate binary data section, only reference the data here
+			writer->writeStartElement(QStringLiteral("binaryData"));
+			writer->writeAttribute(QStringLiteral("blob"), QString::number(dataWriter->addBlob(d->encodeData())));
+			writer->writeEndElement();
+		} else
+			writer->writeCharacters(QLatin1String(d->encodeData().toBase64()));
 
 		// save per-cell validity bitmap for Integer/BigInt columns
 		if ((columnMode() == ColumnMode::Integer || columnMode() == ColumnMode::BigInt) && !d->m_valid.isEmpty()) {
@@ -1398,84 +1416,29 @@ void Column::save(QXmlStreamWriter* writer) const {
 // TODO: extra header
 class DecodeColumnTask : public QRunnable {
 public:
-	DecodeColumnTask(ColumnPrivate* priv, const QString& content, const QString& validContent)
+	DecodeColumnTask(ColumnPrivate* priv, const QString& content, const QString& validContent, bool nanoseconds)
 		: m_private(priv)
 		, m_content(content)
-		, m_validContent(validContent) { };
+		, m_validContent(validContent)
+		, m_nanoseconds(nanoseconds) { };
 	void run() override {
 		const auto bytes = QByteArray::fromBase64(m_content.toLatin1());
-		switch (m_private->columnMode()) {
-		case AbstractColumn::ColumnMode::Double: {
-			auto* data = new QVector<double>(bytes.size() / (int)sizeof(double));
-			memcpy(data->data(), bytes.data(), bytes.size());
-			m_private->replaceData(data);
-			break;
-		}
-		case AbstractColumn::ColumnMode::BigInt: {
-			auto* data = new QVector<qint64>(bytes.size() / (int)sizeof(qint64));
-			memcpy(data->data(), bytes.data(), bytes.size());
-			m_private->replaceData(data);
-			break;
-		}
-		case AbstractColumn::ColumnMode::Integer: {
-			auto* data = new QVector<int>(bytes.size() / (int)sizeof(int));
-			memcpy(data->data(), bytes.data(), bytes.size());
-			m_private->replaceData(data);
-			break;
-		}
-		case AbstractColumn::ColumnMode::Text: {
-			// deserialize text data using Base64 encoding with null separator
-			const QString decoded = QString::fromUtf8(bytes);
-			auto textVector = decoded.split(QLatin1Char('\0'), Qt::KeepEmptyParts);
-			m_private->replaceTexts(-1, textVector);
-			break;
-		}
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::DateTime: {
-			// deserialize QDateTime values from milliseconds since epoch
-			// std::numeric_limits<qint64>::min() is sentinel for invalid/empty DateTimes
-			QVector<QDateTime> dateTimeVector;
-			for (int i = 0; i < bytes.size(); i += sizeof(qint64)) {
-				qint64 msecs;
-				memcpy(&msecs, bytes.data() + i, sizeof(qint64));
-				if (msecs == std::numeric_limits<qint64>::min()) {
-					dateTimeVector.append(QDateTime()); // Invalid QDateTime for empty cells
-				} else {
-					// Interpret stored milliseconds since epoch as UTC to preserve original timezone
-					dateTimeVector.append(QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::UTC));
-				}
-			}
-			m_private->replaceDateTimes(-1, dateTimeVector);
-			break;
-		}
-		}
+		if (m_nanoseconds) {
+			QVector<qint64> nsecs(bytes.size() / (qsizetype)sizeof(qint64));
+			memcpy(nsecs.data(), bytes.constData(), nsecs.size() * sizeof(qint64));
+			m_private->setDateTimeNSecs(nsecs);
+		} else
+			m_private->replaceData(ColumnPrivate::decodeData(m_private->columnMode(), bytes));
 
 		// apply per-element validity bitmap for Integer/BigInt columns
-		if (AbstractColumnPrivate::needsValidityTracking(m_private->columnMode())) {
-			const int numRows = m_private->rowCount();
-			if (!m_validContent.isEmpty()) {
-				// restore saved validity bitmap
-				const auto validBytes = QByteArray::fromBase64(m_validContent.toLatin1());
-				m_private->m_valid = QBitArray(numRows);
-				const int byteCount = qMin(validBytes.size(), (numRows + 7) / 8);
-				const auto* bits = reinterpret_cast<const uchar*>(validBytes.constData());
-				for (int i = 0; i < numRows; ++i) {
-					if (i / 8 < byteCount && (bits[i / 8] & (1 << (i % 8))))
-						m_private->m_valid.setBit(i, true);
-				}
-			} else {
-				// backward compatibility: no validity element, mark all as valid
-				m_private->m_valid.resize(numRows);
-				m_private->m_valid.fill(true);
-			}
-		}
+		m_private->setValidity(QByteArray::fromBase64(m_validContent.toLatin1()));
 	}
 
 private:
 	ColumnPrivate* m_private;
 	QString m_content;
 	QString m_validContent;
+	bool m_nanoseconds;
 };
 
 /**
@@ -1513,10 +1476,16 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 	else
 		d->setWidth(str.toInt());
 
+	// date and time values with nanosecond resolution, milliseconds otherwise
+	const bool nanoseconds = (attribs.value(QStringLiteral("resolution")) == QLatin1String("ns"));
+	if (nanoseconds)
+		d->setPendingDateTimeResolution(DateTimeValues::Resolution::Nanoseconds);
+
 	QVector<QDateTime> dateTimeVector;
 	QVector<QString> textVector;
 	QString pendingDecodeContent;
 	QString pendingValidContent;
+	int pendingBlob = -1;
 
 	// read child elements
 	while (!reader->atEnd()) {
@@ -1607,6 +1576,9 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 				}
 			} else if (reader->name() == QLatin1String("valid")) {
 				pendingValidContent = reader->readElementText().trimmed();
+			} else if (reader->name() == QLatin1String("binaryData")) {
+				if (!preview)
+					pendingBlob = reader->readAttributeInt(QStringLiteral("blob"), &ret_val);
 			} else if (reader->name() == QLatin1String("row")) {
 				// Assumption: the next elements are all rows
 				switch (columnMode()) {
@@ -1652,9 +1624,13 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 		}
 	}
 
-	// start the decode task after all elements (including <valid>) have been parsed
-	if (!pendingDecodeContent.isEmpty()) {
-		auto* task = new DecodeColumnTask(d, pendingDecodeContent, pendingValidContent);
+	// start the decode task after all elements (including <valid>) have been parsed.
+	// data stored in the binary section of the project file is only decoded on the first access.
+	if (pendingBlob >= 0 && reader->dataReader()) {
+		d->setPendingData(reader->dataReader(), pendingBlob);
+		d->setValidity(QByteArray::fromBase64(pendingValidContent.toLatin1()));
+	} else if (!pendingDecodeContent.isEmpty()) {
+		auto* task = new DecodeColumnTask(d, pendingDecodeContent, pendingValidContent, nanoseconds);
 		QThreadPool::globalInstance()->start(task);
 	}
 
@@ -1859,6 +1835,13 @@ bool Column::isValid(int row) const {
 			return false;
 		return d->m_valid.testBit(row);
 	}
+	if (columnMode() == ColumnMode::DateTime || columnMode() == ColumnMode::Month || columnMode() == ColumnMode::Day) {
+		auto values = d->dateTimeMSecs();
+		if (values.empty())
+			values = d->dateTimeNSecs();
+		if (!values.empty())
+			return row >= 0 && row < (int)values.size() && values[row] != DateTimeValues::invalid;
+	}
 	return AbstractColumn::isValid(row);
 }
 void Column::setValid(int row, bool valid) {
@@ -2096,6 +2079,37 @@ double Column::minimum(int startIndex, int endIndex) const {
 		case ColumnMode::Text:
 			break;
 		case ColumnMode::DateTime: {
+			const auto values = dateTimeMSecs();
+			if (!values.empty()) { // no conversion from QDateTime needed, empty cells are skipped via isValid()
+				for (int row = startIndex; row <= endIndex; ++row) {
+					if (!isValid(row) || isMasked(row))
+						continue;
+
+					if (values[row] < min)
+						min = values[row];
+				}
+				break;
+			}
+
+			const auto nsecs = dateTimeNSecs();
+			if (!nsecs.empty()) {
+				// compare the exact nanoseconds, the fractional milliseconds of close values can be equal
+				qint64 minNSecs = std::numeric_limits<qint64>::max();
+				bool found = false;
+				for (int row = startIndex; row <= endIndex; ++row) {
+					if (!isValid(row) || isMasked(row))
+						continue;
+
+					if (!found || nsecs[row] < minNSecs) {
+						minNSecs = nsecs[row];
+						found = true;
+					}
+				}
+				if (found)
+					min = DateTimeValues::toMSecsF(minNSecs);
+				break;
+			}
+
 			auto* vec = static_cast<QVector<QDateTime>*>(data());
 			for (int row = startIndex; row <= endIndex; ++row) {
 				if (!isValid(row) || isMasked(row))
@@ -2130,7 +2144,7 @@ double Column::minimum(int startIndex, int endIndex) const {
 		case ColumnMode::DateTime:
 		case ColumnMode::Month:
 		case ColumnMode::Day:
-			min = dateTimeAt(foundIndex).toMSecsSinceEpoch();
+			min = d->dateTimeMSecsF(foundIndex);
 			break;
 		case ColumnMode::Text:
 			break;
@@ -2238,6 +2252,37 @@ double Column::maximum(int startIndex, int endIndex) const {
 		case ColumnMode::Text:
 			break;
 		case ColumnMode::DateTime: {
+			const auto values = dateTimeMSecs();
+			if (!values.empty()) { // no conversion from QDateTime needed, empty cells are skipped via isValid()
+				for (int row = startIndex; row <= endIndex; ++row) {
+					if (!isValid(row) || isMasked(row))
+						continue;
+
+					if (values[row] > max)
+						max = values[row];
+				}
+				break;
+			}
+
+			const auto nsecs = dateTimeNSecs();
+			if (!nsecs.empty()) {
+				// compare the exact nanoseconds, the fractional milliseconds of close values can be equal
+				qint64 maxNSecs = std::numeric_limits<qint64>::lowest();
+				bool found = false;
+				for (int row = startIndex; row <= endIndex; ++row) {
+					if (!isValid(row) || isMasked(row))
+						continue;
+
+					if (!found || nsecs[row] > maxNSecs) {
+						maxNSecs = nsecs[row];
+						found = true;
+					}
+				}
+				if (found)
+					max = DateTimeValues::toMSecsF(maxNSecs);
+				break;
+			}
+
 			auto* vec = static_cast<QVector<QDateTime>*>(data());
 			for (int row = startIndex; row <= endIndex; ++row) {
 				if (!isValid(row) || isMasked(row))
@@ -2271,7 +2316,7 @@ double Column::maximum(int startIndex, int endIndex) const {
 		case ColumnMode::DateTime:
 		case ColumnMode::Month:
 		case ColumnMode::Day:
-			max = dateTimeAt(foundIndex).toMSecsSinceEpoch();
+			max = d->dateTimeMSecsF(foundIndex);
 			break;
 		case ColumnMode::Text:
 			break;
@@ -2366,31 +2411,29 @@ bool Column::indicesMinMax(double v1, double v2, int& start, int& end) const {
 		case ColumnMode::DateTime:
 		case ColumnMode::Month:
 		case ColumnMode::Day: {
-			qint64 v1int64 = v1;
-			qint64 v2int64 = v2;
-			qint64 value;
+			double value;
 			if (property == Properties::MonotonicIncreasing) {
 				if (start > 0) {
-					value = dateTimeAt(start - 1).toMSecsSinceEpoch();
-					if (value <= v2int64 && value >= v1int64)
+					value = d->dateTimeMSecsF(start - 1);
+					if (value <= v2 && value >= v1)
 						start--;
 				}
 
 				if (end > rowCount - 1) {
-					value = dateTimeAt(end + 1).toMSecsSinceEpoch();
-					if (value <= v2int64 && value >= v1int64)
+					value = d->dateTimeMSecsF(end + 1);
+					if (value <= v2 && value >= v1)
 						end++;
 				}
 			} else {
 				if (end > 0) {
-					value = dateTimeAt(end - 1).toMSecsSinceEpoch();
-					if (value <= v2int64 && value >= v1int64)
+					value = d->dateTimeMSecsF(end - 1);
+					if (value <= v2 && value >= v1)
 						end--;
 				}
 
 				if (start > rowCount - 1) {
-					value = dateTimeAt(start + 1).toMSecsSinceEpoch();
-					if (value <= v2int64 && value >= v1int64)
+					value = d->dateTimeMSecsF(start + 1);
+					if (value <= v2 && value >= v1)
 						start++;
 				}
 			}
@@ -2428,14 +2471,13 @@ bool Column::indicesMinMax(double v1, double v2, int& start, int& end) const {
 	case ColumnMode::DateTime:
 	case ColumnMode::Month:
 	case ColumnMode::Day: {
-		qint64 value;
-		qint64 v2int64 = v2;
-		qint64 v1int64 = v1;
+		// compare the (fractional) milliseconds since epoch without creating QDateTime objects
+		double value;
 		for (int i = 0; i < rowCount; i++) {
 			if (!isValid(i) || isMasked(i))
 				continue;
-			value = dateTimeAt(i).toMSecsSinceEpoch();
-			if (value <= v2int64 && value >= v1int64) {
+			value = d->dateTimeMSecsF(i);
+			if (value <= v2 && value >= v1) {
 				end = i;
 				if (start < 0)
 					start = i;
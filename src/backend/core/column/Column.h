@@ -165,6 +165,7 @@ public:
 
 	Properties properties() const override;
 	void invalidateProperties() override;
+	const QVector<int>& sortedIndex() const;
 
 	void setFromColumn(int, AbstractColumn*, int);
 	QString textAt(int) const override;
@@ -173,13 +174,20 @@ public:
 	void replaceTexts(int, const QVector<QString>&) override;
 	int dictionaryIndex(int row) const override;
 	const QMap<QString, int>& frequencies() const;
+	QVector<int> textRanks() const;
+	bool compactTexts();
+	bool isDictionaryEncoded() const;
 
 	QDate dateAt(int) const override;
 	void setDateAt(int, QDate) override;
 	QTime timeAt(int) const override;
 	void setTimeAt(int, QTime) override;
 	void setDateTimes(const QVector<QDateTime>&);
+	bool compactDateTimes();
 	QDateTime dateTimeAt(int) const override;
+	std::span<const qint64> dateTimeMSecs() const override;
+	std::span<const qint64> dateTimeNSecs() const override;
+	void setDateTimeNSecs(const QVector<qint64>&);
 	void setDateTimeAt(int, const QDateTime&) override;
 	void replaceDateTimes(int, const QVector<QDateTime>&) override;
 
@@ -13,6 +13,9 @@
 #include "ColumnPrivate.h"
 #include "Column.h"
 #include "ColumnStringIO.h"
+#include "DateTimeValues.h"
+#include "TextDictionary.h"
+#include "backend/core/ProjectDataContainer.h"
 #include "backend/core/datatypes/filter.h"
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/lib/trace.h"
@@ -25,6 +28,9 @@
 
 #include "functions.h"
 
+#include <QTimeZone>
+
+#include <algorithm>
 #include <array>
 #include <unordered_map>
 
@@ -88,14 +94,13 @@ int indexForValueCommon(const T* obj,
 						const std::function<AbstractColumn::ColumnMode(const T*)> columnMode,
 						const std::function<int(const T*)> rowCount,
 						const std::function<double(const T*, int)> valueAt,
-						const std::function<QDateTime(const T*, int)> dateTimeAt,
+						const std::function<double(const T*, int)> dateTimeMSecsAt, // (fractional) milliseconds since epoch of date and time values
 						const std::function<AbstractColumn::Properties(const T*)> properties,
 						const std::function<bool(const T*, int)> isValid,
 						const std::function<bool(const T*, int)> isMasked,
 						bool smaller) {
 	int rc = rowCount(obj);
 	double prevValue = 0;
-	qint64 prevValueDateTime = 0;
 	auto mode = columnMode(obj);
 	auto property = properties(obj);
 	if (property == Column::Properties::MonotonicIncreasing || property == Column::Properties::MonotonicDecreasing) {
@@ -126,21 +131,14 @@ int indexForValueCommon(const T* obj,
 		case Column::ColumnMode::DateTime:
 		case Column::ColumnMode::Month:
 		case Column::ColumnMode::Day: {
-			qint64 xInt64 = static_cast<qint64>(x);
 			for (unsigned int i = 0; i < maxSteps; i++) { // so no log_2(rowCount) needed
 				int index = lowerIndex + round(static_cast<double>(higherIndex - lowerIndex) / 2);
-				qint64 value = dateTimeAt(obj, index).toMSecsSinceEpoch();
+				double value = dateTimeMSecsAt(obj, index);
 
 				if (higherIndex - lowerIndex < 2)
-					return finalIndex(dateTimeAt(obj, lowerIndex).toMSecsSinceEpoch(),
-									  dateTimeAt(obj, higherIndex).toMSecsSinceEpoch(),
-									  xInt64,
-									  lowerIndex,
-									  higherIndex,
-									  smaller,
-									  increase);
-
-				determineNewIndices(value, xInt64, index, lowerIndex, higherIndex, smaller, increase);
+					return finalIndex(dateTimeMSecsAt(obj, lowerIndex), dateTimeMSecsAt(obj, higherIndex), x, lowerIndex, higherIndex, smaller, increase);
+
+				determineNewIndices(value, x, index, lowerIndex, higherIndex, smaller, increase);
 			}
 		}
 		}
@@ -175,17 +173,16 @@ int indexForValueCommon(const T* obj,
 		case Column::ColumnMode::DateTime:
 		case Column::ColumnMode::Month:
 		case Column::ColumnMode::Day: {
-			qint64 xInt64 = static_cast<qint64>(x);
 			for (int row = 0; row < rc; row++) {
 				if (!isValid(obj, row) || isMasked(obj, row))
 					continue;
 
 				if (row == 0)
-					prevValueDateTime = dateTimeAt(obj, row).toMSecsSinceEpoch();
+					prevValue = dateTimeMSecsAt(obj, row);
 
-				qint64 value = dateTimeAt(obj, row).toMSecsSinceEpoch();
-				if (std::abs(value - xInt64) <= std::abs(prevValueDateTime - xInt64)) { // "<=" prevents also that row - 1 become < 0
-					prevValueDateTime = value;
+				double value = dateTimeMSecsAt(obj, row);
+				if (std::abs(value - x) <= std::abs(prevValue - x)) { // "<=" prevents also that row - 1 become < 0
+					prevValue = value;
 					index = row;
 				}
 			}
@@ -477,7 +474,7 @@ int ColumnPrivate::ValueLabels::indexForValue(double value, bool smaller) const
 											std::mem_fn(&ValueLabels::mode),
 											std::mem_fn<int() const>(&ValueLabels::count),
 											std::mem_fn(&ValueLabels::valueAt),
-											std::mem_fn(&ValueLabels::dateTimeAt),
+											std::mem_fn(&ValueLabels::valueAt), // milliseconds since epoch for date and time values
 											std::mem_fn(&ValueLabels::properties),
 											std::mem_fn<bool(int) const>(&ValueLabels::isValid),
 											std::mem_fn<bool(int) const>(&ValueLabels::isMasked),
@@ -929,6 +926,9 @@ ColumnPrivate::~ColumnPrivate() {
 }
 
 void ColumnPrivate::deleteData() {
+	m_textDictionary.reset();
+	m_dateTimeValues.reset();
+	m_dictionaryCodeIndex.clear();
 	if (!m_data)
 		return;
 
@@ -967,6 +967,7 @@ AbstractColumn::ColumnMode ColumnPrivate::columnMode() const {
  * initial value) is not supported.
  */
 void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
+	ensureDataLoaded();
 	DEBUG(Q_FUNC_INFO << ", " << ENUM_TO_STRING(AbstractColumn, ColumnMode, m_columnMode) << " -> " << ENUM_TO_STRING(AbstractColumn, ColumnMode, mode))
 	if (mode == m_columnMode)
 		return;
@@ -1396,6 +1397,8 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
  * Replace column mode, data type, data pointer and filters directly
  */
 void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data, AbstractSimpleFilter* in_filter, AbstractSimpleFilter* out_filter) {
+	// the current container is kept in the undo commands, it needs the full content
+	expandData();
 	Q_EMIT q->modeAboutToChange(q);
 	// disconnect formatChanged()
 	switch (m_columnMode) {
@@ -1465,8 +1468,12 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode,
  * \brief Replace data pointer
  */
 void ColumnPrivate::replaceData(void* data) {
+	// the current container is kept in the undo commands, it needs the full content
+	expandData();
 	Q_EMIT q->dataAboutToChange(q);
 
+	discardPendingData();
+
 	m_data = data;
 
 	q->setDataChanged();
@@ -1480,6 +1487,7 @@ void ColumnPrivate::replaceData(void* data) {
  * Use a filter to convert a column to another type.
  */
 bool ColumnPrivate::copy(const AbstractColumn* other) {
+	ensureDataLoaded();
 	DEBUG(Q_FUNC_INFO)
 	if (other->columnMode() != columnMode())
 		return false;
@@ -1554,6 +1562,7 @@ bool ColumnPrivate::copy(const AbstractColumn* other) {
  * \param num_rows the number of rows to copy
  */
 bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int dest_start, int num_rows) {
+	ensureDataLoaded();
 	if (source->columnMode() != m_columnMode)
 		return false;
 	if (num_rows == 0)
@@ -1618,6 +1627,7 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
  * Use a filter to convert a column to another type.
  */
 bool ColumnPrivate::copy(const ColumnPrivate* other) {
+	ensureDataLoaded();
 	if (other->columnMode() != m_columnMode)
 		return false;
 	int num_rows = other->rowCount();
@@ -1681,6 +1691,7 @@ bool ColumnPrivate::copy(const ColumnPrivate* other) {
  * \param num_rows the number of rows to copy
  */
 bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest_start, int num_rows) {
+	ensureDataLoaded();
 	if (source->columnMode() != m_columnMode)
 		return false;
 	if (num_rows == 0)
@@ -1745,6 +1756,10 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
  * This returns the size of the column container
  */
 int ColumnPrivate::rowCount() const {
+	if (m_textDictionary)
+		return m_textDictionary->rowCount();
+	if (m_dateTimeValues)
+		return m_dateTimeValues->rowCount();
 	if (!m_data)
 		return m_rowCount;
 
@@ -1767,6 +1782,19 @@ int ColumnPrivate::rowCount() const {
 }
 
 int ColumnPrivate::rowCount(double min, double max) const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues) {
+		int counter = 0;
+		for (int row = 0; row < m_dateTimeValues->rowCount(); ++row) {
+			const double value = dateTimeMSecsF(row);
+			if (value >= min && value <= max)
+				counter++;
+		}
+		return counter;
+	}
+
+	ensureDataLoaded();
 	if (!m_data)
 		return m_rowCount;
 
@@ -1844,6 +1872,7 @@ int ColumnPrivate::availableRowCount(int max) const {
  * must be emitted.
  */
 void ColumnPrivate::resizeTo(int new_size) {
+	ensureDataLoaded();
 	int old_size = rowCount();
 	if (new_size == old_size)
 		return;
@@ -1904,13 +1933,15 @@ void ColumnPrivate::resizeTo(int new_size) {
 	if (AbstractColumnPrivate::needsValidityTracking(m_columnMode))
 		m_valid.resize(new_size); // new rows are invalid (false), shrinking just truncates
 
-	invalidate();
+	// the last row of the shrinked column is modified too, see above
+	invalidateRows(std::min(old_size, new_size) - 1, std::max(old_size, new_size) - 1);
 }
 
 /**
  * \brief Insert some empty (or initialized with zero) rows
  */
 void ColumnPrivate::insertRows(int before, int count) {
+	ensureDataLoaded();
 	if (count == 0)
 		return;
 
@@ -1963,6 +1994,7 @@ void ColumnPrivate::insertRows(int before, int count) {
  * \brief Remove 'count' rows starting from row 'first'
  */
 void ColumnPrivate::removeRows(int first, int count) {
+	ensureDataLoaded();
 	if (count == 0)
 		return;
 
@@ -2018,7 +2050,9 @@ int ColumnPrivate::indexForValue(double x, bool smaller) const {
 									   std::mem_fn(&Column::columnMode),
 									   std::mem_fn<int() const>(&Column::rowCount),
 									   std::mem_fn(&Column::valueAt),
-									   std::mem_fn(&Column::dateTimeAt),
+									   [this](const Column*, int row) {
+										   return dateTimeMSecsF(row);
+									   },
 									   std::mem_fn(&Column::properties),
 									   std::mem_fn<bool(int) const>(&Column::isValid),
 									   std::mem_fn<bool(int) const>(&Column::isMasked),
@@ -2247,6 +2281,7 @@ void ColumnPrivate::setWidth(int value) {
  * Set new column data
  */
 void ColumnPrivate::setData(void* data) {
+	discardPendingData();
 	deleteData();
 	m_data = data;
 	if (AbstractColumnPrivate::needsValidityTracking(m_columnMode)) {
@@ -2260,12 +2295,293 @@ void ColumnPrivate::setData(void* data) {
  * \brief Return the data pointer
  */
 void* ColumnPrivate::data() const {
+	ensureDataLoaded();
 	if (!m_data)
 		const_cast<ColumnPrivate*>(this)->initDataContainer();
 
 	return m_data;
 }
 
+/*!
+ * returns the binary representation of the column data as it is stored in the project file.
+ * Numerical data is returned without copying and is only valid as long as the column is not modified.
+ * Text is stored as UTF-8 with a null separator, DateTime values as milliseconds since epoch (UTC)
+ * with std::numeric_limits<qint64>::min() for invalid values.
+ */
+QByteArray ColumnPrivate::encodeData() const {
+	if (m_dataPending)
+		loadPendingData();
+	const int rows = rowCount();
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		return QByteArray::fromRawData(reinterpret_cast<const char*>(static_cast<QVector<double>*>(data())->constData()), rows * (qsizetype)sizeof(double));
+	case AbstractColumn::ColumnMode::Integer:
+		return QByteArray::fromRawData(reinterpret_cast<const char*>(static_cast<QVector<int>*>(data())->constData()), rows * (qsizetype)sizeof(int));
+	case AbstractColumn::ColumnMode::BigInt:
+		return QByteArray::fromRawData(reinterpret_cast<const char*>(static_cast<QVector<qint64>*>(data())->constData()), rows * (qsizetype)sizeof(qint64));
+	case AbstractColumn::ColumnMode::Text: {
+		if (m_textDictionary)
+			return m_textDictionary->encode();
+
+		QByteArray bytes;
+		for (int i = 0; i < rows; ++i) {
+			bytes.append(textAt(i).toUtf8());
+			bytes.append('\0');
+		}
+		if (!bytes.isEmpty())
+			bytes.removeLast(); // remove the last null character
+		return bytes;
+	}
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::DateTime: {
+		if (m_dateTimeValues)
+			return m_dateTimeValues->encode();
+
+		QByteArray bytes;
+		bytes.reserve(rows * sizeof(qint64));
+		for (int i = 0; i < rows; ++i) {
+			auto dt = dateTimeAt(i);
+			qint64 msecs;
+			if (!dt.isValid())
+				msecs = std::numeric_limits<qint64>::min(); // sentinel for empty cells
+			else {
+				// If DateTime is not in UTC, convert it to UTC preserving the date/time values
+				// This ensures DateTimes created without explicit UTC timezone are treated consistently
+				if (dt.timeZone() != QTimeZone::UTC)
+					dt = QDateTime(dt.date(), dt.time(), QTimeZone::UTC);
+				msecs = dt.toMSecsSinceEpoch();
+			}
+			bytes.append(reinterpret_cast<const char*>(&msecs), sizeof(qint64));
+		}
+		return bytes;
+	}
+	}
+
+	return {};
+}
+
+/*!
+ * creates the data container for the column mode \c mode out of the binary representation \c bytes
+ * created in \c encodeData(). The ownership of the returned container is passed to the caller.
+ */
+void* ColumnPrivate::decodeData(AbstractColumn::ColumnMode mode, const QByteArray& bytes) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double: {
+		auto* data = new QVector<double>(bytes.size() / (qsizetype)sizeof(double));
+		memcpy(data->data(), bytes.constData(), data->size() * sizeof(double));
+		return data;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		auto* data = new QVector<int>(bytes.size() / (qsizetype)sizeof(int));
+		memcpy(data->data(), bytes.constData(), data->size() * sizeof(int));
+		return data;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		auto* data = new QVector<qint64>(bytes.size() / (qsizetype)sizeof(qint64));
+		memcpy(data->data(), bytes.constData(), data->size() * sizeof(qint64));
+		return data;
+	}
+	case AbstractColumn::ColumnMode::Text:
+		return new QVector<QString>(QString::fromUtf8(bytes).split(QLatin1Char('\0'), Qt::KeepEmptyParts));
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::DateTime: {
+		auto* data = new QVector<QDateTime>();
+		data->reserve(bytes.size() / sizeof(qint64));
+		for (qsizetype i = 0; i + (qsizetype)sizeof(qint64) <= bytes.size(); i += sizeof(qint64)) {
+			qint64 msecs;
+			memcpy(&msecs, bytes.constData() + i, sizeof(qint64));
+			if (msecs == std::numeric_limits<qint64>::min())
+				data->append(QDateTime()); // invalid QDateTime for empty cells
+			else // interpret stored milliseconds since epoch as UTC to preserve original timezone
+				data->append(QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::UTC));
+		}
+		return data;
+	}
+	}
+
+	return nullptr;
+}
+
+/*!
+ * restores the per-element validity bitmap for Integer/BigInt columns from \c bytes.
+ * If \c bytes is empty (projects created before the validity was saved), all values are marked as valid.
+ */
+void ColumnPrivate::setValidity(const QByteArray& bytes) {
+	if (!AbstractColumnPrivate::needsValidityTracking(m_columnMode))
+		return;
+
+	const int numRows = rowCount();
+	if (bytes.isEmpty()) {
+		m_valid.resize(numRows);
+		m_valid.fill(true);
+		return;
+	}
+
+	m_valid = QBitArray(numRows);
+	const int byteCount = qMin(bytes.size(), (qsizetype)(numRows + 7) / 8);
+	const auto* bits = reinterpret_cast<const uchar*>(bytes.constData());
+	for (int i = 0; i < numRows; ++i) {
+		if (i / 8 < byteCount && (bits[i / 8] & (1 << (i % 8))))
+			m_valid.setBit(i, true);
+	}
+}
+
+/*!
+ * sets the blob \c blob in the project file read by \c reader as the content of the column.
+ * The data is only read and decoded on the first access to it, the number of rows is expected to be already set.
+ */
+void ColumnPrivate::setPendingData(const std::shared_ptr<ProjectDataReader>& reader, int blob) {
+	QMutexLocker locker(&m_pendingDataMutex);
+	deleteData();
+	m_pendingDataReader = reader;
+	m_pendingDataBlob = blob;
+	m_dataPending = true;
+}
+
+bool ColumnPrivate::hasPendingData() const {
+	return m_dataPending;
+}
+
+/*!
+ * reads and decodes the data set in \c setPendingData().
+ * No signals are emitted since the content of the column doesn't change from the user's perspective.
+ */
+void ColumnPrivate::loadPendingData() const {
+	QMutexLocker locker(&m_pendingDataMutex);
+	if (!m_dataPending)
+		return;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", column ") + name());
+	if (m_rowCount > 0) {
+		const auto& bytes = m_pendingDataReader->blob(m_pendingDataBlob);
+		auto* self = const_cast<ColumnPrivate*>(this);
+		if (bytes.isEmpty())
+			WARN(Q_FUNC_INFO << ", failed to read the data of the column " << STDSTRING(name()))
+		else {
+			// texts with few distinct values are kept dictionary encoded, date and time values as milliseconds since epoch
+			switch (m_columnMode) {
+			case AbstractColumn::ColumnMode::Text:
+				self->m_textDictionary.reset(TextDictionary::create(bytes));
+				break;
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				self->m_dateTimeValues.reset(DateTimeValues::create(bytes, m_pendingDateTimeResolution));
+				break;
+			case AbstractColumn::ColumnMode::Double:
+			case AbstractColumn::ColumnMode::Integer:
+			case AbstractColumn::ColumnMode::BigInt:
+				break;
+			}
+
+			if (m_textDictionary)
+				self->m_data = new QVector<QString>();
+			else if (m_dateTimeValues)
+				self->m_data = new QVector<QDateTime>();
+			else
+				self->m_data = decodeData(m_columnMode, bytes);
+		}
+	}
+
+	m_pendingDataReader.reset();
+	m_dataPending = false;
+}
+
+void ColumnPrivate::discardPendingData() {
+	QMutexLocker locker(&m_pendingDataMutex);
+	m_pendingDataReader.reset();
+	m_dataPending = false;
+}
+
+/*!
+ * switches the storage of the texts to the dictionary encoded representation if there are few distinct values.
+ * The data container is kept empty, it can be referenced in the undo commands and is filled again in \c expandData()
+ * before the texts are modified or the container is accessed directly.
+ */
+bool ColumnPrivate::compactTexts() {
+	if (m_columnMode != AbstractColumn::ColumnMode::Text)
+		return false;
+
+	if (m_dataPending)
+		loadPendingData();
+	if (m_textDictionary)
+		return true;
+	if (!m_data)
+		return false;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", column ") + name());
+	auto* texts = static_cast<QVector<QString>*>(m_data);
+	auto* dictionary = TextDictionary::create(*texts);
+	if (!dictionary)
+		return false;
+
+	QMutexLocker locker(&m_pendingDataMutex);
+	m_textDictionary.reset(dictionary);
+	*texts = QVector<QString>();
+	available.dictionary = false; // the dictionary needs to be determined for the codes
+	return true;
+}
+
+bool ColumnPrivate::isDictionaryEncoded() const {
+	return m_textDictionary != nullptr;
+}
+
+/*!
+ * switches the storage of the date and time values to milliseconds since epoch if all values have the same time representation.
+ * The data container is kept empty, it can be referenced in the undo commands and is filled again in \c expandData()
+ * before the values are modified or the container is accessed directly.
+ */
+bool ColumnPrivate::compactDateTimes() {
+	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
+		&& m_columnMode != AbstractColumn::ColumnMode::Day)
+		return false;
+
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues)
+		return true;
+	if (!m_data)
+		return false;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", column ") + name());
+	auto* dateTimes = static_cast<QVector<QDateTime>*>(m_data);
+	auto* values = DateTimeValues::create(*dateTimes);
+	if (!values)
+		return false;
+
+	QMutexLocker locker(&m_pendingDataMutex);
+	m_dateTimeValues.reset(values);
+	*dateTimes = QVector<QDateTime>();
+	return true;
+}
+
+/*!
+ * restores the texts stored dictionary encoded or the date and time values stored as milliseconds since epoch
+ * in the data container. No signals are emitted since the content of the column doesn't change from the user's perspective.
+ */
+void ColumnPrivate::expandData() const {
+	QMutexLocker locker(&m_pendingDataMutex);
+	auto* self = const_cast<ColumnPrivate*>(this);
+	if (m_textDictionary) {
+		PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", column ") + name());
+		if (!m_data)
+			self->m_data = new QVector<QString>();
+		*static_cast<QVector<QString>*>(m_data) = m_textDictionary->decode();
+		self->m_textDictionary.reset();
+		self->m_dictionaryCodeIndex.clear();
+	}
+
+	if (m_dateTimeValues) {
+		PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", column ") + name());
+		if (!m_data)
+			self->m_data = new QVector<QDateTime>();
+		*static_cast<QVector<QDateTime>*>(m_data) = m_dateTimeValues->decode();
+		self->m_dateTimeValues.reset();
+	}
+}
+
 /**
  * \brief Return the input filter (for string -> data type conversion)
  */
@@ -2861,6 +3177,10 @@ void ColumnPrivate::replaceValues(int first, const QVector<QString>& new_values)
  * Use this only when columnMode() is Text
  */
 QString ColumnPrivate::textAt(int row) const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_textDictionary)
+		return (row >= 0 && row < m_textDictionary->rowCount()) ? m_textDictionary->text(row) : QString();
 	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::Text)
 		return {};
 	return static_cast<QVector<QString>*>(m_data)->value(row);
@@ -2872,9 +3192,8 @@ QString ColumnPrivate::textAt(int row) const {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 QDate ColumnPrivate::dateAt(int row) const {
-	if (!m_data
-		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
-			&& m_columnMode != AbstractColumn::ColumnMode::Day))
+	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
+		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return QDate{};
 	return dateTimeAt(row).date();
 }
@@ -2885,9 +3204,8 @@ QDate ColumnPrivate::dateAt(int row) const {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 QTime ColumnPrivate::timeAt(int row) const {
-	if (!m_data
-		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
-			&& m_columnMode != AbstractColumn::ColumnMode::Day))
+	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
+		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return QTime{};
 	return dateTimeAt(row).time();
 }
@@ -2898,6 +3216,10 @@ QTime ColumnPrivate::timeAt(int row) const {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 QDateTime ColumnPrivate::dateTimeAt(int row) const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues)
+		return (row >= 0 && row < m_dateTimeValues->rowCount()) ? m_dateTimeValues->dateTime(row) : QDateTime();
 	if (!m_data
 		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
 			&& m_columnMode != AbstractColumn::ColumnMode::Day))
@@ -2905,7 +3227,98 @@ QDateTime ColumnPrivate::dateTimeAt(int row) const {
 	return static_cast<QVector<QDateTime>*>(m_data)->value(row);
 }
 
+/*!
+ * returns the milliseconds since epoch of the value in the row \c row, 0 for invalid values as for QDateTime::toMSecsSinceEpoch().
+ * Doesn't create a QDateTime object if the values are stored as milliseconds since epoch.
+ */
+qint64 ColumnPrivate::dateTimeMSecsAt(int row) const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues) {
+		if (row < 0 || row >= m_dateTimeValues->rowCount())
+			return 0;
+		const qint64 value = m_dateTimeValues->msecs(row);
+		return (value != DateTimeValues::invalid) ? value : 0;
+	}
+	return dateTimeAt(row).toMSecsSinceEpoch();
+}
+
+/*!
+ * returns the value in the row \c row as fractional milliseconds since epoch as used for the coordinates in the plots,
+ * the fraction is only available for the values with nanosecond resolution. 0 is returned for invalid values as in \c dateTimeMSecsAt().
+ */
+double ColumnPrivate::dateTimeMSecsF(int row) const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues && m_dateTimeValues->resolution() == DateTimeValues::Resolution::Nanoseconds) {
+		if (row < 0 || row >= m_dateTimeValues->rowCount())
+			return 0;
+		const qint64 value = m_dateTimeValues->value(row);
+		return (value != DateTimeValues::invalid) ? DateTimeValues::toMSecsF(value) : 0;
+	}
+	return dateTimeMSecsAt(row);
+}
+
+/*!
+ * returns the date and time values of all rows as milliseconds since epoch (\c DateTimeValues::invalid for invalid values)
+ * or an empty span if the values are not stored as milliseconds since epoch.
+ */
+std::span<const qint64> ColumnPrivate::dateTimeMSecs() const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues && m_dateTimeValues->resolution() == DateTimeValues::Resolution::Milliseconds)
+		return m_dateTimeValues->values();
+	return {};
+}
+
+/*!
+ * returns the date and time values of all rows as nanoseconds since epoch (\c DateTimeValues::invalid for invalid values)
+ * or an empty span if the values are not stored with nanosecond resolution.
+ */
+std::span<const qint64> ColumnPrivate::dateTimeNSecs() const {
+	if (m_dataPending)
+		loadPendingData();
+	if (m_dateTimeValues && m_dateTimeValues->resolution() == DateTimeValues::Resolution::Nanoseconds)
+		return m_dateTimeValues->values();
+	return {};
+}
+
+DateTimeValues::Resolution ColumnPrivate::dateTimeResolution() const {
+	if (m_dataPending)
+		loadPendingData();
+	return m_dateTimeValues ? m_dateTimeValues->resolution() : DateTimeValues::Resolution::Milliseconds;
+}
+
+//! sets the resolution of the date and time values to be read from the project file, has to be set before the data is read
+void ColumnPrivate::setPendingDateTimeResolution(DateTimeValues::Resolution resolution) {
+	m_pendingDateTimeResolution = resolution;
+}
+
+/*!
+ * replaces the content of the column with the nanoseconds since epoch (UTC) \c nsecs, \c DateTimeValues::invalid is used for empty cells.
+ * The nanoseconds are kept until the column is modified, the modifications are done on QDateTime with millisecond resolution.
+ * The change is not undoable, used when importing or loading the data.
+ */
+void ColumnPrivate::setDateTimeNSecs(const QVector<qint64>& nsecs) {
+	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
+		&& m_columnMode != AbstractColumn::ColumnMode::Day)
+		return;
+
+	expandData();
+	Q_EMIT q->dataAboutToChange(q);
+	discardPendingData();
+	{
+		QMutexLocker locker(&m_pendingDataMutex);
+		if (!m_data)
+			initDataContainer(false);
+		*static_cast<QVector<QDateTime>*>(m_data) = QVector<QDateTime>();
+		m_dateTimeValues.reset(DateTimeValues::create(nsecs));
+	}
+	q->setDataChanged();
+}
+
 double ColumnPrivate::doubleAt(int index) const {
+	ensureDataLoaded();
 	if (!m_data)
 		return NAN;
 
@@ -2918,6 +3331,8 @@ double ColumnPrivate::doubleAt(int index) const {
  * For cases where the integer value is needed without any implicit conversions, \sa integerAt() has to be used.
  */
 double ColumnPrivate::valueAt(int index) const {
+	if (m_dataPending)
+		loadPendingData();
 	if (!m_data)
 		return NAN;
 
@@ -2929,7 +3344,7 @@ double ColumnPrivate::valueAt(int index) const {
 	case AbstractColumn::ColumnMode::BigInt:
 		return static_cast<QVector<qint64>*>(m_data)->value(index, 0);
 	case AbstractColumn::ColumnMode::DateTime: {
-		const auto dt = static_cast<QVector<QDateTime>*>(m_data)->value(index);
+		const auto dt = dateTimeAt(index);
 		if (!dt.isValid())
 			return NAN;
 
@@ -2950,6 +3365,7 @@ double ColumnPrivate::valueAt(int index) const {
  * \brief Return the int value in row 'row'
  */
 int ColumnPrivate::integerAt(int row) const {
+	ensureDataLoaded();
 	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::Integer)
 		return 0;
 	return static_cast<QVector<int>*>(m_data)->value(row, 0);
@@ -2959,6 +3375,7 @@ int ColumnPrivate::integerAt(int row) const {
  * \brief Return the bigint value in row 'row'
  */
 qint64 ColumnPrivate::bigIntAt(int row) const {
+	ensureDataLoaded();
 	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::BigInt)
 		return 0;
 	return static_cast<QVector<qint64>*>(m_data)->value(row, 0);
@@ -2966,6 +3383,18 @@ qint64 ColumnPrivate::bigIntAt(int row) const {
 
 void ColumnPrivate::invalidate() {
 	available.setUnavailable();
+	m_propertiesBlocks.clear();
+}
+
+/*!
+ * invalidates the cached values after the rows \c first to \c last were modified.
+ * Contrary to invalidate(), the monotonicity of the unmodified blocks of rows is kept (see updateProperties()).
+ */
+void ColumnPrivate::invalidateRows(int first, int last) {
+	available.setUnavailable();
+	const int end = std::min(last / propertiesBlockSize + 1, static_cast<int>(m_propertiesBlocks.size()));
+	for (int block = std::max(first, 0) / propertiesBlockSize; block < end; ++block)
+		m_propertiesBlocks[block] |= BlockDirty;
 }
 
 /**
@@ -2996,6 +3425,11 @@ int ColumnPrivate::dictionaryIndex(int row) const {
 	if (!available.dictionary)
 		const_cast<ColumnPrivate*>(this)->initDictionary();
 
+	if (m_textDictionary && row >= 0 && row < m_textDictionary->rowCount()) {
+		const int index = m_dictionaryCodeIndex.at(m_textDictionary->code(row));
+		return (index != -1) ? index : m_dictionary.size();
+	}
+
 	const auto& value = textAt(row);
 	int index = 0;
 	auto it = m_dictionary.constBegin();
@@ -3022,9 +3456,71 @@ const QMap<QString, int>& ColumnPrivate::frequencies() const {
 	return m_dictionaryFrequencies;
 }
 
+QVector<int> ColumnPrivate::textRanks() const {
+	if (m_dataPending)
+		loadPendingData();
+
+	if (m_textDictionary) {
+		// rank the distinct texts only
+		const auto& ranks = m_textDictionary->ranks();
+		const auto& codes = m_textDictionary->codes();
+		QVector<int> rowRanks(codes.size());
+		for (int row = 0; row < codes.size(); ++row) {
+			const auto code = codes.at(row);
+			rowRanks[row] = m_textDictionary->isEmpty(code) ? -1 : ranks.at(code);
+		}
+		return rowRanks;
+	}
+
+	QVector<int> rowRanks(rowCount(), -1);
+	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::Text)
+		return rowRanks;
+
+	const auto* texts = static_cast<QVector<QString>*>(m_data);
+	QVector<QString> sortedTexts;
+	sortedTexts.reserve(texts->size());
+	for (const auto& text : *texts) {
+		if (!text.isEmpty())
+			sortedTexts << text;
+	}
+	std::sort(sortedTexts.begin(), sortedTexts.end());
+	sortedTexts.erase(std::unique(sortedTexts.begin(), sortedTexts.end()), sortedTexts.end());
+
+	for (int row = 0; row < texts->size(); ++row) {
+		const auto& text = texts->at(row);
+		if (!text.isEmpty())
+			rowRanks[row] = static_cast<int>(std::lower_bound(sortedTexts.cbegin(), sortedTexts.cend(), text) - sortedTexts.cbegin());
+	}
+	return rowRanks;
+}
+
 void ColumnPrivate::initDictionary() {
 	m_dictionary.clear();
 	m_dictionaryFrequencies.clear();
+	m_dictionaryCodeIndex.clear();
+	if (m_dataPending)
+		loadPendingData();
+
+	if (m_textDictionary) {
+		// count the codes, the texts are only converted once per distinct value
+		const int size = m_textDictionary->size();
+		QVector<int> counts(size, 0);
+		m_dictionaryCodeIndex.fill(-1, size);
+		for (const auto code : m_textDictionary->codes()) {
+			if (counts[code]++ == 0 && !m_textDictionary->isEmpty(code)) {
+				m_dictionaryCodeIndex[code] = m_dictionary.size();
+				m_dictionary << m_textDictionary->string(code);
+			}
+		}
+		for (int code = 0; code < size; ++code) {
+			const int index = m_dictionaryCodeIndex.at(code);
+			if (index != -1)
+				m_dictionaryFrequencies[m_dictionary.at(index)] = counts.at(code);
+		}
+		available.dictionary = true;
+		return;
+	}
+
 	if (!m_data)
 		return;
 
@@ -3089,8 +3585,8 @@ void ColumnPrivate::initDictionary() {
 		break;
 	}
 	case AbstractColumn::ColumnMode::DateTime: {
-		auto data = static_cast<QVector<QDateTime>*>(m_data);
-		for (const auto& val : *data) {
+		for (int row = 0; row < rowCount(); ++row) {
+			const auto& val = dateTimeAt(row);
 			if (!val.isValid())
 				continue;
 			value = val.toString(Qt::ISODate);
@@ -3104,8 +3600,8 @@ void ColumnPrivate::initDictionary() {
 		break;
 	}
 	case AbstractColumn::ColumnMode::Month: {
-		auto data = static_cast<QVector<QDateTime>*>(m_data);
-		for (const auto& val : *data) {
+		for (int row = 0; row < rowCount(); ++row) {
+			const auto& val = dateTimeAt(row);
 			if (!val.isValid())
 				continue;
 			value = val.toString(QStringLiteral("MMMM")); // Full month name
@@ -3119,8 +3615,8 @@ void ColumnPrivate::initDictionary() {
 		break;
 	}
 	case AbstractColumn::ColumnMode::Day: {
-		auto data = static_cast<QVector<QDateTime>*>(m_data);
-		for (const auto& val : *data) {
+		for (int row = 0; row < rowCount(); ++row) {
+			const auto& val = dateTimeAt(row);
 			if (!val.isValid())
 				continue;
 			value = val.toString(QStringLiteral("dddd")); // Full day name
@@ -3144,6 +3640,7 @@ void ColumnPrivate::initDictionary() {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 void ColumnPrivate::setDateAt(int row, QDate new_value) {
+	ensureDataLoaded();
 	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
 		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return;
@@ -3163,6 +3660,7 @@ void ColumnPrivate::setDateAt(int row, QDate new_value) {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 void ColumnPrivate::setTimeAt(int row, QTime new_value) {
+	ensureDataLoaded();
 	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
 		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return;
@@ -3245,6 +3743,7 @@ void ColumnPrivate::setValueAt(int row, double new_value) {
  * Use this only when columnMode() is Double, Integer, BigInt or DateTime
  */
 void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values) {
+	ensureDataLoaded();
 	// DEBUG(Q_FUNC_INFO);
 	if (m_columnMode != AbstractColumn::ColumnMode::Double && m_columnMode != AbstractColumn::ColumnMode::DateTime
 		&& m_columnMode != AbstractColumn::ColumnMode::Integer && m_columnMode != AbstractColumn::ColumnMode::BigInt)
@@ -3438,10 +3937,93 @@ void ColumnPrivate::replaceBigInt(int first, const QVector<qint64>& new_values)
 	replaceValuePrivate<qint64>(first, new_values);
 }
 
+namespace {
+/*!
+ * determines the PropertiesBlockFlag of the rows \c first to \c end - 1
+ */
+template<typename ValueAt, typename IsValid>
+quint8 propertiesBlockFlags(int first, int end, ValueAt valueAt, IsValid isValid) {
+	quint8 flags = ColumnPrivate::BlockIncreasing | ColumnPrivate::BlockDecreasing;
+	if (!isValid(first))
+		return ColumnPrivate::BlockInvalid;
+
+	auto prevValue = valueAt(first);
+	for (int row = first + 1; row < end; ++row) {
+		// if there is one invalid or masked value, the property is No, because
+		// otherwise it's difficult to find the correct index in indexForValue().
+		// You don't know if you should increase the index or decrease it when
+		// you hit an invalid value
+		if (!isValid(row))
+			return ColumnPrivate::BlockInvalid;
+
+		const auto value = valueAt(row);
+		if (value > prevValue)
+			flags &= ~ColumnPrivate::BlockDecreasing;
+		else if (value < prevValue)
+			flags &= ~ColumnPrivate::BlockIncreasing;
+		prevValue = value;
+	}
+
+	return flags;
+}
+
+/*!
+ * determines the properties of the \c rows values out of the flags of their blocks in \c blocks.
+ * The flags of the blocks marked as dirty are determined again.
+ */
+template<typename ValueAt, typename IsValid>
+AbstractColumn::Properties blockProperties(QVector<quint8>& blocks, int rows, ValueAt valueAt, IsValid isValid) {
+	const int blockSize = ColumnPrivate::propertiesBlockSize;
+	const int count = (rows - 1) / blockSize + 1;
+	blocks.resize(count, ColumnPrivate::BlockDirty);
+
+	quint8 flags = ColumnPrivate::BlockIncreasing | ColumnPrivate::BlockDecreasing;
+	for (int block = 0; block < count; ++block) {
+		const int first = block * blockSize;
+		if (blocks.at(block) & ColumnPrivate::BlockDirty)
+			blocks[block] = propertiesBlockFlags(first, std::min(first + blockSize, rows), valueAt, isValid);
+
+		const quint8 blockFlags = blocks.at(block);
+		if (blockFlags & ColumnPrivate::BlockInvalid)
+			return AbstractColumn::Properties::No;
+		flags &= blockFlags;
+
+		// compare with the last value of the previous block
+		if (block > 0) {
+			const auto prevValue = valueAt(first - 1);
+			const auto value = valueAt(first);
+			if (value > prevValue)
+				flags &= ~ColumnPrivate::BlockDecreasing;
+			else if (value < prevValue)
+				flags &= ~ColumnPrivate::BlockIncreasing;
+		}
+	}
+
+	if (rows == 1)
+		return AbstractColumn::Properties::NonMonotonic;
+	if (flags == (ColumnPrivate::BlockIncreasing | ColumnPrivate::BlockDecreasing)) {
+		DEBUG("	setting column CONSTANT")
+		return AbstractColumn::Properties::Constant;
+	}
+	if (flags & ColumnPrivate::BlockDecreasing) {
+		DEBUG("	setting column MONOTONIC DECREASING")
+		return AbstractColumn::Properties::MonotonicDecreasing;
+	}
+	if (flags & ColumnPrivate::BlockIncreasing) {
+		DEBUG("	setting column MONOTONIC INCREASING")
+		return AbstractColumn::Properties::MonotonicIncreasing;
+	}
+	return AbstractColumn::Properties::NonMonotonic;
+}
+}
+
 /*!
  * Updates the properties. Will be called, when data in the column changed.
  * The properties will be used to speed up some algorithms.
  * See where variable properties will be used.
+ *
+ * The monotonicity is kept for blocks of propertiesBlockSize rows. After the modification of single values
+ * or ranges of values (see invalidateRows()), e.g. when appending new values, only the modified blocks are checked again.
  */
 void ColumnPrivate::updateProperties() {
 	PERFTRACE(name() + QLatin1String(Q_FUNC_INFO));
@@ -3450,183 +4032,132 @@ void ColumnPrivate::updateProperties() {
 	const int rows = rowCount();
 	if (rows == 0 || m_columnMode == AbstractColumn::ColumnMode::Text) {
 		properties = AbstractColumn::Properties::No;
+		m_propertiesBlocks.clear();
 		available.properties = true;
 		return;
 	}
 
-	double prevValue = NAN;
-	int prevValueInt = 0;
-	qint64 prevValueBigInt = 0;
-	qint64 prevValueDatetime = 0;
-
-	if (m_columnMode == AbstractColumn::ColumnMode::Integer)
-		prevValueInt = integerAt(0);
-	else if (m_columnMode == AbstractColumn::ColumnMode::BigInt)
-		prevValueBigInt = bigIntAt(0);
-	else if (m_columnMode == AbstractColumn::ColumnMode::Double)
-		prevValue = doubleAt(0);
-	else if (m_columnMode == AbstractColumn::ColumnMode::DateTime || m_columnMode == AbstractColumn::ColumnMode::Month
-			 || m_columnMode == AbstractColumn::ColumnMode::Day)
-		prevValueDatetime = dateTimeAt(0).toMSecsSinceEpoch();
-	else {
-		properties = AbstractColumn::Properties::No;
-		available.properties = true;
-		return;
+	// the values are accessed via dateTimeMSecsAt() and dateTimeNSecs() for date and time values,
+	// the compact storage is not expanded to QDateTime objects (this would drop the nanoseconds)
+	if (m_dataPending)
+		loadPendingData();
+	const void* data = m_dateTimeValues ? static_cast<const void*>(m_dateTimeValues.get()) : m_data;
+	if (m_propertiesData != data || m_propertiesMode != m_columnMode) {
+		// the data container was replaced, all blocks need to be checked
+		m_propertiesBlocks.clear();
+		m_propertiesData = data;
+		m_propertiesMode = m_columnMode;
 	}
 
-	int monotonic_decreasing = -1;
-	int monotonic_increasing = -1;
-
-	double value;
-	int valueInt;
-	qint64 valueBigInt;
-	qint64 valueDateTime;
-	for (int row = 1; row < rows; row++) {
-		if (!q->isValid(row) || q->isMasked(row)) {
-			// if there is one invalid or masked value, the property is No, because
-			// otherwise it's difficult to find the correct index in indexForValue().
-			// You don't know if you should increase the index or decrease it when
-			// you hit an invalid value
-			properties = AbstractColumn::Properties::No;
-			available.properties = true;
-			return;
-		}
-
-		switch (m_columnMode) {
-		case AbstractColumn::ColumnMode::Integer: {
-			valueInt = integerAt(row);
-
-			if (valueInt > prevValueInt) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (valueInt < prevValueInt) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
+	const bool masked = q->hasMaskedCells();
+	auto isValid = [this, masked](int row) {
+		return q->isValid(row) && !(masked && q->isMasked(row));
+	};
 
-			prevValueInt = valueInt;
-			break;
-		}
-		case AbstractColumn::ColumnMode::BigInt: {
-			valueBigInt = bigIntAt(row);
-
-			if (valueBigInt > prevValueBigInt) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (valueBigInt < prevValueBigInt) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Integer:
+		properties = blockProperties(
+			m_propertiesBlocks,
+			rows,
+			[this](int row) {
+				return integerAt(row);
+			},
+			isValid);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		properties = blockProperties(
+			m_propertiesBlocks,
+			rows,
+			[this](int row) {
+				return bigIntAt(row);
+			},
+			isValid);
+		break;
+	case AbstractColumn::ColumnMode::Double:
+		properties = blockProperties(
+			m_propertiesBlocks,
+			rows,
+			[this](int row) {
+				return doubleAt(row);
+			},
+			isValid);
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		// compare the nanoseconds for the values with nanosecond resolution, several values can have the same milliseconds
+		const auto nsecs = dateTimeNSecs();
+		properties = blockProperties(
+			m_propertiesBlocks,
+			rows,
+			[this, nsecs](int row) {
+				return nsecs.empty() ? dateTimeMSecsAt(row) : nsecs[row];
+			},
+			isValid);
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text:
+		break;
+	}
 
-			prevValueBigInt = valueBigInt;
-			break;
-		}
-		case AbstractColumn::ColumnMode::Double: {
-			value = doubleAt(row);
+	available.properties = true;
+}
 
-			if (std::isnan(value)) {
-				monotonic_increasing = 0;
-				monotonic_decreasing = 0;
-				break;
-			}
+/*!
+ * returns the valid and not masked rows sorted by their values (stable, rows with the same value keep their order).
+ * For columns that are not monotonic this "sorted view" allows to find the rows with values in a given range
+ * with a binary search. The index is determined on demand and cached until the data is modified.
+ */
+const QVector<int>& ColumnPrivate::sortedIndex() {
+	if (available.sortedIndex)
+		return m_sortedIndex;
 
-			if (value > prevValue) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (value < prevValue) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
+	PERFTRACE(name() + QLatin1String(Q_FUNC_INFO));
+	m_sortedIndex.clear();
+	available.sortedIndex = true;
+	if (m_columnMode == AbstractColumn::ColumnMode::Text || m_columnMode == AbstractColumn::ColumnMode::Month
+		|| m_columnMode == AbstractColumn::ColumnMode::Day)
+		return m_sortedIndex;
 
-			prevValue = value;
-			break;
+	const int rows = rowCount();
+	const bool masked = q->hasMaskedCells();
+
+	// sort the values with nanosecond resolution by the exact nanoseconds
+	const auto nsecs = dateTimeNSecs();
+	if (!nsecs.empty()) {
+		std::vector<std::pair<qint64, int>> values;
+		values.reserve(rows);
+		for (int row = 0; row < rows; ++row) {
+			if (!q->isValid(row) || (masked && q->isMasked(row)))
+				continue;
+			values.emplace_back(nsecs[row], row);
 		}
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day: {
-			valueDateTime = dateTimeAt(row).toMSecsSinceEpoch();
-
-			if (valueDateTime > prevValueDatetime) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (valueDateTime < prevValueDatetime) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
 
-			prevValueDatetime = valueDateTime;
-			break;
-		}
-		case AbstractColumn::ColumnMode::Text:
-			break;
-		}
+		std::sort(values.begin(), values.end());
+		m_sortedIndex.resize(values.size());
+		for (size_t i = 0; i < values.size(); ++i)
+			m_sortedIndex[i] = values[i].second;
+
+		return m_sortedIndex;
 	}
 
-	properties = AbstractColumn::Properties::NonMonotonic;
-	if (monotonic_increasing > 0 && monotonic_decreasing > 0) {
-		properties = AbstractColumn::Properties::Constant;
-		DEBUG("	setting column CONSTANT")
-	} else if (monotonic_decreasing > 0) {
-		properties = AbstractColumn::Properties::MonotonicDecreasing;
-		DEBUG("	setting column MONOTONIC DECREASING")
-	} else if (monotonic_increasing > 0) {
-		properties = AbstractColumn::Properties::MonotonicIncreasing;
-		DEBUG("	setting column MONOTONIC INCREASING")
+	std::vector<std::pair<double, int>> values;
+	values.reserve(rows);
+	for (int row = 0; row < rows; ++row) {
+		if (!q->isValid(row) || (masked && q->isMasked(row)))
+			continue;
+		const double value = (m_columnMode == AbstractColumn::ColumnMode::DateTime) ? dateTimeMSecsF(row) : valueAt(row);
+		values.emplace_back(value, row);
 	}
 
-	available.properties = true;
+	// the pairs are unique because of the row, sorting them is stable with respect to the values
+	std::sort(values.begin(), values.end());
+
+	m_sortedIndex.resize(values.size());
+	for (size_t i = 0; i < values.size(); ++i)
+		m_sortedIndex[i] = values[i].second;
+
+	return m_sortedIndex;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3851,21 +4382,39 @@ void ColumnPrivate::calculateDateTimeStatistics() {
 	statistics.maximum = -INFINITY;
 
 	int valid = 0;
-	for (int row = 0; row < rowCount(); ++row) {
-		if (q->isMasked(row))
-			continue;
+	const auto nsecs = dateTimeNSecs();
+	if (!nsecs.empty()) {
+		// compare the exact nanoseconds and convert only the minimum and the maximum to fractional milliseconds
+		qint64 min = std::numeric_limits<qint64>::max();
+		qint64 max = std::numeric_limits<qint64>::lowest();
+		for (int row = 0; row < rowCount(); ++row) {
+			if (q->isMasked(row) || !q->isValid(row))
+				continue;
 
-		const auto& value = dateTimeAt(row);
-		if (!value.isValid())
-			continue;
+			min = std::min(min, nsecs[row]);
+			max = std::max(max, nsecs[row]);
+			++valid;
+		}
+		if (valid > 0) {
+			statistics.minimum = DateTimeValues::toMSecsF(min);
+			statistics.maximum = DateTimeValues::toMSecsF(max);
+		}
+	} else {
+		for (int row = 0; row < rowCount(); ++row) {
+			if (q->isMasked(row))
+				continue;
 
-		quint64 val = value.toMSecsSinceEpoch();
-		if (val < statistics.minimum)
-			statistics.minimum = val;
-		if (val > statistics.maximum)
-			statistics.maximum = val;
+			if (!q->isValid(row))
+				continue;
 
-		++valid;
+			const double val = dateTimeMSecsF(row);
+			if (val < statistics.minimum)
+				statistics.minimum = val;
+			if (val > statistics.maximum)
+				statistics.maximum = val;
+
+			++valid;
+		}
 	}
 
 	statistics.size = valid;
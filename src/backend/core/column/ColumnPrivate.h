@@ -14,13 +14,21 @@
 
 #include "backend/core/AbstractColumnPrivate.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/lib/IntervalAttribute.h"
 
 #include <QBitArray>
 #include <QMap>
+#include <QMutex>
+
+#include <atomic>
+#include <memory>
+#include <span>
 
 class Column;
 class ColumnSetGlobalFormulaCmd;
+class ProjectDataReader;
+class TextDictionary;
 
 class ColumnPrivate : public AbstractColumnPrivate {
 	Q_OBJECT
@@ -65,6 +73,17 @@ public:
 	void setData(void*);
 	void* data() const;
 	void deleteData();
+
+	// binary representation of the data used in the project file
+	QByteArray encodeData() const;
+	static void* decodeData(AbstractColumn::ColumnMode, const QByteArray&);
+	void setValidity(const QByteArray&);
+
+	// data stored in the project file that is only loaded on the first access
+	void setPendingData(const std::shared_ptr<ProjectDataReader>&, int blob);
+	bool hasPendingData() const;
+	void loadPendingData() const;
+
 	bool valueLabelsInitialized() const;
 	void removeValueLabel(const QString&);
 	void setLabelsMode(Column::ColumnMode mode);
@@ -111,12 +130,23 @@ public:
 	void replaceTexts(int first, const QVector<QString>&);
 	int dictionaryIndex(int row) const;
 	const QMap<QString, int>& frequencies() const;
+	QVector<int> textRanks() const;
+	bool compactTexts();
+	bool isDictionaryEncoded() const;
 
 	QDate dateAt(int row) const;
 	void setDateAt(int row, QDate);
 	QTime timeAt(int row) const;
 	void setTimeAt(int row, QTime);
 	QDateTime dateTimeAt(int row) const;
+	qint64 dateTimeMSecsAt(int row) const;
+	double dateTimeMSecsF(int row) const;
+	std::span<const qint64> dateTimeMSecs() const;
+	std::span<const qint64> dateTimeNSecs() const;
+	DateTimeValues::Resolution dateTimeResolution() const;
+	void setPendingDateTimeResolution(DateTimeValues::Resolution);
+	void setDateTimeNSecs(const QVector<qint64>&);
+	bool compactDateTimes();
 	void setValueAt(int row, QDateTime new_value);
 	void setDateTimeAt(int row, const QDateTime&);
 	void replaceValues(int first, const QVector<QDateTime>&);
@@ -140,8 +170,10 @@ public:
 	void replaceBigInt(int first, const QVector<qint64>&);
 
 	void updateProperties();
+	const QVector<int>& sortedIndex();
 	void calculateStatistics();
 	void invalidate();
+	void invalidateRows(int first, int last);
 	void finalizeLoad();
 
 	void formulaVariableColumnAdded(const AbstractAspect*);
@@ -160,6 +192,7 @@ public:
 		bool hasValues{false}; // is 'hasValues' already available or needs to be (re-)calculated?
 		bool dictionary{false}; // dictionary of text values, relevant for text columns only, available?
 		bool properties{false}; // is 'properties' already available (true) or needs to be (re-)calculated (false)?
+		bool sortedIndex{false}; // is 'm_sortedIndex' already available or needs to be (re-)calculated?
 	};
 
 	CachedValuesAvailable available;
@@ -168,6 +201,15 @@ public:
 	AbstractColumn::Properties properties{
 		AbstractColumn::Properties::No}; // declares the properties of the curve (monotonic increasing/decreasing ...). Speed up algorithms
 
+	// the monotonicity is determined for blocks of rows, only the modified blocks are checked again in updateProperties()
+	static constexpr int propertiesBlockSize = 4096;
+	enum PropertiesBlockFlag : quint8 {
+		BlockIncreasing = 0x1, // the values of the block don't decrease
+		BlockDecreasing = 0x2, // the values of the block don't increase
+		BlockInvalid = 0x4, // the block contains invalid or masked values
+		BlockDirty = 0x8 // the block was modified and needs to be checked again
+	};
+
 	struct ValueLabels {
 		void setMode(AbstractColumn::ColumnMode);
 		void migrateLabels(AbstractColumn::ColumnMode newMode);
@@ -263,8 +305,20 @@ private:
 	AbstractColumn::ColumnMode m_columnMode; // type of column data
 	void* m_data{nullptr}; // pointer to the data container (QVector<T>)
 	int m_rowCount{0};
+	mutable std::atomic<bool> m_dataPending{false}; // the data is not loaded from the project file yet
+	mutable std::shared_ptr<ProjectDataReader> m_pendingDataReader;
+	int m_pendingDataBlob{-1};
+	mutable QMutex m_pendingDataMutex;
+	std::unique_ptr<TextDictionary> m_textDictionary; // dictionary encoded texts, m_data is empty if set
+	std::unique_ptr<DateTimeValues> m_dateTimeValues; // date and time values as milliseconds or nanoseconds since epoch, m_data is empty if set
+	DateTimeValues::Resolution m_pendingDateTimeResolution{DateTimeValues::Resolution::Milliseconds}; // resolution of the data in the project file
 	QVector<QString> m_dictionary; // dictionary for string columns
+	QVector<int> m_dictionaryCodeIndex; // index in m_dictionary for the codes of m_textDictionary, -1 for empty texts
 	QMap<QString, int> m_dictionaryFrequencies; // dictionary for elements frequencies in string columns
+	QVector<quint8> m_propertiesBlocks; // PropertiesBlockFlag of every block of propertiesBlockSize rows
+	const void* m_propertiesData{nullptr}; // data container the blocks were determined for
+	AbstractColumn::ColumnMode m_propertiesMode{AbstractColumn::ColumnMode::Double}; // column mode the blocks were determined for
+	QVector<int> m_sortedIndex; // valid and not masked rows sorted by their values
 
 	AbstractSimpleFilter* m_inputFilter{nullptr}; // input filter for string -> data type conversion
 	AbstractSimpleFilter* m_outputFilter{nullptr}; // output filter for data type -> string conversion
@@ -278,20 +332,30 @@ private:
 	QVector<QMetaObject::Connection> m_connectionsUpdateFormula;
 
 	void initDictionary();
+	void discardPendingData();
+	void expandData() const;
 	void calculateTextStatistics();
 	void calculateDateTimeStatistics();
 	void connectFormulaColumn(const AbstractColumn*);
 
+	inline void ensureDataLoaded() const {
+		if (m_dataPending)
+			loadPendingData();
+		if (m_textDictionary || m_dateTimeValues)
+			expandData();
+	}
+
 	// Never call this function directly, because it does no
 	// mode checking.
 	template<typename T>
 	void setValueAtPrivate(int row, const T& new_value) {
+		ensureDataLoaded();
 		if (!m_data) {
 			if (!initDataContainer())
 				return; // failed to allocate memory
 		}
 
-		invalidate();
+		invalidateRows(row, row);
 
 		Q_EMIT q->dataAboutToChange(q);
 		if (row >= rowCount())
@@ -308,13 +372,20 @@ private:
 	// mode checking.
 	template<typename T>
 	void replaceValuePrivate(int first, const QVector<T>& new_values) {
+		if (first < 0)
+			discardPendingData(); // the complete content is replaced, no need to load it
+		else
+			ensureDataLoaded();
 		if (!m_data) {
 			const bool resize = (first >= 0);
 			if (!initDataContainer(resize))
 				return; // failed to allocate memory
 		}
 
-		invalidate();
+		if (first < 0)
+			invalidate();
+		else
+			invalidateRows(first, first + new_values.size() - 1);
 
 		Q_EMIT q->dataAboutToChange(q);
 
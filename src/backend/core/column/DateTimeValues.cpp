@@ -0,0 +1,165 @@
+/*
+	File                 : DateTimeValues.cpp
+	Project              : LabPlot
+	Description          : Storage of the content of DateTime columns as milliseconds or nanoseconds since epoch
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/core/column/DateTimeValues.h"
+
+#include <cstring>
+#include <memory>
+
+/*!
+ * \class DateTimeValues
+ * \brief Storage of the content of DateTime, Month and Day columns as milliseconds since epoch.
+ *
+ * All values of the column share one time representation (UTC, local time, offset or time zone),
+ * only the milliseconds since epoch are stored per row. The values can be used directly for plotting,
+ * statistics, sorting, etc. without converting every row from QDateTime, QDateTime objects are only
+ * created when single values are requested (e.g. for the display in the spreadsheet).
+ *
+ * Timestamps of high-rate acquisition data (CAN, MCAP, etc.) are stored with nanosecond resolution in UTC.
+ * QDateTime only has a resolution of milliseconds, the nanoseconds are only available via values().
+ * The minimum, maximum and the sorting compare the exact nanoseconds, only the results are converted
+ * to fractional milliseconds for the plots (see toMSecsF()) which can't distinguish close values.
+ *
+ * The content is immutable, the column expands it again to a QVector<QDateTime> on the first modification.
+ *
+ * \ingroup backend
+ */
+
+/*!
+ * creates the representation of \c dateTimes as milliseconds since epoch.
+ * Returns \c nullptr if the valid values have different time representations.
+ */
+DateTimeValues* DateTimeValues::create(const QVector<QDateTime>& dateTimes) {
+	std::unique_ptr<DateTimeValues> values(new DateTimeValues);
+	values->m_values.resize(dateTimes.size());
+	bool first = true;
+	for (int row = 0; row < dateTimes.size(); ++row) {
+		const auto& dateTime = dateTimes.at(row);
+		if (!dateTime.isValid()) {
+			values->m_values[row] = invalid;
+			continue;
+		}
+
+		const auto& timeZone = dateTime.timeRepresentation();
+		if (first) {
+			values->m_timeZone = timeZone;
+			first = false;
+		} else if (timeZone != values->m_timeZone)
+			return nullptr;
+
+		values->m_values[row] = dateTime.toMSecsSinceEpoch();
+	}
+
+	return values.release();
+}
+
+/*!
+ * creates the values out of the binary representation used in the project files
+ * (milliseconds since epoch in UTC, std::numeric_limits<qint64>::min() for invalid values) without any conversion.
+ */
+DateTimeValues* DateTimeValues::create(const QByteArray& bytes, Resolution resolution) {
+	auto* values = new DateTimeValues;
+	values->m_resolution = resolution;
+	values->m_values.resize(bytes.size() / (qsizetype)sizeof(qint64));
+	memcpy(values->m_values.data(), bytes.constData(), values->m_values.size() * sizeof(qint64));
+	return values;
+}
+
+/*!
+ * creates the values with nanosecond resolution out of the nanoseconds since epoch (UTC) \c nsecs,
+ * \c invalid is used for empty cells.
+ */
+DateTimeValues* DateTimeValues::create(const QVector<qint64>& nsecs) {
+	auto* values = new DateTimeValues;
+	values->m_resolution = Resolution::Nanoseconds;
+	values->m_values = nsecs;
+	return values;
+}
+
+//! returns the milliseconds since epoch of the nanoseconds since epoch \c nsecs, rounded towards the past
+qint64 DateTimeValues::toMSecs(qint64 nsecs) {
+	qint64 msecs = nsecs / nsecsPerMSec;
+	if (nsecs % nsecsPerMSec < 0)
+		--msecs;
+	return msecs;
+}
+
+/*!
+ * returns the nanoseconds since epoch \c nsecs as fractional milliseconds since epoch as used for the coordinates in the plots.
+ * The integer and the fractional part are converted separately to not lose more precision than necessary.
+ */
+double DateTimeValues::toMSecsF(qint64 nsecs) {
+	const qint64 msecs = toMSecs(nsecs);
+	return double(msecs) + double(nsecs - msecs * nsecsPerMSec) / nsecsPerMSec;
+}
+
+int DateTimeValues::rowCount() const {
+	return m_values.size();
+}
+
+DateTimeValues::Resolution DateTimeValues::resolution() const {
+	return m_resolution;
+}
+
+const QTimeZone& DateTimeValues::timeZone() const {
+	return m_timeZone;
+}
+
+//! returns the milliseconds or nanoseconds (see resolution()) since epoch of the row \c row or \c invalid for empty cells
+qint64 DateTimeValues::value(int row) const {
+	return m_values.at(row);
+}
+
+//! returns the milliseconds since epoch of the row \c row or \c invalid for empty cells
+qint64 DateTimeValues::msecs(int row) const {
+	const qint64 value = m_values.at(row);
+	if (value == invalid || m_resolution == Resolution::Milliseconds)
+		return value;
+	return toMSecs(value);
+}
+
+std::span<const qint64> DateTimeValues::values() const {
+	return {m_values.constData(), static_cast<size_t>(m_values.size())};
+}
+
+QDateTime DateTimeValues::dateTime(int row) const {
+	const qint64 value = msecs(row);
+	if (value == invalid)
+		return {};
+	return QDateTime::fromMSecsSinceEpoch(value, m_timeZone);
+}
+
+QVector<QDateTime> DateTimeValues::decode() const {
+	QVector<QDateTime> dateTimes(m_values.size());
+	for (int row = 0; row < m_values.size(); ++row)
+		dateTimes[row] = dateTime(row);
+	return dateTimes;
+}
+
+/*!
+ * returns the binary representation used in the project files, the date and time values of
+ * the values not in UTC are stored as UTC (see ColumnPrivate::encodeData()).
+ * The values with nanosecond resolution are always in UTC and are stored as nanoseconds.
+ */
+QByteArray DateTimeValues::encode() const {
+	if (m_timeZone == QTimeZone(QTimeZone::UTC))
+		return {reinterpret_cast<const char*>(m_values.constData()), m_values.size() * (qsizetype)sizeof(qint64)};
+
+	QByteArray bytes;
+	bytes.reserve(m_values.size() * sizeof(qint64));
+	for (int row = 0; row < m_values.size(); ++row) {
+		qint64 value = m_values.at(row);
+		if (value != invalid) {
+			const auto& dt = dateTime(row);
+			value = QDateTime(dt.date(), dt.time(), QTimeZone::UTC).toMSecsSinceEpoch();
+		}
+		bytes.append(reinterpret_cast<const char*>(&value), sizeof(qint64));
+	}
+	return bytes;
+}
@@ -0,0 +1,54 @@
+/*
+	File                 : DateTimeValues.h
+	Project              : LabPlot
+	Description          : Storage of the content of DateTime columns as milliseconds or nanoseconds since epoch
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DATETIMEVALUES_H
+#define DATETIMEVALUES_H
+
+#include <QDateTime>
+#include <QTimeZone>
+#include <QVector>
+
+#include <limits>
+#include <span>
+
+class DateTimeValues {
+public:
+	enum class Resolution { Milliseconds, Nanoseconds };
+
+	static constexpr qint64 invalid = std::numeric_limits<qint64>::min(); // value of the empty cells
+	static constexpr qint64 nsecsPerMSec = 1000000;
+
+	static DateTimeValues* create(const QVector<QDateTime>&);
+	static DateTimeValues* create(const QByteArray&, Resolution = Resolution::Milliseconds);
+	static DateTimeValues* create(const QVector<qint64>& nsecs);
+
+	static qint64 toMSecs(qint64 nsecs);
+	static double toMSecsF(qint64 nsecs);
+
+	int rowCount() const;
+	Resolution resolution() const;
+	const QTimeZone& timeZone() const;
+
+	qint64 value(int row) const;
+	qint64 msecs(int row) const;
+	std::span<const qint64> values() const;
+	QDateTime dateTime(int row) const;
+
+	QVector<QDateTime> decode() const;
+	QByteArray encode() const;
+
+private:
+	DateTimeValues() = default;
+
+	QVector<qint64> m_values; // milliseconds or nanoseconds since epoch (UTC) for every row
+	Resolution m_resolution{Resolution::Milliseconds};
+	QTimeZone m_timeZone{QTimeZone::UTC}; // time representation of all values of the column
+};
+
+#endif
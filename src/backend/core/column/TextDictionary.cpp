@@ -0,0 +1,187 @@
+/*
+	File                 : TextDictionary.cpp
+	Project              : LabPlot
+	Description          : Dictionary encoded storage of the content of text columns
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/core/column/TextDictionary.h"
+
+#include <QHash>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+/*!
+ * \class TextDictionary
+ * \brief Dictionary encoded storage of the content of text columns.
+ *
+ * Every distinct string is stored only once as UTF-8 in a single byte array, the rows only contain
+ * the integer codes of the strings. For categorical data with few distinct values (identifiers, status codes, etc.)
+ * this requires a small fraction of the memory needed for one QString per row, the frequencies, the sorting, etc.
+ * can be determined on the codes without comparing the strings for every row.
+ *
+ * The content is immutable, the column expands it again to a QVector<QString> on the first modification.
+ *
+ * \ingroup backend
+ */
+
+/*!
+ * creates the dictionary encoded representation of \c texts.
+ * Returns \c nullptr if there are too few rows or too many distinct values for the encoding to pay off.
+ */
+TextDictionary* TextDictionary::create(const QVector<QString>& texts) {
+	const int rows = texts.size();
+	if (rows < minimumRows)
+		return nullptr;
+
+	const int maxSize = rows / minimumRepetitions;
+	std::unique_ptr<TextDictionary> dictionary(new TextDictionary);
+	dictionary->m_codes.resize(rows);
+	QHash<QString, quint32> codes;
+	for (int row = 0; row < rows; ++row) {
+		const auto& text = texts.at(row);
+		auto it = codes.constFind(text);
+		if (it == codes.constEnd()) {
+			if (codes.size() == maxSize)
+				return nullptr;
+			const auto& utf8 = text.toUtf8();
+			it = codes.insert(text, dictionary->append(utf8.constData(), utf8.size()));
+		}
+		dictionary->m_codes[row] = it.value();
+	}
+
+	dictionary->m_strings.squeeze();
+	dictionary->m_offsets.squeeze();
+	return dictionary.release();
+}
+
+/*!
+ * creates the dictionary encoded representation of the UTF-8 strings in \c bytes that are separated by null characters
+ * (the format used in the project files) without converting every row to a QString.
+ * Returns \c nullptr if there are too few rows or too many distinct values for the encoding to pay off.
+ */
+TextDictionary* TextDictionary::create(const QByteArray& bytes) {
+	const qsizetype rows = bytes.count('\0') + 1;
+	if (rows < minimumRows || rows > std::numeric_limits<int>::max())
+		return nullptr;
+
+	const qsizetype maxSize = rows / minimumRepetitions;
+	std::unique_ptr<TextDictionary> dictionary(new TextDictionary);
+	dictionary->m_codes.resize(rows);
+	QHash<QByteArrayView, quint32> codes;
+	const char* data = bytes.constData();
+	qsizetype start = 0;
+	for (qsizetype row = 0; row < rows; ++row) {
+		qsizetype end = bytes.indexOf('\0', start);
+		if (end < 0)
+			end = bytes.size();
+
+		const QByteArrayView utf8(data + start, end - start);
+		auto it = codes.constFind(utf8);
+		if (it == codes.constEnd()) {
+			if (codes.size() == maxSize)
+				return nullptr;
+			it = codes.insert(utf8, dictionary->append(utf8.data(), utf8.size()));
+		}
+		dictionary->m_codes[row] = it.value();
+		start = end + 1;
+	}
+
+	dictionary->m_strings.squeeze();
+	dictionary->m_offsets.squeeze();
+	return dictionary.release();
+}
+
+quint32 TextDictionary::append(const char* utf8, qsizetype length) {
+	m_strings.append(utf8, length);
+	m_offsets.append(m_strings.size());
+	return static_cast<quint32>(m_offsets.size() - 2);
+}
+
+int TextDictionary::rowCount() const {
+	return m_codes.size();
+}
+
+//! number of distinct strings
+int TextDictionary::size() const {
+	return m_offsets.size() - 1;
+}
+
+quint32 TextDictionary::code(int row) const {
+	return m_codes.at(row);
+}
+
+const QVector<quint32>& TextDictionary::codes() const {
+	return m_codes;
+}
+
+QString TextDictionary::text(int row) const {
+	return string(m_codes.at(row));
+}
+
+QString TextDictionary::string(quint32 code) const {
+	const qsizetype start = m_offsets.at(code);
+	return QString::fromUtf8(m_strings.constData() + start, m_offsets.at(code + 1) - start);
+}
+
+bool TextDictionary::isEmpty(quint32 code) const {
+	return m_offsets.at(code) == m_offsets.at(code + 1);
+}
+
+/*!
+ * returns the rank of every distinct string in the sorted list of all distinct strings (QString ordering),
+ * comparing the ranks of the codes of two rows is equivalent to comparing their texts.
+ */
+QVector<int> TextDictionary::ranks() const {
+	const int count = size();
+	QVector<QString> strings(count);
+	for (int i = 0; i < count; ++i)
+		strings[i] = string(i);
+
+	QVector<int> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&strings](int a, int b) {
+		return strings.at(a) < strings.at(b);
+	});
+
+	QVector<int> ranks(count);
+	for (int i = 0; i < count; ++i)
+		ranks[order.at(i)] = i;
+	return ranks;
+}
+
+//! returns the content as one string per row, the rows with the same text share the same string data
+QVector<QString> TextDictionary::decode() const {
+	const int count = size();
+	QVector<QString> strings(count);
+	for (int i = 0; i < count; ++i)
+		strings[i] = string(i);
+
+	QVector<QString> texts(m_codes.size());
+	for (int row = 0; row < m_codes.size(); ++row)
+		texts[row] = strings.at(m_codes.at(row));
+	return texts;
+}
+
+//! returns the UTF-8 representation of the rows separated by null characters as it is stored in the project file
+QByteArray TextDictionary::encode() const {
+	QByteArray bytes;
+	qsizetype length = m_codes.size();
+	for (const auto code : m_codes)
+		length += m_offsets.at(code + 1) - m_offsets.at(code);
+	bytes.reserve(length);
+
+	for (const auto code : m_codes) {
+		const qsizetype start = m_offsets.at(code);
+		bytes.append(m_strings.constData() + start, m_offsets.at(code + 1) - start);
+		bytes.append('\0');
+	}
+	if (!bytes.isEmpty())
+		bytes.removeLast(); // remove the last null character
+	return bytes;
+}
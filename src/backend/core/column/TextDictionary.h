@@ -0,0 +1,47 @@
+/*
+	File                 : TextDictionary.h
+	Project              : LabPlot
+	Description          : Dictionary encoded storage of the content of text columns
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef TEXTDICTIONARY_H
+#define TEXTDICTIONARY_H
+
+#include <QByteArray>
+#include <QVector>
+
+class TextDictionary {
+public:
+	// minimal number of rows and of repetitions per distinct value on average for the encoding to be used
+	static constexpr int minimumRows = 1024;
+	static constexpr int minimumRepetitions = 4;
+
+	static TextDictionary* create(const QVector<QString>&);
+	static TextDictionary* create(const QByteArray&);
+
+	int rowCount() const;
+	int size() const;
+
+	quint32 code(int row) const;
+	const QVector<quint32>& codes() const;
+	QString text(int row) const;
+	QString string(quint32 code) const;
+	bool isEmpty(quint32 code) const;
+
+	QVector<int> ranks() const;
+	QVector<QString> decode() const;
+	QByteArray encode() const;
+
+private:
+	TextDictionary() = default;
+	quint32 append(const char* utf8, qsizetype length);
+
+	QVector<quint32> m_codes; // code of the string for every row
+	QByteArray m_strings; // UTF-8 representation of all distinct strings, one after another
+	QVector<qsizetype> m_offsets{0}; // start of the string with the code i in m_strings is m_offsets[i], the end is m_offsets[i+1]
+};
+
+#endif
@@ -572,6 +572,10 @@ void LiveDataSource::read() {
 	if (m_reading)
 		return;
 
+#if PERFTRACE_LIVE_IMPORT
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", source ") + name());
+#endif
+
 	m_reading = true;
 
 	// initialize the device (file, socket, serial port) when calling this function for the first time
@@ -597,12 +601,23 @@ void LiveDataSource::read() {
 																				   m_keepNValues);
 				m_bytesRead += bytes;
 				// DEBUG("Read " << bytes << " bytes, in total: " << m_bytesRead);
+#if PERFTRACE_LIVE_IMPORT
+				PERFTRACE_COUNTER("live import bytes read", m_bytesRead);
+#endif
 			}
 			break;
 		case AbstractFileFilter::FileType::Binary:
-			// TODO: not implemented yet
-			//  bytes = qSharedPointerCast<BinaryFilter>(m_filter)->readFromLiveDevice(*m_file, this, m_bytesRead);
-			// 			m_bytesRead += bytes;
+			if (m_readingType == LiveDataSource::ReadingType::WholeFile)
+				m_filter->readDataFromFile(m_fileName, this);
+			else {
+				// only the records appended since the last read are read and converted
+				const int lines = (m_readingType == LiveDataSource::ReadingType::TillEnd) ? -1 : sampleSize();
+				m_bytesRead += static_cast<BinaryFilter*>(m_filter)->readFromLiveDevice(*m_device, this, m_bytesRead, lines, m_keepNValues);
+#if PERFTRACE_LIVE_IMPORT
+				PERFTRACE_COUNTER("live import bytes read", m_bytesRead);
+#endif
+			}
+			break;
 		case AbstractFileFilter::FileType::ROOT:
 		case AbstractFileFilter::FileType::Spice:
 			// only re-reading of the whole file is supported
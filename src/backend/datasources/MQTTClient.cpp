@@ -166,6 +166,26 @@ int MQTTClient::sampleSize() const {
 	return m_sampleSize;
 }
 
+/*!
+ * \brief Returns the number of received messages of all topics that were not read yet
+ */
+int MQTTClient::queuedMessages() const {
+	int count = 0;
+	for (const auto* topic : children<MQTTTopic>(AbstractAspect::ChildIndexFlag::Recursive))
+		count += topic->queuedMessages();
+	return count;
+}
+
+/*!
+ * \brief Returns the number of messages of all topics dropped because too many messages were waiting to be read
+ */
+qint64 MQTTClient::droppedMessages() const {
+	qint64 count = 0;
+	for (const auto* topic : children<MQTTTopic>(AbstractAspect::ChildIndexFlag::Recursive))
+		count += topic->droppedMessages();
+	return count;
+}
+
 /*!
  * \brief Sets the MQTTClient's reading type to readingType
  * \param readingType
@@ -430,8 +450,10 @@ void MQTTClient::removeMQTTSubscription(const QString& subscriptionName) {
 
 				// Remove every topic of the subscription as well
 				const auto& topics = removeSubscription->topics();
-				for (const auto& topic : topics)
+				for (const auto& topic : topics) {
 					m_topicNames.removeAll(topic->topicName());
+					m_topics.remove(topic->topicName());
+				}
 
 				// Remove the MQTTSubscription
 				removeChild(removeSubscription);
@@ -1051,16 +1073,25 @@ void MQTTClient::onMQTTConnect() {
 void MQTTClient::MQTTSubscriptionMessageReceived(const QMqttMessage& msg) {
 	// Decide to interpret retain message or not
 	if (!msg.retain() || m_MQTTRetain) {
-		// If this is the first message from the topic, save its name
-		if (!m_topicNames.contains(msg.topic().name()))
-			m_topicNames.push_back(msg.topic().name());
-
-		// Pass the message and the topic name to the MQTTSubscription which contains the topic
-		for (auto* subscription : m_MQTTSubscriptions) {
-			if (checkTopicContains(subscription->subscriptionName(), msg.topic().name())) {
-				subscription->messageArrived(msg);
-				Q_EMIT messagedReceived();
-				break;
+		const QString& topicName = msg.topic().name();
+
+		// Pass the message directly to the topic if it's already known and wasn't removed in the meantime
+		auto* topic = m_topics.value(topicName).data();
+		if (topic && topic->parentAspect()) {
+			topic->newMessage(msg);
+			Q_EMIT messagedReceived();
+		} else {
+			// If this is the first message from the topic, save its name
+			if (!m_topicNames.contains(topicName))
+				m_topicNames.push_back(topicName);
+
+			// Pass the message and the topic name to the MQTTSubscription which contains the topic
+			for (auto* subscription : m_MQTTSubscriptions) {
+				if (checkTopicContains(subscription->subscriptionName(), topicName)) {
+					m_topics[topicName] = subscription->messageArrived(msg);
+					Q_EMIT messagedReceived();
+					break;
+				}
 			}
 		}
 
@@ -12,6 +12,7 @@
 
 #include "backend/core/Folder.h"
 
+#include <QPointer>
 #include <QtMqtt/QMqttClient>
 #include <QtMqtt/QMqttMessage>
 #include <QtMqtt/QMqttTopicFilter>
@@ -76,6 +77,9 @@ public:
 	int sampleSize() const;
 	void setSampleSize(int);
 
+	int queuedMessages() const;
+	qint64 droppedMessages() const;
+
 	bool isPaused() const;
 
 	void setUpdateInterval(int);
@@ -184,6 +188,7 @@ private:
 	QMap<QMqttTopicFilter, quint8> m_subscribedTopicNameQoS;
 	QVector<QString> m_subscriptions;
 	QVector<QString> m_topicNames;
+	QHash<QString, QPointer<MQTTTopic>> m_topics; // topics the messages were already passed to
 	bool m_MQTTTest{false};
 	QTimer* m_willTimer;
 	bool m_MQTTFirstConnectEstablished{false};
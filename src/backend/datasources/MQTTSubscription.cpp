@@ -56,34 +56,24 @@ MQTTClient* MQTTSubscription::mqttClient() const {
  * Passes the messages to the appropriate MQTTTopic
  *
  * \param message the message to pass
- * \param topicName the name of the topic the message was sent to
+ * \return the topic the message was passed to
  */
-void MQTTSubscription::messageArrived(const QMqttMessage& msg) {
-	bool found = false;
+MQTTTopic* MQTTSubscription::messageArrived(const QMqttMessage& msg) {
 	QVector<MQTTTopic*> topics = children<MQTTTopic>();
 	// search for the topic among the MQTTTopic children
 	for (auto* topic : topics) {
 		if (msg.topic().name() == topic->topicName()) {
-			// pass the message to the topic
+			// pass the message to the topic, it's read by the topic if needed
 			topic->newMessage(msg);
-
-			// read the message if needed
-			if ((m_MQTTClient->updateType() == MQTTClient::UpdateType::NewData) && !m_MQTTClient->isPaused())
-				topic->read();
-
-			found = true;
-			break;
+			return topic;
 		}
 	}
 
-	// if the topic can't be found, we add it as a new MQTTTopic, and read from it if needed
-	if (!found) {
-		auto* newTopic = new MQTTTopic(msg.topic().name(), this, false);
-		addChildFast(newTopic); // no need for undo/redo here
-		newTopic->newMessage(msg);
-		if ((m_MQTTClient->updateType() == MQTTClient::UpdateType::NewData) && !m_MQTTClient->isPaused())
-			newTopic->read();
-	}
+	// if the topic can't be found, we add it as a new MQTTTopic
+	auto* newTopic = new MQTTTopic(msg.topic().name(), this, false);
+	addChildFast(newTopic); // no need for undo/redo here
+	newTopic->newMessage(msg);
+	return newTopic;
 }
 
 /*!
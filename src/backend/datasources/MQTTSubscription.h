@@ -29,7 +29,7 @@ public:
 	QString subscriptionName() const;
 	const QVector<MQTTTopic*> topics() const;
 	MQTTClient* mqttClient() const;
-	void messageArrived(const QMqttMessage& msg);
+	MQTTTopic* messageArrived(const QMqttMessage& msg);
 
 	QIcon icon() const override;
 	void save(QXmlStreamWriter*) const override;
@@ -21,8 +21,11 @@
 
 #include <KLocalizedString>
 #include <QAction>
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QMenu>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 /*!
   \class MQTTTopic
@@ -49,6 +52,9 @@ MQTTTopic::MQTTTopic(const QString& name, MQTTSubscription* subscription, bool l
 	m_filter->initialize(properties);
 	m_filter->setDataSource(this);
 
+	m_parseWatcher = new QFutureWatcher<void>(this);
+	connect(m_parseWatcher, &QFutureWatcher<void>::finished, this, &MQTTTopic::parsingFinished);
+
 	connect(m_MQTTClient, &MQTTClient::readFromTopics, this, &MQTTTopic::read);
 	qDebug() << "New MqttTopic: " << m_topicName;
 	initActions();
@@ -56,6 +62,7 @@ MQTTTopic::MQTTTopic(const QString& name, MQTTSubscription* subscription, bool l
 
 MQTTTopic::~MQTTTopic() {
 	qDebug() << "MqttTopic destructor:" << m_topicName;
+	m_parseWatcher->waitForFinished();
 	delete m_filter;
 }
 
@@ -111,9 +118,34 @@ QWidget* MQTTTopic::view() const {
 
 /*!
  *\brief Adds a message received by the topic to the message puffer
+ * If the data is updated on new data, the reading is scheduled once for all messages
+ * arriving until the control returns to the event loop.
  */
 void MQTTTopic::newMessage(const QMqttMessage& msg) {
-	m_messagePuffer.push_back(msg);
+	if (m_messagePuffer.size() >= maxQueuedMessages) {
+		m_messagePuffer.dequeue();
+		++m_droppedMessages;
+	}
+	m_messagePuffer.enqueue(msg);
+
+	if (m_MQTTClient->updateType() == MQTTClient::UpdateType::NewData && !m_MQTTClient->isPaused() && !m_readScheduled) {
+		m_readScheduled = true;
+		QTimer::singleShot(0, this, &MQTTTopic::read);
+	}
+}
+
+/*!
+ *\brief Returns the number of received messages that were not read yet
+ */
+int MQTTTopic::queuedMessages() const {
+	return m_messagePuffer.size();
+}
+
+/*!
+ *\brief Returns the number of messages dropped because too many messages were waiting to be read
+ */
+qint64 MQTTTopic::droppedMessages() const {
+	return m_droppedMessages;
 }
 
 /*!
@@ -152,14 +184,60 @@ void MQTTTopic::plotData() {
 
 /*!
  *\brief Reads every message from the message puffer
+ * The payloads of all messages are parsed in a worker thread and appended to the columns in one step
+ * in parsingFinished(). The first messages are read directly since the columns are created when reading them.
  */
 void MQTTTopic::read() {
-	while (!m_messagePuffer.isEmpty()) {
-		qDebug() << "Reading from topic " << m_topicName;
-		auto msg = m_messagePuffer.takeFirst();
-		BufferReader reader(msg.payload());
-		m_filter
-			->readFromDevice(reader, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append, 0, -1, this->mqttClient()->keepNValues());
+	m_readScheduled = false;
+	if (m_messagePuffer.isEmpty())
+		return;
+
+	// the previous messages are still parsed, the new messages are read afterwards
+	if (m_parsedData) {
+		m_readPending = true;
+		return;
+	}
+
+	PERFTRACE(QStringLiteral("MQTTTopic::read, ") + m_topicName);
+	DEBUG(Q_FUNC_INFO << ", topic " << STDSTRING(m_topicName) << ", messages: " << m_messagePuffer.size() << ", dropped: " << m_droppedMessages)
+	if (m_droppedMessages > m_droppedMessagesReported) {
+		WARN(Q_FUNC_INFO << ", topic " << STDSTRING(m_topicName) << ": " << m_droppedMessages - m_droppedMessagesReported
+						 << " messages were dropped because more than " << maxQueuedMessages << " messages were waiting to be read")
+		m_droppedMessagesReported = m_droppedMessages;
+	}
+
+	QVector<QByteArray> payloads;
+	payloads.reserve(m_messagePuffer.size());
+	for (const auto& msg : std::as_const(m_messagePuffer))
+		payloads << msg.payload();
+	m_messagePuffer.clear();
+
+	m_parsedData = m_filter->prepareParsing(payloads);
+	if (!m_parsedData) {
+		m_filter->readFromBuffers(payloads, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append, mqttClient()->keepNValues());
+		return;
+	}
+
+	auto parsedData = m_parsedData;
+	m_parseWatcher->setFuture(QtConcurrent::run([parsedData]() {
+		AsciiFilter::parse(*parsedData);
+	}));
+}
+
+/*!
+ *\brief Appends the messages parsed in the worker thread to the columns
+ */
+void MQTTTopic::parsingFinished() {
+	PERFTRACE(QStringLiteral("MQTTTopic::parsingFinished, ") + m_topicName);
+	const auto parsedData = std::move(m_parsedData);
+	if (!parsedData)
+		return;
+
+	m_filter->appendParsedData(*parsedData, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append, mqttClient()->keepNValues());
+
+	if (m_readPending) {
+		m_readPending = false;
+		read();
 	}
 }
 
@@ -11,14 +11,17 @@
 #ifndef MQTTTOPIC_H
 #define MQTTTOPIC_H
 
+#include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <QMqttMessage>
+#include <QQueue>
 
 class QAction;
+template<typename T>
+class QFutureWatcher;
 class MQTTSubscription;
 class MQTTClient;
-class AsciiFilter;
 
 class MQTTTopic : public Spreadsheet {
 	Q_OBJECT
@@ -37,19 +40,31 @@ public:
 	QString topicName() const;
 	MQTTClient* mqttClient() const;
 	void newMessage(const QMqttMessage& msg);
+	int queuedMessages() const;
+	qint64 droppedMessages() const;
 
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*, bool preview) override;
 
 private:
 	void initActions();
+	void parsingFinished();
 
 	QString m_topicName;
 	MQTTClient* m_MQTTClient;
 	AsciiFilter* m_filter;
-	QVector<QMqttMessage> m_messagePuffer;
+	QQueue<QMqttMessage> m_messagePuffer;
+	qint64 m_droppedMessages{0};
+	qint64 m_droppedMessagesReported{0};
+	bool m_readScheduled{false};
+	bool m_readPending{false}; // new messages arrived while the previous messages were parsed
+	std::shared_ptr<AsciiFilter::ParsedData> m_parsedData; // messages parsed in the worker thread
+	QFutureWatcher<void>* m_parseWatcher{nullptr};
 	QAction* m_plotDataAction;
 
+	// maximal number of messages waiting to be read, the oldest messages are dropped if more messages arrive
+	static constexpr int maxQueuedMessages = 100000;
+
 public Q_SLOTS:
 	void read();
 
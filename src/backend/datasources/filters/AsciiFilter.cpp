@@ -13,6 +13,7 @@
 #include "AsciiFilterPrivate.h"
 #include "backend/core/Project.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/datasources/filters/FilterStatus.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/hostprocess.h"
@@ -33,6 +34,8 @@
 #include <QTimer>
 #include <QUdpSocket>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 namespace {
@@ -58,6 +61,36 @@ private:
 	const bool reset;
 };
 const QLatin1String INTERNAL_SEPARATOR(",");
+
+/*!
+ * converts the Unix timestamp \c value (seconds with an optional fraction) to nanoseconds since epoch,
+ * digits beyond nanoseconds are ignored. Returns \c false if \c value is not a valid timestamp.
+ */
+bool unixTimestampNSecs(QStringView value, const QLocale& locale, qint64& nsecs) {
+	value = value.trimmed();
+	const auto& decimalPoint = locale.decimalPoint();
+	const auto index = value.indexOf(decimalPoint);
+	bool ok;
+	const qint64 secs = locale.toLongLong(index < 0 ? value : value.left(index), &ok);
+	if (!ok)
+		return false;
+
+	qint64 fraction = 0;
+	if (index >= 0) {
+		const auto digits = value.mid(index + decimalPoint.size());
+		for (int i = 0; i < 9; ++i) {
+			fraction *= 10;
+			if (i < digits.size()) {
+				if (!digits.at(i).isDigit())
+					return false;
+				fraction += digits.at(i).digitValue();
+			}
+		}
+	}
+
+	nsecs = secs * 1000000000 + (value.startsWith(QLatin1Char('-')) ? -fraction : fraction);
+	return true;
+}
 } // Anonymous namespace
 
 BufferReader::BufferReader(const QByteArray& buffer)
@@ -91,9 +124,7 @@ qint64 BufferReader::readData(char* out, qint64 maxLen) {
 	if (maxLen < 0)
 		return 0;
 
-	for (int i = 0; i < maxLen; i++) {
-		*out++ = *(const_cast<char*>(m_message.data()) + m_index + i);
-	}
+	memcpy(out, m_message.constData() + m_index, maxLen);
 	m_index += maxLen;
 	return maxLen;
 }
@@ -179,6 +210,70 @@ qint64 AsciiFilter::readFromDevice(QIODevice& device,
 	return bytes_read;
 }
 
+/*!
+ * reads the data of all \p buffers, e.g. the payloads of the messages received by a MQTT topic since the last update,
+ * and appends it to the data source in one step instead of finalizing the import for every single buffer.
+ * Every buffer is parsed like it was read with readFromDevice(). Returns the number of bytes read.
+ */
+qint64 AsciiFilter::readFromBuffers(const QVector<QByteArray>& buffers, ImportMode columnImportMode, ImportMode rowImportMode, qint64 keepNRows) {
+	Q_D(AsciiFilter);
+	qint64 bytes_read;
+	const auto status = d->readFromBuffers(buffers, columnImportMode, rowImportMode, keepNRows, bytes_read);
+	d->setLastError(status);
+	return bytes_read;
+}
+
+AsciiFilter::ParsedData::ParsedData(const AsciiFilterPrivate& filter, const QVector<QByteArray>& buffers)
+	: buffers(buffers)
+	, parser(nullptr) {
+	parser.properties = filter.properties;
+	parser.initialized = true;
+	parser.processEvents = false;
+	parser.m_index = filter.m_index;
+	for (const auto mode : filter.m_DataContainer.columnModes())
+		parser.m_DataContainer.appendVector(mode);
+}
+
+AsciiFilter::ParsedData::~ParsedData() {
+	parser.m_DataContainer.clear(); // the data containers are owned by the parser
+}
+
+/*!
+ * prepares the parsing of \p buffers with parse(), the current settings of the filter are used.
+ * Returns \c nullptr if the filter was not used to read data into the data source yet, in this case
+ * the buffers have to be read with readFromBuffers() which also creates the columns.
+ */
+std::shared_ptr<AsciiFilter::ParsedData> AsciiFilter::prepareParsing(const QVector<QByteArray>& buffers) const {
+	Q_D(const AsciiFilter);
+	if (!d->initialized || d->m_DataContainer.size() == 0)
+		return nullptr;
+
+	return std::make_shared<ParsedData>(*d, buffers);
+}
+
+/*!
+ * parses the buffers of \p data into its data containers. Neither the filter nor the data source
+ * are accessed, so this can be called in a worker thread.
+ */
+void AsciiFilter::parse(ParsedData& data) {
+	data.status = data.parser.parseBuffers(data.buffers, data.rows, data.bytes);
+}
+
+/*!
+ * appends the data parsed with parse() to the data source like readFromBuffers().
+ * If the columns were modified in the meantime, the buffers are read again with readFromBuffers().
+ * Returns the number of bytes read.
+ */
+qint64 AsciiFilter::appendParsedData(ParsedData& data, ImportMode columnImportMode, ImportMode rowImportMode, qint64 keepNRows) {
+	Q_D(AsciiFilter);
+	if (!data.status.success() || !d->canAppendParsedData(data.parser))
+		return readFromBuffers(data.buffers, columnImportMode, rowImportMode, keepNRows);
+
+	const auto status = d->appendParsedData(data.parser, data.rows, columnImportMode, rowImportMode, keepNRows);
+	d->setLastError(status);
+	return data.bytes;
+}
+
 void AsciiFilter::write(const QString& /*fileName*/, AbstractDataSource*) {
 	// TODO
 }
@@ -237,7 +332,7 @@ int AsciiFilter::columnNumber(const QString& /*fileName*/, const QString& /*sepa
  */
 size_t AsciiFilter::lineCount(const QString& fileName, const size_t maxLines) {
 	DEBUG(Q_FUNC_INFO << ", max lines = " << maxLines)
-	PERFTRACE(QLatin1String(Q_FUNC_INFO))
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
 
 	KCompressionDevice device(fileName);
 
@@ -766,6 +861,160 @@ Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 										  bool skipFirstLine) {
 	bytes_read = 0;
 
+	int rowIndex = 0;
+	auto status = prepareReading(device, columnImportMode, rowImportMode, keepNRows, rowIndex);
+	if (!status.success())
+		return status;
+
+	status = readRows(device, from, lines, rowIndex, bytes_read, skipFirstLine);
+	if (!status.success())
+		return status;
+
+	return finishReading(rowIndex, keepNRows, columnImportMode);
+}
+
+/*!
+ * \brief AsciiFilterPrivate::readFromBuffers
+ * Reads the data of all \p buffers (e.g. the payloads of MQTT messages) one after another.
+ * Every buffer is parsed like a separate device (header line, start row, etc.), but the data source
+ * is resized and finalized only once for all of them.
+ * \param keepNRows After reading, keep n rows
+ */
+Status AsciiFilterPrivate::readFromBuffers(const QVector<QByteArray>& buffers,
+										   AbstractFileFilter::ImportMode columnImportMode,
+										   AbstractFileFilter::ImportMode rowImportMode,
+										   qint64 keepNRows,
+										   qint64& bytes_read) {
+	bytes_read = 0;
+	if (buffers.isEmpty())
+		return Status::Success();
+
+	BufferReader first(buffers.first());
+	int rowIndex = 0;
+	auto status = prepareReading(first, columnImportMode, rowImportMode, keepNRows, rowIndex);
+	if (!status.success())
+		return status;
+
+	for (int i = 0; i < buffers.size(); ++i) {
+		qint64 bytes = 0;
+		if (i == 0)
+			status = readRows(first, 0, -1, rowIndex, bytes);
+		else {
+			BufferReader reader(buffers.at(i));
+			status = readRows(reader, 0, -1, rowIndex, bytes);
+		}
+		// empty buffers are skipped
+		if (!status.success() && status.type() != Status::Type::DeviceAtEnd)
+			return status;
+		bytes_read += bytes;
+	}
+
+	return finishReading(rowIndex, keepNRows, columnImportMode);
+}
+
+/*!
+ * parses all \p buffers into the own data containers, used by AsciiFilter::parse().
+ * \p rowIndex is set to the number of rows parsed.
+ */
+Status AsciiFilterPrivate::parseBuffers(const QVector<QByteArray>& buffers, int& rowIndex, qint64& bytes_read) {
+	rowIndex = 0;
+	bytes_read = 0;
+	try {
+		m_DataContainer.resize(qMax(static_cast<qsizetype>(buffers.size()), numberRowsReallocation));
+	} catch (std::bad_alloc&) {
+		return Status::NotEnoughMemory();
+	}
+
+	for (const auto& buffer : buffers) {
+		BufferReader reader(buffer);
+		qint64 bytes = 0;
+		const auto status = readRows(reader, 0, -1, rowIndex, bytes);
+		// empty buffers are skipped
+		if (!status.success() && status.type() != Status::Type::DeviceAtEnd)
+			return status;
+		bytes_read += bytes;
+	}
+
+	return Status::Success();
+}
+
+/*!
+ * returns \c true if the data parsed by \p parser fits to the current data containers, returns \c false
+ * if the filter was reinitialized or the columns were recreated since the parsing was prepared.
+ */
+bool AsciiFilterPrivate::canAppendParsedData(const AsciiFilterPrivate& parser) const {
+	return initialized && m_DataContainer.size() > 0 && m_DataContainer.columnModes() == parser.m_DataContainer.columnModes()
+		&& properties.createIndex == parser.properties.createIndex;
+}
+
+namespace {
+template<typename T>
+void moveRows(void* target, void* source, int rowIndex, int rows) {
+	auto* sourceVector = static_cast<QVector<T>*>(source);
+	std::move(sourceVector->begin(), sourceVector->begin() + rows, static_cast<QVector<T>*>(target)->begin() + rowIndex);
+}
+} // anonymous namespace
+
+/*!
+ * appends the first \p rows rows of the data containers of \p parser to the data containers of the data source
+ * and finalizes the import like readFromBuffers().
+ */
+Status AsciiFilterPrivate::appendParsedData(AsciiFilterPrivate& parser,
+											int rows,
+											AbstractFileFilter::ImportMode columnImportMode,
+											AbstractFileFilter::ImportMode rowImportMode,
+											qint64 keepNRows) {
+	const QByteArray empty; // the filter is initialized already, the device is not used
+	BufferReader device(empty);
+	int rowIndex = 0;
+	auto status = prepareReading(device, columnImportMode, rowImportMode, keepNRows, rowIndex);
+	if (!status.success())
+		return status;
+
+	try {
+		if (rowIndex + rows > m_DataContainer.rowCount())
+			m_DataContainer.resize(rowIndex + rows);
+	} catch (std::bad_alloc&) {
+		return Status::NotEnoughMemory();
+	}
+
+	auto& target = m_DataContainer.dataContainer();
+	auto& source = parser.m_DataContainer.dataContainer();
+	for (size_t i = 0; i < target.size(); ++i) {
+		switch (m_DataContainer.columnMode(i)) {
+		case AbstractColumn::ColumnMode::BigInt:
+			moveRows<qint64>(target[i], source[i], rowIndex, rows);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			moveRows<qint32>(target[i], source[i], rowIndex, rows);
+			break;
+		case AbstractColumn::ColumnMode::Double:
+			moveRows<double>(target[i], source[i], rowIndex, rows);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			moveRows<QString>(target[i], source[i], rowIndex, rows);
+			break;
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::DateTime:
+			moveRows<QDateTime>(target[i], source[i], rowIndex, rows);
+			break;
+		}
+	}
+	m_index = parser.m_index;
+
+	return finishReading(rowIndex + rows, keepNRows, columnImportMode);
+}
+
+/*!
+ * initializes the filter and the data containers if not done yet and reserves the rows for the new data.
+ * \p rowIndex is set to the first row to be read in the data containers.
+ */
+Status AsciiFilterPrivate::prepareReading(QIODevice& device,
+										  AbstractFileFilter::ImportMode columnImportMode,
+										  AbstractFileFilter::ImportMode rowImportMode,
+										  qint64 keepNRows,
+										  int& rowIndex) {
 	bool ok;
 	if (!initialized) {
 		const auto status = initialize(device);
@@ -826,6 +1075,26 @@ Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 		return Status::NotEnoughMemory();
 	}
 
+	// the timestamps are additionally kept with nanosecond resolution when the data is imported completely into a spreadsheet,
+	// live data sources modify the imported data afterwards (see Spreadsheet::finalizeImport())
+	m_nanoseconds.clear();
+	if (dataContainerStartIndex == 0 && keepNRows == 0 && m_dataSource && m_dataSource->type() == AspectType::Spreadsheet) {
+		for (int i = 0; i < properties.dataTypes.size(); ++i) {
+			const auto type = properties.dataTypes.at(i);
+			if (type == AsciiFilter::DataType::TimestampUnix || type == AsciiFilter::DataType::TimestampWindows)
+				m_nanoseconds[i] = QVector<qint64>();
+		}
+	}
+
+	rowIndex = dataContainerStartIndex;
+	return Status::Success();
+}
+
+/*!
+ * reads the lines of \p device starting at the position \p from into the data containers starting at the row \p rowIndex.
+ * At most \p lines rows are read if \p lines is not negative. \p rowIndex is set to the row after the last row read.
+ */
+Status AsciiFilterPrivate::readRows(QIODevice& device, qint64 from, qint64 lines, int& rowIndex, qint64& bytes_read, bool skipFirstLine) {
 	auto handleError = [this](Status status) {
 		setLastError(status);
 		m_DataContainer.resize(0);
@@ -852,7 +1121,7 @@ Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 
 	int counter = 0;
 	int startDataRow = 1;
-	int rowIndex = dataContainerStartIndex;
+	const int dataContainerStartIndex = rowIndex;
 	const size_t columnCountExpected = m_DataContainer.size() - properties.createIndex - properties.createTimestamp;
 	QVector<QStringView> columnValues(columnCountExpected);
 	const auto separatorLength = properties.separator.size();
@@ -929,11 +1198,20 @@ Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 					Q_EMIT q->completed(static_cast<int>(value));
 				}
 			}
-			QApplication::processEvents(QEventLoop::AllEvents, 0);
+			if (processEvents)
+				QApplication::processEvents(QEventLoop::AllEvents, 0);
 		}
 
 	} while (true);
 
+	return Status::Success();
+}
+
+/*!
+ * keeps the last \p keepNRows rows if \p keepNRows is positive, resizes the data containers to the rows read
+ * and finalizes the import into the data source.
+ */
+Status AsciiFilterPrivate::finishReading(int rowIndex, qint64 keepNRows, AbstractFileFilter::ImportMode columnImportMode) {
 	int removedRows = rowIndex - keepNRows;
 	if (keepNRows > 0 && removedRows > 0) {
 		// Just keep the last n rows
@@ -942,9 +1220,33 @@ Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 	} else
 		m_DataContainer.resize(rowIndex);
 
+	// determine the columns of the timestamps with a resolution below milliseconds before the columns are finalized
+	QVector<QPair<Column*, QVector<qint64>>> nanosecondColumns;
+	for (auto it = m_nanoseconds.begin(); it != m_nanoseconds.end(); ++it) {
+		it->resize(rowIndex);
+		const bool subMSecs = std::any_of(it->cbegin(), it->cend(), [](qint64 nsecs) {
+			return nsecs != DateTimeValues::invalid && nsecs % DateTimeValues::nsecsPerMSec != 0;
+		});
+		if (!subMSecs)
+			continue;
+
+		const void* data = m_DataContainer.datas(it.key());
+		for (auto* column : m_dataSource->children<Column>()) {
+			if (column->data() == data) {
+				nanosecondColumns << qMakePair(column, *it);
+				break;
+			}
+		}
+	}
+	m_nanoseconds.clear();
+
 	QDEBUG("column name = " << properties.columnNames)
 	DEBUG("CALLING finalizeImport with " << properties.columnNames.size() - 1)
 	m_dataSource->finalizeImport(0, 0, properties.columnNames.size() - 1, properties.dateTimeFormat, columnImportMode);
+
+	for (const auto& nanosecondColumn : std::as_const(nanosecondColumns))
+		nanosecondColumn.first->setDateTimeNSecs(nanosecondColumn.second);
+
 	return Status::Success();
 }
 
@@ -991,31 +1293,36 @@ void AsciiFilterPrivate::setValues(const QVector<T>& values, int rowIndex, const
 			break;
 		}
 		case AsciiFilter::DataType::TimestampUnix: {
-			// Unix epoch: seconds since January 1, 1970, 00:00:00 UTC
-			qint64 timestamp = props.locale.toLongLong(value, &conversionOk);
+			// Unix epoch: seconds (with an optional fraction) since January 1, 1970, 00:00:00 UTC
+			qint64 nsecs;
 			QDateTime dt;
-			if (conversionOk) {
-				dt = QDateTime::fromSecsSinceEpoch(timestamp, Qt::UTC);
+			if (unixTimestampNSecs(value, props.locale, nsecs)) {
+				dt = QDateTime::fromMSecsSinceEpoch(DateTimeValues::toMSecs(nsecs), Qt::UTC);
 			} else {
+				nsecs = DateTimeValues::invalid;
 				dt = QDateTime(); // Invalid datetime
 			}
 			m_DataContainer.setData(columnIndex, rowIndex, dt);
+			setNanoseconds(columnIndex, rowIndex, nsecs);
 			break;
 		}
 		case AsciiFilter::DataType::TimestampWindows: {
 			// Windows epoch: 100-nanosecond intervals since January 1, 1601, 00:00:00 UTC
 			qint64 timestamp = props.locale.toLongLong(value, &conversionOk);
+			qint64 nsecs;
 			QDateTime dt;
 			if (conversionOk) {
-				// Convert 100-nanosecond intervals to milliseconds
+				// Convert 100-nanosecond intervals to nanoseconds since the Unix epoch
 				// Windows epoch is 11644473600 seconds before Unix epoch
 				const qint64 windowsToUnixEpochOffset = 11644473600LL;
-				qint64 unixTimestamp = (timestamp / 10000000LL) - windowsToUnixEpochOffset;
-				dt = QDateTime::fromSecsSinceEpoch(unixTimestamp, Qt::UTC);
+				nsecs = (timestamp - windowsToUnixEpochOffset * 10000000LL) * 100;
+				dt = QDateTime::fromMSecsSinceEpoch(DateTimeValues::toMSecs(nsecs), Qt::UTC);
 			} else {
+				nsecs = DateTimeValues::invalid;
 				dt = QDateTime(); // Invalid datetime
 			}
 			m_DataContainer.setData(columnIndex, rowIndex, dt);
+			setNanoseconds(columnIndex, rowIndex, nsecs);
 			break;
 		}
 		}
@@ -1023,6 +1330,17 @@ void AsciiFilterPrivate::setValues(const QVector<T>& values, int rowIndex, const
 	}
 }
 
+//! stores the nanoseconds since epoch \c nsecs of the timestamp column \c columnIndex if they are kept for the current import
+void AsciiFilterPrivate::setNanoseconds(int columnIndex, int rowIndex, qint64 nsecs) {
+	auto it = m_nanoseconds.find(columnIndex);
+	if (it == m_nanoseconds.end())
+		return;
+
+	if (it->size() <= rowIndex)
+		it->resize(m_DataContainer.rowCount());
+	(*it)[rowIndex] = nsecs;
+}
+
 QStringList AsciiFilterPrivate::determineColumnsSimplifyWhiteSpace(const QStringView& line, const AsciiFilter::Properties& properties) {
 	return determineColumnsSimplifyWhiteSpace(line,
 											  properties.separator,
@@ -1496,7 +1814,7 @@ QVector<QStringList> AsciiFilterPrivate::preview(QIODevice& device, int lines, b
 
 Status AsciiFilterPrivate::setLastError(Status status) {
 	lastStatus = status;
-	if (!status.success())
+	if (!status.success() && q)
 		q->setLastError(status.message());
 	return status;
 }
@@ -1715,6 +2033,10 @@ qsizetype AsciiFilterPrivate::DataContainer::size() const {
 	return m_dataContainer.size();
 }
 
+const QVector<AbstractColumn::ColumnMode> AsciiFilterPrivate::DataContainer::columnModes() const {
+	return m_columnModes;
+}
+
 void AsciiFilterPrivate::DataContainer::clear() {
 	for (uint i = 0; i < m_dataContainer.size(); i++) {
 		switch (m_columnModes.at(i)) {
@@ -1727,11 +2049,13 @@ void AsciiFilterPrivate::DataContainer::clear() {
 		case AbstractColumn::ColumnMode::Double:
 			delete static_cast<QVector<double>*>(m_dataContainer[i]);
 			break;
-		// TODO: implement missing cases
 		case AbstractColumn::ColumnMode::Text:
+			delete static_cast<QVector<QString>*>(m_dataContainer[i]);
+			break;
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime:
+			delete static_cast<QVector<QDateTime>*>(m_dataContainer[i]);
 			break;
 		}
 	}
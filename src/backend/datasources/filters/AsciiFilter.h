@@ -67,6 +67,14 @@ public:
 						  qint64 lines,
 						  qint64 keepNRows = 0,
 						  bool skipFirstLine = false);
+	qint64 readFromBuffers(const QVector<QByteArray>& buffers, ImportMode columnImportMode, ImportMode rowImportMode, qint64 keepNRows = 0);
+
+	// parsing of buffers in a worker thread, the parsed data is appended to the data source in the GUI thread afterwards
+	struct ParsedData;
+	std::shared_ptr<ParsedData> prepareParsing(const QVector<QByteArray>& buffers) const;
+	static void parse(ParsedData&);
+	qint64 appendParsedData(ParsedData&, ImportMode columnImportMode, ImportMode rowImportMode, qint64 keepNRows = 0);
+
 	void write(const QString& fileName, AbstractDataSource*) override;
 	QVector<QStringList> preview(QIODevice& device, int lines, bool reinit = true, bool skipFirstLine = false);
 	QVector<QStringList> preview(const QString& fileName, int lines, bool reinit = true);
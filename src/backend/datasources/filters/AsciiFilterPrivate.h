@@ -12,6 +12,7 @@
 
 #include "AsciiFilter.h"
 #include "FilterStatus.h"
+#include <QMap>
 #include <QString>
 
 struct Status;
@@ -30,6 +31,18 @@ public:
 						  qint64 keepNRows,
 						  qint64& bytes_read,
 						  bool skipFirstLine = false);
+	Status readFromBuffers(const QVector<QByteArray>&,
+						   AbstractFileFilter::ImportMode columnImportMode,
+						   AbstractFileFilter::ImportMode rowImportMode,
+						   qint64 keepNRows,
+						   qint64& bytes_read);
+	Status parseBuffers(const QVector<QByteArray>&, int& rowIndex, qint64& bytes_read);
+	Status appendParsedData(AsciiFilterPrivate& parser,
+							int rows,
+							AbstractFileFilter::ImportMode columnImportMode,
+							AbstractFileFilter::ImportMode rowImportMode,
+							qint64 keepNRows);
+	bool canAppendParsedData(const AsciiFilterPrivate& parser) const;
 	QVector<QStringList> preview(QIODevice&, int lines, bool reinit = true, bool skipFirstLine = false);
 	QVector<QStringList> preview(const QString& fileName, int lines, bool reinit = true);
 
@@ -41,6 +54,7 @@ public:
 
 	AsciiFilter::Properties properties;
 	bool initialized{false};
+	bool processEvents{true}; // disabled when parsing in a worker thread
 	size_t fileNumberLines{0};
 
 private:
@@ -60,9 +74,17 @@ private:
 								   QVector<QStringView>& columnValues);
 	static Status determineSeparator(const QString& line, bool removeQuotes, bool simplifyWhiteSpaces, QString& separator);
 	Status getLine(QIODevice&, QString& line);
+	Status prepareReading(QIODevice&,
+						  AbstractFileFilter::ImportMode columnImportMode,
+						  AbstractFileFilter::ImportMode rowImportMode,
+						  qint64 keepNRows,
+						  int& rowIndex);
+	Status readRows(QIODevice&, qint64 from, qint64 lines, int& rowIndex, qint64& bytes_read, bool skipFirstLine = false);
+	Status finishReading(int rowIndex, qint64 keepNRows, AbstractFileFilter::ImportMode columnImportMode);
 
 	template<typename T>
 	void setValues(const QVector<T>& values, int rowIndex, const AsciiFilter::Properties&);
+	void setNanoseconds(int columnIndex, int rowIndex, qint64 nsecs);
 
 	// Copied from CANFilterPrivate
 	// TODO: think about moving it to a common place
@@ -119,6 +141,8 @@ private:
 	};
 
 	DataContainer m_DataContainer;
+	// nanoseconds since epoch of the timestamp columns (column index -> values), used if the timestamps have a resolution below milliseconds
+	QMap<int, QVector<qint64>> m_nanoseconds;
 	qint64 m_index{1}; // Index counter used when a index column was prepended
 	Status lastStatus;
 	AbstractDataSource* m_dataSource{nullptr};
@@ -129,6 +153,22 @@ private:
 	qsizetype numberRowsReallocation = 10000; // When importing new data reallocate that amount of rows. So not for every row it must be reallocated
 
 	friend class AsciiFilterTest;
+	friend struct AsciiFilter::ParsedData;
+};
+
+/*!
+ * data parsed by AsciiFilter::parse(). \c parser is a copy of the filter's settings
+ * that reads into its own data containers instead of the columns of the data source.
+ */
+struct AsciiFilter::ParsedData {
+	ParsedData(const AsciiFilterPrivate&, const QVector<QByteArray>&);
+	~ParsedData();
+
+	QVector<QByteArray> buffers;
+	AsciiFilterPrivate parser;
+	int rows{0};
+	qint64 bytes{0};
+	Status status{Status::Success()};
 };
 
 #endif // ASCIIFILTERPRIVATE_H
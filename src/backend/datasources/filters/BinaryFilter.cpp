@@ -13,29 +13,18 @@
 #include "backend/datasources/filters/BinaryFilterPrivate.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
 
 #include <KCompressionDevice>
 #include <KLocalizedString>
 #include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrentMap>
 #include <QtEndian>
-#include <array>
 
-#define IMPORT_DATA(DATATYPE, TARGETTYPE)                                                                                                                      \
-	{                                                                                                                                                          \
-		DATATYPE value;                                                                                                                                        \
-		for (int n = startColumn; n < m_actualCols; ++n) {                                                                                                     \
-			for (size_t l = 0; l < std::min(readLines, mNumberLines); l++) {                                                                                   \
-				const size_t lineNumber = l * lineBytes;                                                                                                       \
-				const size_t index = lineNumber + (n - startColumn) * typeSize;                                                                                \
-				if (byteOrder == QDataStream::BigEndian)                                                                                                       \
-					value = qFromBigEndian<DATATYPE>(&binary[index]);                                                                                          \
-				else                                                                                                                                           \
-					value = qFromLittleEndian<DATATYPE>(&binary[index]);                                                                                       \
-				/*DEBUG("column = " << n << ", index = " << index << ", value = " << value)*/                                                                  \
-				(*static_cast<QVector<TARGETTYPE>*>(dataContainer[n]))[i * mNumberLines + l] = value;                                                          \
-			}                                                                                                                                                  \
-		}                                                                                                                                                      \
-	}
+#include <algorithm>
+#include <array>
 
 /*!
 \class BinaryFilter
@@ -64,6 +53,14 @@ void BinaryFilter::readDataFromDevice(QIODevice& device, AbstractDataSource* dat
 	d->readDataFromDevice(device, dataSource, importMode, lines);
 }
 
+/*!
+  reads the records appended to the live device \c device since the position \c from and appends them to \c dataSource.
+  Returns the number of bytes read.
+*/
+qint64 BinaryFilter::readFromLiveDevice(QIODevice& device, AbstractDataSource* dataSource, qint64 from, int lines, int keepNRows) {
+	return d->readFromLiveDevice(device, dataSource, from, lines, keepNRows);
+}
+
 QVector<QStringList> BinaryFilter::preview(const QString& fileName, int lines) {
 	return d->preview(fileName, lines);
 }
@@ -100,21 +97,10 @@ int BinaryFilter::dataSize(BinaryFilter::DataType type) {
   returns the number of rows (length of vectors) in the file \c fileName.
 */
 size_t BinaryFilter::rowNumber(const QString& fileName, const size_t vectors, const BinaryFilter::DataType type, const size_t maxRows) {
-	KCompressionDevice device(fileName);
-	if (!device.open(QIODevice::ReadOnly))
-		return 0;
-
-	// size() and bytesAvailable() return 0 and data may be compressed. Need to read the file once
-	size_t rows = 0;
-	while (!device.atEnd()) {
-		if (rows >= maxRows) // stop when maxRows available
-			return rows;
-		// one row
-		device.read(BinaryFilter::dataSize(type) * vectors);
-		rows++;
-	}
-
-	return rows;
+	BinaryFilter filter;
+	filter.setVectors(vectors);
+	filter.setDataType(type);
+	return filter.d->rowNumber(fileName, maxRows);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -179,6 +165,25 @@ void BinaryFilter::setCreateIndexEnabled(bool b) {
 	d->createIndexEnabled = b;
 }
 
+/*!
+ * sets the layout of the records in the file to the fields \c fields, every field is imported into one column.
+ * The fields can have different data types and byte orders. \c recordSize is the size of the records in bytes
+ * including the padding after the last field, the end of the last field is used if it's smaller.
+ * If \c fields is empty, the records consist of vectors() values of dataType() each followed by skipBytes() bytes.
+ */
+void BinaryFilter::setRecordLayout(const QVector<BinaryFilter::Field>& fields, size_t recordSize) {
+	d->fields = fields;
+	d->recordSize = recordSize;
+}
+
+QVector<BinaryFilter::Field> BinaryFilter::recordLayout() const {
+	return d->layout();
+}
+
+size_t BinaryFilter::recordSize() const {
+	return d->layoutRecordSize();
+}
+
 void BinaryFilter::setAutoModeEnabled(bool b) {
 	d->autoModeEnabled = b;
 }
@@ -198,19 +203,320 @@ QString BinaryFilter::fileInfoString(const QString& /*fileName*/) {
 // ################### Private implementation ##########################
 // #####################################################################
 
+namespace {
+// size of the chunks of records that are converted in parallel
+constexpr size_t chunkBytes = 1 << 20;
+
+AbstractColumn::ColumnMode columnMode(BinaryFilter::DataType type) {
+	switch (type) {
+	case BinaryFilter::DataType::INT8:
+	case BinaryFilter::DataType::INT16:
+	case BinaryFilter::DataType::INT32:
+	case BinaryFilter::DataType::UINT8:
+	case BinaryFilter::DataType::UINT16:
+		return AbstractColumn::ColumnMode::Integer;
+	case BinaryFilter::DataType::UINT32:
+	case BinaryFilter::DataType::INT64:
+		return AbstractColumn::ColumnMode::BigInt;
+	case BinaryFilter::DataType::UINT64:
+	case BinaryFilter::DataType::REAL32:
+	case BinaryFilter::DataType::REAL64:
+		break;
+	}
+	return AbstractColumn::ColumnMode::Double;
+}
+
+// returns the pointer to the values of the column data \c container for the values of the data type \c type
+void* columnData(void* container, BinaryFilter::DataType type) {
+	switch (columnMode(type)) {
+	case AbstractColumn::ColumnMode::Integer:
+		return static_cast<QVector<int>*>(container)->data();
+	case AbstractColumn::ColumnMode::BigInt:
+		return static_cast<QVector<qint64>*>(container)->data();
+	default:
+		return static_cast<QVector<double>*>(container)->data();
+	}
+}
+
+// removes the first \c removed rows of the column data \c container and resizes it to \c rows rows
+template<typename T>
+void resizeRows(void* container, int removed, int rows) {
+	auto* vector = static_cast<QVector<T>*>(container);
+	if (removed > 0)
+		vector->remove(0, removed);
+	vector->resize(rows);
+}
+
+void resizeRows(void* container, AbstractColumn::ColumnMode mode, int removed, int rows) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Integer:
+		resizeRows<int>(container, removed, rows);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		resizeRows<qint64>(container, removed, rows);
+		break;
+	default:
+		resizeRows<double>(container, removed, rows);
+	}
+}
+
+/*!
+ * converts the values of the type T at \c data in \c count records of \c stride bytes to the values starting at \c row in \c target.
+ * The loops have no branches and a fixed value size so that the compiler can vectorize the byte swapping and the conversion.
+ */
+template<typename T, typename Target>
+void convert(const char* data, size_t stride, size_t count, bool bigEndian, void* target, size_t row) {
+	auto* values = static_cast<Target*>(target) + row;
+	if (bigEndian) {
+		for (size_t i = 0; i < count; ++i)
+			values[i] = static_cast<Target>(qFromBigEndian<T>(data + i * stride));
+	} else {
+		for (size_t i = 0; i < count; ++i)
+			values[i] = static_cast<Target>(qFromLittleEndian<T>(data + i * stride));
+	}
+}
+
+// converts the field \c field of \c count records of \c stride bytes at \c records to the column values \c target starting at \c row
+void convertField(const char* records, size_t stride, size_t count, const BinaryFilter::Field& field, void* target, size_t row) {
+	const char* data = records + field.offset;
+	const bool bigEndian = (field.byteOrder == QDataStream::BigEndian);
+	switch (field.type) {
+	case BinaryFilter::DataType::INT8:
+		convert<qint8, int>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::INT16:
+		convert<qint16, int>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::INT32:
+		convert<qint32, int>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::INT64:
+		convert<qint64, qint64>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::UINT8:
+		convert<quint8, int>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::UINT16:
+		convert<quint16, int>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::UINT32:
+		convert<quint32, qint64>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::UINT64:
+		convert<quint64, double>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::REAL32:
+		convert<float, double>(data, stride, count, bigEndian, target, row);
+		break;
+	case BinaryFilter::DataType::REAL64:
+		convert<double, double>(data, stride, count, bigEndian, target, row);
+		break;
+	}
+}
+
+template<typename T>
+QString valueString(const char* data, bool bigEndian) {
+	return QString::number(bigEndian ? qFromBigEndian<T>(data) : qFromLittleEndian<T>(data));
+}
+
+// returns the value of the field \c field in the record \c record as string for the preview
+QString fieldString(const char* record, const BinaryFilter::Field& field) {
+	const char* data = record + field.offset;
+	const bool bigEndian = (field.byteOrder == QDataStream::BigEndian);
+	switch (field.type) {
+	case BinaryFilter::DataType::INT8:
+		return valueString<qint8>(data, bigEndian);
+	case BinaryFilter::DataType::INT16:
+		return valueString<qint16>(data, bigEndian);
+	case BinaryFilter::DataType::INT32:
+		return valueString<qint32>(data, bigEndian);
+	case BinaryFilter::DataType::INT64:
+		return valueString<qint64>(data, bigEndian);
+	case BinaryFilter::DataType::UINT8:
+		return valueString<quint8>(data, bigEndian);
+	case BinaryFilter::DataType::UINT16:
+		return valueString<quint16>(data, bigEndian);
+	case BinaryFilter::DataType::UINT32:
+		return valueString<quint32>(data, bigEndian);
+	case BinaryFilter::DataType::UINT64:
+		return valueString<quint64>(data, bigEndian);
+	case BinaryFilter::DataType::REAL32:
+		return valueString<float>(data, bigEndian);
+	case BinaryFilter::DataType::REAL64:
+		return valueString<double>(data, bigEndian);
+	}
+	return {};
+}
+}
+
 BinaryFilterPrivate::BinaryFilterPrivate(BinaryFilter* owner)
 	: q(owner) {
 }
 
 /*!
-	reads the content of the device \c device to the data source \c dataSource or return as string for preview.
-	Uses the settings defined in the data source.
+ * returns the fields of the records, \c vectors values of the type \c dataType each followed by \c skipBytes bytes
+ * if no record layout was set.
+ */
+QVector<BinaryFilter::Field> BinaryFilterPrivate::layout() const {
+	if (!fields.isEmpty())
+		return fields;
+
+	QVector<BinaryFilter::Field> layout;
+	const size_t size = BinaryFilter::dataSize(dataType) + skipBytes;
+	for (size_t i = 0; i < vectors; ++i)
+		layout << BinaryFilter::Field{dataType, i * size, byteOrder};
+	return layout;
+}
+
+//! returns the size of the records in bytes
+size_t BinaryFilterPrivate::layoutRecordSize() const {
+	if (fields.isEmpty())
+		return vectors * (BinaryFilter::dataSize(dataType) + skipBytes);
+
+	size_t size = recordSize;
+	for (const auto& field : fields)
+		size = std::max(size, field.offset + BinaryFilter::dataSize(field.type));
+	return size;
+}
+
+/*!
+ * returns the number of complete records after the first \c skipStartBytes bytes of the file \c fileName.
+ * The size of uncompressed files is known, compressed files are read once.
+ */
+size_t BinaryFilterPrivate::rowNumber(const QString& fileName, size_t maxRows) const {
+	const size_t recordBytes = layoutRecordSize();
+	KCompressionDevice device(fileName);
+	if (recordBytes == 0 || !device.open(QIODevice::ReadOnly))
+		return 0;
+
+	size_t size = 0;
+	if (device.compressionType() == KCompressionDevice::None)
+		size = QFileInfo(fileName).size();
+	else {
+		// size() is not available for compressed data
+		const size_t maxSize = maxRows < (std::numeric_limits<size_t>::max() - skipStartBytes) / recordBytes ? skipStartBytes + maxRows * recordBytes
+																												: std::numeric_limits<size_t>::max();
+		std::vector<char> buffer(chunkBytes);
+		while (size < maxSize) {
+			const qint64 bytes = device.read(buffer.data(), buffer.size());
+			if (bytes <= 0)
+				break;
+			size += bytes;
+		}
+	}
+
+	if (size <= skipStartBytes)
+		return 0;
+	return std::min(maxRows, (size - skipStartBytes) / recordBytes);
+}
+
+/*!
+ * determines the rows and columns to read out of \c numRows, \c startRow and \c endRow.
+ * Returns \c false if the selection is empty.
+ */
+bool BinaryFilterPrivate::selectRows() {
+	const size_t rows = std::min(numRows, static_cast<size_t>(std::numeric_limits<int>::max()));
+	const size_t first = std::max(startRow, 1);
+	const size_t last = (endRow < 0 || static_cast<size_t>(endRow) > rows) ? rows : endRow;
+	if (first > last)
+		return false;
+
+	m_actualRows = static_cast<int>(last - first + 1);
+	m_actualCols = layout().size();
+
+	DEBUG("numRows = " << numRows);
+	DEBUG("endRow = " << endRow);
+	DEBUG("actual rows = " << m_actualRows);
+	DEBUG("actual cols = " << m_actualCols);
+
+	return m_actualCols > 0;
+}
+
+/*!
+ * skips the bytes at the start and the records before the start row in \c device.
+ * Returns \c false if the device ends before.
+ */
+bool BinaryFilterPrivate::skipToStartRow(QIODevice& device) const {
+	const qint64 bytes = skipStartBytes + static_cast<qint64>(std::max(startRow, 1) - 1) * layoutRecordSize();
+	return device.skip(bytes) == bytes;
+}
+
+/*!
+ * prepares the columns of \c dataSource for \c m_actualRows rows of the fields of the record layout and creates the index column if enabled.
+ * Returns the column offset or -1 if the columns couldn't be allocated.
+ */
+int BinaryFilterPrivate::prepareImport(AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, std::vector<void*>& dataContainer) {
+	// TODO: use given names
+	QStringList vectorNames;
+	columnModes.clear();
+	if (createIndexEnabled) {
+		vectorNames << i18n("Index");
+		columnModes << AbstractColumn::ColumnMode::Integer;
+	}
+	for (const auto& field : layout())
+		columnModes << columnMode(field.type);
+
+	bool ok = false;
+	const int columnOffset = dataSource->prepareImport(dataContainer, importMode, m_actualRows, columnModes.size(), vectorNames, columnModes, ok);
+	if (!ok) {
+		q->setLastError(i18n("Not enough memory."));
+		return -1;
+	}
+
+	if (createIndexEnabled) {
+		auto* index = static_cast<QVector<int>*>(dataContainer[0]);
+		for (int i = 0; i < m_actualRows; ++i)
+			(*index)[i] = i + 1;
+	}
+
+	return columnOffset;
+}
+
+/*!
+ * de-interleaves the fields of \c count records at \c records into the rows starting at \c row of the columns in \c dataContainer.
+ * Large blocks of records are split into chunks that are converted in parallel.
+ */
+void BinaryFilterPrivate::importRecords(const char* records, size_t count, size_t row, const std::vector<void*>& dataContainer) const {
+	const auto& fields = layout();
+	const size_t stride = layoutRecordSize();
+	const int startColumn = createIndexEnabled ? 1 : 0;
+
+	std::vector<void*> targets(fields.size());
+	for (int i = 0; i < fields.size(); ++i)
+		targets[i] = columnData(dataContainer[startColumn + i], fields.at(i).type);
+
+	// all fields of a chunk are converted one after another while the chunk is in the cache
+	auto convertChunk = [&](size_t first, size_t rows) {
+		for (int i = 0; i < fields.size(); ++i)
+			convertField(records + first * stride, stride, rows, fields.at(i), targets[i], row + first);
+	};
+
+	const size_t chunkRows = std::max<size_t>(1, chunkBytes / stride);
+	if (count <= chunkRows) {
+		convertChunk(0, count);
+		return;
+	}
+
+	QVector<size_t> chunks;
+	for (size_t first = 0; first < count; first += chunkRows)
+		chunks << first;
+	QtConcurrent::blockingMap(chunks, [&](size_t first) {
+		convertChunk(first, std::min(chunkRows, count - first));
+	});
+}
+
+/*!
+	reads the content of the file \c fileName to the data source \c dataSource.
+	Uncompressed files are read from the memory mapped file, compressed files are decompressed on the fly.
 */
 void BinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	DEBUG(Q_FUNC_INFO);
 
+	if (readDataFromMappedFile(fileName, dataSource, importMode))
+		return;
+
 	KCompressionDevice device(fileName);
-	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType);
+	numRows = rowNumber(fileName);
 
 	if (!device.open(QIODevice::ReadOnly)) {
 		DEBUG("	could not open file " << STDSTRING(fileName));
@@ -220,46 +526,114 @@ void BinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractData
 }
 
 /*!
- * returns 1 if the current read position in the device is at the end and 0 otherwise.
+ * imports the selected records of the uncompressed file \c fileName directly out of the memory mapped file:
+ * the start row is accessed without reading the records before it and the fields are converted without copying the file content.
+ * Returns \c false if the file is compressed or can't be mapped.
  */
-int BinaryFilterPrivate::prepareStreamToRead(QDataStream& in) {
-	DEBUG(Q_FUNC_INFO);
+bool BinaryFilterPrivate::readDataFromMappedFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	{
+		KCompressionDevice device(fileName);
+		if (!device.open(QIODevice::ReadOnly) || device.compressionType() != KCompressionDevice::None)
+			return false;
+	}
+
+	QFile file(fileName);
+	const size_t recordBytes = layoutRecordSize();
+	if (recordBytes == 0 || !file.open(QIODevice::ReadOnly) || static_cast<size_t>(file.size()) <= skipStartBytes)
+		return false;
 
-	in.setByteOrder(byteOrder);
+	numRows = (file.size() - skipStartBytes) / recordBytes;
+	if (!selectRows())
+		return false;
 
-	// catch case that skipStartBytes or startRow is bigger than file
-	if (skipStartBytes >= BinaryFilter::dataSize(dataType) * vectors * numRows || startRow > (int)numRows)
-		return 1;
+	const qint64 offset = skipStartBytes + static_cast<qint64>(std::max(startRow, 1) - 1) * recordBytes;
+	uchar* data = file.map(offset, static_cast<qint64>(m_actualRows) * recordBytes);
+	if (!data)
+		return false;
 
-	// skip bytes at start
-	for (size_t i = 0; i < skipStartBytes; ++i) {
-		qint8 tmp;
-		in >> tmp;
+	std::vector<void*> dataContainer;
+	const int columnOffset = prepareImport(dataSource, importMode, dataContainer);
+	if (columnOffset >= 0) {
+		PERFTRACE(QStringLiteral("binary import, convert memory mapped records"));
+		importRecords(reinterpret_cast<const char*>(data), m_actualRows, 0, dataContainer);
 	}
+	file.unmap(data);
 
-	// skip until start row
-	for (size_t i = 0; i < (startRow - 1) * vectors; ++i) {
-		for (int j = 0; j < BinaryFilter::dataSize(dataType); ++j) {
-			qint8 tmp;
-			in >> tmp;
+	if (columnOffset >= 0)
+		dataSource->finalizeImport(columnOffset, 1, columnModes.size(), QString(), importMode);
+	return true;
+}
+
+/*!
+ * reads the complete records appended to the live device \c device since the position \c from (the number of bytes read before)
+ * and appends them to the columns of \c dataSource, at most \c lines records if \c lines is not negative.
+ * The first read (\c from is 0) skips the start bytes and the rows before the start row and replaces the columns.
+ * Only the last \c keepNRows rows are kept if \c keepNRows is positive. Incomplete records are read with the next call.
+ * Returns the number of bytes read including the skipped bytes.
+ */
+qint64 BinaryFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSource* dataSource, qint64 from, int lines, int keepNRows) {
+	const size_t recordBytes = layoutRecordSize();
+	if (recordBytes == 0 || (!device.isOpen() && !device.open(QIODevice::ReadOnly)))
+		return 0;
+
+	const qint64 skipped = (from == 0) ? skipStartBytes + static_cast<qint64>(std::max(startRow, 1) - 1) * recordBytes : 0;
+	qint64 available = 0;
+	if (device.isSequential()) {
+		if (skipped > 0 && device.skip(skipped) != skipped)
+			return 0;
+		available = device.bytesAvailable();
+	} else {
+		if (device.size() < from + skipped || !device.seek(from + skipped))
+			return 0;
+		available = device.size() - from - skipped;
+	}
+
+	qint64 records = available / static_cast<qint64>(recordBytes);
+	if (lines >= 0)
+		records = std::min(records, static_cast<qint64>(lines));
+	records = std::min(records, static_cast<qint64>(std::numeric_limits<int>::max()));
+	const QByteArray data = device.read(records * recordBytes);
+	const int count = static_cast<int>(data.size() / static_cast<qint64>(recordBytes));
+	if (count == 0)
+		return 0;
+
+	const int columnCount = layout().size() + (createIndexEnabled ? 1 : 0);
+	const auto& columns = dataSource->children<Column>();
+	std::vector<void*> dataContainer;
+	int row = 0;
+	if (from == 0 || columns.size() != columnCount) {
+		// first read, create the columns
+		m_actualRows = count;
+		m_actualCols = layout().size();
+		if (prepareImport(dataSource, AbstractFileFilter::ImportMode::Replace, dataContainer) < 0)
+			return 0;
+	} else {
+		// append the records to the data containers of the columns
+		row = columns.constFirst()->rowCount();
+		for (auto* column : columns) {
+			dataContainer.push_back(column->data());
+			resizeRows(column->data(), column->columnMode(), 0, row + count);
+		}
+		if (createIndexEnabled) {
+			auto* index = static_cast<QVector<int>*>(dataContainer[0]);
+			const int last = (row > 0) ? index->at(row - 1) : 0;
+			for (int i = 0; i < count; ++i)
+				(*index)[row + i] = last + i + 1;
 		}
 	}
 
-	// set range of rows
-	if (endRow == -1)
-		m_actualRows = (int)numRows - startRow + 1;
-	else if (endRow > (int)numRows - startRow + 1)
-		m_actualRows = (int)numRows;
-	else
-		m_actualRows = endRow - startRow + 1;
-	m_actualCols = (int)vectors;
+	importRecords(data.constData(), count, row, dataContainer);
 
-	DEBUG("numRows = " << numRows);
-	DEBUG("endRow = " << endRow);
-	DEBUG("actual rows = " << m_actualRows);
-	DEBUG("actual cols = " << m_actualCols);
+	// keep the last keepNRows rows only
+	const int rows = row + count;
+	if (keepNRows > 0 && rows > keepNRows) {
+		const auto& newColumns = dataSource->children<Column>();
+		for (int i = 0; i < columnCount; ++i)
+			resizeRows(dataContainer[i], newColumns.at(i)->columnMode(), rows - keepNRows, keepNRows);
+	}
 
-	return 0;
+	dataSource->finalizeImport(0, 1, columnCount, QString(), AbstractFileFilter::ImportMode::Replace);
+	return skipped + static_cast<qint64>(count) * recordBytes;
 }
 
 /*!
@@ -274,251 +648,98 @@ QVector<QStringList> BinaryFilterPrivate::preview(const QString& fileName, int l
 		return {};
 	}
 
-	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType, lines);
-
-	QDataStream in(&device);
-	const int deviceError = prepareStreamToRead(in);
-
-	if (deviceError) {
+	const size_t first = std::max(startRow, 1);
+	numRows = rowNumber(fileName, lines < 0 ? std::numeric_limits<size_t>::max() : first - 1 + lines);
+	const bool selected = selectRows() && skipToStartRow(device);
+	numRows = 0;
+	if (!selected) {
 		q->setLastError(i18n("Data selection empty."));
 		return {};
 	}
 
-	// all columns as double is ok for preview
-	columnModes.resize(m_actualCols);
-
-	// TODO: use given names
-	QStringList vectorNames;
-	if (createIndexEnabled)
-		vectorNames.prepend(i18n("Index"));
-
+	// read data
 	if (lines == -1)
 		lines = m_actualRows;
-
-	// read data
 	lines = std::min(lines, m_actualRows);
 	DEBUG(Q_FUNC_INFO << ", generating preview for " << lines << " lines")
-	int progressIndex = 0;
-	const qreal progressInterval = 0.01 * lines; // update on every 1% only
+
+	const auto& fields = layout();
+	const size_t recordBytes = layoutRecordSize();
+	const QByteArray data = device.read(static_cast<qint64>(lines) * recordBytes);
+	lines = data.size() / recordBytes;
 
 	QVector<QStringList> dataStrings;
 	for (int i = 0; i < lines; ++i) {
+		const char* record = data.constData() + i * recordBytes;
 		QStringList lineString;
 
 		// prepend the index if required
 		if (createIndexEnabled)
 			lineString << QString::number(i + 1);
 
-		for (int n = 0; n < m_actualCols; ++n) {
-			switch (dataType) {
-			case BinaryFilter::DataType::INT8: {
-				qint8 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::INT16: {
-				qint16 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::INT32: {
-				qint32 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::INT64: {
-				qint64 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::UINT8: {
-				quint8 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::UINT16: {
-				quint16 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::UINT32: {
-				quint32 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::UINT64: {
-				quint64 value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::REAL32: {
-				float value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			case BinaryFilter::DataType::REAL64: {
-				double value;
-				in >> value;
-				lineString << QString::number(value);
-				break;
-			}
-			}
-		}
+		for (const auto& field : fields)
+			lineString << fieldString(record, field);
 		dataStrings << lineString;
-
-		// ask to update the progress bar only if we have more than 1000 lines
-		// only in 1% steps
-		progressIndex++;
-		if (lines > 1000 && progressIndex > progressInterval) {
-			double value = 100. * i / lines;
-			Q_EMIT q->completed(static_cast<int>(value));
-			progressIndex = 0;
-			QApplication::processEvents(QEventLoop::AllEvents, 0);
-		}
 	}
 
 	return dataStrings;
 }
 
 /*!
-reads the content of the file \c fileName to the data source \c dataSource or return as string for preview.
-Uses the settings defined in the data source.
+reads the content of the device \c device to the data source \c dataSource.
+The number of records \c numRows is determined by the caller for files. If it is not known (e.g. for streams),
+all complete records available in the device are read.
 */
 void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
 	DEBUG(Q_FUNC_INFO);
 
-	QDataStream in(&device);
-	const int deviceError = prepareStreamToRead(in);
-	if (deviceError) {
+	const size_t recordBytes = layoutRecordSize();
+	bool selected = (recordBytes > 0 && skipToStartRow(device));
+	QByteArray buffer;
+	if (selected && numRows == 0) {
+		buffer = device.readAll();
+		numRows = std::max(startRow, 1) - 1 + buffer.size() / recordBytes;
+	}
+	selected = selected && selectRows();
+	numRows = 0; // determined again for the next device
+	if (!selected) {
 		dataSource->clear();
 		DEBUG(Q_FUNC_INFO << ", Device error. Gving up");
 		q->setLastError(i18n("Failed to open the device/file or it's empty."));
 		return;
 	}
 
-	if (createIndexEnabled)
-		m_actualCols++;
-
-	// DEBUG("actual cols = " << m_actualCols)
-	columnModes.resize(m_actualCols);
-	switch (dataType) {
-	case BinaryFilter::DataType::INT8:
-	case BinaryFilter::DataType::INT16:
-	case BinaryFilter::DataType::INT32:
-	case BinaryFilter::DataType::UINT8:
-	case BinaryFilter::DataType::UINT16:
-		columnModes.fill(AbstractColumn::ColumnMode::Integer);
-		break;
-	case BinaryFilter::DataType::UINT32:
-	case BinaryFilter::DataType::INT64:
-		columnModes.fill(AbstractColumn::ColumnMode::BigInt);
-		break;
-	case BinaryFilter::DataType::UINT64:
-	case BinaryFilter::DataType::REAL32:
-	case BinaryFilter::DataType::REAL64:
-		columnModes.fill(AbstractColumn::ColumnMode::Double);
-		break;
-	}
-
-	// TODO: use given names
-	QStringList vectorNames;
-
-	if (createIndexEnabled) {
-		vectorNames.prepend(i18n("Index"));
-		columnModes[0] = AbstractColumn::ColumnMode::Integer;
-	}
+	if (lines >= 0)
+		m_actualRows = std::min(lines, m_actualRows);
 
 	std::vector<void*> dataContainer;
-	bool ok = false;
-	int columnOffset = dataSource->prepareImport(dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes, ok);
-	if (!ok) {
-		q->setLastError(i18n("Not enough memory."));
+	const int columnOffset = prepareImport(dataSource, importMode, dataContainer);
+	if (columnOffset < 0)
 		return;
-	}
 
-	if (lines == -1)
-		lines = m_actualRows;
-
-	int startColumn = 0;
-	if (createIndexEnabled)
-		startColumn++;
+	if (!buffer.isEmpty())
+		importRecords(buffer.constData(), m_actualRows, 0, dataContainer);
+	else {
+		// read and convert chunks of records
+		DEBUG(Q_FUNC_INFO << ", Reading " << m_actualRows << " lines");
+		const size_t chunkRecords = std::max<size_t>(1, 16 * chunkBytes / recordBytes);
+		const size_t rows = m_actualRows;
+		for (size_t row = 0; row < rows; row += chunkRecords) {
+			const size_t count = std::min(chunkRecords, rows - row);
+			const QByteArray ba = device.read(count * recordBytes);
+			const size_t readRecords = ba.size() / recordBytes;
+			importRecords(ba.constData(), readRecords, row, dataContainer);
+			if (readRecords < count)
+				break;
 
-	// read data
-	lines = std::min(lines, m_actualRows);
-	DEBUG(Q_FUNC_INFO << ", Reading " << lines << " lines");
-	int progressIndex = 0;
-	const qreal progressInterval = 0.01 * lines; // update on every 1% only
-
-	// prepend the index if required
-	if (createIndexEnabled)
-		for (int i = 0; i < lines; ++i)
-			static_cast<QVector<int>*>(dataContainer[0])->operator[](i) = i + 1;
-
-	// chunk to read at once
-	const size_t mNumberLines = 100000; // see SpiceReader::mNumberLines
-	const int typeSize = BinaryFilter::dataSize(dataType);
-	const int lineBytes = m_actualCols * typeSize;
-
-	// DEBUG("lines/mNumberLines = " << lines << "/" << mNumberLines << " -> " << lines/mNumberLines + 1)
-	for (size_t i = 0; i <= lines / mNumberLines; ++i) {
-		// DEBUG("reading chunk " << i + 1);
-		const QByteArray ba = device.read(mNumberLines * lineBytes);
-		const char* binary = ba.data();
-		const size_t readLines = (int)(ba.length() / lineBytes);
-		// DEBUG("Read lines " << readLines)
-		switch (dataType) {
-		case BinaryFilter::DataType::INT8:
-			IMPORT_DATA(qint8, int)
-			break;
-		case BinaryFilter::DataType::INT16:
-			IMPORT_DATA(qint16, int)
-			break;
-		case BinaryFilter::DataType::INT32:
-			IMPORT_DATA(qint32, int)
-			break;
-		case BinaryFilter::DataType::INT64:
-			IMPORT_DATA(qint64, qint64)
-			break;
-		case BinaryFilter::DataType::UINT8:
-			IMPORT_DATA(quint8, int)
-			break;
-		case BinaryFilter::DataType::UINT16:
-			IMPORT_DATA(quint16, int)
-			break;
-		case BinaryFilter::DataType::UINT32:
-			IMPORT_DATA(quint32, qint64)
-			break;
-		case BinaryFilter::DataType::UINT64:
-			IMPORT_DATA(quint64, double)
-			break;
-		case BinaryFilter::DataType::REAL32:
-			IMPORT_DATA(float, double)
-			break;
-		case BinaryFilter::DataType::REAL64:
-			IMPORT_DATA(double, double)
-			break;
-		}
-		// ask to update the progress bar only if we have more than 1000 lines
-		// only in 1% steps
-		progressIndex++;
-		if (lines > 1000 && progressIndex > progressInterval) {
-			double value = 100. * i / lines * mNumberLines;
-			Q_EMIT q->completed(static_cast<int>(value));
-			progressIndex = 0;
-			QApplication::processEvents(QEventLoop::AllEvents, 0);
+			if (rows > chunkRecords) {
+				Q_EMIT q->completed(static_cast<int>(100. * (row + count) / rows));
+				QApplication::processEvents(QEventLoop::AllEvents, 0);
+			}
 		}
 	}
 
-	dataSource->finalizeImport(columnOffset, 1, m_actualCols, QString(), importMode);
+	dataSource->finalizeImport(columnOffset, 1, columnModes.size(), QString(), importMode);
 }
 
 /*!
@@ -546,6 +767,14 @@ void BinaryFilter::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("skipStartBytes"), QString::number(d->skipStartBytes));
 	writer->writeAttribute(QStringLiteral("skipBytes"), QString::number(d->skipBytes));
 	writer->writeAttribute(QStringLiteral("createIndex"), QString::number(d->createIndexEnabled));
+	if (!d->fields.isEmpty()) {
+		// record layout as "type offset byteOrder" for every field
+		QStringList fields;
+		for (const auto& field : d->fields)
+			fields << QStringLiteral("%1 %2 %3").arg(static_cast<int>(field.type)).arg(field.offset).arg(static_cast<int>(field.byteOrder));
+		writer->writeAttribute(QStringLiteral("fields"), fields.join(QLatin1Char(';')));
+		writer->writeAttribute(QStringLiteral("recordSize"), QString::number(d->recordSize));
+	}
 	writer->writeEndElement();
 }
 
@@ -610,5 +839,18 @@ bool BinaryFilter::load(XmlStreamReader* reader) {
 	else
 		d->createIndexEnabled = str.toInt();
 
+	// optional record layout
+	d->fields.clear();
+	str = attribs.value(QStringLiteral("fields")).toString();
+	for (const auto& fieldString : str.split(QLatin1Char(';'), Qt::SkipEmptyParts)) {
+		const auto& values = fieldString.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+		if (values.size() != 3)
+			continue;
+		d->fields << BinaryFilter::Field{static_cast<BinaryFilter::DataType>(values.at(0).toInt()),
+										 static_cast<size_t>(values.at(1).toULongLong()),
+										 static_cast<QDataStream::ByteOrder>(values.at(2).toInt())};
+	}
+	d->recordSize = static_cast<size_t>(attribs.value(QStringLiteral("recordSize")).toULongLong());
+
 	return true;
 }
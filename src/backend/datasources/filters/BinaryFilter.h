@@ -11,6 +11,7 @@
 
 #include "backend/datasources/filters/AbstractFileFilter.h"
 #include <QDataStream>
+#include <QVector>
 #include <limits>
 
 class BinaryFilterPrivate;
@@ -29,6 +30,13 @@ public:
 	enum class DataType { INT8, INT16, INT32, INT64, UINT8, UINT16, UINT32, UINT64, REAL32, REAL64 };
 	Q_ENUM(DataType)
 
+	// field of the records in the file, every field is imported into one column
+	struct Field {
+		DataType type{DataType::REAL64};
+		size_t offset{0}; // offset of the field in the record in bytes
+		QDataStream::ByteOrder byteOrder{QDataStream::LittleEndian};
+	};
+
 	BinaryFilter();
 	~BinaryFilter() override;
 
@@ -40,6 +48,7 @@ public:
 	// read data from any device
 	void readDataFromDevice(QIODevice&, AbstractDataSource* = nullptr, ImportMode = ImportMode::Replace, int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource*, ImportMode = ImportMode::Replace) override;
+	qint64 readFromLiveDevice(QIODevice&, AbstractDataSource*, qint64 from, int lines = -1, int keepNRows = 0);
 	void write(const QString& fileName, AbstractDataSource*) override;
 	QVector<QStringList> preview(const QString& fileName, int lines);
 
@@ -59,6 +68,9 @@ public:
 	void setSkipBytes(const size_t);
 	size_t skipBytes() const;
 	void setCreateIndexEnabled(const bool);
+	void setRecordLayout(const QVector<BinaryFilter::Field>&, size_t recordSize = 0);
+	QVector<BinaryFilter::Field> recordLayout() const;
+	size_t recordSize() const;
 
 	void setAutoModeEnabled(const bool);
 	bool isAutoModeEnabled() const;
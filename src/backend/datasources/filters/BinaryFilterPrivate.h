@@ -19,12 +19,18 @@ class BinaryFilterPrivate {
 public:
 	explicit BinaryFilterPrivate(BinaryFilter*);
 
-	int prepareStreamToRead(QDataStream&);
+	QVector<BinaryFilter::Field> layout() const;
+	size_t layoutRecordSize() const;
+	size_t rowNumber(const QString& fileName, size_t maxRows = std::numeric_limits<std::size_t>::max()) const;
+	bool selectRows();
+	bool skipToStartRow(QIODevice&) const;
 	void readDataFromDevice(QIODevice& device,
 							AbstractDataSource* = nullptr,
 							AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 							int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
+	bool readDataFromMappedFile(const QString& fileName, AbstractDataSource*, AbstractFileFilter::ImportMode);
+	qint64 readFromLiveDevice(QIODevice&, AbstractDataSource*, qint64 from, int lines, int keepNRows);
 	void write(const QString& fileName, AbstractDataSource*);
 	QVector<QStringList> preview(const QString& fileName, int lines);
 
@@ -41,10 +47,15 @@ public:
 	size_t skipStartBytes{0}; // bytes to skip at start
 	size_t skipBytes{0}; // bytes to skip after each value
 	bool createIndexEnabled{false}; // if create index column
+	QVector<BinaryFilter::Field> fields; // record layout, vectors values of dataType if empty
+	size_t recordSize{0}; // size of the records of the layout in bytes, end of the last field if 0
 
 	bool autoModeEnabled{true};
 
 private:
+	int prepareImport(AbstractDataSource*, AbstractFileFilter::ImportMode, std::vector<void*>& dataContainer);
+	void importRecords(const char* records, size_t count, size_t row, const std::vector<void*>& dataContainer) const;
+
 	int m_actualRows{0};
 	int m_actualCols{0};
 };
@@ -105,3 +105,15 @@ void DbcParser::getSignals(const QVector<uint32_t>& ids, PrefixType p, SuffixTyp
 	Q_UNUSED(out)
 #endif
 }
+
+QString DbcParser::messageName(uint32_t id) const {
+#ifdef HAVE_DBC_PARSER
+	for (const auto& message : m_parser.get_messages()) {
+		if (message.id() == id)
+			return QString::fromStdString(message.name());
+	}
+#else
+	Q_UNUSED(id)
+#endif
+	return {};
+}
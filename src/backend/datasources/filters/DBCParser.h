@@ -58,6 +58,13 @@ public:
 	 */
 	void getSignals(const QVector<uint32_t>& ids, PrefixType p, SuffixType s, QHash<uint32_t, int>& idIndex, Signals& out) const;
 
+	/*!
+	 * \brief messageName
+	 * \param id CAN id of the message
+	 * \return name of the message as defined in the dbc file or an empty string if the id is not available
+	 */
+	QString messageName(uint32_t id) const;
+
 private:
 	DbcParser::ParseStatus m_parseFileStatus{DbcParser::ParseStatus::ErrorDBCParserUnsupported};
 	// QMap<uint32_t, libdbc::Message> m_messages;
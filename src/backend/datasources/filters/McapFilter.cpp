@@ -11,6 +11,7 @@
 
 #include "backend/datasources/filters/McapFilter.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/McapFilterPrivate.h"
 #include "backend/lib/XmlStreamReader.h"
@@ -27,6 +28,7 @@
 #include <chrono>
 #include <thread>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -376,7 +378,14 @@ void McapFilterPrivate::setValueFromString(int column, int row, const QString& v
 	}
 	case AbstractColumn::ColumnMode::DateTime: {
 		if (vectorNames[column] == QLatin1String("publishTime") || vectorNames[column] == QLatin1String("logTime")) {
-			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = QDateTime::fromMSecsSinceEpoch(valueString.toLongLong());
+			// nanoseconds since epoch, see mcapToJson()
+			bool isNumber;
+			const qint64 nsecs = valueString.toLongLong(&isNumber);
+			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) =
+				isNumber ? QDateTime::fromMSecsSinceEpoch(DateTimeValues::toMSecs(nsecs), QTimeZone::UTC) : QDateTime();
+			auto it = m_nanoseconds.find(column);
+			if (it != m_nanoseconds.end())
+				(*it)[row] = isNumber ? nsecs : DateTimeValues::invalid;
 			break;
 		}
 		const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
@@ -539,9 +548,9 @@ int McapFilterPrivate::mcapToJson(const QString& fileName, int lines) {
 
 			// TODO: handle seqeunce, and times as longs instead of strings
 			obj.insert(QLatin1String("sequence"), QJsonValue::fromVariant(QString::number(it->message.sequence)));
-			obj.insert(QLatin1String("logTime"), QJsonValue::fromVariant(QString::number(it->message.logTime / 1000000))); // nano to milli otherwise value is 0
-			obj.insert(QLatin1String("publishTime"),
-					   QJsonValue::fromVariant(QString::number(it->message.publishTime / 1000000))); // nano to milli otherwise value is 0
+			// the times are kept in nanoseconds, the columns store them with nanosecond resolution (see importData())
+			obj.insert(QLatin1String("logTime"), QJsonValue::fromVariant(QString::number(it->message.logTime)));
+			obj.insert(QLatin1String("publishTime"), QJsonValue::fromVariant(QString::number(it->message.publishTime)));
 
 			if (timeOffset == std::numeric_limits<mcap::Timestamp>::max()) {
 				minTime = std::min(minTime, it->message.logTime);
@@ -577,16 +586,16 @@ int McapFilterPrivate::mcapToJson(const QString& fileName, int lines) {
 		}
 
 		if (timeOffset != 0 && timeOffset != std::numeric_limits<mcap::Timestamp>::max()) {
-			const qint64 timeOffsetMs = static_cast<qint64>(timeOffset / 1000000);
+			const qint64 timeOffsetNs = static_cast<qint64>(timeOffset);
 			for (int index = 0; index < jsonArray.count(); ++index) {
 				auto obj = jsonArray[index].toObject();
 				if (obj.contains(QLatin1String("logTime"))) {
 					const qint64 value = obj.value(QLatin1String("logTime")).toString().toLongLong();
-					obj.insert(QLatin1String("logTime"), QJsonValue::fromVariant(QString::number(value - timeOffsetMs)));
+					obj.insert(QLatin1String("logTime"), QJsonValue::fromVariant(QString::number(value - timeOffsetNs)));
 				}
 				if (obj.contains(QLatin1String("publishTime"))) {
 					const qint64 value = obj.value(QLatin1String("publishTime")).toString().toLongLong();
-					obj.insert(QLatin1String("publishTime"), QJsonValue::fromVariant(QString::number(value - timeOffsetMs)));
+					obj.insert(QLatin1String("publishTime"), QJsonValue::fromVariant(QString::number(value - timeOffsetNs)));
 				}
 				jsonArray[index] = obj;
 			}
@@ -626,6 +635,16 @@ void McapFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileF
 	DEBUG("reading " << m_actualRows << " lines");
 	DEBUG("reading " << m_actualCols << " columns");
 
+	// the nanoseconds of logTime and publishTime are set after the import if the data is imported into a spreadsheet
+	m_nanoseconds.clear();
+	if (dataSource->type() == AspectType::Spreadsheet) {
+		for (int column = colOffset; column < m_actualCols; ++column) {
+			if (columnModes.at(column) == AbstractColumn::ColumnMode::DateTime
+				&& (vectorNames.at(column) == QLatin1String("publishTime") || vectorNames.at(column) == QLatin1String("logTime")))
+				m_nanoseconds[column] = QVector<qint64>(m_actualRows, DateTimeValues::invalid);
+		}
+	}
+
 	int progressIndex = 0;
 	const float progressInterval = 0.01 * lines; // update on every 1% only
 
@@ -682,6 +701,16 @@ void McapFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileF
 		}
 	}
 	dataSource->finalizeImport(m_columnOffset, startColumn, startColumn + m_actualCols - 1, dateTimeFormat, importMode);
+
+	// keep the nanosecond resolution of the MCAP timestamps
+	for (auto it = m_nanoseconds.cbegin(); it != m_nanoseconds.cend(); ++it) {
+		const bool subMSecs = std::any_of(it->cbegin(), it->cend(), [](qint64 nsecs) {
+			return nsecs != DateTimeValues::invalid && nsecs % DateTimeValues::nsecsPerMSec != 0;
+		});
+		if (subMSecs)
+			static_cast<Spreadsheet*>(dataSource)->column(m_columnOffset + it.key())->setDateTimeNSecs(*it);
+	}
+	m_nanoseconds.clear();
 }
 
 /*!
@@ -755,7 +784,7 @@ QVector<QStringList> McapFilterPrivate::preview(int lines) {
 				break;
 			case QJsonValue::String:
 				if (columnModes.at(n + createIndexEnabled) == AbstractColumn::ColumnMode::DateTime) {
-					lineString += QDateTime::fromMSecsSinceEpoch(value.toString().toLong()).toString(dateTimeFormat);
+					lineString += QDateTime::fromMSecsSinceEpoch(DateTimeValues::toMSecs(value.toString().toLongLong()), QTimeZone::UTC).toString(dateTimeFormat);
 				} else {
 					lineString += value.toString();
 				}
@@ -787,6 +816,19 @@ void McapFilterPrivate::write(const QString& fileName, AbstractDataSource* dataS
 /*!
 writes the content of \c dataSource to the file \c fileName.
 */
+namespace {
+//! returns the MCAP timestamp (nanoseconds since epoch) of the row \c row of the column \c column with the numeric value \c value
+mcap::Timestamp timestamp(const Column* column, int row, const QVariant& value) {
+	if (column->columnMode() != AbstractColumn::ColumnMode::DateTime)
+		return mcap::Timestamp(value.toLongLong() * 1000000); // milliseconds
+
+	const auto nsecs = column->dateTimeNSecs();
+	if (!nsecs.empty())
+		return mcap::Timestamp(nsecs[row] != DateTimeValues::invalid ? nsecs[row] : 0);
+	return mcap::Timestamp(column->dateTimeAt(row).toMSecsSinceEpoch() * 1000000);
+}
+}
+
 void McapFilterPrivate::writeWithOptions(const QString& fileName, AbstractDataSource* dataSource, int compression_mode, int compression_level) {
 	DEBUG(Q_FUNC_INFO);
 
@@ -846,11 +888,11 @@ void McapFilterPrivate::writeWithOptions(const QString& fileName, AbstractDataSo
 			QVariant value = spreadsheet->column(col)->valueAt(row);
 			auto jsonValue = QJsonValue::fromVariant(value);
 			if (columnName == QLatin1String("logTime")) { // Special field in MCAP
-				msg.logTime = mcap::Timestamp(value.toLongLong() * 1000000);
+				msg.logTime = timestamp(spreadsheet->column(col), row, value);
 				continue;
 			}
 			if (columnName == QLatin1String("publishTime")) { // Special field in MCAP
-				msg.publishTime = mcap::Timestamp(value.toLongLong() * 1000000);
+				msg.publishTime = timestamp(spreadsheet->column(col), row, value);
 				continue;
 			}
 			if (columnName == QLatin1String("sequence")) { // Special field in MCAP
@@ -11,6 +11,7 @@
 #define MCAPFILTERPRIVATE_H
 
 #include "QJsonModel.h"
+#include <QMap>
 #include <limits.h>
 
 class QJsonDocument;
@@ -75,6 +76,7 @@ private:
 	int m_columnOffset{0}; // indexes the "start column" in the datasource. Data will be imported starting from this column.
 	QString current_topic = QLatin1String("");
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers (columns).
+	QMap<int, QVector<qint64>> m_nanoseconds; // nanoseconds since epoch of logTime and publishTime (column index -> values)
 	QJsonDocument m_doc; // original and full JSON document
 	QJsonDocument m_preparedDoc; // selected part of the full JSON document, the part that needs to be imported
 	QVector<QString> m_validTopics;
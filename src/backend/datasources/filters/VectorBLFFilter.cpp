@@ -20,6 +20,10 @@
 
 #include <KLocalizedString>
 #include <QDateTime>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <map>
+#include <memory>
 
 #ifdef HAVE_VECTOR_BLF
 #ifdef __GNUC__
@@ -470,8 +474,204 @@ int VectorBLFFilterPrivate::readDataFromFileCommonTime(const QString& fileName,
 #endif // HAVE_VECTOR_BLF
 }
 
-int VectorBLFFilterPrivate::readDataFromFileSeparateTime(const QString& /*fileName*/, int /*lines*/) {
-	return 0; // Not implemented yet
+/*!
+ * reads the messages with a separate time column for every message id, i.e. the signals of every message
+ * are imported with their native rate and no values are duplicated or filled with NANs for the messages with other ids.
+ * The number of rows is given by the maximal number of messages with the same id, the columns of the messages
+ * with less entries are filled with NANs (signals) and 0 (time) at the end.
+ *
+ * The file is read and decoded in chunks, the messages in every chunk are decoded in parallel per message id.
+ * Only the object headers of the current chunk are kept in memory.
+ */
+int VectorBLFFilterPrivate::readDataFromFileSeparateTime(const QString& fileName, int lines) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+
+	if (!isValid(fileName)) {
+		q->setLastError(i18n("Invalid file."));
+		return 0;
+	}
+
+	const auto validStatus = m_dbcParser.isValid();
+	if (validStatus != DbcParser::ParseStatus::Success) {
+		addWarningError({DBCParserParseStatusToVectorBLFStatus(validStatus), 0});
+		return 0;
+	}
+
+	if (m_parseState.ready && m_parseState.requestedLines == lines)
+		return m_parseState.readLines;
+
+	m_DataContainer.clear();
+
+#ifdef HAVE_VECTOR_BLF
+	Vector::BLF::File file;
+	file.open(fileName.toLocal8Bit().data());
+
+	// 1. read and decode the messages chunk-wise
+	static const int chunkSize = 100000; // max. number of object headers kept in memory
+	QVector<uint32_t> ids; // message ids in the order of their first occurrence
+	std::map<uint32_t, MessageData> messageData; // std::map to have stable references during the parallel decoding
+	std::vector<std::unique_ptr<Vector::BLF::ObjectHeaderBase>> chunk;
+	chunk.reserve(chunkSize);
+	int message_counter = 0;
+	bool endOfFile = false;
+	while (!endOfFile) {
+		chunk.clear(); // deletes the object headers of the previous chunk
+		{
+			PERFTRACE(QLatin1String(Q_FUNC_INFO) + QLatin1String("Parsing BLF file"));
+			while ((int)chunk.size() < chunkSize) {
+				if (!file.good() || (lines >= 0 && message_counter >= lines)) {
+					endOfFile = true;
+					break;
+				}
+
+				Vector::BLF::ObjectHeaderBase* objectHeader = nullptr;
+				try {
+					objectHeader = file.read();
+				} catch (std::runtime_error& e) {
+					DEBUG("Exception: " << e.what() << std::endl);
+				}
+				if (objectHeader == nullptr) {
+					endOfFile = true;
+					break;
+				}
+
+				if (objectHeader->objectType != Vector::BLF::ObjectType::CAN_MESSAGE2) {
+					delete objectHeader;
+					continue;
+				}
+
+				chunk.emplace_back(objectHeader);
+				message_counter++;
+			}
+		}
+
+		// group the messages of the current chunk by their ids
+		QHash<uint32_t, QVector<const Vector::BLF::CanMessage2*>> chunkMessages;
+		for (const auto& objectHeader : chunk) {
+			const auto* message = static_cast<const Vector::BLF::CanMessage2*>(objectHeader.get());
+			if (messageData.find(message->id) == messageData.end()) {
+				messageData[message->id] = MessageData();
+				ids.append(message->id);
+			}
+			chunkMessages[message->id].append(message);
+		}
+
+		// decode in parallel, every task handles all messages of one id in the chunk and writes to its own MessageData only
+		struct DecodeTask {
+			const QVector<const Vector::BLF::CanMessage2*>* messages;
+			MessageData* data;
+		};
+		std::vector<DecodeTask> tasks;
+		tasks.reserve(chunkMessages.size());
+		for (auto it = chunkMessages.cbegin(); it != chunkMessages.cend(); ++it)
+			tasks.push_back({&it.value(), &messageData[it.key()]});
+
+		PERFTRACE(QLatin1String(Q_FUNC_INFO) + QLatin1String("Decoding messages"));
+		QtConcurrent::blockingMap(tasks, [this](const DecodeTask& task) {
+			auto& data = *task.data;
+			std::vector<double> values;
+			for (const auto* message : *task.messages) {
+				values.clear();
+				const auto status = m_dbcParser.parseMessage(message->id, message->data, values);
+				if (status != DbcParser::ParseStatus::Success) {
+					data.status = status;
+					continue;
+				}
+
+				if (data.timestamps.isEmpty())
+					data.values.resize(values.size());
+				else if (values.size() != data.values.size()) {
+					data.status = DbcParser::ParseStatus::ErrorInvalidConversion;
+					continue;
+				}
+
+				uint64_t timestamp;
+				data.timeInNS = getTime(message, timestamp);
+				data.timestamps.append(timestamp);
+				for (size_t i = 0; i < values.size(); ++i)
+					data.values[i].append(values.at(i));
+			}
+		});
+	}
+	chunk.clear();
+
+	// 2. warnings for the messages that couldn't be decoded
+	QVector<uint32_t> validIds;
+	int rows = 0;
+	for (const auto id : std::as_const(ids)) {
+		const auto& data = messageData.at(id);
+		if (data.status != DbcParser::ParseStatus::Success) {
+			// id is not available in the dbc file, so it is not possible to decode
+			DEBUG("Unable to decode message: " << id << ": " << (int)data.status);
+			addWarningError({DBCParserParseStatusToVectorBLFStatus(data.status), id});
+		}
+		if (!data.timestamps.isEmpty()) {
+			validIds.append(id);
+			rows = std::max(rows, (int)data.timestamps.size());
+		}
+	}
+
+	// 3. create vector names, the message name is used as prefix to distinguish the time columns and the signals of different messages
+	QHash<uint32_t, int> idIndexTable;
+	DbcParser::Signals messageSignals;
+	m_dbcParser.getSignals(validIds, DbcParser::PrefixType::Message, DbcParser::SuffixType::Unit, idIndexTable, messageSignals);
+	m_signals.signal_names.clear();
+	m_signals.value_descriptions.clear();
+
+	// 4. move the decoded data into the data container, one time column followed by the signal columns for every message
+	try {
+		for (const auto id : std::as_const(validIds)) {
+			auto& data = messageData.at(id);
+			const int count = data.timestamps.size();
+
+			QString timeName;
+			if (convertTimeToSeconds) {
+				auto* vector = new QVector<double>(rows, std::nan("0"));
+				const double factor = data.timeInNS ? 1e-9 : 1e-5; // TimeOneNans or TimeTenMics
+				for (int i = 0; i < count; ++i)
+					(*vector)[i] = (double)data.timestamps.at(i) * factor;
+				m_DataContainer.appendVector<double>(vector, AbstractColumn::ColumnMode::Double);
+				timeName = i18n("Time_s");
+			} else {
+				auto* vector = new QVector<qint64>(rows, 0);
+				for (int i = 0; i < count; ++i)
+					(*vector)[i] = data.timestamps.at(i);
+				m_DataContainer.appendVector<qint64>(vector, AbstractColumn::ColumnMode::BigInt); // BigInt is qint64 and not quint64!
+				timeName = data.timeInNS ? i18n("Time_ns") : i18n("Time_10µs");
+			}
+			data.timestamps = QVector<uint64_t>(); // free memory
+
+			m_signals.signal_names << m_dbcParser.messageName(id) + QLatin1Char('_') + timeName;
+			m_signals.value_descriptions.push_back(std::vector<DbcParser::ValueDescriptions>()); // Time does not have any labels
+
+			const int startIndex = idIndexTable.value(id);
+			for (size_t i = 0; i < data.values.size(); ++i) {
+				auto* vector = new QVector<double>(std::move(data.values[i]));
+				vector->resize(rows);
+				std::fill(vector->begin() + count, vector->end(), std::nan("0"));
+				m_DataContainer.appendVector(vector, AbstractColumn::ColumnMode::Double);
+
+				m_signals.signal_names << messageSignals.signal_names.at(startIndex + i);
+				m_signals.value_descriptions.push_back(messageSignals.value_descriptions.at(startIndex + i));
+			}
+		}
+	} catch (std::bad_alloc&) {
+		m_DataContainer.clear();
+		m_signals = DbcParser::Signals();
+		q->setLastError(i18n("Not enough memory."));
+		return 0;
+	}
+
+	if (!m_DataContainer.resize(rows))
+		return 0;
+
+	// Use message_counter here, because it will be used as reference for caching
+	m_parseState = ParseState(message_counter, rows);
+	return rows;
+#else
+	Q_UNUSED(lines)
+	return 0;
+#endif // HAVE_VECTOR_BLF
 }
 
 // ##############################################################################
@@ -43,6 +43,16 @@ private:
 	};
 	void addWarningError(const Warning&) const;
 
+	/*!
+	 * decoded data of all messages with the same CAN id, used when importing with separate time columns
+	 */
+	struct MessageData {
+		QVector<uint64_t> timestamps;
+		bool timeInNS{true}; // true if the timestamps are in ns, false if they are in 10µs
+		std::vector<QVector<double>> values; // one vector per signal
+		DbcParser::ParseStatus status{DbcParser::ParseStatus::Success}; // last error occurred while decoding
+	};
+
 private:
 	virtual int readDataFromFileCommonTime(const QString& fileName, int lines = -1) override;
 	virtual int readDataFromFileSeparateTime(const QString& fileName, int lines = -1) override;
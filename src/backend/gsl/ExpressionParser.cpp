@@ -741,6 +741,9 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr,
 	}
 	if (yVector->size() < minSize)
 		minSize = yVector->size();
+#if PERFTRACE_EXPRESSION_PARSER
+	PERFTRACE_COUNTER("expression parser rows processed", minSize);
+#endif
 
 	// calculate values
 	const auto numberLocale = QLocale();
@@ -176,3 +176,15 @@ int XmlStreamReader::readAttributeInt(const QString& name, bool* ok) {
 
 	return str.toInt(ok);
 }
+
+/*!
+ * sets the reader for the binary data section of the project file the XML is read from.
+ * The data of the columns stored there is read lazily by the columns via \c dataReader().
+ */
+void XmlStreamReader::setDataReader(const std::shared_ptr<ProjectDataReader>& reader) {
+	m_dataReader = reader;
+}
+
+const std::shared_ptr<ProjectDataReader>& XmlStreamReader::dataReader() const {
+	return m_dataReader;
+}
@@ -14,6 +14,9 @@
 
 #include <QXmlStreamReader>
 
+#include <memory>
+
+class ProjectDataReader;
 class QString;
 
 class XmlStreamReader : public QXmlStreamReader {
@@ -43,10 +46,14 @@ public:
 	bool skipToEndElement();
 	int readAttributeInt(const QString& name, bool* ok);
 
+	void setDataReader(const std::shared_ptr<ProjectDataReader>&);
+	const std::shared_ptr<ProjectDataReader>& dataReader() const;
+
 private:
 	QStringList m_warnings;
 	QStringList m_missingCASPlugins;
 	bool m_failedCASMissing{false};
+	std::shared_ptr<ProjectDataReader> m_dataReader; // binary data section of the project file, if available
 	void init();
 };
 
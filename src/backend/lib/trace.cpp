@@ -0,0 +1,276 @@
+/*
+	File                 : trace.cpp
+	Project              : LabPlot
+	Description          : Function and macros related to performance and debugging tracing
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * \namespace PerfTrace
+ * \brief Recording of the performance traces for the export in the Chrome trace format.
+ *
+ * While the recording is active, every \c PERFTRACE() scope is stored as a span and every
+ * \c PERFTRACE_COUNTER() as a counter value in a ring buffer of the calling thread.
+ * The recorded events can be exported with \c writeTrace() as a JSON file that can be
+ * opened in chrome://tracing or in the Perfetto UI (https://ui.perfetto.dev).
+ *
+ * The recording is started at the application start if the environment variable \c LABPLOT_TRACE
+ * or the command line option \c --trace is set to the name of the output file, the trace
+ * is written to this file when the application exits.
+ */
+namespace {
+using Clock = std::chrono::steady_clock;
+const Clock::time_point traceStart = Clock::now();
+
+// number of events kept per thread, older events are overwritten
+constexpr size_t bufferCapacity = 1 << 16;
+
+qint64 now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - traceStart).count();
+}
+
+struct Event {
+	std::string name;
+	qint64 start{0}; // in ns
+	qint64 duration{-1}; // in ns, -1 for counters
+	double value{0.};
+};
+
+struct ThreadBuffer {
+	ThreadBuffer(int id, std::string name)
+		: tid(id)
+		, threadName(std::move(name)) {
+	}
+
+	void add(Event&& event) {
+		// only locked concurrently during the export, uncontended otherwise
+		std::lock_guard<std::mutex> lock(mutex);
+		if (events.size() < bufferCapacity)
+			events.push_back(std::move(event));
+		else
+			events[count % bufferCapacity] = std::move(event);
+		++count;
+	}
+
+	const int tid;
+	const std::string threadName;
+	std::mutex mutex;
+	std::vector<Event> events;
+	size_t count{0}; // total number of added events
+};
+
+struct Registry {
+	QMutex mutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	QString fileName;
+};
+
+Registry& registry() {
+	static Registry r;
+	return r;
+}
+
+std::atomic<bool> recording{false};
+thread_local int depth = 0; // nesting level of the spans in the current thread
+
+ThreadBuffer& threadBuffer() {
+	// the buffers are owned by the registry too so the events survive the end of the thread
+	thread_local std::shared_ptr<ThreadBuffer> buffer;
+	if (!buffer) {
+		auto& r = registry();
+		QMutexLocker locker(&r.mutex);
+		const int tid = static_cast<int>(r.buffers.size()) + 1;
+		const auto* thread = QThread::currentThread();
+		std::string name = thread ? thread->objectName().toStdString() : std::string();
+		if (name.empty()) {
+			const auto* app = QCoreApplication::instance();
+			if (app && app->thread() == thread)
+				name = "main";
+			else
+				name = "thread " + std::to_string(tid);
+		}
+		buffer = std::make_shared<ThreadBuffer>(tid, std::move(name));
+		r.buffers.push_back(buffer);
+	}
+	return *buffer;
+}
+
+QByteArray escaped(const std::string& str) {
+	QByteArray result;
+	result.reserve(str.size());
+	for (const char c : str) {
+		switch (c) {
+		case '"':
+			result += "\\\"";
+			break;
+		case '\\':
+			result += "\\\\";
+			break;
+		case '\n':
+			result += "\\n";
+			break;
+		case '\t':
+			result += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+				result += "\\u00" + QByteArray::number(static_cast<int>(c), 16).rightJustified(2, '0');
+			else
+				result += c;
+		}
+	}
+	return result;
+}
+
+// timestamps in the Chrome trace format are in microseconds
+QByteArray microseconds(qint64 ns) {
+	return QByteArray::number(ns / 1000., 'f', 3);
+}
+}
+
+PerfTracer::PerfTracer(const QString& msg) {
+	m_print = perfTraceEnabled();
+	m_record = recording.load(std::memory_order_relaxed);
+	if (!m_print && !m_record)
+		return;
+
+	m_msg = msg.toStdString();
+	m_depth = depth++;
+	m_start = now();
+}
+
+PerfTracer::~PerfTracer() {
+	if (m_start < 0)
+		return;
+
+	const qint64 end = now();
+	--depth;
+
+	if (m_print)
+		std::cout << std::string(2 * m_depth, ' ') << m_msg << ": " << (end - m_start) / 1000000 << " ms" << std::endl;
+
+	if (m_record && recording.load(std::memory_order_relaxed))
+		threadBuffer().add({std::move(m_msg), m_start, end - m_start, 0.});
+}
+
+namespace PerfTrace {
+bool isRecording() {
+	return recording.load(std::memory_order_relaxed);
+}
+
+/*!
+ * starts the recording of the trace events. If \c fileName is not empty,
+ * the recorded trace is written to this file in \c finish().
+ */
+void startRecording(const QString& fileName) {
+	auto& r = registry();
+	{
+		QMutexLocker locker(&r.mutex);
+		r.fileName = fileName;
+	}
+	recording = true;
+}
+
+void stopRecording() {
+	recording = false;
+}
+
+/*!
+ * stops the recording and writes the trace to the file specified in \c startRecording(), if any.
+ * Called when the application exits.
+ */
+void finish() {
+	if (!isRecording())
+		return;
+
+	stopRecording();
+
+	QString fileName;
+	{
+		auto& r = registry();
+		QMutexLocker locker(&r.mutex);
+		fileName = r.fileName;
+	}
+
+	if (fileName.isEmpty())
+		return;
+
+	if (writeTrace(fileName))
+		std::cout << "Performance trace written to " << STDSTRING(fileName) << std::endl;
+	else
+		std::cerr << "Failed to write the performance trace to " << STDSTRING(fileName) << std::endl;
+}
+
+/*!
+ * records the value \c value of the counter \c name (rows processed, bytes read, etc.) at the current time.
+ */
+void counter(const char* name, double value) {
+	if (!isRecording())
+		return;
+
+	threadBuffer().add({std::string(name), now(), -1, value});
+}
+
+/*!
+ * writes all recorded events in the Chrome trace event format (JSON) to \c fileName.
+ */
+bool writeTrace(const QString& fileName) {
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	{
+		auto& r = registry();
+		QMutexLocker locker(&r.mutex);
+		buffers = r.buffers;
+	}
+
+	const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+	QByteArray data;
+	data += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	auto append = [&data, &first](const QByteArray& event) {
+		if (!first)
+			data += ",\n";
+		data += event;
+		first = false;
+	};
+
+	for (const auto& buffer : buffers) {
+		const QByteArray tid = QByteArray::number(buffer->tid);
+		append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":\"" + escaped(buffer->threadName) + "\"}}");
+
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		const size_t size = buffer->events.size();
+		const size_t oldest = (buffer->count > size) ? buffer->count % size : 0; // oldest event in the ring buffer
+		for (size_t i = 0; i < size; ++i) {
+			const auto& event = buffer->events.at((oldest + i) % size);
+			if (event.duration >= 0)
+				append("{\"name\":\"" + escaped(event.name) + "\",\"cat\":\"labplot\",\"ph\":\"X\",\"ts\":" + microseconds(event.start) + ",\"dur\":"
+					   + microseconds(event.duration) + ",\"pid\":" + pid + ",\"tid\":" + tid + "}");
+			else
+				append("{\"name\":\"" + escaped(event.name) + "\",\"ph\":\"C\",\"ts\":" + microseconds(event.start) + ",\"pid\":" + pid + ",\"tid\":" + tid
+					   + ",\"args\":{\"value\":" + QByteArray::number(event.value, 'g', 15) + "}}");
+		}
+	}
+
+	data += "]}\n";
+	return file.write(data) == data.size();
+}
+}
@@ -11,29 +11,43 @@
 #define TRACE_H
 
 #include "backend/lib/macros.h"
-#include <chrono>
 
+#include <string>
+
+/*!
+ * RAII helper measuring the time spent in the enclosing scope.
+ * The result is printed to the console if the performance trace is enabled in the settings
+ * and is recorded as a span for the Chrome trace export if the trace recording is active (\sa PerfTrace).
+ */
 class PerfTracer {
 public:
-	explicit PerfTracer(QString m) {
-		if (perfTraceEnabled()) {
-			msg = STDSTRING(m);
-			start = std::chrono::high_resolution_clock::now();
-		}
-	};
-	~PerfTracer() {
-		if (perfTraceEnabled()) {
-			const auto end = std::chrono::high_resolution_clock::now();
-			const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-			std::cout << msg << ": " << diff << " ms" << std::endl;
-		}
-	}
+	explicit PerfTracer(const QString&);
+	~PerfTracer();
+
+	PerfTracer(const PerfTracer&) = delete;
+	PerfTracer& operator=(const PerfTracer&) = delete;
 
 private:
-	std::chrono::high_resolution_clock::time_point start;
-	std::string msg;
+	std::string m_msg;
+	qint64 m_start{-1}; // in ns, -1 if the tracer is not active
+	int m_depth{0};
+	bool m_print{false};
+	bool m_record{false};
 };
 
+namespace PerfTrace {
+bool isRecording();
+void startRecording(const QString& fileName = QString());
+void stopRecording();
+void finish();
+void counter(const char* name, double value);
+bool writeTrace(const QString& fileName);
+}
+
+static inline bool perfTraceActive() {
+	return perfTraceEnabled() || PerfTrace::isRecording();
+}
+
 #define PERFTRACE_ENABLED 1
 
 #define PERFTRACE_CURVES 1
@@ -42,11 +56,22 @@ private:
 #define PERFTRACE_AUTOSCALE 1
 #define PERFTRACE_EXPRESSION_PARSER 1
 
+#define PERFTRACE_CONCAT_IMPL(a, b) a##b
+#define PERFTRACE_CONCAT(a, b) PERFTRACE_CONCAT_IMPL(a, b)
+
 #ifdef PERFTRACE_ENABLED
-#define PERFTRACE(msg)                                                                                                                                         \
-	{ PerfTracer tracer(msg); }
+// the tracer lives until the end of the enclosing scope, the message is only created if the tracing is active
+#define PERFTRACE(msg) const PerfTracer PERFTRACE_CONCAT(perfTracer, __LINE__)(perfTraceActive() ? QString(msg) : QString())
+#define PERFTRACE_COUNTER(name, value)                                                                                                                         \
+	do {                                                                                                                                                       \
+		if (PerfTrace::isRecording())                                                                                                                          \
+			PerfTrace::counter(name, value);                                                                                                                   \
+	} while (0)
 #else
 #define PERFTRACE(msg) DEBUG(msg)
+#define PERFTRACE_COUNTER(name, value)                                                                                                                         \
+	do {                                                                                                                                                       \
+	} while (0)
 #endif
 
 #ifndef HAVE_WINDOWS
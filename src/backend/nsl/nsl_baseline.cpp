@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <gsl/gsl_fit.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_statistics_double.h>
 #include <vector>
 
@@ -695,6 +696,152 @@ double nsl_baseline_remove_arpls_GSL(double* data, const size_t n, double p, dou
 	return crit;
 }
 
+/* banded version of ARPLS
+ * W + lambda*D*D^T is symmetric pentadiagonal (D*D^T is the second difference penalty), it is factorized as L*Diag*L^T
+ * with the two subdiagonals of L in O(n) on every iteration. All bands and vectors are allocated once. */
+double nsl_baseline_remove_arpls_banded(double* data, const size_t n, double p, double lambda, int niter) {
+	double crit = 1.;
+
+	// Handle empty data
+	if (n == 0) {
+		return -1.; // Need at least 1 point
+	}
+
+	// Handle single point case
+	if (n == 1) {
+		// For single point, subtracting baseline (which is the point itself) results in 0
+		if (!std::isfinite(data[0])) {
+			return -1.;
+		}
+		data[0] = 0.0;
+		return 0.;
+	}
+
+	// Handle two point case
+	if (n == 2) {
+		// For two points, subtracting the line through them results in 0 for both points
+		// This is a simple linear interpolation
+		double y0 = data[0];
+		double y1 = data[1];
+		if (!std::isfinite(y0) || !std::isfinite(y1)) {
+			return -1.;
+		}
+		double slope = (y1 - y0) / (1.0); // assuming x positions are 0 and 1
+		data[0] -= y0;
+		data[1] -= (y0 + slope);
+		return 0.;
+	}
+
+	// Validate inputs
+	if (p <= 0 || lambda <= 0) {
+		return -1.;
+	}
+	if (niter < 1) {
+		return -1.;
+	}
+
+	// Validate data - check for NaN and Infinity
+	for (size_t i = 0; i < n; i++) {
+		if (!std::isfinite(data[i])) {
+			return -1.;
+		}
+	}
+
+	// bands of H = lambda * D.dot(D.T): diagonal h0, first (h1) and second (h2) off-diagonal
+	std::vector<double> h0(n, 0.), h1(n, 0.), h2(n, 0.);
+	const double c[] = {1., -2., 1.}; // column of D
+	for (size_t j = 0; j < n - 2; ++j) {
+		for (size_t k = 0; k < 3; ++k)
+			h0[j + k] += lambda * c[k] * c[k];
+		h1[j] += lambda * c[0] * c[1];
+		h1[j + 1] += lambda * c[1] * c[2];
+		h2[j] += lambda * c[0] * c[2];
+	}
+
+	// factorization (diagonal d, subdiagonals l1 and l2 of L), solution z and weights w
+	std::vector<double> d(n), l1(n, 0.), l2(n, 0.), z(data, data + n), w(n, 1.);
+	int count = 0;
+	while (crit > p) {
+		// solve (W+H)z = W*data
+		for (size_t i = 0; i < n; ++i) {
+			double di = w[i] + h0[i];
+			double bi = h1[i];
+			if (i > 0) {
+				di -= l1[i - 1] * l1[i - 1] * d[i - 1];
+				bi -= l2[i - 1] * l1[i - 1] * d[i - 1];
+			}
+			if (i > 1)
+				di -= l2[i - 2] * l2[i - 2] * d[i - 2];
+			if (!(di > 0.)) // not positive definite
+				return -1.;
+
+			d[i] = di;
+			l1[i] = bi / di;
+			l2[i] = h2[i] / di;
+		}
+
+		// L*y = W*data, Diag*L^T*z = y
+		for (size_t i = 0; i < n; ++i) {
+			double y = w[i] * data[i];
+			if (i > 0)
+				y -= l1[i - 1] * z[i - 1];
+			if (i > 1)
+				y -= l2[i - 2] * z[i - 2];
+			z[i] = y;
+		}
+		for (size_t i = n; i-- > 0;) {
+			double zi = z[i] / d[i];
+			if (i + 1 < n)
+				zi -= l1[i] * z[i + 1];
+			if (i + 2 < n)
+				zi -= l2[i] * z[i + 2];
+			z[i] = zi;
+		}
+
+		// mean and stdev of negative diff values
+		double m = 0.;
+		size_t num = 0;
+		for (size_t i = 0; i < n; ++i) {
+			const double v = data[i] - z[i];
+			if (v < 0) {
+				m += v;
+				num++;
+			}
+		}
+		if (num > 0)
+			m /= num;
+		double s = 0.;
+		for (size_t i = 0; i < n; ++i) {
+			const double v = data[i] - z[i];
+			if (v < 0)
+				s += gsl_pow_2(v - m);
+		}
+		if (num > 0)
+			s /= num;
+		s = sqrt(s);
+
+		// w_new = 1 / (1 + np.exp(2 * (d - (2*s - m))/s)), crit = norm(w_new - w) / norm(w)
+		const bool valid = !(s == 0 || std::isnan(s) || std::isinf(m));
+		double norm = 0., normw = 0.;
+		for (size_t i = 0; i < n; ++i) {
+			const double wn = valid ? 1. / (1. + exp(2. * (data[i] - z[i] - (2. * s - m)) / s)) : 1.;
+			norm += gsl_pow_2(wn - w[i]);
+			normw += gsl_pow_2(w[i]);
+			w[i] = wn;
+		}
+		crit = sqrt(norm / normw);
+
+		count++;
+		if (count > niter)
+			break;
+	}
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] -= z[i];
+
+	return crit;
+}
+
 double nsl_baseline_remove_arpls(double* data, const size_t n, double p, double lambda, int niter) {
 	// Handle empty data
 	if (n == 0) {
@@ -734,9 +881,5 @@ double nsl_baseline_remove_arpls(double* data, const size_t n, double p, double
 	if (niter == 0)
 		niter = 10;
 
-#ifdef HAVE_EIGEN3
-	return nsl_baseline_remove_arpls_Eigen3(data, n, p, lambda, niter);
-#else
-	return nsl_baseline_remove_arpls_GSL(data, n, p, lambda, niter);
-#endif
+	return nsl_baseline_remove_arpls_banded(data, n, p, lambda, niter);
 }
@@ -46,6 +46,8 @@ int nsl_baseline_remove_linreg(double* xdata, double* ydata, size_t n);
 double nsl_baseline_remove_arpls(double* data, size_t n, double p, double lambda, int niter);
 double nsl_baseline_remove_arpls_Eigen3(double* data, size_t n, double p, double lambda, int niter);
 double nsl_baseline_remove_arpls_GSL(double* data, size_t n, double p, double lambda, int niter);
+/*  O(n) version with a banded LDL^T factorization of the pentadiagonal system (used by nsl_baseline_remove_arpls()) */
+double nsl_baseline_remove_arpls_banded(double* data, size_t n, double p, double lambda, int niter);
 /* TODO: ALS - asymmetric least square, airPLS - adaptive iteratively reweighted Penalized Least Squares */
 
 #endif
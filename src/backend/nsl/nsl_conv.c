@@ -9,11 +9,8 @@
 
 #include "nsl_conv.h"
 #include "nsl_common.h"
+#include "nsl_fft.h"
 #include <gsl/gsl_cblas.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 #include "backend/nsl/nsl_stats.h"
 
 const char* nsl_conv_direction_name[] = {i18n("Forward (Convolution)"), i18n("Backward (Deconvolution)")};
@@ -351,13 +348,9 @@ int nsl_conv_fft_type(const double s[],
 int nsl_conv_fft_FFTW(double s[], double r[], size_t n, nsl_conv_direction_type dir, size_t wi, double out[]) {
 	size_t i;
 	const size_t size = 2 * (n / 2 + 1);
-	double* in = (double*)malloc(size * sizeof(double));
-	fftw_plan rpf = fftw_plan_dft_r2c_1d((int)n, in, (fftw_complex*)in, FFTW_ESTIMATE);
-
-	fftw_execute_dft_r2c(rpf, s, (fftw_complex*)s);
-	fftw_execute_dft_r2c(rpf, r, (fftw_complex*)r);
-	fftw_destroy_plan(rpf);
-	free(in);
+	// cached plans, see nsl_fft.h
+	nsl_fft_r2c(s, s, n);
+	nsl_fft_r2c(r, r, n);
 
 	// multiply/divide
 	if (dir == nsl_conv_direction_forward) {
@@ -382,30 +375,21 @@ int nsl_conv_fft_FFTW(double s[], double r[], size_t n, nsl_conv_direction_type
 	}
 
 	// back transform
-	double* o = (double*)malloc(size * sizeof(double));
-	fftw_plan rpb = fftw_plan_dft_c2r_1d((int)n, (fftw_complex*)o, o, FFTW_ESTIMATE);
-
-	fftw_execute_dft_c2r(rpb, (fftw_complex*)s, s);
-	fftw_destroy_plan(rpb);
+	nsl_fft_c2r(s, s, n);
 
 	for (i = 0; i < n; i++) {
 		size_t index = (i + wi) % n;
 		out[i] = s[index] / n;
 	}
-	free(o);
 
 	return 0;
 }
 #endif
 
 int nsl_conv_fft_GSL(double s[], double r[], size_t n, nsl_conv_direction_type dir, double out[]) {
-	gsl_fft_real_workspace* work = gsl_fft_real_workspace_alloc(n);
-	gsl_fft_real_wavetable* real = gsl_fft_real_wavetable_alloc(n);
-
-	/* FFT s and r */
-	gsl_fft_real_transform(s, 1, n, real, work);
-	gsl_fft_real_transform(r, 1, n, real, work);
-	gsl_fft_real_wavetable_free(real);
+	/* FFT s and r (cached wavetables, see nsl_fft.h) */
+	nsl_fft_real_transform(s, 1, n);
+	nsl_fft_real_transform(r, 1, n);
 
 	size_t i;
 	/* calculate halfcomplex product/quotient depending on direction */
@@ -441,10 +425,7 @@ int nsl_conv_fft_GSL(double s[], double r[], size_t n, nsl_conv_direction_type d
 	}
 
 	/* back transform */
-	gsl_fft_halfcomplex_wavetable* hc = gsl_fft_halfcomplex_wavetable_alloc(n);
-	gsl_fft_halfcomplex_inverse(out, 1, n, hc, work);
-	gsl_fft_halfcomplex_wavetable_free(hc);
-	gsl_fft_real_workspace_free(work);
+	nsl_fft_halfcomplex_inverse(out, 1, n);
 
 	return 0;
 }
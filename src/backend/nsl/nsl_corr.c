@@ -9,11 +9,8 @@
 
 #include "nsl_corr.h"
 #include "nsl_common.h"
+#include "nsl_fft.h"
 #include <gsl/gsl_cblas.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 
 const char* nsl_corr_type_name[] = {i18n("Linear (Zero-padded)"), i18n("Circular")};
 const char* nsl_corr_norm_name[] = {i18n("None"), i18n("Biased"), i18n("Unbiased"), i18n("Coeff")};
@@ -122,12 +119,9 @@ int nsl_corr_fft_FFTW(double s[], double r[], size_t n, double out[]) {
 		return -1;
 
 	const size_t size = 2 * (n / 2 + 1);
-	double* in = (double*)malloc(size * sizeof(double));
-	fftw_plan rpf = fftw_plan_dft_r2c_1d((int)n, in, (fftw_complex*)in, FFTW_ESTIMATE);
-
-	fftw_execute_dft_r2c(rpf, s, (fftw_complex*)s);
-	fftw_execute_dft_r2c(rpf, r, (fftw_complex*)r);
-	fftw_destroy_plan(rpf);
+	// cached plans, see nsl_fft.h
+	nsl_fft_r2c(s, s, n);
+	nsl_fft_r2c(r, r, n);
 
 	size_t i;
 
@@ -141,28 +135,19 @@ int nsl_corr_fft_FFTW(double s[], double r[], size_t n, double out[]) {
 	}
 
 	// back transform
-	double* o = (double*)malloc(size * sizeof(double));
-	fftw_plan rpb = fftw_plan_dft_c2r_1d((int)n, (fftw_complex*)o, o, FFTW_ESTIMATE);
-	fftw_execute_dft_c2r(rpb, (fftw_complex*)s, s);
-	fftw_destroy_plan(rpb);
+	nsl_fft_c2r(s, s, n);
 
 	for (i = 0; i < n; i++)
 		out[i] = s[i] / n;
 
-	free(in);
-	free(o);
 	return 0;
 }
 #endif
 
 int nsl_corr_fft_GSL(double s[], double r[], size_t n, double out[]) {
-	gsl_fft_real_workspace* work = gsl_fft_real_workspace_alloc(n);
-	gsl_fft_real_wavetable* real = gsl_fft_real_wavetable_alloc(n);
-
-	/* FFT s and r */
-	gsl_fft_real_transform(s, 1, n, real, work);
-	gsl_fft_real_transform(r, 1, n, real, work);
-	gsl_fft_real_wavetable_free(real);
+	/* FFT s and r (cached wavetables, see nsl_fft.h) */
+	nsl_fft_real_transform(s, 1, n);
+	nsl_fft_real_transform(r, 1, n);
 
 	size_t i;
 	/* calculate halfcomplex product */
@@ -177,10 +162,7 @@ int nsl_corr_fft_GSL(double s[], double r[], size_t n, double out[]) {
 	}
 
 	/* back transform */
-	gsl_fft_halfcomplex_wavetable* hc = gsl_fft_halfcomplex_wavetable_alloc(n);
-	gsl_fft_halfcomplex_inverse(out, 1, n, hc, work);
-	gsl_fft_halfcomplex_wavetable_free(hc);
-	gsl_fft_real_workspace_free(work);
+	nsl_fft_halfcomplex_inverse(out, 1, n);
 
 	return 0;
 }
@@ -9,11 +9,8 @@
 
 #include "nsl_dft.h"
 #include "nsl_common.h"
+#include "nsl_fft.h"
 #include <gsl/gsl_fft_halfcomplex.h>
-#include <gsl/gsl_fft_real.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 
 const char* nsl_dft_result_type_name[] = {i18n("Magnitude"),
 										  i18n("Amplitude"),
@@ -27,6 +24,7 @@ const char* nsl_dft_result_type_name[] = {i18n("Magnitude"),
 										  i18n("Amplitude Squared"),
 										  i18n("Raw")};
 const char* nsl_dft_xscale_name[] = {i18n("Frequency"), i18n("Index"), i18n("Period")};
+const char* nsl_dft_method_name[] = {i18n("Full Signal"), i18n("Welch (Averaged Segments)")};
 
 int nsl_dft_transform_window(double data[], size_t stride, size_t n, int two_sided, nsl_dft_result_type type, nsl_sf_window_type window_type) {
 	/* apply window function */
@@ -43,7 +41,7 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 	if (n < 2) // we need at least 2 points
 		return 1;
 	size_t i;
-	double* result = (double*)malloc(2 * n * sizeof(double));
+	double* result = nsl_fft_buffer_alloc(2 * n);
 	size_t N = n / 2; /* number of resulting data points */
 	if (two_sided)
 		N = n;
@@ -51,9 +49,8 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 	/* stride ignored */
 	(void)stride;
 
-	fftw_plan plan = fftw_plan_dft_r2c_1d((int)n, data, (fftw_complex*)result, FFTW_ESTIMATE);
-	fftw_execute(plan);
-	fftw_destroy_plan(plan);
+	/* 1. transform (cached plan, see nsl_fft.h) */
+	nsl_fft_r2c(data, result, n);
 
 	/* 2. unpack data */
 	if (two_sided) {
@@ -68,12 +65,7 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 	}
 #else
 	/* 1. transform */
-	gsl_fft_real_wavetable* real = gsl_fft_real_wavetable_alloc(n);
-	gsl_fft_real_workspace* work = gsl_fft_real_workspace_alloc(n);
-
-	gsl_fft_real_transform(data, stride, n, real, work);
-	gsl_fft_real_wavetable_free(real);
-	gsl_fft_real_workspace_free(work);
+	nsl_fft_real_transform(data, stride, n);
 
 	/* 2. unpack data */
 	gsl_fft_halfcomplex_unpack(data, result, stride, n);
@@ -155,7 +147,7 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 		break;
 	}
 
-	free(result);
+	nsl_fft_buffer_free(result, 2 * n);
 
 	return 0;
 }
@@ -47,6 +47,11 @@ extern const char* nsl_dft_result_type_name[];
 typedef enum { nsl_dft_xscale_frequency, nsl_dft_xscale_index, nsl_dft_xscale_period } nsl_dft_xscale;
 extern const char* nsl_dft_xscale_name[];
 
+/* method: transform of the full signal or averaged power spectral density of overlapping segments (Welch's method) */
+#define NSL_DFT_METHOD_COUNT 2
+typedef enum { nsl_dft_method_full, nsl_dft_method_welch } nsl_dft_method;
+extern const char* nsl_dft_method_name[];
+
 /* transform data of size n. result in data
 	calculates the two-sided DFT
 */
@@ -0,0 +1,433 @@
+/*
+	File                 : nsl_fft.cpp
+	Project              : LabPlot
+	Description          : NSL cache of the FFT plans and wavetables
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "nsl_fft.h"
+
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
+#ifdef HAVE_FFTW3
+#include <fftw3.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+/* The plans (FFTW) and wavetables (GSL) depend only on the size and the kind of the transform
+ * and are reused for all transforms of the same kind. The live data sources recalculate the spectra
+ * of the same size many times per second and the plan creation is often more expensive than the transform itself.
+ *
+ * The FFTW planner is not thread-safe, all calls to it are serialized with plannerMutex. The planning is done
+ * without holding the lock of the cache, the lookups of the plans available already are not blocked by it.
+ * The execution of a plan with the new-array functions (fftw_execute_dft_r2c() etc.) is thread-safe,
+ * the arrays need to have the same alignment as the arrays used for the planning, that's why the alignment is part of the key.
+ * The GSL wavetables are read-only in the transform and can be shared between the threads too.
+ */
+namespace {
+// maximal number of cached plans and wavetables, the least recently used are removed first
+constexpr size_t maxCacheSize = 32;
+// alignment of the buffers, sufficient for all SIMD instruction sets used by FFTW
+constexpr size_t bufferAlignment = 64;
+// maximal number of released buffers kept per thread
+constexpr size_t maxPoolSize = 4;
+
+enum class Kind { R2C, C2R, C2CForward, C2CBackward, GslReal, GslHalfcomplex, GslComplex };
+
+struct Key {
+	size_t n;
+	Kind kind;
+	int inAlignment; // offset of the arrays to the SIMD alignment in bytes
+	int outAlignment;
+	bool inplace;
+	unsigned int flags; // planner flags
+
+	bool operator==(const Key& other) const {
+		return n == other.n && kind == other.kind && inAlignment == other.inAlignment && outAlignment == other.outAlignment && inplace == other.inplace
+			&& flags == other.flags;
+	}
+};
+
+struct KeyHash {
+	size_t operator()(const Key& key) const {
+		size_t hash = std::hash<size_t>()(key.n);
+		hash ^= (static_cast<size_t>(key.kind) << 1) ^ (static_cast<size_t>(key.inAlignment) << 5) ^ (static_cast<size_t>(key.outAlignment) << 12)
+			^ (static_cast<size_t>(key.inplace) << 19) ^ (static_cast<size_t>(key.flags) << 20);
+		return hash;
+	}
+};
+
+struct Entry {
+	std::shared_ptr<void> object; // plan or wavetable
+	unsigned long long lastUse{0};
+};
+
+#ifdef HAVE_FFTW3
+// declared before the cache, the plans are destroyed under this lock when the cache is destroyed at exit
+std::mutex plannerMutex;
+#endif
+
+std::mutex cacheMutex;
+std::unordered_map<Key, Entry, KeyHash> cache;
+unsigned long long useCounter = 0;
+
+std::atomic<int> plannerMode{nsl_fft_planner_estimate};
+
+/* returns the cached object for key under the lock of the cache, nullptr if not available */
+std::shared_ptr<void> lookup(const Key& key) {
+	auto it = cache.find(key);
+	if (it == cache.end())
+		return {};
+
+	it->second.lastUse = ++useCounter;
+	return it->second.object;
+}
+
+/* returns the cached object for key, creates it with create() if not available yet.
+ * The returned object stays valid while it's used even if it's removed from the cache in the meantime.
+ * create() is called without holding the lock of the cache (the planning with FFTW_MEASURE can take seconds),
+ * the lookups of the other threads are not blocked meanwhile. If several threads create the object for the same key
+ * at the same time, the first one inserted into the cache is used. */
+template<typename Create>
+std::shared_ptr<void> cached(const Key& key, Create create) {
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		if (auto object = lookup(key))
+			return object;
+	}
+
+	std::shared_ptr<void> object = create();
+	if (!object)
+		return object;
+
+	// the replaced objects are destroyed after the lock is released, destroying a plan locks plannerMutex
+	std::shared_ptr<void> evicted;
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	if (auto existing = lookup(key)) {
+		evicted = std::move(object);
+		return existing;
+	}
+
+	if (cache.size() >= maxCacheSize) {
+		auto lru = std::min_element(cache.begin(), cache.end(), [](const auto& a, const auto& b) {
+			return a.second.lastUse < b.second.lastUse;
+		});
+		evicted = std::move(lru->second.object);
+		cache.erase(lru);
+	}
+	cache.emplace(key, Entry{object, ++useCounter});
+
+	return object;
+}
+
+double* allocate(size_t n) {
+	return static_cast<double*>(::operator new[](n * sizeof(double), std::align_val_t(bufferAlignment)));
+}
+
+void deallocate(double* buffer) {
+	::operator delete[](buffer, std::align_val_t(bufferAlignment));
+}
+
+// released buffers of the current thread, available for the next nsl_fft_buffer_alloc() in this thread
+struct BufferPool {
+	~BufferPool() {
+		for (const auto& buffer : buffers)
+			deallocate(buffer.first);
+	}
+
+	std::vector<std::pair<double*, size_t>> buffers;
+};
+thread_local BufferPool bufferPool;
+
+// GSL workspaces are modified in the transform and can't be shared, reuse them per thread
+struct GslWorkspaces {
+	~GslWorkspaces() {
+		if (real)
+			gsl_fft_real_workspace_free(real);
+		if (complex)
+			gsl_fft_complex_workspace_free(complex);
+	}
+
+	gsl_fft_real_workspace* realWorkspace(size_t n) {
+		if (real && real->n != n) {
+			gsl_fft_real_workspace_free(real);
+			real = nullptr;
+		}
+		if (!real)
+			real = gsl_fft_real_workspace_alloc(n);
+		return real;
+	}
+
+	gsl_fft_complex_workspace* complexWorkspace(size_t n) {
+		if (complex && complex->n != n) {
+			gsl_fft_complex_workspace_free(complex);
+			complex = nullptr;
+		}
+		if (!complex)
+			complex = gsl_fft_complex_workspace_alloc(n);
+		return complex;
+	}
+
+	gsl_fft_real_workspace* real{nullptr};
+	gsl_fft_complex_workspace* complex{nullptr};
+};
+thread_local GslWorkspaces gslWorkspaces;
+
+#ifdef HAVE_FFTW3
+unsigned int plannerFlags() {
+	return plannerMode == nsl_fft_planner_measure ? FFTW_MEASURE : FFTW_ESTIMATE;
+}
+
+/* creates the plan of the given kind for arrays with the alignment of in and out.
+ * FFTW_MEASURE overwrites the arrays during the planning, the planning is done on scratch arrays with the same alignment. */
+std::shared_ptr<void> createPlan(const Key& key) {
+	const size_t n = key.n;
+	size_t inSize = 0, outSize = 0;
+	switch (key.kind) {
+	case Kind::R2C:
+		inSize = key.inplace ? 2 * (n / 2 + 1) : n;
+		outSize = 2 * (n / 2 + 1);
+		break;
+	case Kind::C2R:
+		inSize = 2 * (n / 2 + 1);
+		outSize = key.inplace ? inSize : n;
+		break;
+	case Kind::C2CForward:
+	case Kind::C2CBackward:
+		inSize = outSize = 2 * n;
+		break;
+	default:
+		return {};
+	}
+
+	// scratch arrays with the same offset to the SIMD alignment as the arrays of the caller
+	const size_t padding = bufferAlignment / sizeof(double);
+	double* scratchIn = allocate(inSize + padding);
+	double* scratchOut = key.inplace ? nullptr : allocate(outSize + padding);
+	double* in = reinterpret_cast<double*>(reinterpret_cast<char*>(scratchIn) + key.inAlignment);
+	double* out = key.inplace ? in : reinterpret_cast<double*>(reinterpret_cast<char*>(scratchOut) + key.outAlignment);
+
+	fftw_plan plan = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(plannerMutex);
+		switch (key.kind) {
+		case Kind::R2C:
+			plan = fftw_plan_dft_r2c_1d((int)n, in, (fftw_complex*)out, key.flags);
+			break;
+		case Kind::C2R:
+			plan = fftw_plan_dft_c2r_1d((int)n, (fftw_complex*)in, out, key.flags);
+			break;
+		case Kind::C2CForward:
+			plan = fftw_plan_dft_1d((int)n, (fftw_complex*)in, (fftw_complex*)out, FFTW_FORWARD, key.flags);
+			break;
+		case Kind::C2CBackward:
+			plan = fftw_plan_dft_1d((int)n, (fftw_complex*)in, (fftw_complex*)out, FFTW_BACKWARD, key.flags);
+			break;
+		default:
+			break;
+		}
+	}
+
+	deallocate(scratchIn);
+	if (scratchOut)
+		deallocate(scratchOut);
+
+	if (!plan)
+		return {};
+
+	return std::shared_ptr<void>(plan, [](void* p) {
+		std::lock_guard<std::mutex> lock(plannerMutex);
+		fftw_destroy_plan(static_cast<fftw_plan>(p));
+	});
+}
+
+fftw_plan plan(Kind kind, size_t n, const double* in, const double* out, std::shared_ptr<void>& holder) {
+	const Key key{n, kind, fftw_alignment_of(const_cast<double*>(in)), fftw_alignment_of(const_cast<double*>(out)), in == out, plannerFlags()};
+	holder = cached(key, [&key]() {
+		return createPlan(key);
+	});
+	return static_cast<fftw_plan>(holder.get());
+}
+#endif
+}
+
+void nsl_fft_set_planner_mode(nsl_fft_planner_mode mode) {
+	plannerMode = mode;
+}
+
+nsl_fft_planner_mode nsl_fft_get_planner_mode(void) {
+	return static_cast<nsl_fft_planner_mode>(plannerMode.load());
+}
+
+int nsl_fft_import_wisdom(const char* filename) {
+#ifdef HAVE_FFTW3
+	std::lock_guard<std::mutex> lock(plannerMutex);
+	return fftw_import_wisdom_from_filename(filename) != 0;
+#else
+	(void)filename;
+	return 0;
+#endif
+}
+
+int nsl_fft_export_wisdom(const char* filename) {
+#ifdef HAVE_FFTW3
+	std::lock_guard<std::mutex> lock(plannerMutex);
+	return fftw_export_wisdom_to_filename(filename) != 0;
+#else
+	(void)filename;
+	return 0;
+#endif
+}
+
+size_t nsl_fft_cache_size(void) {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return cache.size();
+}
+
+void nsl_fft_cache_clear(void) {
+	// the plans are destroyed after the lock is released
+	std::unordered_map<Key, Entry, KeyHash> removed;
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	removed.swap(cache);
+}
+
+int nsl_fft_r2c(double in[], double out[], size_t n) {
+#ifdef HAVE_FFTW3
+	std::shared_ptr<void> holder;
+	fftw_plan p = plan(Kind::R2C, n, in, out, holder);
+	if (!p)
+		return -1;
+	fftw_execute_dft_r2c(p, in, (fftw_complex*)out);
+	return 0;
+#else
+	(void)in;
+	(void)out;
+	(void)n;
+	return -1;
+#endif
+}
+
+int nsl_fft_c2r(double in[], double out[], size_t n) {
+#ifdef HAVE_FFTW3
+	std::shared_ptr<void> holder;
+	fftw_plan p = plan(Kind::C2R, n, in, out, holder);
+	if (!p)
+		return -1;
+	fftw_execute_dft_c2r(p, (fftw_complex*)in, out);
+	return 0;
+#else
+	(void)in;
+	(void)out;
+	(void)n;
+	return -1;
+#endif
+}
+
+int nsl_fft_c2c(double in[], double out[], size_t n, int sign) {
+#ifdef HAVE_FFTW3
+	std::shared_ptr<void> holder;
+	fftw_plan p = plan(sign < 0 ? Kind::C2CForward : Kind::C2CBackward, n, in, out, holder);
+	if (!p)
+		return -1;
+	fftw_execute_dft(p, (fftw_complex*)in, (fftw_complex*)out);
+	return 0;
+#else
+	(void)in;
+	(void)out;
+	(void)n;
+	(void)sign;
+	return -1;
+#endif
+}
+
+int nsl_fft_real_transform(double data[], size_t stride, size_t n) {
+	const Key key{n, Kind::GslReal, 0, 0, true, 0};
+	const auto wavetable = cached(key, [n]() {
+		return std::shared_ptr<void>(gsl_fft_real_wavetable_alloc(n), [](void* p) {
+			gsl_fft_real_wavetable_free(static_cast<gsl_fft_real_wavetable*>(p));
+		});
+	});
+	auto* work = gslWorkspaces.realWorkspace(n);
+	if (!wavetable || !work)
+		return -1;
+
+	return gsl_fft_real_transform(data, stride, n, static_cast<gsl_fft_real_wavetable*>(wavetable.get()), work);
+}
+
+int nsl_fft_halfcomplex_inverse(double data[], size_t stride, size_t n) {
+	const Key key{n, Kind::GslHalfcomplex, 0, 0, true, 0};
+	const auto wavetable = cached(key, [n]() {
+		return std::shared_ptr<void>(gsl_fft_halfcomplex_wavetable_alloc(n), [](void* p) {
+			gsl_fft_halfcomplex_wavetable_free(static_cast<gsl_fft_halfcomplex_wavetable*>(p));
+		});
+	});
+	auto* work = gslWorkspaces.realWorkspace(n);
+	if (!wavetable || !work)
+		return -1;
+
+	return gsl_fft_halfcomplex_inverse(data, stride, n, static_cast<gsl_fft_halfcomplex_wavetable*>(wavetable.get()), work);
+}
+
+int nsl_fft_complex_inverse(double data[], size_t stride, size_t n) {
+	const Key key{n, Kind::GslComplex, 0, 0, true, 0};
+	const auto wavetable = cached(key, [n]() {
+		return std::shared_ptr<void>(gsl_fft_complex_wavetable_alloc(n), [](void* p) {
+			gsl_fft_complex_wavetable_free(static_cast<gsl_fft_complex_wavetable*>(p));
+		});
+	});
+	auto* work = gslWorkspaces.complexWorkspace(n);
+	if (!wavetable || !work)
+		return -1;
+
+	return gsl_fft_complex_inverse(data, stride, n, static_cast<gsl_fft_complex_wavetable*>(wavetable.get()), work);
+}
+
+double* nsl_fft_buffer_alloc(size_t n) {
+	auto& buffers = bufferPool.buffers;
+
+	// smallest released buffer that is large enough
+	auto best = buffers.end();
+	for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+		if (it->second >= n && (best == buffers.end() || it->second < best->second))
+			best = it;
+	}
+
+	if (best != buffers.end()) {
+		double* buffer = best->first;
+		buffers.erase(best);
+		return buffer;
+	}
+
+	return allocate(n);
+}
+
+void nsl_fft_buffer_free(double* buffer, size_t n) {
+	if (!buffer)
+		return;
+
+	auto& buffers = bufferPool.buffers;
+	if (buffers.size() < maxPoolSize) {
+		buffers.emplace_back(buffer, n);
+		return;
+	}
+
+	// keep the larger buffers
+	auto smallest = std::min_element(buffers.begin(), buffers.end(), [](const auto& a, const auto& b) {
+		return a.second < b.second;
+	});
+	if (smallest->second < n) {
+		deallocate(smallest->first);
+		*smallest = std::make_pair(buffer, n);
+	} else
+		deallocate(buffer);
+}
@@ -0,0 +1,72 @@
+/*
+	File                 : nsl_fft.h
+	Project              : LabPlot
+	Description          : NSL cache of the FFT plans and wavetables
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef NSL_FFT_H
+#define NSL_FFT_H
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#define __BEGIN_DECLS extern "C" {
+#define __END_DECLS }
+#else
+#define __BEGIN_DECLS /* empty */
+#define __END_DECLS /* empty */
+#endif
+__BEGIN_DECLS
+
+#include <stdlib.h>
+
+/* planner mode used for new FFTW plans:
+	estimate = FFTW_ESTIMATE, fast planning (default)
+	measure = FFTW_MEASURE, slower planning but faster transforms, the plans can be saved as wisdom
+   the GSL wavetables don't depend on the mode
+*/
+typedef enum { nsl_fft_planner_estimate, nsl_fft_planner_measure } nsl_fft_planner_mode;
+
+void nsl_fft_set_planner_mode(nsl_fft_planner_mode);
+nsl_fft_planner_mode nsl_fft_get_planner_mode(void);
+
+/* load/save the FFTW wisdom (accumulated plans) from/to file filename. returns 1 on success, 0 otherwise (and always without FFTW) */
+int nsl_fft_import_wisdom(const char* filename);
+int nsl_fft_export_wisdom(const char* filename);
+
+/* number of cached plans/wavetables and removal of all of them.
+   must not be called while transforms are running */
+size_t nsl_fft_cache_size(void);
+void nsl_fft_cache_clear(void);
+
+/* transforms using the cached plans (FFTW) or wavetables (GSL).
+   complex data is stored as interleaved real and imaginary parts.
+   the plans depend on the alignment of the arrays and on in-place vs. out-of-place,
+   the best performance is achieved with buffers allocated with nsl_fft_buffer_alloc().
+   all functions return 0 on success */
+
+/* real to complex (n/2+1 complex values), FFTW only */
+int nsl_fft_r2c(double in[], double out[], size_t n);
+/* complex (n/2+1 values) to real, unnormalized, in is overwritten. FFTW only */
+int nsl_fft_c2r(double in[], double out[], size_t n);
+/* complex to complex of size n, unnormalized. sign: -1 = forward, +1 = backward. FFTW only */
+int nsl_fft_c2c(double in[], double out[], size_t n, int sign);
+
+/* in-place real to halfcomplex transform, GSL only */
+int nsl_fft_real_transform(double data[], size_t stride, size_t n);
+/* in-place inverse halfcomplex to real transform (normalized), GSL only */
+int nsl_fft_halfcomplex_inverse(double data[], size_t stride, size_t n);
+/* in-place inverse complex transform (normalized), GSL only */
+int nsl_fft_complex_inverse(double data[], size_t stride, size_t n);
+
+/* SIMD aligned buffer for at least n doubles, taken from a per-thread pool of released buffers if possible.
+   release it with nsl_fft_buffer_free() using the same n to make it available for the next call */
+double* nsl_fft_buffer_alloc(size_t n);
+void nsl_fft_buffer_free(double* buffer, size_t n);
+
+__END_DECLS
+
+#endif /* NSL_FFT_H */
@@ -9,13 +9,10 @@
 
 #include "nsl_filter.h"
 #include "nsl_common.h"
+#include "nsl_fft.h"
 #include "nsl_sf_poly.h"
 #include <gsl/gsl_fft_halfcomplex.h>
-#include <gsl/gsl_fft_real.h>
 #include <gsl/gsl_sf_pow_int.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 
 const char* nsl_filter_type_name[] = {i18n("Low Pass"), i18n("High Pass"), i18n("Band Pass"), i18n("Band Reject")};
 const char* nsl_filter_form_name[] =
@@ -254,18 +251,11 @@ void print_fdata(double const data[], size_t n) {
 
 int nsl_filter_fourier(double data[], size_t n, nsl_filter_type type, nsl_filter_form form, int order, int cutindex, int bandwidth) {
 	/* 1. transform */
-	double* fdata = (double*)malloc(2 * n * sizeof(double)); /* contains re0,im0,re1,im1,re2,im2,... */
+	double* fdata = nsl_fft_buffer_alloc(2 * n); /* contains re0,im0,re1,im1,re2,im2,... */
 #ifdef HAVE_FFTW3
-	fftw_plan plan = fftw_plan_dft_r2c_1d((int)n, data, (fftw_complex*)fdata, FFTW_ESTIMATE);
-	fftw_execute(plan);
-	fftw_destroy_plan(plan);
+	nsl_fft_r2c(data, fdata, n);
 #else
-	gsl_fft_real_wavetable* real = gsl_fft_real_wavetable_alloc(n);
-	gsl_fft_real_workspace* work = gsl_fft_real_workspace_alloc(n);
-
-	gsl_fft_real_transform(data, 1, n, real, work);
-	gsl_fft_real_wavetable_free(real);
-
+	nsl_fft_real_transform(data, 1, n);
 	gsl_fft_halfcomplex_unpack(data, fdata, 1, n);
 #endif
 
@@ -276,20 +266,15 @@ int nsl_filter_fourier(double data[], size_t n, nsl_filter_type type, nsl_filter
 
 	/* 3. back transform */
 #ifdef HAVE_FFTW3
-	plan = fftw_plan_dft_c2r_1d((int)n, (fftw_complex*)fdata, data, FFTW_ESTIMATE);
-	fftw_execute(plan);
-	fftw_destroy_plan(plan);
+	nsl_fft_c2r(fdata, data, n);
 	/* normalize*/
 	size_t i;
 	for (i = 0; i < n; i++)
 		data[i] /= n;
 #else
-	gsl_fft_halfcomplex_wavetable* hc = gsl_fft_halfcomplex_wavetable_alloc(n);
-	gsl_fft_halfcomplex_inverse(data, 1, n, hc, work);
-	gsl_fft_halfcomplex_wavetable_free(hc);
-	gsl_fft_real_workspace_free(work);
+	nsl_fft_halfcomplex_inverse(data, 1, n);
 #endif
-	free(fdata);
+	nsl_fft_buffer_free(fdata, 2 * n);
 
 	return status;
 }
@@ -22,7 +22,10 @@ const char* nsl_geom_linesim_type_name[] = {i18n("Douglas-Peucker (Number)"),
 											i18n("Radial Distance"),
 											i18n("Interpolation"),
 											i18n("Opheim"),
-											i18n("Lang")};
+											i18n("Lang"),
+											i18n("Visvalingam-Whyatt (Number)"),
+											i18n("Largest-Triangle-Three-Buckets (Number)"),
+											i18n("MinMaxLTTB (Number)")};
 
 /*********** error calculation functions *********/
 
@@ -117,37 +120,296 @@ double nsl_geom_linesim_avg_dist_perpoint(const double xdata[], const double yda
 
 /*********** simplification algorithms *********/
 
-void nsl_geom_linesim_douglas_peucker_step(const double xdata[],
-										   const double ydata[],
-										   const size_t start,
-										   const size_t end,
-										   size_t* nout,
-										   const double tol,
-										   size_t index[]) {
-	/*printf("DP: %d - %d\n", start, end);*/
-
-	size_t i, nkey = start;
-	double maxdist = 0;
-	/* search for key (biggest perp. distance) */
-	for (i = start + 1; i < end; i++) {
-		double dist = nsl_geom_point_line_dist(xdata[start], ydata[start], xdata[end], ydata[end], xdata[i], ydata[i]);
-		if (dist > maxdist) {
-			maxdist = dist;
-			nkey = i;
+/* hull tree: binary tree over blocks of NSL_GEOM_LINESIM_HULL_BLOCK consecutive points where every node stores the upper and
+ * the lower convex hull (sorted by x) of its points. The point of a range with the largest perpendicular distance to a line
+ * is an extreme point of the hulls of the O(log n) nodes covering the range in one of the directions normal to the line,
+ * which is found by binary search on the hulls (idea of Hershberger and Snoeyink to speed up Douglas-Peucker).
+ * The hulls only provide upper bounds of the distances. The points of the blocks whose bound is not below the maximum
+ * (up to rounding errors) are tested like before, so the first point with the largest distance is taken for ties as before.
+ * This reduces the worst case of Douglas-Peucker from O(n^2) to O(n log^2 n) if there are not many points with the same distance. */
+#define NSL_GEOM_LINESIM_HULL_BLOCK 32
+
+typedef struct {
+	const double* xdata;
+	const double* ydata;
+	size_t n;
+	double tolerance; /* upper bound of the rounding errors of the distances */
+	size_t leaves; /* number of leaves (power of two) */
+	size_t* hull; /* vertices of the hulls of all nodes, NULL if the tree is not available */
+	size_t size, capacity;
+	size_t* start; /* the upper hull of node k starts at hull[start[2k]], the lower hull at hull[start[2k+1]] */
+	size_t* count; /* number of vertices of the hulls, same layout as start */
+} nsl_geom_linesim_hull_tree;
+
+/* point a comes before point b when sorted by x and y */
+static int nsl_geom_linesim_hull_before(const nsl_geom_linesim_hull_tree* tree, size_t a, size_t b) {
+	return tree->xdata[a] < tree->xdata[b] || (tree->xdata[a] == tree->xdata[b] && tree->ydata[a] < tree->ydata[b]);
+}
+
+static int nsl_geom_linesim_hull_reserve(nsl_geom_linesim_hull_tree* tree, size_t size) {
+	if (tree->size + size <= tree->capacity)
+		return 0;
+
+	size_t capacity = 2 * tree->capacity;
+	if (capacity < tree->size + size)
+		capacity = tree->size + size;
+	size_t* hull = (size_t*)realloc(tree->hull, capacity * sizeof(size_t));
+	if (hull == NULL)
+		return -1;
+	tree->hull = hull;
+	tree->capacity = capacity;
+	return 0;
+}
+
+/* appends the upper (upper = 1) or the lower hull of the np sorted points to the vertices, returns the number of vertices */
+static size_t nsl_geom_linesim_hull_chain(nsl_geom_linesim_hull_tree* tree, const size_t points[], size_t np, int upper) {
+	const double* x = tree->xdata;
+	const double* y = tree->ydata;
+	size_t* hull = tree->hull + tree->size;
+	size_t i, h = 0;
+	for (i = 0; i < np; i++) {
+		const size_t p = points[i];
+		while (h >= 2) {
+			const size_t a = hull[h - 2], b = hull[h - 1];
+			const double cross = (x[b] - x[a]) * (y[p] - y[a]) - (y[b] - y[a]) * (x[p] - x[a]);
+			if ((upper && cross >= 0) || (!upper && cross <= 0))
+				h--;
+			else
+				break;
+		}
+		hull[h++] = p;
+	}
+	tree->size += h;
+	return h;
+}
+
+static void nsl_geom_linesim_hull_tree_free(nsl_geom_linesim_hull_tree* tree) {
+	free(tree->hull);
+	free(tree->start);
+	free(tree->count);
+	tree->hull = NULL;
+	tree->start = NULL;
+	tree->count = NULL;
+}
+
+/* builds the hull tree of the n points. If there is not enough memory or the data is not finite, tree->hull is NULL and all points are tested */
+static void nsl_geom_linesim_hull_tree_init(nsl_geom_linesim_hull_tree* tree, const double xdata[], const double ydata[], const size_t n) {
+	tree->xdata = xdata;
+	tree->ydata = ydata;
+	tree->n = n;
+	tree->hull = NULL;
+	tree->start = NULL;
+	tree->count = NULL;
+
+	/* the rounding errors of the distances are small compared to the extent of the data */
+	double xmin = xdata[0], xmax = xdata[0], ymin = ydata[0], ymax = ydata[0];
+	size_t k, i, j;
+	for (i = 0; i < n; i++) {
+		if (!isfinite(xdata[i]) || !isfinite(ydata[i]))
+			return;
+		xmin = fmin(xmin, xdata[i]);
+		xmax = fmax(xmax, xdata[i]);
+		ymin = fmin(ymin, ydata[i]);
+		ymax = fmax(ymax, ydata[i]);
+	}
+	tree->tolerance = 1.e-10 * (xmax - xmin + ymax - ymin);
+
+	tree->leaves = 1;
+	while (tree->leaves * NSL_GEOM_LINESIM_HULL_BLOCK < n)
+		tree->leaves *= 2;
+	tree->size = 0;
+	tree->capacity = 2 * n;
+	tree->hull = (size_t*)malloc(tree->capacity * sizeof(size_t));
+	tree->start = (size_t*)malloc(4 * tree->leaves * sizeof(size_t));
+	tree->count = (size_t*)malloc(4 * tree->leaves * sizeof(size_t));
+	size_t* points = (size_t*)malloc((n + NSL_GEOM_LINESIM_HULL_BLOCK) * sizeof(size_t));
+	if (tree->hull == NULL || tree->start == NULL || tree->count == NULL || points == NULL) {
+		nsl_geom_linesim_hull_tree_free(tree);
+		free(points);
+		return;
+	}
+
+	/* leaves: hulls of the sorted points of the blocks */
+	int status = 0;
+	for (k = 0; k < tree->leaves; k++) {
+		const size_t node = tree->leaves + k;
+		const size_t first = k * NSL_GEOM_LINESIM_HULL_BLOCK;
+		const size_t last = (first + NSL_GEOM_LINESIM_HULL_BLOCK < n) ? first + NSL_GEOM_LINESIM_HULL_BLOCK : n;
+		size_t np = 0;
+		for (i = first; i < last; i++) { /* insertion sort */
+			j = np++;
+			while (j > 0 && nsl_geom_linesim_hull_before(tree, i, points[j - 1])) {
+				points[j] = points[j - 1];
+				j--;
+			}
+			points[j] = i;
+		}
+
+		if (nsl_geom_linesim_hull_reserve(tree, 2 * np) != 0) {
+			status = -1;
+			break;
+		}
+		tree->start[2 * node] = tree->size;
+		tree->count[2 * node] = nsl_geom_linesim_hull_chain(tree, points, np, 1);
+		tree->start[2 * node + 1] = tree->size;
+		tree->count[2 * node + 1] = nsl_geom_linesim_hull_chain(tree, points, np, 0);
+	}
+
+	/* inner nodes: hulls of the merged vertices of the hulls of the children */
+	for (k = tree->leaves - 1; k >= 1 && status == 0; k--) {
+		int h;
+		for (h = 0; h < 2; h++) {
+			const size_t na = tree->count[4 * k + h], nb = tree->count[4 * k + 2 + h];
+			if (nsl_geom_linesim_hull_reserve(tree, na + nb) != 0) {
+				status = -1;
+				break;
+			}
+
+			const size_t* a = tree->hull + tree->start[4 * k + h];
+			const size_t* b = tree->hull + tree->start[4 * k + 2 + h];
+			size_t np = 0;
+			i = 0;
+			j = 0;
+			while (i < na || j < nb) {
+				if (j == nb || (i < na && nsl_geom_linesim_hull_before(tree, a[i], b[j])))
+					points[np++] = a[i++];
+				else
+					points[np++] = b[j++];
+			}
+
+			tree->start[2 * k + h] = tree->size;
+			tree->count[2 * k + h] = nsl_geom_linesim_hull_chain(tree, points, np, h == 0);
+		}
+	}
+
+	free(points);
+	if (status != 0)
+		nsl_geom_linesim_hull_tree_free(tree);
+}
+
+/* vertex of the hull with the largest value of dx * x + dy * y (the projections along the hull are unimodal) */
+static size_t nsl_geom_linesim_hull_extreme(const nsl_geom_linesim_hull_tree* tree, const size_t hull[], size_t h, double dx, double dy) {
+	const double* x = tree->xdata;
+	const double* y = tree->ydata;
+	size_t lo = 0, hi = h - 1;
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		const size_t a = hull[mid], b = hull[mid + 1];
+		if (dx * (x[b] - x[a]) + dy * (y[b] - y[a]) > 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return hull[lo];
+}
+
+/* checks whether point i has a larger distance to the line start--end than the current maximum *maxdist at *key,
+ * for equal distances the first point is taken. Returns the distance of the point */
+static double nsl_geom_linesim_farthest_check(const double xdata[], const double ydata[], size_t start, size_t end, size_t i, double* maxdist, size_t* key) {
+	const double dist = nsl_geom_point_line_dist(xdata[start], ydata[start], xdata[end], ydata[end], xdata[i], ydata[i]);
+	if (dist > *maxdist || (dist == *maxdist && i < *key)) {
+		*maxdist = dist;
+		*key = i;
+	}
+	return dist;
+}
+
+static void nsl_geom_linesim_farthest_scan(const double xdata[], const double ydata[], size_t start, size_t end, size_t first, size_t last, double* maxdist, size_t* key) {
+	size_t i;
+	for (i = first; i <= last; i++)
+		nsl_geom_linesim_farthest_check(xdata, ydata, start, end, i, maxdist, key);
+}
+
+/* checks the extreme points of the hulls of the node, returns the largest distance of them which is an upper bound
+ * of the distances of all points of the node up to rounding errors */
+static double nsl_geom_linesim_farthest_node(const nsl_geom_linesim_hull_tree* tree, size_t start, size_t end, size_t node, double* maxdist, size_t* key) {
+	/* the distance is proportional to |dy * x - dx * y + c| */
+	const double dx = tree->xdata[end] - tree->xdata[start];
+	const double dy = tree->ydata[end] - tree->ydata[start];
+	double bound = -1;
+	int sign;
+	for (sign = -1; sign <= 1; sign += 2) {
+		const double ndx = sign * dy, ndy = -sign * dx;
+		const int h = ndy >= 0 ? 0 : 1; /* the extreme point is on the upper hull for directions pointing upwards */
+		const size_t count = tree->count[2 * node + h];
+		if (count > 0) {
+			const size_t i = nsl_geom_linesim_hull_extreme(tree, tree->hull + tree->start[2 * node + h], count, ndx, ndy);
+			const double dist = nsl_geom_linesim_farthest_check(tree->xdata, tree->ydata, start, end, i, maxdist, key);
+			if (dist > bound)
+				bound = dist;
 		}
 	}
-	/*printf("maxdist = %g @ i = %zu\n", maxdist, nkey);*/
+	return bound;
+}
 
-	if (maxdist > tol) {
-		/*printf("take %d\n", nkey);*/
-		index[(*nout)++] = nkey;
-		if (nkey - start > 1)
-			nsl_geom_linesim_douglas_peucker_step(xdata, ydata, start, nkey, nout, tol, index);
-		if (end - nkey > 1)
-			nsl_geom_linesim_douglas_peucker_step(xdata, ydata, nkey, end, nout, tol, index);
+/* tests the points of the node with the upper bound of the distances bound if they can have the maximal distance.
+ * The children are tested recursively down to the blocks whose points are all tested */
+static void nsl_geom_linesim_farthest_descend(const nsl_geom_linesim_hull_tree* tree,
+											  size_t start,
+											  size_t end,
+											  size_t node,
+											  double bound,
+											  double* maxdist,
+											  size_t* key) {
+	if (bound + tree->tolerance < *maxdist)
+		return;
+
+	if (node >= tree->leaves) {
+		const size_t first = (node - tree->leaves) * NSL_GEOM_LINESIM_HULL_BLOCK;
+		nsl_geom_linesim_farthest_scan(tree->xdata, tree->ydata, start, end, first, first + NSL_GEOM_LINESIM_HULL_BLOCK - 1, maxdist, key);
+		return;
 	}
 
-	/*printf("nout=%d\n", *nout);*/
+	const double left = nsl_geom_linesim_farthest_node(tree, start, end, 2 * node, maxdist, key);
+	const double right = nsl_geom_linesim_farthest_node(tree, start, end, 2 * node + 1, maxdist, key);
+	nsl_geom_linesim_farthest_descend(tree, start, end, 2 * node, left, maxdist, key);
+	nsl_geom_linesim_farthest_descend(tree, start, end, 2 * node + 1, right, maxdist, key);
+}
+
+/* searches the point in first..last (first > start, last < end) with the largest perpendicular distance to the line start--end.
+ * Returns the distance (-1 if there is no such point) and the index of the point in key */
+static double nsl_geom_linesim_farthest(const nsl_geom_linesim_hull_tree* tree, size_t start, size_t end, size_t first, size_t last, size_t* key) {
+	const double* x = tree->xdata;
+	const double* y = tree->ydata;
+	double maxdist = -1;
+	*key = first;
+
+	const size_t firstBlock = first / NSL_GEOM_LINESIM_HULL_BLOCK, lastBlock = last / NSL_GEOM_LINESIM_HULL_BLOCK;
+	/* the line is undefined for equal end points, all points are tested like for short ranges */
+	if (tree->hull == NULL || lastBlock - firstBlock < 4 || (x[start] == x[end] && y[start] == y[end])) {
+		nsl_geom_linesim_farthest_scan(x, y, start, end, first, last, &maxdist, key);
+		return maxdist;
+	}
+
+	/* points in the partially covered blocks at the borders */
+	nsl_geom_linesim_farthest_scan(x, y, start, end, first, (firstBlock + 1) * NSL_GEOM_LINESIM_HULL_BLOCK - 1, &maxdist, key);
+	nsl_geom_linesim_farthest_scan(x, y, start, end, lastBlock * NSL_GEOM_LINESIM_HULL_BLOCK, last, &maxdist, key);
+
+	/* nodes covering the blocks in between (at most two per level) */
+	size_t nodes[2 * 8 * sizeof(size_t)];
+	double bounds[2 * 8 * sizeof(size_t)];
+	size_t nnodes = 0;
+	size_t l = tree->leaves + firstBlock + 1, r = tree->leaves + lastBlock;
+	while (l < r) {
+		if (l & 1) {
+			bounds[nnodes] = nsl_geom_linesim_farthest_node(tree, start, end, l, &maxdist, key);
+			nodes[nnodes++] = l++;
+		}
+		if (r & 1) {
+			--r;
+			bounds[nnodes] = nsl_geom_linesim_farthest_node(tree, start, end, r, &maxdist, key);
+			nodes[nnodes++] = r;
+		}
+		l /= 2;
+		r /= 2;
+	}
+
+	/* the points of the nodes that can contain the maximum are tested to find the first point with the maximal distance */
+	size_t i;
+	for (i = 0; i < nnodes; i++)
+		nsl_geom_linesim_farthest_descend(tree, start, end, nodes[i], bounds[i], &maxdist, key);
+
+	return maxdist;
 }
 
 size_t nsl_geom_linesim_douglas_peucker(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]) {
@@ -156,7 +418,44 @@ size_t nsl_geom_linesim_douglas_peucker(const double xdata[], const double ydata
 	/*first point*/
 	index[nout++] = 0;
 
-	nsl_geom_linesim_douglas_peucker_step(xdata, ydata, 0, n - 1, &nout, tol, index);
+	if (n > 2) {
+		nsl_geom_linesim_hull_tree tree;
+		nsl_geom_linesim_hull_tree_init(&tree, xdata, ydata, n);
+
+		/* segments still to be divided (at most one per key) */
+		size_t* segments = (size_t*)malloc(2 * n * sizeof(size_t));
+		if (segments == NULL) {
+			printf("nsl_geom_linesim_douglas_peucker(): ERROR allocating memory!\n");
+			nsl_geom_linesim_hull_tree_free(&tree);
+			return 0;
+		}
+
+		size_t nsegments = 0;
+		segments[nsegments++] = 0;
+		segments[nsegments++] = n - 1;
+		while (nsegments > 0) {
+			const size_t end = segments[--nsegments];
+			const size_t start = segments[--nsegments];
+
+			/* search for key (biggest perp. distance) */
+			size_t key;
+			const double maxdist = nsl_geom_linesim_farthest(&tree, start, end, start + 1, end - 1, &key);
+			if (maxdist > tol) {
+				index[nout++] = key;
+				if (key - start > 1) {
+					segments[nsegments++] = start;
+					segments[nsegments++] = key;
+				}
+				if (end - key > 1) {
+					segments[nsegments++] = key;
+					segments[nsegments++] = end;
+				}
+			}
+		}
+
+		free(segments);
+		nsl_geom_linesim_hull_tree_free(&tree);
+	}
 
 	/* last point */
 	if (index[nout - 1] != n - 1)
@@ -172,10 +471,63 @@ size_t nsl_geom_linesim_douglas_peucker_auto(const double xdata[], const double
 	return nsl_geom_linesim_douglas_peucker(xdata, ydata, n, tol, index);
 }
 
+/* edge of the simplified line with the point of the largest distance in between (key) */
+typedef struct {
+	size_t start, end, key;
+	double dist;
+} nsl_geom_linesim_edge;
+
+/* edge a is divided before edge b: larger distance first, then the first edge */
+static int nsl_geom_linesim_edge_before(const nsl_geom_linesim_edge* a, const nsl_geom_linesim_edge* b) {
+	return a->dist > b->dist || (a->dist == b->dist && a->start < b->start);
+}
+
+static void nsl_geom_linesim_edge_push(nsl_geom_linesim_edge heap[], size_t* size, const nsl_geom_linesim_edge* edge) {
+	size_t p = (*size)++;
+	while (p > 0 && nsl_geom_linesim_edge_before(edge, &heap[(p - 1) / 2])) {
+		heap[p] = heap[(p - 1) / 2];
+		p = (p - 1) / 2;
+	}
+	heap[p] = *edge;
+}
+
+static nsl_geom_linesim_edge nsl_geom_linesim_edge_pop(nsl_geom_linesim_edge heap[], size_t* size) {
+	const nsl_geom_linesim_edge top = heap[0];
+	const nsl_geom_linesim_edge last = heap[--(*size)];
+	size_t p = 0;
+	for (;;) {
+		size_t child = 2 * p + 1;
+		if (child >= *size)
+			break;
+		if (child + 1 < *size && nsl_geom_linesim_edge_before(&heap[child + 1], &heap[child]))
+			child++;
+		if (!nsl_geom_linesim_edge_before(&heap[child], &last))
+			break;
+		heap[p] = heap[child];
+		p = child;
+	}
+	if (*size > 0)
+		heap[p] = last;
+	return top;
+}
+
+/* determines the key of the edge start--end and adds it to the heap if there are points in between */
+static void nsl_geom_linesim_edge_add(const nsl_geom_linesim_hull_tree* tree, nsl_geom_linesim_edge heap[], size_t* size, size_t start, size_t end) {
+	if (end - start < 2)
+		return;
+
+	nsl_geom_linesim_edge edge;
+	edge.start = start;
+	edge.end = end;
+	edge.dist = nsl_geom_linesim_farthest(tree, start, end, start + 1, end - 1, &edge.key);
+	nsl_geom_linesim_edge_push(heap, size, &edge);
+}
+
 /*
  * Douglas-Peucker variant:
  * The key of all edges of the current simplified line is calculated and only the
  * largest is added. This is repeated until nout is reached.
+ * The edges are kept in a heap sorted by the distance of their keys.
  * */
 double nsl_geom_linesim_douglas_peucker_variant(const double xdata[], const double ydata[], const size_t n, const size_t nout, size_t index[]) {
 	size_t i;
@@ -193,93 +545,36 @@ double nsl_geom_linesim_douglas_peucker_variant(const double xdata[], const doub
 	if (nout <= 2) /* use only first and last point (perp. dist is zero) */
 		return 0.0;
 
-	double* dist = (double*)malloc(n * sizeof(double));
-	if (dist == NULL) {
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ERROR allocating memory for 'dist'!\n"); */
+	nsl_geom_linesim_edge* edges = (nsl_geom_linesim_edge*)malloc(nout * sizeof(nsl_geom_linesim_edge));
+	if (edges == NULL) {
+		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ERROR allocating memory for 'edges'!\n"); */
 		return DBL_MAX;
 	}
 
-	double* maxdist = (double*)malloc(nout * sizeof(double)); /* max dist per edge */
-	if (maxdist == NULL) {
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ERROR allocating memory for 'maxdist'!\n"); */
-		free(dist);
-		return DBL_MAX;
-	}
+	nsl_geom_linesim_hull_tree tree;
+	nsl_geom_linesim_hull_tree_init(&tree, xdata, ydata, n);
 
-	for (i = 0; i < n; i++) { /* initialize  dist */
-		dist[i] = nsl_geom_point_line_dist(xdata[0], ydata[0], xdata[n - 1], ydata[n - 1], xdata[i], ydata[i]);
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): %zu dist = %g\n", i, dist[i]); */
-	}
-	for (i = 0; i < nout; i++)
-		maxdist[i] = 0;
+	size_t nedges = 0;
+	nsl_geom_linesim_edge_add(&tree, edges, &nedges, 0, n - 1);
 
 	double newmaxdist = 0;
-	do {
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): NEXT ITERATION\n"); */
-		size_t key = 0;
-
-		/* find edge of maximum */
-		size_t maxindex;
-		nsl_stats_maximum(maxdist, ncount, &maxindex);
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): found edge with max dist at index %zu\n", maxindex); */
-		/*newmaxdist = nsl_stats_maximum(dist, n, &key);*/
-		newmaxdist = 0;
-		for (i = index[maxindex] + 1; i < index[maxindex + 1]; i++) {
-			/* printf("nsl_geom_linesim_douglas_peucker_variant(): iterate i=%zu\n", i); */
-			if (dist[i] > newmaxdist) {
-				newmaxdist = dist[i];
-				key = i;
-			}
-		}
-
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): found key %zu (dist = %g)\n", key, newmaxdist); */
-		ncount++;
-		dist[key] = 0;
-
-		/* find index of previous key */
-		size_t previndex = 0;
-		while (index[previndex + 1] < key)
-			previndex++;
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): previndex = %zu (update keys %zu - %zu)\n", previndex, index[previndex], index[previndex+1]); */
+	while (ncount < nout && nedges > 0) {
+		/* divide the edge with the largest distance at its key */
+		const nsl_geom_linesim_edge edge = nsl_geom_linesim_edge_pop(edges, &nedges);
+		newmaxdist = edge.dist > 0 ? edge.dist : 0;
+		index[ncount++] = edge.key;
 
-		size_t v;
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ncount = %zu, previndex = %zu\n", ncount, previndex); */
-		/* update dist[]. no update on last key */
+		/* no update on last key */
 		if (ncount < nout) {
-			/* shift maxdist */
-			for (v = ncount; v > previndex; v--)
-				maxdist[v] = maxdist[v - 1];
-
-			double tmpmax = 0;
-			for (v = index[previndex] + 1; v < key; v++) {
-				/* printf("nsl_geom_linesim_douglas_peucker_variant(): %zu in %zu - %zu", v, index[previndex], key); */
-				dist[v] = nsl_geom_point_line_dist(xdata[index[previndex]], ydata[index[previndex]], xdata[key], ydata[key], xdata[v], ydata[v]);
-				if (dist[v] > tmpmax)
-					tmpmax = dist[v];
-
-				/* printf(" dist = %g\n", dist[v]); */
-			}
-			maxdist[previndex] = tmpmax;
-
-			tmpmax = 0;
-			for (v = key + 1; v < index[previndex + 1]; v++) {
-				/* printf("nsl_geom_linesim_douglas_peucker_variant(): %zu in %zu - %zu", v, key, index[previndex+1]); */
-				dist[v] = nsl_geom_point_line_dist(xdata[key], ydata[key], xdata[index[previndex + 1]], ydata[index[previndex + 1]], xdata[v], ydata[v]);
-				if (dist[v] > tmpmax)
-					tmpmax = dist[v];
-				/* printf(" dist = %g\n", dist[v]); */
-			}
-			maxdist[previndex + 1] = tmpmax;
+			nsl_geom_linesim_edge_add(&tree, edges, &nedges, edge.start, edge.key);
+			nsl_geom_linesim_edge_add(&tree, edges, &nedges, edge.key, edge.end);
 		}
+	}
 
-		/* put into index array */
-		for (v = ncount; v > previndex + 1; v--)
-			index[v] = index[v - 1];
-		index[previndex + 1] = key;
-	} while (ncount < nout);
+	nsl_geom_linesim_hull_tree_free(&tree);
+	free(edges);
 
-	free(maxdist);
-	free(dist);
+	nsl_sort_size_t(index, ncount);
 
 	return newmaxdist;
 }
@@ -446,91 +741,155 @@ size_t nsl_geom_linesim_interp_auto(const double xdata[], const double ydata[],
 	return nsl_geom_linesim_interp(xdata, ydata, n, tol, index);
 }
 
-size_t nsl_geom_linesim_visvalingam_whyatt(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]) {
-	if (n < 3) /* we need at least three points */
-		return 0;
+/* min-heap of the points sorted by their effective area used by Visvalingam-Whyatt */
+typedef struct {
+	double* area; /* effective area of every point */
+	size_t* heap; /* points in the heap */
+	size_t size;
+	size_t* pos; /* position of every point in the heap */
+} nsl_geom_linesim_vw_heap;
 
+static int nsl_geom_linesim_vw_before(const nsl_geom_linesim_vw_heap* heap, size_t a, size_t b) {
+	return heap->area[a] < heap->area[b] || (heap->area[a] == heap->area[b] && a < b);
+}
+
+static void nsl_geom_linesim_vw_set(nsl_geom_linesim_vw_heap* heap, size_t p, size_t point) {
+	heap->heap[p] = point;
+	heap->pos[point] = p;
+}
+
+static void nsl_geom_linesim_vw_sift_down(nsl_geom_linesim_vw_heap* heap, size_t p) {
+	const size_t point = heap->heap[p];
+	for (;;) {
+		size_t child = 2 * p + 1;
+		if (child >= heap->size)
+			break;
+		if (child + 1 < heap->size && nsl_geom_linesim_vw_before(heap, heap->heap[child + 1], heap->heap[child]))
+			child++;
+		if (!nsl_geom_linesim_vw_before(heap, heap->heap[child], point))
+			break;
+		nsl_geom_linesim_vw_set(heap, p, heap->heap[child]);
+		p = child;
+	}
+	nsl_geom_linesim_vw_set(heap, p, point);
+}
+
+/* Visvalingam-Whyatt: the remaining points are kept in a doubly linked list and in the heap, the point with the smallest
+ * area (the first one for equal areas) is removed until its area is not smaller than tol or only nmin points are left.
+ * Returns the number of points and the area of the last removed point in lastarea */
+static size_t
+nsl_geom_linesim_vw(const double xdata[], const double ydata[], const size_t n, const double tol, const size_t nmin, size_t index[], double* lastarea) {
 	size_t i, nout = n;
-	double* area = (double*)malloc((n - 2) * sizeof(double)); /* area associated with every point */
-	if (area == NULL) {
+	nsl_geom_linesim_vw_heap heap;
+	heap.area = (double*)malloc(n * sizeof(double));
+	heap.heap = (size_t*)malloc(n * sizeof(size_t));
+	heap.pos = (size_t*)malloc(n * sizeof(size_t));
+	size_t* prev = (size_t*)malloc(n * sizeof(size_t));
+	size_t* next = (size_t*)malloc(n * sizeof(size_t));
+	if (heap.area == NULL || heap.heap == NULL || heap.pos == NULL || prev == NULL || next == NULL) {
 		printf("nsl_geom_linesim_visvalingam_whyatt(): ERROR allocating memory!\n");
+		free(heap.area);
+		free(heap.heap);
+		free(heap.pos);
+		free(prev);
+		free(next);
 		return 0;
 	}
-	for (i = 0; i < n; i++)
-		index[i] = i;
-	for (i = 1; i < n - 1; i++)
-		area[i - 1] = nsl_geom_three_point_area(xdata[i - 1], ydata[i - 1], xdata[i], ydata[i], xdata[i + 1], ydata[i + 1]);
-
-	size_t minindex;
-	while (nsl_stats_minimum(area, n - 2, &minindex) < tol && nout > 2) {
-		/* double minarea;
-		while ( (minarea = nsl_stats_minimum(area, n-2, &minindex)) < tol && nout > 2) { */
-		/*for (i=0; i < n-2; i++)
-			if (area[i]<DBL_MAX)
-				printf("area[%zu] = %g\n", i, area[i]);
-		*/
-		/* remove point minindex */
-		/*printf("removing point %zu (minindex = %zu, minarea = %g) nout=%zu\n", minindex+1, minindex, minarea, nout-1);*/
-		index[minindex + 1] = 0;
-		area[minindex] = DBL_MAX;
+
+	heap.size = 0;
+	for (i = 1; i < n - 1; i++) {
+		prev[i] = i - 1;
+		next[i] = i + 1;
+		heap.area[i] = nsl_geom_three_point_area(xdata[i - 1], ydata[i - 1], xdata[i], ydata[i], xdata[i + 1], ydata[i + 1]);
+		nsl_geom_linesim_vw_set(&heap, heap.size++, i);
+	}
+	for (i = heap.size / 2; i > 0; i--)
+		nsl_geom_linesim_vw_sift_down(&heap, i - 1);
+	next[0] = 1;
+
+	*lastarea = 0;
+	while (heap.size > 0 && nout > nmin) {
+		/* remove the point with the minimal area */
+		const size_t point = heap.heap[0];
+		if (!(heap.area[point] < tol))
+			break;
+		*lastarea = heap.area[point];
+		nsl_geom_linesim_vw_set(&heap, 0, heap.heap[--heap.size]);
+		if (heap.size > 0)
+			nsl_geom_linesim_vw_sift_down(&heap, 0);
+
+		const size_t before = prev[point], after = next[point];
+		next[before] = after;
+		if (after < n - 1)
+			prev[after] = before;
+
+		/* update area of neighbor points, take largest value of new and old area (the areas only grow) */
 		double tmparea;
-		/* update area of neighbor points */
-		size_t before = minindex, after = minindex + 2; /* find index before and after */
-		while (index[before] == 0 && before > 0)
-			before--;
-		while (after < n + 1 && index[after] == 0)
-			after++;
-		if (minindex > 0) { /*before */
-			if (before > 0) {
-				size_t beforebefore = before - 1;
-				while (index[beforebefore] == 0 && beforebefore > 0)
-					beforebefore--;
-				/*printf("recalculate area[%zu] from %zu %zu %zu\n", before-1, beforebefore, before, after);*/
-				tmparea = nsl_geom_three_point_area(xdata[beforebefore], ydata[beforebefore], xdata[before], ydata[before], xdata[after], ydata[after]);
-				if (tmparea > area[before - 1]) /* take largest value of new and old area */
-					area[before - 1] = tmparea;
+		if (before > 0) {
+			tmparea = nsl_geom_three_point_area(xdata[prev[before]], ydata[prev[before]], xdata[before], ydata[before], xdata[after], ydata[after]);
+			if (tmparea > heap.area[before]) {
+				heap.area[before] = tmparea;
+				nsl_geom_linesim_vw_sift_down(&heap, heap.pos[before]);
 			}
 		}
-		if (minindex < n - 3) { /* after */
-			if (after < n - 1) {
-				size_t afterafter = after + 1;
-				while (afterafter < n - 1 && index[afterafter] == 0)
-					afterafter++;
-				/*printf("recalculate area[%zu] from %zu %zu %zu\n",after-1, before, after, afterafter);*/
-				tmparea = nsl_geom_three_point_area(xdata[before], ydata[before], xdata[after], ydata[after], xdata[afterafter], ydata[afterafter]);
-				if (tmparea > area[after - 1]) /* take largest value of new and old area */
-					area[after - 1] = tmparea;
+		if (after < n - 1) {
+			tmparea = nsl_geom_three_point_area(xdata[before], ydata[before], xdata[after], ydata[after], xdata[next[after]], ydata[next[after]]);
+			if (tmparea > heap.area[after]) {
+				heap.area[after] = tmparea;
+				nsl_geom_linesim_vw_sift_down(&heap, heap.pos[after]);
 			}
 		}
 		nout--;
-	};
-
-	/*for(i=0;i<n;i++)
-		printf("INDEX = %d\n", index[i]);
-	*/
-
-	/* condens index */
-	i = 1;
-	size_t newi = 1;
-	while (newi < n - 1) {
-		while (index[newi] == 0)
-			newi++;
-		index[i++] = index[newi++];
-	};
-
-	/*for(i=0;i<nout;i++)
-		printf("INDEX2 = %d\n", index[i]);
-	*/
-
-	free(area);
+	}
+
+	/* remaining points */
+	i = 0;
+	size_t point = 0;
+	while (point < n - 1) {
+		index[i++] = point;
+		point = next[point];
+	}
+	index[i] = n - 1;
+
+	free(heap.area);
+	free(heap.heap);
+	free(heap.pos);
+	free(prev);
+	free(next);
 	return nout;
 }
+
+size_t nsl_geom_linesim_visvalingam_whyatt(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]) {
+	if (n < 3) /* we need at least three points */
+		return 0;
+
+	double lastarea;
+	return nsl_geom_linesim_vw(xdata, ydata, n, tol, 2, index, &lastarea);
+}
 size_t nsl_geom_linesim_visvalingam_whyatt_auto(const double xdata[], const double ydata[], const size_t n, size_t index[]) {
 	double tol = nsl_geom_linesim_clip_area_perpoint(xdata, ydata, n);
 
 	return nsl_geom_linesim_visvalingam_whyatt(xdata, ydata, n, tol, index);
 }
 
+/*
+ * Visvalingam-Whyatt variant:
+ * The points with the smallest effective area are removed until nout points are left.
+ * */
+double nsl_geom_linesim_visvalingam_whyatt_variant(const double xdata[], const double ydata[], const size_t n, const size_t nout, size_t index[]) {
+	size_t i;
+	if (nout >= n || n < 3) { /* use all points */
+		for (i = 0; i < n; i++)
+			index[i] = i;
+		return 0;
+	}
+
+	double lastarea = 0;
+	if (nsl_geom_linesim_vw(xdata, ydata, n, DBL_MAX, nout > 2 ? nout : 2, index, &lastarea) == 0)
+		return DBL_MAX;
+	return lastarea;
+}
+
 size_t nsl_geom_linesim_reumann_witkam(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]) {
 	size_t i, nout = 0, key = 0, key2 = 1;
 
@@ -654,3 +1013,114 @@ size_t nsl_geom_linesim_lang_auto(const double xdata[], const double ydata[], co
 
 	return nsl_geom_linesim_lang(xdata, ydata, n, tol, region, index);
 }
+
+/* Largest-Triangle-Three-Buckets: the inner points are divided into nout - 2 buckets with the same number of points,
+ * the point of every bucket forming the largest triangle with the point selected in the previous bucket
+ * and the average of the next bucket is taken */
+size_t nsl_geom_linesim_lttb(const double xdata[], const double ydata[], const size_t n, const size_t nout, size_t index[]) {
+	size_t i, j;
+	if (nout >= n || nout < 2) { /* use all points */
+		for (i = 0; i < n; i++)
+			index[i] = i;
+		return n;
+	}
+
+	const double every = nout > 2 ? (double)(n - 2) / (double)(nout - 2) : 0.; /* bucket size */
+	size_t key = 0, count = 0;
+	index[count++] = 0;
+	for (i = 0; i < nout - 2; i++) {
+		/* average of the next bucket (the last point for the last bucket) */
+		size_t start = (size_t)((i + 1) * every) + 1, end = (size_t)((i + 2) * every) + 1;
+		if (end > n)
+			end = n;
+		double avgx = 0, avgy = 0;
+		for (j = start; j < end; j++) {
+			avgx += xdata[j];
+			avgy += ydata[j];
+		}
+		avgx /= (double)(end - start);
+		avgy /= (double)(end - start);
+
+		/* point of the current bucket with the largest triangle */
+		start = (size_t)(i * every) + 1;
+		end = (size_t)((i + 1) * every) + 1;
+		double maxarea = -1.;
+		size_t maxindex = start;
+		for (j = start; j < end; j++) {
+			const double area = nsl_geom_three_point_area(xdata[key], ydata[key], xdata[j], ydata[j], avgx, avgy);
+			if (area > maxarea) {
+				maxarea = area;
+				maxindex = j;
+			}
+		}
+		index[count++] = key = maxindex;
+	}
+	index[count++] = n - 1;
+
+	return count;
+}
+
+/* MinMaxLTTB: the minimum and maximum of ratio * nout / 2 buckets of the inner points are preselected
+ * and LTTB is applied to the preselected points only */
+size_t nsl_geom_linesim_minmax_lttb(const double xdata[], const double ydata[], const size_t n, const size_t nout, const size_t ratio, size_t index[]) {
+	size_t i, j;
+	const size_t nbuckets = ratio * nout / 2;
+	if (nout >= n || nout < 3 || nbuckets == 0 || 2 * nbuckets + 2 >= n) /* nothing to preselect */
+		return nsl_geom_linesim_lttb(xdata, ydata, n, nout, index);
+
+	/* preselected points: first point, minimum and maximum of every bucket (in the order of the data) and last point */
+	size_t* selected = (size_t*)malloc((2 * nbuckets + 2) * sizeof(size_t));
+	double* x = (double*)malloc((2 * nbuckets + 2) * sizeof(double));
+	double* y = (double*)malloc((2 * nbuckets + 2) * sizeof(double));
+	if (selected == NULL || x == NULL || y == NULL) {
+		printf("nsl_geom_linesim_minmax_lttb(): ERROR allocating memory!\n");
+		free(selected);
+		free(x);
+		free(y);
+		return 0;
+	}
+
+	const double every = (double)(n - 2) / (double)nbuckets;
+	size_t nselected = 0;
+	selected[nselected++] = 0;
+	for (i = 0; i < nbuckets; i++) {
+		const size_t start = (size_t)(i * every) + 1;
+		size_t end = (size_t)((i + 1) * every) + 1;
+		if (end > n - 1)
+			end = n - 1;
+		if (start >= end)
+			continue;
+
+		size_t minindex = start, maxindex = start;
+		for (j = start + 1; j < end; j++) {
+			if (ydata[j] < ydata[minindex])
+				minindex = j;
+			else if (ydata[j] > ydata[maxindex])
+				maxindex = j;
+		}
+		if (minindex < maxindex) {
+			selected[nselected++] = minindex;
+			selected[nselected++] = maxindex;
+		} else if (minindex > maxindex) {
+			selected[nselected++] = maxindex;
+			selected[nselected++] = minindex;
+		} else
+			selected[nselected++] = minindex;
+	}
+	selected[nselected++] = n - 1;
+
+	for (i = 0; i < nselected; i++) {
+		x[i] = xdata[selected[i]];
+		y[i] = ydata[selected[i]];
+	}
+
+	/* index of the preselected points to index of the data points */
+	const size_t count = nsl_geom_linesim_lttb(x, y, nselected, nout, index);
+	for (i = 0; i < count; i++)
+		index[i] = selected[index[i]];
+
+	free(selected);
+	free(x);
+	free(y);
+	return count;
+}
@@ -9,7 +9,6 @@
 
 /*
 	TODO:
-	* accelerate Visvalingam-Whyatt
 	* calculate error statistics
 	* more algorithms: Jenks, Zhao-Saalfeld
 	* non-parametric version of Visvalingam-Whyatt, Opheim and Lang
@@ -20,7 +19,7 @@
 
 #include <stdlib.h>
 
-#define NSL_GEOM_LINESIM_TYPE_COUNT 10
+#define NSL_GEOM_LINESIM_TYPE_COUNT 13
 typedef enum {
 	nsl_geom_linesim_type_douglas_peucker_variant,
 	nsl_geom_linesim_type_douglas_peucker,
@@ -31,7 +30,10 @@ typedef enum {
 	nsl_geom_linesim_type_raddist,
 	nsl_geom_linesim_type_interp,
 	nsl_geom_linesim_type_opheim,
-	nsl_geom_linesim_type_lang
+	nsl_geom_linesim_type_lang,
+	nsl_geom_linesim_type_visvalingam_whyatt_variant,
+	nsl_geom_linesim_type_lttb,
+	nsl_geom_linesim_type_minmax_lttb
 } nsl_geom_linesim_type;
 extern const char* nsl_geom_linesim_type_name[];
 
@@ -65,7 +67,7 @@ double nsl_geom_linesim_avg_dist_perpoint(const double xdata[], const double yda
 
 /*********** simplification algorithms *********/
 
-/* Douglas-Peucker line simplification
+/* Douglas-Peucker line simplification (O(n log^2 n), O(n^2) in the worst case of many points with the same distance)
 	xdata, ydata: data points
 	n: number of points
 	tol: minimum tolerance (perpendicular distance)
@@ -125,7 +127,7 @@ size_t nsl_geom_linesim_perpdist_repeat(const double xdata[], const double ydata
 size_t nsl_geom_linesim_interp(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]);
 size_t nsl_geom_linesim_interp_auto(const double xdata[], const double ydata[], const size_t n, size_t index[]);
 
-/* Visvalingam-Whyatt line simplification
+/* Visvalingam-Whyatt line simplification (O(n log n))
 	xdata, ydata: data points
 	n: number of points
 	tol: tolerance (area)
@@ -134,6 +136,14 @@ size_t nsl_geom_linesim_interp_auto(const double xdata[], const double ydata[],
 */
 size_t nsl_geom_linesim_visvalingam_whyatt(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]);
 size_t nsl_geom_linesim_visvalingam_whyatt_auto(const double xdata[], const double ydata[], const size_t n, size_t index[]);
+/* Visvalingam-Whyatt variant resulting in a given number of points (the nout points with the largest effective area)
+	xdata, ydata: data points
+	n: number of points
+	nout: number of output points
+	index: index of reduced points
+	-> returns effective area of the last removed point (upper limit for all removed points)
+*/
+double nsl_geom_linesim_visvalingam_whyatt_variant(const double xdata[], const double ydata[], const size_t n, const size_t nout, size_t index[]);
 
 /* Reumann-Witkam line simplification
 	xdata, ydata: data points
@@ -167,4 +177,23 @@ size_t nsl_geom_linesim_opheim_auto(const double xdata[], const double ydata[],
 size_t nsl_geom_linesim_lang(const double xdata[], const double ydata[], const size_t n, const double tol, const size_t region, size_t index[]);
 size_t nsl_geom_linesim_lang_auto(const double xdata[], const double ydata[], const size_t n, size_t index[]);
 
+/* Largest-Triangle-Three-Buckets (LTTB) downsampling (O(n))
+	xdata, ydata: data points
+	n: number of points
+	nout: number of output points
+	index: index of reduced points
+	-> returns final number of points
+*/
+size_t nsl_geom_linesim_lttb(const double xdata[], const double ydata[], const size_t n, const size_t nout, size_t index[]);
+
+/* MinMaxLTTB downsampling, LTTB applied to the minimum and maximum points of ratio * nout / 2 buckets (O(n))
+	xdata, ydata: data points
+	n: number of points
+	nout: number of output points
+	ratio: number of preselected points per output point (4 is a good default)
+	index: index of reduced points
+	-> returns final number of points
+*/
+size_t nsl_geom_linesim_minmax_lttb(const double xdata[], const double ydata[], const size_t n, const size_t nout, const size_t ratio, size_t index[]);
+
 #endif /* NSL_GEOM_LINESIM_H */
@@ -9,11 +9,8 @@
 
 #include "nsl_hilbert.h"
 #include "nsl_common.h"
-#include <gsl/gsl_fft_complex.h>
+#include "nsl_fft.h"
 #include <gsl/gsl_fft_halfcomplex.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 
 const char* nsl_hilbert_result_type_name[] = {i18n("Imaginary Part"), i18n("Envelope")};
 
@@ -26,7 +23,7 @@ int nsl_hilbert_transform(double data[], size_t stride, size_t n, nsl_hilbert_re
 	nsl_dft_transform(data, stride, n, 1, nsl_dft_result_raw);
 
 	const size_t N = 2 * n;
-	double* result = (double*)malloc(N * sizeof(double));
+	double* result = nsl_fft_buffer_alloc(N);
 	gsl_fft_halfcomplex_unpack(data, result, stride, n);
 
 	size_t i;
@@ -51,18 +48,9 @@ int nsl_hilbert_transform(double data[], size_t stride, size_t n, nsl_hilbert_re
 	*/
 	/* 3. back transform */
 #ifdef HAVE_FFTW3
-	fftw_complex* o = (fftw_complex*)malloc(N * sizeof(double));
-	fftw_plan pb = fftw_plan_dft_1d((int)n, o, o, FFTW_BACKWARD, FFTW_ESTIMATE);
-
-	fftw_execute_dft(pb, (fftw_complex*)result, (fftw_complex*)result);
-	fftw_destroy_plan(pb);
-	free(o);
+	nsl_fft_c2c(result, result, n, 1);
 #else
-	gsl_fft_complex_workspace* work = gsl_fft_complex_workspace_alloc(n);
-	gsl_fft_complex_wavetable* hc = gsl_fft_complex_wavetable_alloc(n);
-	gsl_fft_complex_inverse(result, 1, n, hc, work);
-	gsl_fft_complex_wavetable_free(hc);
-	gsl_fft_complex_workspace_free(work);
+	nsl_fft_complex_inverse(result, 1, n);
 #endif
 
 	/*	for (i = 0; i < N; i++)
@@ -92,7 +80,7 @@ int nsl_hilbert_transform(double data[], size_t stride, size_t n, nsl_hilbert_re
 #endif
 	}
 
-	free(result);
+	nsl_fft_buffer_free(result, N);
 
 	return 0;
 }
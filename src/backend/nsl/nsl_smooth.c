@@ -35,330 +35,599 @@ const char* nsl_smooth_weight_type_name[] = {i18n("Uniform (Rectangular)"),
 											 i18n("Cosine")};
 double nsl_smooth_pad_constant_lvalue = 0.0, nsl_smooth_pad_constant_rvalue = 0.0;
 
+/* weights of the central moving average with np points */
+static void nsl_smooth_weights(double* w, size_t np, nsl_smooth_weight_type weight) {
+	size_t j;
+	double sum = 0.0;
+	switch (weight) {
+	case nsl_smooth_weight_uniform:
+		for (j = 0; j < np; j++)
+			w[j] = 1. / np;
+		break;
+	case nsl_smooth_weight_triangular:
+		sum = gsl_pow_2((double)(np + 1) / 2);
+		for (j = 0; j < np; j++)
+			w[j] = GSL_MIN(j + 1, np - j) / sum;
+		break;
+	case nsl_smooth_weight_binomial:
+		sum = (np - 1) / 2.;
+		for (j = 0; j < np; j++)
+			w[j] = gsl_sf_choose((unsigned int)(2 * sum), (unsigned int)((sum + fabs(j - sum)) / pow(4., sum)));
+		break;
+	case nsl_smooth_weight_parabolic:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_parabolic(2. * (j - (np - 1) / 2.) / (np + 1));
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_quartic:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_quartic(2. * (j - (np - 1) / 2.) / (np + 1));
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_triweight:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_triweight(2. * (j - (np - 1) / 2.) / (np + 1));
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_tricube:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_tricube(2. * (j - (np - 1) / 2.) / (np + 1));
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_cosine:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_cosine((j - (np - 1) / 2.) / ((np + 1) / 2.));
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	}
+}
+
+/* weights of the lagged moving average with np points */
+static void nsl_smooth_weights_lagged(double* w, size_t np, nsl_smooth_weight_type weight) {
+	size_t j;
+	double sum = 0.0;
+	switch (weight) {
+	case nsl_smooth_weight_uniform:
+		for (j = 0; j < np; j++)
+			w[j] = 1. / np;
+		break;
+	case nsl_smooth_weight_triangular:
+		sum = np * (double)(np + 1) / 2;
+		for (j = 0; j < np; j++)
+			w[j] = (j + 1) / sum;
+		break;
+	case nsl_smooth_weight_binomial:
+		for (j = 0; j < np; j++) {
+			w[j] = gsl_sf_choose((unsigned int)(2 * (np - 1)), (unsigned int)j);
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_parabolic:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_parabolic(1. - (1 + j) / (double)np);
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_quartic:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_quartic(1. - (1 + j) / (double)np);
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_triweight:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_triweight(1. - (1 + j) / (double)np);
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_tricube:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_tricube(1. - (1 + j) / (double)np);
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_cosine:
+		for (j = 0; j < np; j++) {
+			w[j] = nsl_sf_kernel_cosine((np - 1 - j) / (double)np);
+			sum += w[j];
+		}
+		for (j = 0; j < np; j++)
+			w[j] /= sum;
+		break;
+	}
+}
+
+/* value of the signal at the index (also outside of [0, n-1]) for the padding mode (see nsl_smooth_pad_mode) */
+static double nsl_smooth_padded_value(const double* data, int n, int index, nsl_smooth_pad_mode mode, double lvalue, double rvalue) {
+	switch (mode) {
+	case nsl_smooth_pad_none:
+	case nsl_smooth_pad_interp:
+		break;
+	case nsl_smooth_pad_mirror:
+		index = abs(index);
+		index = GSL_MIN(index, 2 * (n - 1) - index);
+		break;
+	case nsl_smooth_pad_nearest:
+		break;
+	case nsl_smooth_pad_constant:
+		if (index < 0)
+			return lvalue;
+		else if (index > n - 1)
+			return rvalue;
+		break;
+	case nsl_smooth_pad_periodic:
+		if (index < 0)
+			index += n;
+		else if (index > n - 1)
+			index -= n;
+		break;
+	}
+
+	/* windows larger than the signal can't be padded by a single reflection or period */
+	return data[GSL_MIN(n - 1, GSL_MAX(0, index))];
+}
+
+/* signal padded with left and right values, ext[k] is the value at the index k - left */
+static double* nsl_smooth_pad(const double* data, size_t n, size_t left, size_t right, nsl_smooth_pad_mode mode, double lvalue, double rvalue) {
+	double* ext = (double*)malloc((left + n + right) * sizeof(double));
+	if (!ext)
+		return NULL;
+
+	size_t k;
+	for (k = 0; k < left; k++)
+		ext[k] = nsl_smooth_padded_value(data, (int)n, (int)k - (int)left, mode, lvalue, rvalue);
+	memcpy(ext + left, data, n * sizeof(double));
+	for (k = 0; k < right; k++)
+		ext[left + n + k] = nsl_smooth_padded_value(data, (int)n, (int)(n + k), mode, lvalue, rvalue);
+
+	return ext;
+}
+
+/* the points before the first and after the last of the count full windows starting at first
+ * get the value of the nearest full window (interpolating padding of the sliding window filters) */
+static void nsl_smooth_fill_edges(double* result, size_t n, size_t first, size_t count) {
+	size_t i;
+	for (i = 0; i < first; i++)
+		result[i] = result[first];
+	for (i = first + count; i < n; i++)
+		result[i] = result[first + count - 1];
+}
+
+/* sums[i] = x[i] + ... + x[i + len - 1] for the first count windows of x.
+ * running sum that is recalculated every len windows to not accumulate rounding errors */
+static void nsl_smooth_window_sums(const double* x, size_t count, size_t len, double* sums) {
+	size_t i, j;
+	double sum = 0.0;
+	for (i = 0; i < count; i++) {
+		if (i % len == 0) {
+			sum = 0.0;
+			for (j = 0; j < len; j++)
+				sum += x[i + j];
+		} else
+			sum += x[i + len - 1] - x[i - 1];
+		sums[i] = sum;
+	}
+}
+
+/* sums[i] = 1*x[i] + 2*x[i + 1] + ... + len*x[i + len - 1] for the first count windows of x,
+ * updated with the window sums (see nsl_smooth_window_sums()) and recalculated every len windows */
+static void nsl_smooth_window_ramp_sums(const double* x, size_t count, size_t len, const double* window_sums, double* sums) {
+	size_t i, j;
+	double sum = 0.0;
+	for (i = 0; i < count; i++) {
+		if (i % len == 0) {
+			sum = 0.0;
+			for (j = 0; j < len; j++)
+				sum += (j + 1) * x[i + j];
+		} else
+			sum += len * x[i + len - 1] - window_sums[i - 1];
+		sums[i] = sum;
+	}
+}
+
+/* weighted averages of the first count windows with np points of x (central or lagged weights).
+ * O(count) for uniform and triangular weights, O(count * np) for the other weights. */
+static int nsl_smooth_window_average(const double* x, size_t count, size_t np, nsl_smooth_weight_type weight, int lagged, double* result) {
+	size_t i, j;
+	if (count == 0)
+		return 0;
+
+	if (weight == nsl_smooth_weight_uniform) {
+		nsl_smooth_window_sums(x, count, np, result);
+		for (i = 0; i < count; i++)
+			result[i] /= np;
+	} else if (weight == nsl_smooth_weight_triangular && !lagged) {
+		/* the triangle is the convolution of two boxes with (np + 1)/2 and np + 1 - (np + 1)/2 points */
+		const size_t len1 = (np + 1) / 2, len2 = np + 1 - len1;
+		double* sums = (double*)malloc((count + len2 - 1) * sizeof(double));
+		if (!sums)
+			return -1;
+		nsl_smooth_window_sums(x, count + len2 - 1, len1, sums);
+		nsl_smooth_window_sums(sums, count, len2, result);
+		free(sums);
+
+		const double norm = gsl_pow_2((double)(np + 1) / 2);
+		for (i = 0; i < count; i++)
+			result[i] /= norm;
+	} else if (weight == nsl_smooth_weight_triangular) {
+		double* sums = (double*)malloc(count * sizeof(double));
+		if (!sums)
+			return -1;
+		nsl_smooth_window_sums(x, count, np, sums);
+		nsl_smooth_window_ramp_sums(x, count, np, sums, result);
+		free(sums);
+
+		const double norm = np * (double)(np + 1) / 2;
+		for (i = 0; i < count; i++)
+			result[i] /= norm;
+	} else {
+		double* w = (double*)malloc(np * sizeof(double));
+		if (!w)
+			return -1;
+		if (lagged)
+			nsl_smooth_weights_lagged(w, np, weight);
+		else
+			nsl_smooth_weights(w, np, weight);
+
+		for (i = 0; i < count; i++) {
+			double sum = 0.0;
+			for (j = 0; j < np; j++)
+				sum += w[j] * x[i + j];
+			result[i] = sum;
+		}
+		free(w);
+	}
+
+	return 0;
+}
+
 int nsl_smooth_moving_average(double* data, size_t n, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode) {
+	return nsl_smooth_moving_average_padded(data, n, points, weight, mode, nsl_smooth_pad_constant_lvalue, nsl_smooth_pad_constant_rvalue);
+}
+
+int nsl_smooth_moving_average_padded(double* data,
+									 size_t n,
+									 size_t points,
+									 nsl_smooth_weight_type weight,
+									 nsl_smooth_pad_mode mode,
+									 double lvalue,
+									 double rvalue) {
 	if (n == 0 || points == 0)
 		return -1;
 
 	size_t i, j;
+	/* no full window for the interpolation at the edges */
+	if (mode == nsl_smooth_pad_interp && n < points)
+		mode = nsl_smooth_pad_none;
+
 	double* result = (double*)malloc(n * sizeof(double));
-	for (i = 0; i < n; i++)
-		result[i] = 0;
+	if (!result)
+		return -1;
 
-	for (i = 0; i < n; i++) {
-		size_t np = points;
-		size_t half = (points - 1) / 2;
-		if (mode == nsl_smooth_pad_none) { /* reduce points */
-			half = GSL_MIN(GSL_MIN((points - 1) / 2, i), n - i - 1);
-			np = 2 * half + 1;
-		}
+	const size_t half = (points - 1) / 2;
+	size_t np = points, first = 0, count = n;
+	double* ext = NULL;
+	const double* x = data;
+	if (mode == nsl_smooth_pad_none) {
+		/* full windows only for the points at least half points away from the edges */
+		np = 2 * half + 1;
+		first = GSL_MIN(half, n);
+		count = n > 2 * half ? n - 2 * half : 0;
 
-		/* weight */
-		double sum = 0.0;
+		/* reduce points at the edges */
 		double* w = (double*)malloc(np * sizeof(double));
-		switch (weight) {
-		case nsl_smooth_weight_uniform:
-			for (j = 0; j < np; j++)
-				w[j] = 1. / np;
-			break;
-		case nsl_smooth_weight_triangular:
-			sum = gsl_pow_2((double)(np + 1) / 2);
-			for (j = 0; j < np; j++)
-				w[j] = GSL_MIN(j + 1, np - j) / sum;
-			break;
-		case nsl_smooth_weight_binomial:
-			sum = (np - 1) / 2.;
-			for (j = 0; j < np; j++)
-				w[j] = gsl_sf_choose((unsigned int)(2 * sum), (unsigned int)((sum + fabs(j - sum)) / pow(4., sum)));
-			break;
-		case nsl_smooth_weight_parabolic:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_parabolic(2. * (j - (np - 1) / 2.) / (np + 1));
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_quartic:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_quartic(2. * (j - (np - 1) / 2.) / (np + 1));
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_triweight:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_triweight(2. * (j - (np - 1) / 2.) / (np + 1));
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_tricube:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_tricube(2. * (j - (np - 1) / 2.) / (np + 1));
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_cosine:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_cosine((j - (np - 1) / 2.) / ((np + 1) / 2.));
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
+		if (!w) {
+			free(result);
+			return -1;
 		}
-
-		/*printf("(%d) w:",i);
-		for(j=0;j<np;j++)
-			printf(" %g",w[j]);
-		printf(" (half=%d) index = ",half);*/
-
-		/* calculate weighted average */
-		for (j = 0; j < np; j++) {
-			int index = (int)(i - half + j);
-			switch (mode) {
-			case nsl_smooth_pad_none:
-				result[i] += w[j] * data[index];
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index = abs((int)(i - half + j));
-				/*printf(" %d",GSL_MIN(index,2*(n-1)-index));*/
-				result[i] += w[j] * data[GSL_MIN(index, 2 * ((int)n - 1) - index)];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d",GSL_MIN(n-1,GSL_MAX(0,index)));*/
-				result[i] += w[j] * data[GSL_MIN((int)n - 1, GSL_MAX(0, index))];
-				break;
-			case nsl_smooth_pad_constant:
-				if (index < 0)
-					result[i] += w[j] * nsl_smooth_pad_constant_lvalue;
-				else if (index > (int)n - 1)
-					result[i] += w[j] * nsl_smooth_pad_constant_rvalue;
-				else
-					result[i] += w[j] * data[index];
-				break;
-			case nsl_smooth_pad_periodic:
-				if (index < 0)
-					index = index + (int)n;
-				else if (index > (int)n - 1)
-					index = index - (int)n;
-				result[i] += w[j] * data[index];
-				break;
-			}
+		for (i = 0; i < n; i++) {
+			if (i >= first && i < first + count)
+				continue;
+			const size_t h = GSL_MIN(GSL_MIN(half, i), n - i - 1);
+			nsl_smooth_weights(w, 2 * h + 1, weight);
+			result[i] = 0.0;
+			for (j = 0; j < 2 * h + 1; j++)
+				result[i] += w[j] * data[i - h + j];
 		}
-		/*puts("");*/
 		free(w);
+	} else if (mode == nsl_smooth_pad_interp) {
+		/* full windows only, the points at the edges get the value of the first and last full window */
+		first = half;
+		count = n - points + 1;
+	} else {
+		ext = nsl_smooth_pad(data, n, half, points - 1 - half, mode, lvalue, rvalue);
+		if (!ext) {
+			free(result);
+			return -1;
+		}
+		x = ext;
 	}
 
-	for (i = 0; i < n; i++)
-		data[i] = result[i];
+	const int status = nsl_smooth_window_average(x, count, np, weight, 0, result + first);
+	if (status == 0) {
+		if (mode == nsl_smooth_pad_interp)
+			nsl_smooth_fill_edges(result, n, first, count);
+		memcpy(data, result, n * sizeof(double));
+	}
+	free(ext);
 	free(result);
 
-	return 0;
+	return status;
 }
 
 int nsl_smooth_moving_average_lagged(double* data, size_t n, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode) {
+	return nsl_smooth_moving_average_lagged_padded(data, n, points, weight, mode, nsl_smooth_pad_constant_lvalue);
+}
+
+int nsl_smooth_moving_average_lagged_padded(double* data, size_t n, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode, double lvalue) {
 	if (n == 0 || points == 0)
 		return -1;
 
 	size_t i, j;
+	/* no full window for the interpolation at the beginning */
+	if (mode == nsl_smooth_pad_interp && n < points)
+		mode = nsl_smooth_pad_none;
+
 	double* result = (double*)malloc(n * sizeof(double));
-	for (i = 0; i < n; i++)
-		result[i] = 0;
+	if (!result)
+		return -1;
+
+	size_t first = 0, count = n;
+	double* ext = NULL;
+	const double* x = data;
+	if (mode == nsl_smooth_pad_none) {
+		/* reduce points at the beginning */
+		first = GSL_MIN(points - 1, n);
+		count = n - first;
 
-	for (i = 0; i < n; i++) {
-		size_t np = points;
-		size_t half = (points - 1) / 2;
-		if (mode == nsl_smooth_pad_none) { /* reduce points */
-			np = GSL_MIN(points, i + 1);
-			half = np - 1;
+		double* w = (double*)malloc(points * sizeof(double));
+		if (!w) {
+			free(result);
+			return -1;
+		}
+		for (i = 0; i < first; i++) {
+			nsl_smooth_weights_lagged(w, i + 1, weight);
+			result[i] = 0.0;
+			for (j = 0; j < i + 1; j++)
+				result[i] += w[j] * data[j];
 		}
+		free(w);
+	} else if (mode == nsl_smooth_pad_interp) {
+		/* full windows only, the points at the beginning get the value of the first full window */
+		first = points - 1;
+		count = n - first;
+	} else {
+		ext = nsl_smooth_pad(data, n, points - 1, 0, mode, lvalue, 0.);
+		if (!ext) {
+			free(result);
+			return -1;
+		}
+		x = ext;
+	}
 
-		/* weight */
-		double sum = 0.0, *w = (double*)malloc(np * sizeof(double));
-		switch (weight) {
-		case nsl_smooth_weight_uniform:
-			for (j = 0; j < np; j++)
-				w[j] = 1. / np;
-			break;
-		case nsl_smooth_weight_triangular:
-			sum = np * (double)(np + 1) / 2;
-			for (j = 0; j < np; j++)
-				w[j] = (j + 1) / sum;
-			break;
-		case nsl_smooth_weight_binomial:
-			for (j = 0; j < np; j++) {
-				w[j] = gsl_sf_choose((unsigned int)(2 * (np - 1)), (unsigned int)j);
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_parabolic:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_parabolic(1. - (1 + j) / (double)np);
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_quartic:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_quartic(1. - (1 + j) / (double)np);
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_triweight:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_triweight(1. - (1 + j) / (double)np);
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_tricube:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_tricube(1. - (1 + j) / (double)np);
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
+	const int status = nsl_smooth_window_average(x, count, points, weight, 1, result + first);
+	if (status == 0) {
+		if (mode == nsl_smooth_pad_interp)
+			nsl_smooth_fill_edges(result, n, first, count);
+		memcpy(data, result, n * sizeof(double));
+	}
+	free(ext);
+	free(result);
+
+	return status;
+}
+
+/* order statistics of a sliding window: the slots of the window values are kept in a max-heap of the
+ * lower values (heap 0) and a min-heap of the upper values (heap 1), the value leaving the window
+ * is replaced by the value entering it in the same slot */
+typedef struct {
+	double* value; /* value of every slot */
+	size_t* heap[2]; /* slots in the heaps */
+	size_t size[2];
+	size_t* pos; /* position of every slot in its heap */
+	unsigned char* which; /* heap of every slot */
+} nsl_smooth_window;
+
+/* slot a belongs above slot b in heap h */
+static int nsl_smooth_window_before(const nsl_smooth_window* win, int h, size_t a, size_t b) {
+	return h == 0 ? win->value[a] > win->value[b] : win->value[a] < win->value[b];
+}
+
+static void nsl_smooth_window_set(nsl_smooth_window* win, int h, size_t p, size_t slot) {
+	win->heap[h][p] = slot;
+	win->pos[slot] = p;
+	win->which[slot] = (unsigned char)h;
+}
+
+static void nsl_smooth_window_sift(nsl_smooth_window* win, int h, size_t p) {
+	size_t* heap = win->heap[h];
+	const size_t slot = heap[p];
+	/* up */
+	while (p > 0 && nsl_smooth_window_before(win, h, slot, heap[(p - 1) / 2])) {
+		nsl_smooth_window_set(win, h, p, heap[(p - 1) / 2]);
+		p = (p - 1) / 2;
+	}
+	/* down */
+	for (;;) {
+		size_t child = 2 * p + 1;
+		if (child >= win->size[h])
 			break;
-		case nsl_smooth_weight_cosine:
-			for (j = 0; j < np; j++) {
-				w[j] = nsl_sf_kernel_cosine((np - 1 - j) / (double)np);
-				sum += w[j];
-			}
-			for (j = 0; j < np; j++)
-				w[j] /= sum;
+		if (child + 1 < win->size[h] && nsl_smooth_window_before(win, h, heap[child + 1], heap[child]))
+			child++;
+		if (!nsl_smooth_window_before(win, h, heap[child], slot))
 			break;
-		}
+		nsl_smooth_window_set(win, h, p, heap[child]);
+		p = child;
+	}
+	nsl_smooth_window_set(win, h, p, slot);
+}
 
-		/*printf("(%d) w:",i);
-		for(j=0;j<np;j++)
-			printf(" %g",w[j]);
-		printf(" (half=%d) index = ",half);*/
+/* percentile (type 7, see nsl_stats_quantile_sorted()) of the first count windows with np points of x in O(count log np) */
+static int nsl_smooth_window_percentile(const double* x, size_t count, size_t np, double percentile, double* result) {
+	if (count == 0)
+		return 0;
+
+	/* the window value with the rank k - 1 is the top of the lower heap, the one with rank k the top of the upper heap */
+	size_t k = np;
+	double frac = 0.0;
+	if (percentile != 1.0 && np > 1) {
+		const int i = (int)floor((np - 1) * percentile + 1);
+		k = (size_t)i;
+		frac = (np - 1) * percentile + 1 - i;
+	}
 
-		/* calculate weighted average */
-		for (j = 0; j < np; j++) {
-			int index = (int)(i - np + 1 + j);
-			switch (mode) {
-			case nsl_smooth_pad_none:
-				result[i] += w[j] * data[i - half + j];
-				/*printf(" %d",index);*/
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index = abs(index);
-				/*printf(" %d",index);*/
-				result[i] += w[j] * data[index];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d", index);*/
-				result[i] += w[j] * data[GSL_MAX(0, index)];
-				break;
-			case nsl_smooth_pad_constant:
-				if (index < 0)
-					result[i] += w[j] * nsl_smooth_pad_constant_lvalue;
-				else
-					result[i] += w[j] * data[index];
-
-				break;
-			case nsl_smooth_pad_periodic:
-				if (index < 0)
-					index += (int)n;
-				/*printf(" %d",index);*/
-				result[i] += w[j] * data[index];
-				break;
+	nsl_smooth_window win;
+	win.value = (double*)malloc(np * sizeof(double));
+	win.heap[0] = (size_t*)malloc(np * sizeof(size_t));
+	win.heap[1] = (size_t*)malloc(np * sizeof(size_t));
+	win.pos = (size_t*)malloc(np * sizeof(size_t));
+	win.which = (unsigned char*)malloc(np);
+	if (!win.value || !win.heap[0] || !win.heap[1] || !win.pos || !win.which) {
+		free(win.value);
+		free(win.heap[0]);
+		free(win.heap[1]);
+		free(win.pos);
+		free(win.which);
+		return -1;
+	}
+
+	/* first window: the sorted slots in descending order for the lower and ascending order for the upper heap are valid heaps */
+	size_t i, j;
+	memcpy(win.value, x, np * sizeof(double));
+	size_t* order = win.heap[1];
+	gsl_sort_index(order, win.value, 1, np);
+	win.size[0] = k;
+	win.size[1] = np - k;
+	for (j = 0; j < k; j++)
+		nsl_smooth_window_set(&win, 0, j, order[k - 1 - j]);
+	for (j = k; j < np; j++)
+		nsl_smooth_window_set(&win, 1, j - k, order[j]);
+
+	for (i = 0; i < count; i++) {
+		if (i > 0) {
+			/* replace the value of the slot leaving the window */
+			const size_t slot = (i - 1) % np;
+			const int h = win.which[slot];
+			win.value[slot] = x[i - 1 + np];
+			nsl_smooth_window_sift(&win, h, win.pos[slot]);
+
+			/* only the changed value may be on the wrong side */
+			if (win.size[0] > 0 && win.size[1] > 0 && win.value[win.heap[0][0]] > win.value[win.heap[1][0]]) {
+				const size_t lower = win.heap[0][0], upper = win.heap[1][0];
+				nsl_smooth_window_set(&win, 0, 0, upper);
+				nsl_smooth_window_set(&win, 1, 0, lower);
+				nsl_smooth_window_sift(&win, 0, 0);
+				nsl_smooth_window_sift(&win, 1, 0);
 			}
 		}
-		/*puts("");*/
-		free(w);
+
+		if (win.size[1] == 0)
+			result[i] = win.value[win.heap[0][0]];
+		else {
+			const double lower = win.value[win.heap[0][0]], upper = win.value[win.heap[1][0]];
+			result[i] = lower + frac * (upper - lower);
+		}
 	}
 
-	for (i = 0; i < n; i++)
-		data[i] = result[i];
-	free(result);
+	free(win.value);
+	free(win.heap[0]);
+	free(win.heap[1]);
+	free(win.pos);
+	free(win.which);
 
 	return 0;
 }
 
 int nsl_smooth_percentile(double* data, size_t n, size_t points, double percentile, nsl_smooth_pad_mode mode) {
+	return nsl_smooth_percentile_padded(data, n, points, percentile, mode, nsl_smooth_pad_constant_lvalue, nsl_smooth_pad_constant_rvalue);
+}
+
+int nsl_smooth_percentile_padded(double* data, size_t n, size_t points, double percentile, nsl_smooth_pad_mode mode, double lvalue, double rvalue) {
 	if (n == 0 || points == 0)
 		return -1;
 
-	size_t i, j;
+	size_t i;
+	/* no full window for the interpolation at the edges */
+	if (mode == nsl_smooth_pad_interp && n < points)
+		mode = nsl_smooth_pad_none;
+
 	double* result = (double*)malloc(n * sizeof(double));
+	if (!result)
+		return -1;
 
-	for (i = 0; i < n; i++) {
-		size_t np = points;
-		size_t half = (points - 1) / 2;
-		if (mode == nsl_smooth_pad_none) { /* reduce points */
-			half = GSL_MIN(GSL_MIN((points - 1) / 2, i), n - i - 1);
-			np = 2 * half + 1;
-		}
+	const size_t half = (points - 1) / 2;
+	size_t np = points, first = 0, count = n;
+	double* ext = NULL;
+	const double* x = data;
+	if (mode == nsl_smooth_pad_none) {
+		/* full windows only for the points at least half points away from the edges */
+		np = 2 * half + 1;
+		first = GSL_MIN(half, n);
+		count = n > 2 * half ? n - 2 * half : 0;
 
+		/* reduce points at the edges */
 		double* values = (double*)malloc(np * sizeof(double));
-		for (j = 0; j < np; j++) {
-			int index = (int)(i - half + j);
-			switch (mode) {
-			case nsl_smooth_pad_none:
-				/*printf(" %d",index);*/
-				values[j] = data[index];
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index = abs(index);
-				/*printf(" %d",GSL_MIN(index,2*(n-1)-index));*/
-				values[j] = data[GSL_MIN(index, 2 * ((int)n - 1) - index)];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d",GSL_MIN(n-1,GSL_MAX(0,index)));*/
-				values[j] = data[GSL_MIN((int)n - 1, GSL_MAX(0, index))];
-				break;
-			case nsl_smooth_pad_constant:
-				if (index < 0)
-					values[j] = nsl_smooth_pad_constant_lvalue;
-				else if (index > (int)n - 1)
-					values[j] = nsl_smooth_pad_constant_rvalue;
-				else
-					values[j] = data[index];
-				break;
-			case nsl_smooth_pad_periodic:
-				if (index < 0)
-					index = index + (int)n;
-				else if (index > (int)n - 1)
-					index = index - (int)n;
-				/*printf(" %d",index);*/
-				values[j] = data[index];
-				break;
-			}
+		if (!values) {
+			free(result);
+			return -1;
+		}
+		for (i = 0; i < n; i++) {
+			if (i >= first && i < first + count)
+				continue;
+			const size_t h = GSL_MIN(GSL_MIN(half, i), n - i - 1);
+			memcpy(values, data + i - h, (2 * h + 1) * sizeof(double));
+			/*using type 7 as default */
+			result[i] = nsl_stats_quantile(values, 1, 2 * h + 1, percentile, nsl_stats_quantile_type7);
 		}
-		/*puts("");*/
-
-		/*using type 7 as default */
-		result[i] = nsl_stats_quantile(values, 1, np, percentile, nsl_stats_quantile_type7);
 		free(values);
+	} else if (mode == nsl_smooth_pad_interp) {
+		/* full windows only, the points at the edges get the value of the first and last full window */
+		first = half;
+		count = n - points + 1;
+	} else {
+		ext = nsl_smooth_pad(data, n, half, points - 1 - half, mode, lvalue, rvalue);
+		if (!ext) {
+			free(result);
+			return -1;
+		}
+		x = ext;
 	}
 
-	for (i = 0; i < n; i++)
-		data[i] = result[i];
+	const int status = nsl_smooth_window_percentile(x, count, np, percentile, result + first);
+	if (status == 0) {
+		if (mode == nsl_smooth_pad_interp)
+			nsl_smooth_fill_edges(result, n, first, count);
+		memcpy(data, result, n * sizeof(double));
+	}
+	free(ext);
 	free(result);
 
-	return 0;
+	return status;
 }
 
 /* taken from SciDAVis */
@@ -414,6 +683,10 @@ void nsl_smooth_pad_constant_set(double lvalue, double rvalue) {
 }
 
 int nsl_smooth_savgol(double* data, size_t n, size_t points, int order, nsl_smooth_pad_mode mode) {
+	return nsl_smooth_savgol_padded(data, n, points, order, mode, nsl_smooth_pad_constant_lvalue, nsl_smooth_pad_constant_rvalue);
+}
+
+int nsl_smooth_savgol_padded(double* data, size_t n, size_t points, int order, nsl_smooth_pad_mode mode, double lvalue, double rvalue) {
 	size_t i, k;
 	int error = 0;
 	size_t half = (points - 1) / 2; /* n//2 */
@@ -474,7 +747,7 @@ int nsl_smooth_savgol(double* data, size_t n, size_t points, int order, nsl_smoo
 					break;
 				case nsl_smooth_pad_constant:
 					if (k < half - i)
-						result[i] += gsl_matrix_get(h, half, k) * nsl_smooth_pad_constant_lvalue;
+						result[i] += gsl_matrix_get(h, half, k) * lvalue;
 					else
 						result[i] += gsl_matrix_get(h, half, k) * data[i - half + k];
 					break;
@@ -527,7 +800,7 @@ int nsl_smooth_savgol(double* data, size_t n, size_t points, int order, nsl_smoo
 					if (k < n - i + half)
 						result[i] += gsl_matrix_get(h, half, k) * data[i - half + k];
 					else
-						result[i] += gsl_matrix_get(h, half, k) * nsl_smooth_pad_constant_rvalue;
+						result[i] += gsl_matrix_get(h, half, k) * rvalue;
 					break;
 				case nsl_smooth_pad_periodic:
 					result[i] += gsl_matrix_get(h, half, k) * data[(i - half + k) % n];
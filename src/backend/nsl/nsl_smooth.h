@@ -25,7 +25,7 @@ extern const char* nsl_smooth_type_name[];
 
 /* mode of extension for padding signal
  *	none: reduce points at edges
- *	interp: polynomial interpolation
+ *	interp: polynomial interpolation (moving average and percentile: value of the first/last full window)
  *	mirror:   3 2 | 1 2 3 4 5 | 4 3	(reflect)
  *	nearest:  1 1 | 1 2 3 4 5 | 5 5	(repeat)
  *	constant: L L | 1 2 3 4 5 | R R
@@ -56,19 +56,32 @@ typedef enum {
 extern const char* nsl_smooth_weight_type_name[];
 /*TODO: IIR: exponential, Gaussian, see nsl_sf_kernel */
 
-/* values used for constant padding */
+/* values used for constant padding by the functions without explicit padding values.
+ * not thread-safe, use the *_padded() variants when smoothing concurrently */
 extern double nsl_smooth_pad_constant_lvalue, nsl_smooth_pad_constant_rvalue;
 
 /********* Smoothing algorithms **********/
 
 /* Moving average */
 int nsl_smooth_moving_average(double* data, size_t n, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode);
+/* Moving average with the values lvalue and rvalue for constant padding */
+int nsl_smooth_moving_average_padded(double* data,
+									 size_t n,
+									 size_t points,
+									 nsl_smooth_weight_type weight,
+									 nsl_smooth_pad_mode mode,
+									 double lvalue,
+									 double rvalue);
 
 /* Lagged moving average */
 int nsl_smooth_moving_average_lagged(double* data, size_t n, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode);
+/* Lagged moving average with the value lvalue for constant padding */
+int nsl_smooth_moving_average_lagged_padded(double* data, size_t n, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode, double lvalue);
 
 /* Percentile filter */
 int nsl_smooth_percentile(double* data, size_t n, size_t points, double percentile, nsl_smooth_pad_mode mode);
+/* Percentile filter with the values lvalue and rvalue for constant padding */
+int nsl_smooth_percentile_padded(double* data, size_t n, size_t points, double percentile, nsl_smooth_pad_mode mode, double lvalue, double rvalue);
 
 /* Savitzky-Golay coefficients */
 /**
@@ -100,6 +113,8 @@ void nsl_smooth_pad_constant_set(double lvalue, double rvalue);
  * generic method able to handle non-uniform input data.
  */
 int nsl_smooth_savgol(double* data, size_t n, size_t points, int order, nsl_smooth_pad_mode mode);
+/* Savitzky-Golay smoothing with the values lvalue and rvalue for constant padding */
+int nsl_smooth_savgol_padded(double* data, size_t n, size_t points, int order, nsl_smooth_pad_mode mode, double lvalue, double rvalue);
 
 /* Savitzky-Golay default smoothing (interp) */
 int nsl_smooth_savgol_default(double* data, size_t n, size_t points, int order);
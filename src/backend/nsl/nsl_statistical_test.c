@@ -12,10 +12,14 @@
 #include "nsl_statistical_test.h"
 #include "nsl_stats.h"
 #include <gsl/gsl_cdf.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_rng.h>
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_statistics_double.h>
 #include <math.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define DECLARE_COMPARE_FUNCTION(struct_type, field_name)                                                                                                      \
 	int compare_##struct_type##_##field_name(const void* a, const void* b) {                                                                                   \
@@ -967,6 +971,337 @@ struct chisq_gof_test_result nsl_stats_chisq_gof_x2(const long long* observed, c
 	return result;
 }
 
+/* counts the pairs i < j with a[i] > a[j] (inversions) with a merge sort in O(n log n), a is sorted ascending afterwards */
+static size_t nsl_stats_count_inversions(double a[], double tmp[], size_t n) {
+	if (n < 2)
+		return 0;
+
+	const size_t mid = n / 2;
+	size_t count = nsl_stats_count_inversions(a, tmp, mid) + nsl_stats_count_inversions(a + mid, tmp, n - mid);
+
+	size_t i = 0, j = mid, k = 0;
+	while (i < mid && j < n) {
+		if (a[i] <= a[j])
+			tmp[k++] = a[i++];
+		else {
+			count += mid - i; // a[j] is smaller than all remaining values of the left half
+			tmp[k++] = a[j++];
+		}
+	}
+	while (i < mid)
+		tmp[k++] = a[i++];
+	while (j < n)
+		tmp[k++] = a[j++];
+	memcpy(a, tmp, n * sizeof(double));
+
+	return count;
+}
+
+/* Theil-Sen estimator (median of the pairwise slopes (y_j - y_i)/(j - i), i < j) without storing all n(n-1)/2 slopes
+ *
+ * For a slope t the pair (i, j) has a slope <= t if and only if y_j - t*j <= y_i - t*i. Ordering the indices by y - t*x
+ * the number of slopes <= t is the number of inversions of this ordering and the slopes in an interval (lo, hi)
+ * are the pairs ordered differently for lo and for hi. The slopes in the interval are sampled at random
+ * (with a Fenwick tree on the orderings) to shrink the interval around the slope with the requested rank
+ * until the remaining slopes can be enumerated (randomized slope selection, expected O(n log n)).
+ */
+
+// element of the ordering of the indices for a slope t
+typedef struct {
+	double z; // y_i - t*i
+	size_t index;
+} theil_sen_key;
+
+// ascending z, equal values by descending index (pairs with the slope t count as <= t)
+static int compare_theil_sen_key(const void* a, const void* b) {
+	const theil_sen_key* k1 = (const theil_sen_key*)a;
+	const theil_sen_key* k2 = (const theil_sen_key*)b;
+	if (k1->z != k2->z)
+		return k1->z < k2->z ? -1 : 1;
+	return (k1->index < k2->index) - (k1->index > k2->index);
+}
+
+// ascending z, equal values by ascending index (pairs with the slope t don't count as < t)
+static int compare_theil_sen_key_strict(const void* a, const void* b) {
+	const theil_sen_key* k1 = (const theil_sen_key*)a;
+	const theil_sen_key* k2 = (const theil_sen_key*)b;
+	if (k1->z != k2->z)
+		return k1->z < k2->z ? -1 : 1;
+	return (k1->index > k2->index) - (k1->index < k2->index);
+}
+
+static int compare_size_t(const void* a, const void* b) {
+	const size_t v1 = *(const size_t*)a;
+	const size_t v2 = *(const size_t*)b;
+	return (v1 > v2) - (v1 < v2);
+}
+
+typedef struct {
+	const double* y;
+	size_t n;
+	theil_sen_key* keys;
+	size_t* lo_order; // indices ordered for the lower bound of the interval
+	size_t* hi_order; // indices ordered for the upper bound of the interval
+	size_t* hi_pos; // position of every index in hi_order
+	size_t* partners; // number of pairs in the interval of the index at every position of lo_order
+	size_t* tree; // Fenwick tree over the positions in hi_order
+	double* a; // workspace of the inversion count
+	double* tmp;
+	size_t limit; // maximal number of slopes to enumerate
+	size_t* ranks; // ranks of the sampled slopes within the interval
+	double* slopes; // sampled slopes
+	gsl_rng* rng;
+} theil_sen_workspace;
+
+/* orders the indices by y_i - t*i, for i < j the index j is ordered before i if the slope of the pair is <= t (strict = 0) or < t (strict = 1) */
+static void theil_sen_order(const theil_sen_workspace* w, double t, int strict, size_t order[]) {
+	const size_t n = w->n;
+	if (isinf(t)) { // all slopes are > -inf and < +inf
+		for (size_t i = 0; i < n; i++)
+			order[i] = (t < 0) ? i : n - 1 - i;
+		return;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		w->keys[i].z = w->y[i] - t * (double)i;
+		w->keys[i].index = i;
+	}
+	qsort(w->keys, n, sizeof(theil_sen_key), strict ? compare_theil_sen_key_strict : compare_theil_sen_key);
+	for (size_t i = 0; i < n; i++)
+		order[i] = w->keys[i].index;
+}
+
+/* number of slopes <= t (strict = 0) or < t (strict = 1) */
+static size_t theil_sen_count(const theil_sen_workspace* w, double t, int strict) {
+	theil_sen_order(w, t, strict, w->hi_order);
+	for (size_t i = 0; i < w->n; i++)
+		w->a[i] = (double)w->hi_order[i];
+	return nsl_stats_count_inversions(w->a, w->tmp, w->n);
+}
+
+static void fenwick_add(size_t tree[], size_t n, size_t pos) {
+	for (size_t i = pos + 1; i <= n; i += i & -i)
+		tree[i]++;
+}
+
+/* number of inserted positions < pos */
+static size_t fenwick_count(const size_t tree[], size_t pos) {
+	size_t count = 0;
+	for (size_t i = pos; i > 0; i -= i & -i)
+		count += tree[i];
+	return count;
+}
+
+/* k-th (0-based) smallest inserted position */
+static size_t fenwick_find(const size_t tree[], size_t n, size_t k) {
+	size_t step = 1;
+	while (2 * step <= n)
+		step *= 2;
+
+	size_t pos = 0;
+	for (; step > 0; step /= 2) {
+		if (pos + step <= n && tree[pos + step] <= k) {
+			pos += step;
+			k -= tree[pos];
+		}
+	}
+	return pos;
+}
+
+/* returns the slope with the rank k (0-based) of all pairwise slopes by enumerating the slopes in the interval [lo, hi].
+ * Used if the interval can't be shrunk further, the interval is extended to all slopes if it doesn't contain the rank
+ * due to rounding errors in the orderings. At most w->limit slopes are kept (reservoir sample): as long as the interval
+ * contains more slopes, it is split at the sampled slope closest to the rank, every step needs O(n^2) time but no
+ * additional memory. */
+static double theil_sen_select_interval(theil_sen_workspace* w, size_t k, double lo, double hi) {
+	const double* y = w->y;
+	const size_t n = w->n;
+	for (;;) {
+		size_t below = 0, count = 0;
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = i + 1; j < n; j++) {
+				const double slope = (y[j] - y[i]) / (double)(j - i);
+				if (slope < lo)
+					below++;
+				else if (slope <= hi) {
+					if (count < w->limit)
+						w->slopes[count] = slope;
+					else {
+						const size_t r = (size_t)(gsl_rng_uniform(w->rng) * (count + 1));
+						if (r < w->limit)
+							w->slopes[r] = slope;
+					}
+					count++;
+				}
+			}
+		}
+
+		if (k < below || k >= below + count) {
+			if (isinf(lo) && isinf(hi))
+				return NAN; // not reached, all slopes are in the interval
+			lo = -INFINITY;
+			hi = INFINITY;
+			continue;
+		}
+
+		const size_t rank = k - below;
+		const size_t sampled = GSL_MIN(count, w->limit);
+		gsl_sort(w->slopes, 1, sampled);
+		if (count <= w->limit)
+			return w->slopes[rank];
+
+		// split the interval at the sampled slope closest to the rank
+		const double t = w->slopes[GSL_MIN((size_t)((double)rank * sampled / count), sampled - 1)];
+		size_t less = 0, equal = 0;
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = i + 1; j < n; j++) {
+				const double slope = (y[j] - y[i]) / (double)(j - i);
+				if (slope >= lo && slope < t)
+					less++;
+				else if (slope == t)
+					equal++;
+			}
+		}
+
+		if (rank < less)
+			hi = nextafter(t, -INFINITY);
+		else if (rank < less + equal) // tied slopes
+			return t;
+		else
+			lo = nextafter(t, INFINITY);
+	}
+}
+
+/* returns the slope with the rank k (0-based) of all pairwise slopes */
+static double theil_sen_select(theil_sen_workspace* w, size_t k) {
+	const double* y = w->y;
+	const size_t n = w->n;
+
+	// the interval of slopes (lo, hi) containing the slope with the rank k, count_lo is the number of slopes <= lo
+	double lo = -INFINITY, hi = INFINITY;
+	size_t count_lo = 0;
+	for (int iteration = 0;; iteration++) {
+		theil_sen_order(w, lo, 0, w->lo_order);
+		theil_sen_order(w, hi, 1, w->hi_order);
+		for (size_t i = 0; i < n; i++)
+			w->hi_pos[w->hi_order[i]] = i;
+
+		// the pairs in the interval are ordered after each other in lo_order and before each other in hi_order
+		memset(w->tree, 0, (n + 1) * sizeof(size_t));
+		size_t m = 0;
+		for (size_t p = n; p-- > 0;) {
+			const size_t pos = w->hi_pos[w->lo_order[p]];
+			w->partners[p] = fenwick_count(w->tree, pos);
+			m += w->partners[p];
+			fenwick_add(w->tree, n, pos);
+		}
+		// the rank is outside of the interval only due to rounding errors in the orderings,
+		// enumerate the slopes in this case and if the interval doesn't converge
+		if (k < count_lo || k - count_lo >= m || iteration == 64)
+			return theil_sen_select_interval(w, k, lo, hi);
+		const size_t rank = k - count_lo;
+
+		// enumerate all slopes of the interval or sample n of them
+		const int enumerate = (m <= w->limit);
+		const size_t r = enumerate ? m : n;
+		if (enumerate) {
+			for (size_t i = 0; i < r; i++)
+				w->ranks[i] = i;
+		} else {
+			for (size_t i = 0; i < r; i++)
+				w->ranks[i] = GSL_MIN((size_t)(gsl_rng_uniform(w->rng) * m), m - 1);
+			qsort(w->ranks, r, sizeof(size_t), compare_size_t);
+		}
+
+		// the pair with the rank u: the element at the position p in lo_order with cumulative partners <= u
+		// and the (u - cumulative)-th smallest position in hi_order of the elements after it in lo_order
+		memset(w->tree, 0, (n + 1) * sizeof(size_t));
+		size_t cumulative = 0, s = 0;
+		for (size_t p = n; p-- > 0 && s < r;) {
+			const size_t i = w->lo_order[p];
+			while (s < r && w->ranks[s] < cumulative + w->partners[p]) {
+				const size_t j = w->hi_order[fenwick_find(w->tree, n, w->ranks[s] - cumulative)];
+				w->slopes[s++] = (i < j) ? (y[j] - y[i]) / (double)(j - i) : (y[i] - y[j]) / (double)(i - j);
+			}
+			cumulative += w->partners[p];
+			fenwick_add(w->tree, n, w->hi_pos[i]);
+		}
+		gsl_sort(w->slopes, 1, r);
+
+		if (enumerate)
+			return w->slopes[rank];
+
+		// shrink the interval to the sampled slopes that bracket the rank with high probability
+		const double expected = (double)rank * r / m;
+		const double delta = sqrt((double)r);
+		const double candidates[2] = {floor(expected - delta), ceil(expected + delta)};
+		for (int c = 0; c < 2; c++) {
+			if (candidates[c] < 0 || candidates[c] >= r)
+				continue;
+
+			const double t = w->slopes[(size_t)candidates[c]];
+			if (!(t > lo && t < hi))
+				continue;
+
+			const size_t below = theil_sen_count(w, t, 1);
+			const size_t below_equal = theil_sen_count(w, t, 0);
+			if (below <= k && k < below_equal)
+				return t;
+			if (k < below)
+				hi = t;
+			else {
+				lo = t;
+				count_lo = below_equal;
+			}
+		}
+	}
+}
+
+double nsl_stats_theil_sen_slope(const double sample[], size_t n) {
+	if (n < 2)
+		return NAN;
+
+	theil_sen_workspace w;
+	w.y = sample;
+	w.n = n;
+	w.limit = GSL_MAX(2 * n, 1024);
+	w.keys = (theil_sen_key*)malloc(n * sizeof(theil_sen_key));
+	w.lo_order = (size_t*)malloc(n * sizeof(size_t));
+	w.hi_order = (size_t*)malloc(n * sizeof(size_t));
+	w.hi_pos = (size_t*)malloc(n * sizeof(size_t));
+	w.partners = (size_t*)malloc(n * sizeof(size_t));
+	w.tree = (size_t*)malloc((n + 1) * sizeof(size_t));
+	w.a = (double*)malloc(n * sizeof(double));
+	w.tmp = (double*)malloc(n * sizeof(double));
+	w.ranks = (size_t*)malloc(w.limit * sizeof(size_t));
+	w.slopes = (double*)malloc(w.limit * sizeof(double));
+	w.rng = gsl_rng_alloc(gsl_rng_default);
+
+	double slope = NAN;
+	if (w.keys && w.lo_order && w.hi_order && w.hi_pos && w.partners && w.tree && w.a && w.tmp && w.ranks && w.slopes && w.rng) {
+		const size_t n_pairs = n * (n - 1) / 2;
+		if (n_pairs % 2 == 1)
+			slope = theil_sen_select(&w, n_pairs / 2);
+		else
+			slope = (theil_sen_select(&w, n_pairs / 2 - 1) + theil_sen_select(&w, n_pairs / 2)) / 2.;
+	}
+
+	free(w.keys);
+	free(w.lo_order);
+	free(w.hi_order);
+	free(w.hi_pos);
+	free(w.partners);
+	free(w.tree);
+	free(w.a);
+	free(w.tmp);
+	free(w.ranks);
+	free(w.slopes);
+	if (w.rng)
+		gsl_rng_free(w.rng);
+
+	return slope;
+}
+
 /* Mann-Kendall Test for monotonic trend detection */
 struct mann_kendall_test_result nsl_stats_mann_kendall(const double sample[], size_t n, nsl_stats_tail_type tail) {
 	struct mann_kendall_test_result result;
@@ -975,48 +1310,60 @@ struct mann_kendall_test_result nsl_stats_mann_kendall(const double sample[], si
 	result.tau = NAN;
 	result.z = NAN;
 	result.p = NAN;
+	result.slope = NAN;
 
 	if (n < 3) {
 		fprintf(stderr, "Error: Mann-Kendall test requires at least 3 data points.\n");
 		return result;
 	}
 
-	// calculate S statistic (sum of signs of all pairwise differences) and
-	// the Sen's slope (median of all pairwise slopes)
-	double S = 0.0;
-	const double n_pairs = (double)(n * (n - 1)) / 2.0;
-	double* slopes = (double*)malloc(sizeof(double) * (size_t)n_pairs);
-	size_t slope_idx = 0;
-	for (size_t i = 0; i < n - 1; i++) {
-		for (size_t j = i + 1; j < n; j++) {
-			double diff = sample[j] - sample[i];
-			if (diff > 0.0)
-				S += 1.0;
-			else if (diff < 0.0)
-				S -= 1.0;
-
-			double slope = (sample[j] - sample[i]) / (double)(j - i);
-			slopes[slope_idx++] = slope;
+	// calculate S statistic (sum of signs of all pairwise differences) in O(n log n) (Knight's algorithm):
+	// S = (number of increasing pairs) - (number of decreasing pairs) = n_pairs - (number of tied pairs) - 2*(number of inversions)
+	double* sorted = (double*)malloc(n * sizeof(double));
+	double* tmp = (double*)malloc(n * sizeof(double));
+	if (!sorted || !tmp) {
+		free(sorted);
+		free(tmp);
+		return result;
+	}
+	memcpy(sorted, sample, n * sizeof(double));
+	const double inversions = (double)nsl_stats_count_inversions(sorted, tmp, n);
+	free(tmp);
+
+	// tied groups for the number of tied pairs and the tie correction of the variance
+	double tied_pairs = 0.0, ties_correction = 0.0;
+	for (size_t i = 0; i < n;) {
+		size_t j = i + 1;
+		while (j < n && sorted[j] == sorted[i])
+			j++;
+		const double t = (double)(j - i);
+		if (t > 1) {
+			tied_pairs += t * (t - 1) / 2.0;
+			ties_correction += t * (t - 1) * (2 * t + 5);
 		}
+		i = j;
 	}
+	free(sorted);
+
+	const double n_pairs = (double)n * (double)(n - 1) / 2.0;
+	const double S = n_pairs - tied_pairs - 2.0 * inversions;
 	result.S = S;
 
-	gsl_sort(slopes, 1, (size_t)n_pairs);
-	double slope = gsl_stats_median_from_sorted_data(slopes, 1, (size_t)n_pairs);
-	free(slopes);
-	result.slope = slope;
+	// Sen's slope (median of all pairwise slopes)
+	result.slope = nsl_stats_theil_sen_slope(sample, n);
 
 	// calculate Kendall's tau, the "correlation coefficient" for the trend, ranging from -1 to +1.
 	result.tau = S / n_pairs;
 
-	// calculate the variance of S:
-	// for simplicity, we assume no ties in the data
-	// variance without tie correction: Var(S) = n(n-1)(2n+5)/18
-	double var_S = (double)(n * (n - 1) * (2 * n + 5)) / 18.0;
+	// calculate the variance of S with the correction for ties:
+	// Var(S) = [n(n-1)(2n+5) - sum_t t(t-1)(2t+5)]/18, t the size of each group of tied values
+	const double var_S = ((double)n * (double)(n - 1) * (double)(2 * n + 5) - ties_correction) / 18.0;
 
 	// calculate Z-score
 	double z;
-	if (S > 0.0)
+	if (var_S <= 0.0) // all values are equal
+		z = 0.0;
+	else if (S > 0.0)
 		z = (S - 1.0) / sqrt(var_S);
 	else if (S < 0.0)
 		z = (S + 1.0) / sqrt(var_S);
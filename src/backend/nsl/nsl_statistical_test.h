@@ -170,6 +170,8 @@ struct mann_kendall_test_result {
 	double slope;
 };
 struct mann_kendall_test_result nsl_stats_mann_kendall(const double sample[], size_t n, nsl_stats_tail_type tail);
+/* Theil-Sen slope (median of all pairwise slopes) of the sample with the indices as x values in expected O(n log n) time and O(n) memory */
+double nsl_stats_theil_sen_slope(const double sample[], size_t n);
 
 struct wald_wolfowitz_runs_test_result {
 	double z;
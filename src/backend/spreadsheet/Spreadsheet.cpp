@@ -316,6 +316,9 @@ void Spreadsheet::updateHorizontalHeader() {
 void Spreadsheet::updateLocale() {
 	for (auto* col : children<Column>())
 		col->updateLocale();
+
+	if (m_model)
+		m_model->clearFormattingCache();
 }
 
 /*!
@@ -983,16 +986,18 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 		static bool bigIntGreater(QPair<qint64, int> a, QPair<qint64, int> b) {
 			return a.first > b.first;
 		}
-		static bool QStringLess(const QPair<QString, int>& a, const QPair<QString, int>& b) {
+		// texts are compared by their ranks (see Column::textRanks()), ties are ordered by the row as for the texts
+		static bool textRankLess(QPair<int, int> a, QPair<int, int> b) {
 			return a < b;
 		}
-		static bool QStringGreater(const QPair<QString, int>& a, const QPair<QString, int>& b) {
+		static bool textRankGreater(QPair<int, int> a, QPair<int, int> b) {
 			return a > b;
 		}
-		static bool QDateTimeLess(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
+		// date and time values are compared by their milliseconds (or nanoseconds) since epoch as QDateTime does, ties are ordered by the row
+		static bool dateTimeLess(QPair<qint64, int> a, QPair<qint64, int> b) {
 			return a < b;
 		}
-		static bool QDateTimeGreater(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
+		static bool dateTimeGreater(QPair<qint64, int> a, QPair<qint64, int> b) {
 			return a > b;
 		}
 	};
@@ -1070,17 +1075,18 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 				break;
 			}
 			case AbstractColumn::ColumnMode::Text: {
-				QVector<QPair<QString, int>> map;
+				QVector<QPair<int, int>> map;
+				const auto& ranks = col->textRanks();
 
 				for (int i = 0; i < rows; i++)
-					if (!col->textAt(i).isEmpty())
-						map.append(QPair<QString, int>(col->textAt(i), i));
+					if (ranks.at(i) != -1)
+						map.append(QPair<int, int>(ranks.at(i), i));
 				const int filledRows = map.size();
 
 				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
+					std::stable_sort(map.begin(), map.end(), CompareFunctions::textRankLess);
 				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+					std::stable_sort(map.begin(), map.end(), CompareFunctions::textRankGreater);
 
 				// put the values in the right order into tempCol
 				for (int i = 0; i < filledRows; i++) {
@@ -1094,17 +1100,20 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day: {
-				QVector<QPair<QDateTime, int>> map;
+				QVector<QPair<qint64, int>> map;
+				auto values = col->dateTimeNSecs();
+				if (values.empty())
+					values = col->dateTimeMSecs();
 
 				for (int i = 0; i < rows; i++)
 					if (col->isValid(i))
-						map.append(QPair<QDateTime, int>(col->dateTimeAt(i), i));
+						map.append(QPair<qint64, int>(!values.empty() ? values[i] : col->dateTimeAt(i).toMSecsSinceEpoch(), i));
 				const int filledRows = map.size();
 
 				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
+					std::stable_sort(map.begin(), map.end(), CompareFunctions::dateTimeLess);
 				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
+					std::stable_sort(map.begin(), map.end(), CompareFunctions::dateTimeGreater);
 
 				// put the values in the right order into tempCol
 				for (int i = 0; i < filledRows; i++) {
@@ -1247,12 +1256,13 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 			break;
 		}
 		case AbstractColumn::ColumnMode::Text: {
-			QVector<QPair<QString, int>> map;
+			QVector<QPair<int, int>> map;
 			QVector<int> emptyIndex;
+			const auto& ranks = leading->textRanks();
 
 			for (int i = 0; i < rows; i++)
-				if (!leading->textAt(i).isEmpty())
-					map.append(QPair<QString, int>(leading->textAt(i), i));
+				if (ranks.at(i) != -1)
+					map.append(QPair<int, int>(ranks.at(i), i));
 				else
 					emptyIndex << i;
 			// QDEBUG("	empty indices: " << emptyIndex)
@@ -1260,9 +1270,9 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 			const int emptyRows = emptyIndex.size();
 
 			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
+				std::stable_sort(map.begin(), map.end(), CompareFunctions::textRankLess);
 			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+				std::stable_sort(map.begin(), map.end(), CompareFunctions::textRankGreater);
 
 			for (auto* col : cols) {
 				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
@@ -1302,21 +1312,24 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day: {
-			QVector<QPair<QDateTime, int>> map;
+			QVector<QPair<qint64, int>> map;
 			QVector<int> invalidIndex;
+			auto values = leading->dateTimeNSecs();
+			if (values.empty())
+				values = leading->dateTimeMSecs();
 
 			for (int i = 0; i < rows; i++)
 				if (leading->isValid(i))
-					map.append(QPair<QDateTime, int>(leading->dateTimeAt(i), i));
+					map.append(QPair<qint64, int>(!values.empty() ? values[i] : leading->dateTimeAt(i).toMSecsSinceEpoch(), i));
 				else
 					invalidIndex << i;
 			const int filledRows = map.size();
 			const int invalidRows = invalidIndex.size();
 
 			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
+				std::stable_sort(map.begin(), map.end(), CompareFunctions::dateTimeLess);
 			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
+				std::stable_sort(map.begin(), map.end(), CompareFunctions::dateTimeGreater);
 
 			for (auto* col : cols) {
 				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
@@ -1852,6 +1865,17 @@ void Spreadsheet::finalizeImport(size_t columnOffset,
 			column->setDataChanged(); // Invalidate properties
 			column->setSuppressDataChangedSignal(false);
 		}
+
+		// categorical data with few distinct values is stored dictionary encoded,
+		// date and time values are stored as milliseconds since epoch.
+		// not done for live data sources, their filters keep writing into the data containers of the columns
+		if (type() != AspectType::Spreadsheet)
+			continue;
+		const auto mode = column->columnMode();
+		if (mode == AbstractColumn::ColumnMode::Text)
+			column->compactTexts();
+		else if (mode == AbstractColumn::ColumnMode::DateTime || mode == AbstractColumn::ColumnMode::Month || mode == AbstractColumn::ColumnMode::Day)
+			column->compactDateTimes();
 	}
 
 	if (columnImportMode == AbstractFileFilter::ImportMode::Replace) {
@@ -22,8 +22,10 @@
 #include <KLocalizedString>
 
 #include <QBrush>
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QPalette>
+#include <QtConcurrent/QtConcurrentRun>
 
 /*!
 	\class SpreadsheetModel
@@ -39,6 +41,84 @@
 
 	\ingroup backend
 */
+namespace {
+// copy of the values of a block of rows of a numeric column together with the formatting settings,
+// used to format the values in a background thread
+struct BlockValues {
+	AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};
+	char numericFormat{'g'};
+	int digits{6};
+	QLocale locale;
+	QVector<double> values;
+	QVector<qint64> integers;
+	QVector<bool> valid;
+};
+
+/*!
+ * copies the values of the rows \c first to \c last of \c column into \c block.
+ * Returns \c false if the values of the column cannot be formatted in the background.
+ */
+bool blockValues(const Column* column, int first, int last, BlockValues& block) {
+	block.mode = column->columnMode();
+	block.locale = column->outputFilter()->numberLocale();
+	const int size = last - first + 1;
+	switch (block.mode) {
+	case AbstractColumn::ColumnMode::Double: {
+		const auto* filter = dynamic_cast<const Double2StringFilter*>(column->outputFilter());
+		if (!filter)
+			return false;
+		block.numericFormat = filter->numericFormat();
+		block.digits = filter->numDigits();
+		block.values.resize(size);
+		for (int i = 0; i < size; ++i)
+			block.values[i] = column->valueAt(first + i);
+		return true;
+	}
+	case AbstractColumn::ColumnMode::Integer:
+	case AbstractColumn::ColumnMode::BigInt:
+		block.integers.resize(size);
+		block.valid.resize(size);
+		for (int i = 0; i < size; ++i) {
+			block.integers[i] = (block.mode == AbstractColumn::ColumnMode::Integer) ? column->integerAt(first + i) : column->bigIntAt(first + i);
+			block.valid[i] = column->isValid(first + i);
+		}
+		return true;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	return false;
+}
+
+//! formats the values as shown in the view (Qt::DisplayRole)
+QVector<QString> formatBlock(const BlockValues& block) {
+	QVector<QString> texts;
+	if (block.mode == AbstractColumn::ColumnMode::Double) {
+		texts.reserve(block.values.size());
+		for (const double value : block.values) {
+			if (std::isnan(value))
+				texts << QStringLiteral("-");
+			else if (std::isinf(value))
+				texts << UTF8_QSTRING("∞");
+			else
+				texts << block.locale.toString(value, block.numericFormat, block.digits);
+		}
+	} else {
+		texts.reserve(block.integers.size());
+		for (int i = 0; i < block.integers.size(); ++i) {
+			if (!block.valid.at(i))
+				texts << QStringLiteral("-");
+			else
+				texts << block.locale.toString(block.integers.at(i));
+		}
+	}
+	return texts;
+}
+}
+
 SpreadsheetModel::SpreadsheetModel(Spreadsheet* spreadsheet)
 	: QAbstractItemModel(nullptr)
 	, m_spreadsheet(spreadsheet)
@@ -87,6 +167,7 @@ void SpreadsheetModel::suppressSignals(bool value) {
 	else {
 		m_rowCount = m_spreadsheet->rowCount();
 		m_columnCount = m_spreadsheet->columnCount();
+		clearFormattingCache();
 		updateHorizontalHeader(false);
 		endResetModel();
 	}
@@ -168,24 +249,11 @@ QVariant SpreadsheetModel::data(const QModelIndex& index, int role) const {
 
 		break;
 	case Qt::DisplayRole:
-		if (col_ptr->columnMode() == AbstractColumn::ColumnMode::Double) {
-			double value = col_ptr->valueAt(row);
-			if (std::isnan(value))
-				return {QStringLiteral("-")};
-			else if (std::isinf(value))
-				return {UTF8_QSTRING("∞")};
-			else
-				return {col_ptr->asStringColumn()->textAt(row)};
-		}
-
-		if (!col_ptr->isValid(row))
-			return {QStringLiteral("-")};
-
 		// m_formula_mode is not used at the moment
 		// if (m_formula_mode)
 		//	return QVariant(col_ptr->formula(row));
 
-		return {col_ptr->asStringColumn()->textAt(row)};
+		return {displayText(col_ptr, row)};
 	case Qt::ForegroundRole:
 		if (!col_ptr->isValid(row))
 			return QBrush(Qt::red);
@@ -212,6 +280,112 @@ QVariant SpreadsheetModel::data(const QModelIndex& index, int role) const {
 	return {};
 }
 
+/*!
+ * returns the text shown for the cell \c row of the column \c column.
+ * The texts are formatted in blocks of rows and cached until the column is changed. The neighbour blocks
+ * of the accessed blocks are formatted in advance in the background so scrolling mostly only requires cache lookups.
+ */
+QString SpreadsheetModel::displayText(const Column* column, int row) const {
+	const int block = row / formattingBlockSize;
+	const BlockKey key(column, block);
+	const quint64 version = formattingVersion(column);
+	auto* formattedBlock = m_formattedBlocks.object(key);
+	if (formattedBlock && formattedBlock->version == version) {
+		if (formattedBlock->prefetched) {
+			// the prefetched block is shown for the first time, continue prefetching in this direction
+			formattedBlock->prefetched = false;
+			prefetchBlock(column, block - 1);
+			prefetchBlock(column, block + 1);
+		}
+		const int index = row - block * formattingBlockSize;
+		if (index < formattedBlock->texts.size())
+			return formattedBlock->texts.at(index);
+	}
+
+	// format the block now
+	const int first = block * formattingBlockSize;
+	const int last = std::min(first + formattingBlockSize, m_rowCount) - 1;
+	if (row > last)
+		return {};
+
+	QVector<QString> texts;
+	BlockValues values;
+	if (blockValues(column, first, last, values))
+		texts = formatBlock(values);
+	else {
+		texts.reserve(last - first + 1);
+		for (int i = first; i <= last; ++i)
+			texts << (column->isValid(i) ? column->asStringColumn()->textAt(i) : QStringLiteral("-"));
+	}
+
+	const QString text = texts.at(row - first);
+	m_formattedBlocks.insert(key, new FormattedBlock{version, std::move(texts), false}, last - first + 1);
+	prefetchBlock(column, block - 1);
+	prefetchBlock(column, block + 1);
+	return text;
+}
+
+/*!
+ * formats the block \c block of numeric columns in the background if it's not cached yet.
+ */
+void SpreadsheetModel::prefetchBlock(const Column* column, int block) const {
+	const BlockKey key(column, block);
+	const int first = block * formattingBlockSize;
+	if (block < 0 || first >= m_rowCount || m_pendingBlocks.contains(key))
+		return;
+
+	const quint64 version = formattingVersion(column);
+	const auto* cachedBlock = m_formattedBlocks.object(key);
+	if (cachedBlock && cachedBlock->version == version)
+		return;
+
+	// the values are copied here, the column must not be accessed from the background thread
+	auto values = std::make_shared<BlockValues>();
+	const int last = std::min(first + formattingBlockSize, m_rowCount) - 1;
+	if (!blockValues(column, first, last, *values))
+		return;
+
+	m_pendingBlocks.insert(key);
+	auto* model = const_cast<SpreadsheetModel*>(this);
+	auto* watcher = new QFutureWatcher<QVector<QString>>(model);
+	connect(watcher, &QFutureWatcher<QVector<QString>>::finished, model, [model, watcher, key, version]() {
+		model->m_pendingBlocks.remove(key);
+		// discard the result if the column was changed in the meantime
+		if (model->m_formattingVersions.value(key.first) == version) {
+			auto texts = watcher->result();
+			const int size = texts.size();
+			model->m_formattedBlocks.insert(key, new FormattedBlock{version, std::move(texts), true}, size);
+		}
+		watcher->deleteLater();
+	});
+	watcher->setFuture(QtConcurrent::run([values]() {
+		return formatBlock(*values);
+	}));
+}
+
+/*!
+ * returns the current formatting version of \c column, the cached blocks of older versions are outdated.
+ */
+quint64 SpreadsheetModel::formattingVersion(const AbstractColumn* column) const {
+	auto it = m_formattingVersions.find(column);
+	if (it == m_formattingVersions.end())
+		it = m_formattingVersions.insert(column, ++m_formattingVersion);
+	return it.value();
+}
+
+void SpreadsheetModel::invalidateFormatting(const AbstractColumn* column) {
+	m_formattingVersions.remove(column);
+}
+
+/*!
+ * removes all cached formatted values, to be called if the formatting changed without a notification
+ * of the columns (e.g. the number locale).
+ */
+void SpreadsheetModel::clearFormattingCache() {
+	m_formattingVersions.clear();
+	m_formattedBlocks.clear();
+}
+
 QVariant SpreadsheetModel::headerData(int section, Qt::Orientation orientation, int role) const {
 	if ((orientation == Qt::Horizontal && section > m_columnCount - 1) || (orientation == Qt::Vertical && section > m_rowCount - 1))
 		return {};
@@ -490,6 +664,8 @@ void SpreadsheetModel::handleAspectCountChanged() {
 	if (m_suppressSignals)
 		return;
 
+	clearFormattingCache();
+
 	m_columnCount = m_spreadsheet->columnCount();
 	updateHorizontalHeader(false);
 }
@@ -545,6 +721,7 @@ void SpreadsheetModel::handlePlotDesignationChange(const AbstractColumn* col) {
 }
 
 void SpreadsheetModel::handleDataChange(const AbstractColumn* col) {
+	invalidateFormatting(col);
 	if (m_suppressSignals)
 		return;
 
@@ -582,6 +759,7 @@ void SpreadsheetModel::handleRowCountChanged(int newRowCount) {
 	if (m_suppressSignals)
 		return;
 	m_rowCount = newRowCount;
+	clearFormattingCache();
 	updateVerticalHeader();
 }
 
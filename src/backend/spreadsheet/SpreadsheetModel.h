@@ -14,6 +14,8 @@
 
 #include "backend/core/AbstractColumn.h"
 #include <QAbstractItemModel>
+#include <QCache>
+#include <QSet>
 
 class Column;
 class Spreadsheet;
@@ -53,6 +55,8 @@ public:
 	void setSearchText(const QString&);
 	QModelIndex index(const QString&) const;
 
+	void clearFormattingCache();
+
 	Spreadsheet* spreadsheet();
 
 private Q_SLOTS:
@@ -99,6 +103,24 @@ private:
 	QString m_searchText;
 
 	QVariant color(const AbstractColumn*, int row, AbstractColumn::Formatting) const;
+
+	// cache of the formatted values shown in the view, the values are formatted in blocks of rows
+	struct FormattedBlock {
+		quint64 version{0}; // formatting version of the column when the block was formatted
+		QVector<QString> texts;
+		bool prefetched{false}; // formatted in advance, the neighbour blocks are prefetched on the first access
+	};
+	using BlockKey = QPair<const AbstractColumn*, int>;
+	static constexpr int formattingBlockSize = 256;
+	mutable QCache<BlockKey, FormattedBlock> m_formattedBlocks{1024 * formattingBlockSize}; // cost = number of rows
+	mutable QHash<const AbstractColumn*, quint64> m_formattingVersions;
+	mutable quint64 m_formattingVersion{0};
+	mutable QSet<BlockKey> m_pendingBlocks; // blocks formatted in the background
+
+	QString displayText(const Column*, int row) const;
+	quint64 formattingVersion(const AbstractColumn*) const;
+	void invalidateFormatting(const AbstractColumn*);
+	void prefetchBlock(const Column*, int block) const;
 };
 
 #endif
@@ -0,0 +1,263 @@
+/*
+	File                 : SpectralAnalysis.cpp
+	Project              : LabPlot
+	Description          : Segment based spectral analysis (Welch's method, spectrogram)
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/timeseriesanalysis/SpectralAnalysis.h"
+#include "backend/core/AbstractColumn.h"
+#include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+#include "backend/matrix/Matrix.h"
+
+extern "C" {
+#include "backend/nsl/nsl_dft.h"
+}
+
+#include <KLocalizedString>
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <cfloat>
+#include <numeric>
+#include <vector>
+
+/*!
+ * \namespace SpectralAnalysis
+ * \brief Spectral analysis of long signals based on overlapping segments.
+ *
+ * The signal is streamed segment by segment directly from the columns, the windowed power spectra
+ * of a batch of segments are calculated in parallel and are accumulated afterwards. The required memory
+ * only depends on the segment length and on the number of threads and not on the length of the signal.
+ *
+ * \ingroup backend
+ */
+namespace SpectralAnalysis {
+
+namespace {
+// minimal number of samples per segment, the Hann window of shorter segments is zero everywhere
+constexpr int minSegmentLength = 4;
+
+bool isValid(const AbstractColumn* x, const AbstractColumn* y, int row, const Options& options) {
+	if (y->isMasked(row) || std::isnan(y->valueAt(row)))
+		return false;
+
+	if (!x)
+		return true;
+
+	if (x->isMasked(row))
+		return false;
+
+	const double value = x->valueAt(row);
+	if (std::isnan(value))
+		return false;
+
+	return !((!std::isnan(options.xMin) && value < options.xMin) || (!std::isnan(options.xMax) && value > options.xMax));
+}
+
+int rowCount(const AbstractColumn* x, const AbstractColumn* y) {
+	return x ? std::min(x->rowCount(), y->rowCount()) : y->rowCount();
+}
+
+/*!
+ * determines the number of valid samples, the segmentation and the sampling rate without copying the data.
+ */
+Info scan(const AbstractColumn* x, const AbstractColumn* y, const Options& options) {
+	Info info;
+	bool first = true;
+	const int rows = rowCount(x, y);
+	for (int row = 0; row < rows; ++row) {
+		if (!isValid(x, y, row, options))
+			continue;
+
+		const double xValue = x ? x->valueAt(row) : row;
+		if (first) {
+			info.xFirst = xValue;
+			first = false;
+		}
+		info.xLast = xValue;
+		++info.samples;
+	}
+
+	if (info.samples < static_cast<size_t>(minSegmentLength))
+		return info;
+
+	// the segments are never longer than the signal, the requested length can be invalid if set via the API or in a loaded project
+	const int requestedLength = std::max(options.segmentLength, minSegmentLength);
+	info.segmentLength = static_cast<int>(std::min(static_cast<size_t>(requestedLength), info.samples));
+	info.segmentLength -= info.segmentLength % 2;
+	const double overlap = qBound(0., options.overlap, 0.95);
+	info.step = std::max(1, info.segmentLength - static_cast<int>(std::round(info.segmentLength * overlap)));
+	info.segments = 1 + (info.samples - info.segmentLength) / info.step;
+
+	// equidistant samples are assumed as in the transform of the full signal
+	if (info.xLast != info.xFirst)
+		info.samplingRate = (info.samples - 1) / std::abs(info.xLast - info.xFirst);
+
+	return info;
+}
+
+/*!
+ * streams the valid samples into segments and calls \c consume(segment, power) for every segment in the order of the segments,
+ * \c power contains the segmentLength/2 values of the squared magnitude of the DFT of the windowed segment.
+ */
+template<typename Consume>
+void processSegments(const AbstractColumn* x, const AbstractColumn* y, const Options& options, const Info& info, Consume consume) {
+	const int length = info.segmentLength;
+	const int batchSize = 4 * std::max(1, QThread::idealThreadCount());
+	std::vector<double> batch(static_cast<size_t>(batchSize) * length);
+	std::vector<double> samples; // samples of the current segment
+	samples.reserve(length);
+
+	size_t segment = 0;
+	int count = 0; // number of segments in the current batch
+	QVector<int> indices(batchSize);
+	std::iota(indices.begin(), indices.end(), 0);
+	auto flush = [&]() {
+		PERFTRACE(QStringLiteral("spectral analysis, batch of segments"));
+		QtConcurrent::blockingMap(indices.begin(), indices.begin() + count, [&batch, &options, length](int i) {
+			nsl_dft_transform_window(batch.data() + static_cast<size_t>(i) * length, 1, length, 0, nsl_dft_result_squaremagnitude, options.windowType);
+		});
+		for (int i = 0; i < count; ++i)
+			consume(segment++, batch.data() + static_cast<size_t>(i) * length);
+		count = 0;
+	};
+
+	const int rows = rowCount(x, y);
+	for (int row = 0; row < rows && segment + count < info.segments; ++row) {
+		if (!isValid(x, y, row, options))
+			continue;
+
+		samples.push_back(y->valueAt(row));
+		if ((int)samples.size() < length)
+			continue;
+
+		std::copy(samples.cbegin(), samples.cend(), batch.begin() + static_cast<size_t>(count) * length);
+		if (++count == batchSize)
+			flush();
+		samples.erase(samples.begin(), samples.begin() + std::min(info.step, length));
+	}
+
+	if (count > 0)
+		flush();
+}
+
+/*!
+ * returns the factors to scale the accumulated squared magnitudes of \c segments segments to the one-sided power spectral density.
+ */
+QVector<double> psdScale(const Info& info, nsl_sf_window_type windowType, size_t segments) {
+	// power of the window
+	std::vector<double> window(info.segmentLength, 1.);
+	nsl_sf_apply_window(window.data(), window.size(), windowType);
+	const double power = std::accumulate(window.cbegin(), window.cend(), 0., [](double sum, double w) {
+		return sum + w * w;
+	});
+
+	QVector<double> scale(info.segmentLength / 2, 2. / (info.samplingRate * power * segments));
+	if (!scale.isEmpty())
+		scale[0] /= 2.; // DC is not doubled in the one-sided spectrum
+	return scale;
+}
+}
+
+/*!
+ * calculates the one-sided power spectral density of \c y (sampled at \c x, equidistant sampling is assumed)
+ * with Welch's method. The spectrum has segmentLength/2 values, the frequency of the value k is k*samplingRate/segmentLength.
+ * Returns \c false if there are not enough valid samples.
+ */
+bool welch(const AbstractColumn* x, const AbstractColumn* y, const Options& options, QVector<double>& psd, Info& info) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	if (!y)
+		return false;
+
+	info = scan(x, y, options);
+	if (info.segments == 0)
+		return false;
+
+	QVector<double> sum(info.segmentLength / 2, 0.);
+	processSegments(x, y, options, info, [&sum](size_t, const double* power) {
+		for (int k = 0; k < sum.size(); ++k)
+			sum[k] += power[k];
+	});
+
+	const auto& scale = psdScale(info, options.windowType, info.segments);
+	psd.resize(sum.size());
+	for (int k = 0; k < sum.size(); ++k)
+		psd[k] = sum.at(k) * scale.at(k);
+
+	return true;
+}
+
+/*!
+ * calculates the spectrogram (short-time Fourier transform) of \c y. The result \c psd contains the power spectral densities in dB
+ * for at most \c maxTimeBins time bins, consecutive segments are averaged if there are more segments than time bins.
+ * \c tFirst and \c tLast are the times (x values) of the centers of the first and of the last time bin.
+ * Returns \c false if there are not enough valid samples.
+ */
+bool spectrogram(const AbstractColumn* x,
+				 const AbstractColumn* y,
+				 const Options& options,
+				 int maxTimeBins,
+				 QVector<QVector<double>>& psd,
+				 Info& info,
+				 double& tFirst,
+				 double& tLast) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	if (!y || maxTimeBins < 1)
+		return false;
+
+	info = scan(x, y, options);
+	if (info.segments == 0)
+		return false;
+
+	const size_t segmentsPerBin = (info.segments + maxTimeBins - 1) / maxTimeBins;
+	const int bins = static_cast<int>((info.segments + segmentsPerBin - 1) / segmentsPerBin);
+	const int frequencies = info.segmentLength / 2;
+	psd = QVector<QVector<double>>(bins, QVector<double>(frequencies, 0.));
+	processSegments(x, y, options, info, [&psd, segmentsPerBin, frequencies](size_t segment, const double* power) {
+		auto& bin = psd[static_cast<int>(segment / segmentsPerBin)];
+		for (int k = 0; k < frequencies; ++k)
+			bin[k] += power[k];
+	});
+
+	for (int b = 0; b < bins; ++b) {
+		const size_t segments = std::min(segmentsPerBin, info.segments - b * segmentsPerBin);
+		const auto& scale = psdScale(info, options.windowType, segments);
+		auto& bin = psd[b];
+		for (int k = 0; k < frequencies; ++k)
+			bin[k] = 10. * log10(std::max(bin.at(k) * scale.at(k), DBL_MIN));
+	}
+
+	// time of the center of the segment s
+	const double direction = (info.xLast >= info.xFirst) ? 1. : -1.;
+	auto time = [&info, direction](double s) {
+		return info.xFirst + direction * (s * info.step + info.segmentLength / 2.) / info.samplingRate;
+	};
+	tFirst = time((segmentsPerBin - 1) / 2.);
+	const size_t lastBinStart = (bins - 1) * segmentsPerBin;
+	tLast = time((lastBinStart + info.segments - 1) / 2.);
+
+	return true;
+}
+
+/*!
+ * creates a matrix with the spectrogram of \c y, the columns of the matrix correspond to the time bins and the rows to the frequencies.
+ * Returns \c nullptr if there are not enough valid samples.
+ */
+Matrix* createSpectrogramMatrix(const AbstractColumn* x, const AbstractColumn* y, const Options& options, int maxTimeBins) {
+	QVector<QVector<double>> psd;
+	Info info;
+	double tFirst, tLast;
+	if (!spectrogram(x, y, options, maxTimeBins, psd, info, tFirst, tLast))
+		return nullptr;
+
+	auto* matrix = new Matrix(psd.constFirst().size(), psd.size(), i18n("Spectrogram for %1", y->name()));
+	static_cast<QVector<QVector<double>>*>(matrix->data())->swap(psd);
+	matrix->setCoordinates(tFirst, tLast, 0., (info.segmentLength / 2 - 1) * info.samplingRate / info.segmentLength);
+	return matrix;
+}
+}
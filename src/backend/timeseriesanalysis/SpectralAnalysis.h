@@ -0,0 +1,48 @@
+/*
+	File                 : SpectralAnalysis.h
+	Project              : LabPlot
+	Description          : Segment based spectral analysis (Welch's method, spectrogram)
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef SPECTRALANALYSIS_H
+#define SPECTRALANALYSIS_H
+
+extern "C" {
+#include "backend/nsl/nsl_sf_window.h"
+}
+
+#include <QVector>
+
+#include <cmath>
+
+class AbstractColumn;
+class Matrix;
+
+namespace SpectralAnalysis {
+struct Options {
+	int segmentLength{1024}; // number of samples per segment
+	double overlap{0.5}; // overlap of consecutive segments as fraction of the segment length
+	nsl_sf_window_type windowType{nsl_sf_window_hann};
+	double xMin{NAN}; // range of the x values to use, all data if not set
+	double xMax{NAN};
+};
+
+struct Info {
+	size_t samples{0}; // number of used (valid) samples
+	int segmentLength{0}; // effective segment length, smaller than requested for short signals
+	int step{0}; // distance between the starts of consecutive segments
+	size_t segments{0}; // number of segments
+	double samplingRate{1.};
+	double xFirst{0.}; // x of the first and of the last used sample
+	double xLast{0.};
+};
+
+bool welch(const AbstractColumn* x, const AbstractColumn* y, const Options&, QVector<double>& psd, Info&);
+bool spectrogram(const AbstractColumn* x, const AbstractColumn* y, const Options&, int maxTimeBins, QVector<QVector<double>>& psd, Info&, double& tFirst, double& tLast);
+Matrix* createSpectrogramMatrix(const AbstractColumn* x, const AbstractColumn* y, const Options&, int maxTimeBins = 2000);
+}
+
+#endif
@@ -440,6 +440,20 @@ int TextLabel::gluePointCount() {
 
 void TextLabel::updateTeXImage() {
 	Q_D(TextLabel);
+	if (d->teXImagePending) // not applied in waitForTeXImage() yet
+		d->updateTeXImage();
+}
+
+/*!
+ * waits until the TeX image rendered in the background is available and shows it,
+ * called before the label is exported or printed.
+ */
+void TextLabel::waitForTeXImage() {
+	Q_D(TextLabel);
+	if (!d->teXImagePending)
+		return;
+
+	d->teXImageFutureWatcher.waitForFinished();
 	d->updateTeXImage();
 }
 
@@ -472,7 +486,7 @@ TextLabelPrivate::TextLabelPrivate(TextLabel* owner)
  */
 QRectF TextLabelPrivate::size() {
 	double w, h;
-	if (textWrapper.mode == TextLabel::Mode::LaTeX) {
+	if (textWrapper.mode == TextLabel::Mode::LaTeX && !teXPlaceholder) {
 		// image size is in pixel, convert to scene units
 		const qreal imageDpr = (teXImage.devicePixelRatio() > 0.0) ? teXImage.devicePixelRatio() : 1.0;
 		const qreal effectiveZoom = (zoomFactor > 0.0) ? zoomFactor : 1.0;
@@ -609,6 +623,7 @@ void TextLabelPrivate::updateText() {
 	if (suppressRetransform)
 		return;
 
+	teXPlaceholder = false;
 	switch (textWrapper.mode) {
 	case TextLabel::Mode::Text: {
 		// DEBUG(Q_FUNC_INFO << ", TEXT = " << STDSTRING(textWrapper.text))
@@ -640,8 +655,18 @@ void TextLabelPrivate::updateText() {
 		format.fontSize = teXFont.pointSize();
 		format.fontFamily = teXFont.family();
 		format.dpi = teXImageResolution;
-		QFuture<QByteArray> future = QtConcurrent::run(TeXRenderer::renderImageLaTeX, textWrapper.text, &teXRenderResult, format);
+		QFuture<QByteArray> future = QtConcurrent::run(TeXRenderer::threadPool(), TeXRenderer::renderImageLaTeX, textWrapper.text, &teXRenderResult, format);
 		teXImageFutureWatcher.setFuture(future);
+		teXImagePending = true;
+
+		// show the TeX code as a placeholder until the first image is rendered,
+		// the previous image is shown otherwise
+		if (teXImage.isNull() && !textWrapper.text.isEmpty()) {
+			teXPlaceholder = true;
+			m_textItem->setHtml(QStringLiteral("<span style=\"color:gray\">%1</span>").arg(textWrapper.text.toHtmlEscaped()));
+			m_textItem->show();
+			updateBoundingRect();
+		}
 
 		// don't need to call retransform() here since it is done in updateTeXImage
 		// when the asynchronous rendering of the image is finished.
@@ -696,7 +721,7 @@ void TextLabelPrivate::updateBoundingRect() {
 	// DEBUG(Q_FUNC_INFO)
 	// determine the size of the label in scene units.
 	double w, h;
-	if (textWrapper.mode == TextLabel::Mode::LaTeX) {
+	if (textWrapper.mode == TextLabel::Mode::LaTeX && !teXPlaceholder) {
 		// image size is in pixel, convert to scene units.
 		// the image is scaled so we have a good image quality when the worksheet was zoomed,
 		// for the bounding rect we need to scale back since it's scaled again in paint() when drawing the rect
@@ -732,9 +757,15 @@ void TextLabelPrivate::updateBoundingRect() {
 
 void TextLabelPrivate::updateTeXImage() {
 	DEBUG(Q_FUNC_INFO)
+	teXImagePending = false;
 	if (textWrapper.mode != TextLabel::Mode::LaTeX)
 		return;
 
+	if (teXPlaceholder) {
+		teXPlaceholder = false;
+		m_textItem->hide();
+	}
+
 	if (zoomFactor == -1.0) {
 		// the view was not zoomed after the label was added so the zoom factor is not set yet.
 		// determine the current zoom factor in the view and use it
@@ -127,6 +127,7 @@ public:
 	Line* borderLine() const;
 
 	void setZoomFactor(double);
+	void waitForTeXImage();
 	QRectF size();
 	QPointF findNearestGluePoint(QPointF scenePoint);
 	int gluePointCount();
@@ -39,6 +39,8 @@ public:
 	QByteArray teXPdfData;
 	QFutureWatcher<QByteArray> teXImageFutureWatcher;
 	TeXRenderer::Result teXRenderResult;
+	bool teXPlaceholder{false}; // the TeX code is shown while the first image is rendered
+	bool teXImagePending{false}; // the image rendered in the background is not applied yet
 
 	TextLabel::BorderShape borderShape{TextLabel::BorderShape::NoBorder};
 	Line* borderLine{nullptr};
@@ -18,10 +18,12 @@
 #include "backend/lib/ScopedUndoDisabler.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
+#include "backend/lib/trace.h"
 #include "backend/worksheet/Image.h"
 #include "backend/worksheet/Line.h"
 #include "backend/worksheet/TextLabel.h"
 #include "backend/worksheet/TreeModel.h"
+#include "backend/worksheet/plots/cartesian/XYCurve.h"
 #include "frontend/ThemeHandler.h"
 #include "frontend/worksheet/ExportWorksheetDialog.h"
 #include "frontend/worksheet/WorksheetView.h"
@@ -43,6 +45,24 @@
 
 namespace {
 constexpr auto CURSOR_UUID_EDIT_ROLE = Qt::UserRole;
+
+/*!
+ * the curves of all plots requested to be retransformed during the lifetime of this object
+ * are retransformed in one batch at its end, see Worksheet::deferRetransform().
+ */
+class RetransformBatch {
+public:
+	explicit RetransformBatch(WorksheetPrivate* d)
+		: m_d(d) {
+		m_d->beginRetransformBatch();
+	}
+	~RetransformBatch() {
+		m_d->endRetransformBatch();
+	}
+
+private:
+	WorksheetPrivate* m_d;
+};
 }
 
 /**
@@ -258,7 +278,9 @@ QVector<AspectType> Worksheet::pasteTypes() const {
 }
 
 bool Worksheet::exportToFile(const QString& path, const ExportFormat format, const ExportArea area, const bool background, int resolution) const {
-	return static_cast<WorksheetView*>(view())->exportToFile(path, format, area, background, resolution);
+	auto* worksheetView = static_cast<WorksheetView*>(view());
+	prepareExport();
+	return worksheetView->exportToFile(path, format, area, background, resolution);
 }
 
 bool Worksheet::exportView() const {
@@ -275,6 +297,7 @@ bool Worksheet::exportView() const {
 		const int resolution = dlg->exportResolution();
 
 		WAIT_CURSOR_AUTO_RESET;
+		prepareExport();
 		m_view->exportToFile(path, format, area, background, resolution);
 	}
 	delete dlg;
@@ -288,6 +311,7 @@ bool Worksheet::exportView(QPixmap& pixmap) const {
 	if (!m_view)
 		return false;
 
+	prepareExport();
 	m_view->exportToPixmap(pixmap);
 	return true;
 }
@@ -299,8 +323,10 @@ bool Worksheet::printView() {
 	auto* dlg = new QPrintDialog(&printer, m_view);
 	dlg->setWindowTitle(i18nc("@title:window", "Print Worksheet"));
 	bool ret;
-	if ((ret = (dlg->exec() == QDialog::Accepted)))
+	if ((ret = (dlg->exec() == QDialog::Accepted))) {
+		prepareExport();
 		m_view->print(&printer);
+	}
 
 	delete dlg;
 	setPrinting(false);
@@ -313,6 +339,7 @@ bool Worksheet::printView() {
 bool Worksheet::printPreview() const {
 #ifndef SDK
 	setPrinting(true);
+	prepareExport();
 	auto* dlg = new QPrintPreviewDialog(m_view);
 	connect(dlg, &QPrintPreviewDialog::paintRequested, m_view, &WorksheetView::print);
 	const auto r = dlg->exec();
@@ -574,6 +601,41 @@ void Worksheet::setIsClosing() {
 		m_view->setIsClosing();
 }
 
+/*!
+ * marks the worksheet to be retransformed when its view is created for the first time,
+ * called after the project was loaded, see Project::setDeferWorksheetRetransform().
+ */
+void Worksheet::setRetransformDeferred() {
+	m_retransformDeferred = true;
+	if (m_partView) // already shown, nothing to defer
+		retransformDeferred();
+}
+
+/*!
+ * finishes the updates still pending before the worksheet is exported or printed:
+ * the retransform deferred after the project was loaded and the TeX images of the labels rendered in the background.
+ */
+void Worksheet::prepareExport() const {
+	retransformDeferred();
+	for (auto* label : children<TextLabel>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden))
+		label->waitForTeXImage();
+}
+
+/*!
+ * retransforms the elements if this was deferred after the project was loaded.
+ * Called before the worksheet is shown in a view, exported or printed.
+ */
+void Worksheet::retransformDeferred() const {
+	if (!m_retransformDeferred)
+		return;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	m_retransformDeferred = false;
+	RetransformBatch batch(d_ptr);
+	for (auto* e : children<WorksheetElement>(ChildIndexFlag::IncludeHidden))
+		e->retransform();
+}
+
 void Worksheet::suppressSelectionChangedEvent(bool value) {
 	if (m_view)
 		m_view->suppressSelectionChangedEvent(value);
@@ -619,6 +681,22 @@ void Worksheet::updateLayout() {
 	d->updateLayout();
 }
 
+/*!
+ * called by the curves when they need to be retransformed. While all plots of the worksheet are retransformed
+ * (layout and page size changes, actions applied to all plots, etc.), the retransformation of the curves is deferred
+ * and done for all of them together at the end, see XYCurve::retransformCurves(). Multiple requests of the same curve
+ * are combined. Returns \c true if the retransformation was deferred, \c false if the curve has to retransform itself.
+ */
+bool Worksheet::deferRetransform(XYCurve* curve) {
+	Q_D(Worksheet);
+	if (d->retransformBatchLevel == 0)
+		return false;
+
+	if (!d->deferredRetransforms.contains(curve))
+		d->deferredRetransforms << curve;
+	return true;
+}
+
 Worksheet::CartesianPlotActionMode Worksheet::cartesianPlotActionMode() const {
 	Q_D(const Worksheet);
 	return d->cartesianPlotActionMode;
@@ -925,6 +1003,7 @@ void Worksheet::cartesianPlotMousePressZoomSelectionMode(QPointF logicPos) {
 }
 
 void Worksheet::cartesianPlotMouseReleaseZoomSelectionMode() {
+	RetransformBatch batch(d_ptr);
 	auto senderPlot = static_cast<CartesianPlot*>(QObject::sender());
 	auto mouseMode = senderPlot->mouseMode();
 	auto actionMode = cartesianPlotActionMode();
@@ -971,6 +1050,7 @@ void Worksheet::cartesianPlotMouseMoveZoomSelectionMode(QPointF logicPos) {
 }
 
 void Worksheet::cartesianPlotMouseMoveSelectionMode(QPointF logicStart, QPointF logicEnd) {
+	RetransformBatch batch(d_ptr);
 	auto* senderPlot = static_cast<CartesianPlot*>(QObject::sender());
 	auto actionMode = cartesianPlotActionMode();
 	if (actionMode == CartesianPlotActionMode::ApplyActionToAll) {
@@ -1030,6 +1110,7 @@ void Worksheet::cartesianPlotMouseHoverOutsideDataRect() {
 }
 
 void Worksheet::cartesianPlotAxisShift(int delta, Dimension dim, int index) {
+	RetransformBatch batch(d_ptr);
 	const auto& plots = children<CartesianPlot>(AbstractAspect::ChildIndexFlag::Recursive | AbstractAspect::ChildIndexFlag::IncludeHidden);
 	const auto cursorMode = cartesianPlotActionMode();
 	bool leftOrDown = false;
@@ -1081,6 +1162,7 @@ void Worksheet::cartesianPlotAxisShift(int delta, Dimension dim, int index) {
 }
 
 void Worksheet::cartesianPlotWheelEvent(const QPointF& sceneRelPos, int delta, int xIndex, int yIndex, bool considerDimension, Dimension dim) {
+	RetransformBatch batch(d_ptr);
 	const auto& plots = children<CartesianPlot>(AbstractAspect::ChildIndexFlag::Recursive | AbstractAspect::ChildIndexFlag::IncludeHidden);
 	const auto cursorMode = cartesianPlotActionMode();
 	if (considerDimension) {
@@ -1591,6 +1673,7 @@ void WorksheetPrivate::updatePageRect() {
 			const auto& children = q->children<WorksheetElement>(AbstractAspect::ChildIndexFlag::IncludeHidden);
 			if (useViewSize) {
 				// don't make the change of the geometry undoable/redoable if the view size is used.
+				RetransformBatch batch(this);
 				for (auto* elem : children) {
 					elem->setUndoAware(false);
 					elem->handleResize(horizontalRatio, verticalRatio, true);
@@ -1608,6 +1691,30 @@ void WorksheetPrivate::update() {
 	q->update();
 }
 
+/*!
+ * starts the retransformation of several plots, the retransformation of their curves is deferred
+ * until the matching call of endRetransformBatch(), see Worksheet::deferRetransform().
+ * The calls can be nested, the curves are retransformed at the end of the outermost batch.
+ */
+void WorksheetPrivate::beginRetransformBatch() {
+	++retransformBatchLevel;
+}
+
+void WorksheetPrivate::endRetransformBatch() {
+	if (--retransformBatchLevel > 0 || deferredRetransforms.isEmpty())
+		return;
+
+	QVector<XYCurve*> curves;
+	curves.reserve(deferredRetransforms.size());
+	for (const auto& curve : std::as_const(deferredRetransforms)) {
+		if (curve) // the curve might have been deleted in the meantime
+			curves << curve;
+	}
+	deferredRetransforms.clear();
+
+	XYCurve::retransformCurves(curves);
+}
+
 WorksheetPrivate::~WorksheetPrivate() {
 	delete m_scene;
 	delete cursorData;
@@ -1650,6 +1757,8 @@ void WorksheetPrivate::updateLayout(bool undoable) {
 		return;
 	}
 
+	// retransform the curves of all plots in one step after the new geometry of the plots was set
+	beginRetransformBatch();
 	double x = layoutLeftMargin;
 	double y = layoutTopMargin;
 	double w, h;
@@ -1694,6 +1803,7 @@ void WorksheetPrivate::updateLayout(bool undoable) {
 			}
 		}
 	}
+	endRetransformBatch();
 
 	Q_EMIT q->changed();
 }
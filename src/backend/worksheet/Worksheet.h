@@ -85,6 +85,8 @@ public:
 	void setItemSelectedInView(const QGraphicsItem*, const bool);
 	void deleteAspectFromGraphicsItem(const QGraphicsItem*);
 	void setIsClosing();
+	void setRetransformDeferred();
+	void retransformDeferred() const;
 	void suppressSelectionChangedEvent(bool);
 
 	CartesianPlotActionMode cartesianPlotActionMode() const;
@@ -119,6 +121,7 @@ public:
 
 	void setSuppressLayoutUpdate(bool);
 	void updateLayout();
+	bool deferRetransform(XYCurve*);
 
 	void registerShortcuts() override;
 	void unregisterShortcuts() override;
@@ -149,10 +152,12 @@ private:
 	void init();
 	WorksheetElement* aspectFromGraphicsItem(const WorksheetElement*, const QGraphicsItem*) const;
 	void loadTheme(const QString&);
+	void prepareExport() const;
 
 	Q_DECLARE_PRIVATE(Worksheet)
 	WorksheetPrivate* const d_ptr;
 	mutable WorksheetView* m_view{nullptr};
+	mutable bool m_retransformDeferred{false};
 	friend class WorksheetPrivate;
 
 private Q_SLOTS:
@@ -13,11 +13,13 @@
 #include <backend/worksheet/Worksheet.h>
 
 #include <QColor>
+#include <QPointer>
 
 class Background;
 class TreeModel;
 class Worksheet;
 class WorksheetElementContainer;
+class XYCurve;
 
 class QBrush;
 class QGraphicsScene;
@@ -39,10 +41,14 @@ public:
 	void updateLayout(bool undoable = true);
 	void setContainerRect(WorksheetElementContainer*, double x, double y, double h, double w, bool undoable);
 	void updatePageRect();
+	void beginRetransformBatch();
+	void endRetransformBatch();
 
 	Background* background{nullptr};
 	Worksheet::Layout layout{Worksheet::Layout::VerticalLayout};
 	bool suppressLayoutUpdate{false};
+	int retransformBatchLevel{0}; // > 0 while the plots are retransformed as a whole, see beginRetransformBatch()
+	QVector<QPointer<XYCurve>> deferredRetransforms; // curves to be retransformed at the end of the current batch
 	bool suppressCursorPosChanged{false};
 	double layoutTopMargin{0.0};
 	double layoutBottomMargin{0.0};
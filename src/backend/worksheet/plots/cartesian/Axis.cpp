@@ -2342,10 +2342,8 @@ void AxisPrivate::retransformTickLabelStrings() {
 		}
 	} else if (datetime) {
 		for (const auto value : std::as_const(tickLabelValues)) {
-			QDateTime dateTime;
-			dateTime.setTimeZone(QTimeZone::UTC);
-			dateTime.setMSecsSinceEpoch(value);
-			str = dateTime.toString(labelsDateTimeFormat);
+			// the values are fractional milliseconds, DateTime::toString() also formats microseconds and nanoseconds
+			str = DateTime::toString(value, labelsDateTimeFormat);
 			str = labelsPrefix + str + labelsSuffix;
 			tickLabelStrings << str;
 		}
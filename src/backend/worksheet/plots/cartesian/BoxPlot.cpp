@@ -13,6 +13,7 @@
 #include "backend/core/Folder.h"
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/macrosCurve.h"
@@ -1069,6 +1070,8 @@ void BoxPlotPrivate::recalc(int index) {
 	const double outerFenceMax = statistics.thirdQuartile + 3.0 * statistics.iqr;
 	const double outerFenceMin = statistics.firstQuartile - 3.0 * statistics.iqr;
 
+	const auto dateTimes = column->dateTimeMSecs();
+	const auto timestamps = column->dateTimeNSecs();
 	for (int row = 0; row < column->rowCount(); ++row) {
 		if (!column->isValid(row) || column->isMasked(row))
 			continue;
@@ -1081,7 +1084,10 @@ void BoxPlotPrivate::recalc(int index) {
 			value = column->valueAt(row);
 			break;
 		case AbstractColumn::ColumnMode::DateTime:
-			value = column->dateTimeAt(row).toMSecsSinceEpoch();
+			if (!timestamps.empty())
+				value = DateTimeValues::toMSecsF(timestamps[row]);
+			else
+				value = !dateTimes.empty() ? dateTimes[row] : column->dateTimeAt(row).toMSecsSinceEpoch();
 			break;
 		case AbstractColumn::ColumnMode::Text:
 		case AbstractColumn::ColumnMode::Month:
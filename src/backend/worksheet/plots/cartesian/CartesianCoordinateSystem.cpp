@@ -13,8 +13,54 @@
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include <KLocalizedString>
 
+#include <QtConcurrent/QtConcurrentMap>
+
 #include "backend/nsl/nsl_math.h"
 
+namespace {
+// number of values mapped at once with the batch mapping of the scales
+constexpr qsizetype mappingBlockSize = 4096;
+// minimal number of points mapped in parallel and number of points mapped per task
+constexpr qsizetype parallelMappingMinSize = 1 << 16;
+constexpr qsizetype parallelMappingChunkSize = 1 << 14;
+// number of points converted at once from QPointF to separate x- and y-values
+constexpr qsizetype pointsBlockSize = 1 << 18;
+
+/*!
+ * maps the \c count points with the indices \c indexAt(0), ..., \c indexAt(count - 1) in \c logicalPoints with the batch mapping
+ * of \c cSystem and calls \c visit(index, visible, x, y) for every point in this order.
+ */
+template<typename IndexAt, typename Visit>
+void mapPoints(const CartesianCoordinateSystem* cSystem,
+			   IndexAt indexAt,
+			   qsizetype count,
+			   const Points& logicalPoints,
+			   AbstractCoordinateSystem::MappingFlags flags,
+			   Visit visit) {
+	const qsizetype blockSize = std::min(count, pointsBlockSize);
+	std::vector<double> x(blockSize), y(blockSize), sceneX(blockSize), sceneY(blockSize);
+	std::vector<quint8> visible(blockSize);
+	for (qsizetype start = 0; start < count; start += blockSize) {
+		const qsizetype size = std::min(blockSize, count - start);
+		for (qsizetype k = 0; k < size; ++k) {
+			const auto& point = logicalPoints.at(indexAt(start + k));
+			x[k] = point.x();
+			y[k] = point.y();
+		}
+
+		cSystem->mapLogicalToScene({x.data(), static_cast<size_t>(size)},
+								   {y.data(), static_cast<size_t>(size)},
+								   {sceneX.data(), static_cast<size_t>(size)},
+								   {sceneY.data(), static_cast<size_t>(size)},
+								   {visible.data(), static_cast<size_t>(size)},
+								   flags);
+
+		for (qsizetype k = 0; k < size; ++k)
+			visit(indexAt(start + k), visible[k], sceneX[k], sceneY[k]);
+	}
+}
+}
+
 /* ============================================================================ */
 /* ========================= coordinate system ================================ */
 /* ============================================================================ */
@@ -118,48 +164,20 @@ bool CartesianCoordinateSystem::mapYLogicalToScene(double& y, MappingFlags flags
 
 Points CartesianCoordinateSystem::mapLogicalToScene(const Points& points, MappingFlags flags) const {
 	// DEBUG(Q_FUNC_INFO << ", (points with flags)")
-	const QRectF pageRect = d->plot->dataRect();
-	const bool noPageClipping = pageRect.isNull() || (flags & MappingFlag::SuppressPageClipping);
-	const bool noPageClippingY = flags & MappingFlag::SuppressPageClippingY;
-	const bool limit = flags & MappingFlag::Limit;
-	const double xPage = pageRect.x(), yPage = pageRect.y();
-	const double w = pageRect.width(), h = pageRect.height();
-
-	// DEBUG(Q_FUNC_INFO << ", xScales/YScales size: " << d->xScales.size() << '/' << d->yScales.size())
-
 	Points result;
 	result.reserve(points.size());
-	for (const auto* xScale : d->xScales) {
-		if (!xScale)
-			continue;
-
-		for (const auto* yScale : d->yScales) {
-			if (!yScale)
-				continue;
-
-			for (const auto& point : points) {
-				double x = point.x(), y = point.y();
-
-				if (!xScale->contains(x) || !yScale->contains(y))
-					continue;
-				if (!xScale->map(&x) || !yScale->map(&y))
-					continue;
-
-				if (limit) {
-					// set to max/min if passed over
-					x = qBound(xPage, x, xPage + w);
-					y = qBound(yPage, y, yPage + h);
-				}
-
-				if (noPageClippingY)
-					y = yPage + h / 2.;
-
-				const QPointF mappedPoint(x, y);
-				if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint))
-					result.append(mappedPoint);
-			}
-		}
-	}
+	mapPoints(
+		this,
+		[](qsizetype k) {
+			return k;
+		},
+		points.size(),
+		points,
+		flags,
+		[&result](qsizetype, bool visible, double x, double y) {
+			if (visible)
+				result.append(QPointF(x, y));
+		});
 	result.squeeze();
 
 	return result;
@@ -178,51 +196,19 @@ void CartesianCoordinateSystem::mapLogicalToScene(const Points& logicalPoints,
 												  std::vector<bool>& visiblePoints,
 												  MappingFlags flags) const {
 	// DEBUG(Q_FUNC_INFO << ", (curve with all points)")
-	const QRectF pageRect = d->plot->dataRect();
-	const bool noPageClipping = pageRect.isNull() || (flags & MappingFlag::SuppressPageClipping);
-	const bool noPageClippingY = flags & MappingFlag::SuppressPageClippingY;
-	const bool limit = flags & MappingFlag::Limit;
-	const double xPage = pageRect.x(), yPage = pageRect.y();
-	const double w = pageRect.width(), h = pageRect.height();
-
-	// DEBUG(Q_FUNC_INFO << ", xScales/YScales size: " << d->xScales.size() << '/' << d->yScales.size())
-
-	for (const auto* xScale : d->xScales) {
-		if (!xScale)
-			continue;
-
-		for (const auto* yScale : d->yScales) {
-			if (!yScale)
-				continue;
-
-			int i = 0;
-			for (const auto& point : logicalPoints) {
-				double x = point.x(), y = point.y();
-				if (!xScale->contains(x) || !yScale->contains(y))
-					continue;
-				if (!xScale->map(&x) || !yScale->map(&y))
-					continue;
-
-				if (limit) {
-					// set to max/min if passed over
-					x = qBound(xPage, x, xPage + w);
-					y = qBound(yPage, y, yPage + h);
-				}
-
-				if (noPageClippingY)
-					y = yPage + h / 2.;
-
-				const QPointF mappedPoint(x, y);
-				if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint)) {
-					scenePoints.append(mappedPoint);
-					visiblePoints[i] = true;
-				} else
-					visiblePoints[i] = false;
-
-				i++;
-			}
-		}
-	}
+	mapPoints(
+		this,
+		[](qsizetype k) {
+			return k;
+		},
+		logicalPoints.size(),
+		logicalPoints,
+		flags,
+		[&scenePoints, &visiblePoints](qsizetype i, bool visible, double x, double y) {
+			if (visible)
+				scenePoints.append(QPointF(x, y));
+			visiblePoints[i] = visible;
+		});
 }
 
 /*!
@@ -239,12 +225,50 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
 												  std::vector<bool>& visiblePoints,
 												  MappingFlags flags) const {
 	// DEBUG(Q_FUNC_INFO << ", (curve points)")
+	mapLogicalToSceneUnique(
+		[startIndex](int k) {
+			return startIndex + k;
+		},
+		endIndex - startIndex + 1,
+		logicalPoints,
+		scenePoints,
+		visiblePoints,
+		flags);
+}
+
+/*!
+	Same as above, but only the points with the indices in \c indices are mapped, in the order of \c indices.
+	Used for curves with unsorted x-data where the points within the current x-range are determined via a sorted index.
+ */
+void CartesianCoordinateSystem::mapLogicalToScene(const std::vector<int>& indices,
+												  const Points& logicalPoints,
+												  Points& scenePoints,
+												  std::vector<bool>& visiblePoints,
+												  MappingFlags flags) const {
+	// DEBUG(Q_FUNC_INFO << ", (curve points with indices)")
+	mapLogicalToSceneUnique(
+		[&indices](int k) {
+			return indices[k];
+		},
+		static_cast<int>(indices.size()),
+		logicalPoints,
+		scenePoints,
+		visiblePoints,
+		flags);
+}
+
+/*!
+	maps the \c count points with the indices \c indexAt(0), ..., \c indexAt(count - 1) and skips the points falling into an already used pixel.
+ */
+template<typename IndexAt>
+void CartesianCoordinateSystem::mapLogicalToSceneUnique(IndexAt indexAt,
+														int count,
+														const Points& logicalPoints,
+														Points& scenePoints,
+														std::vector<bool>& visiblePoints,
+														MappingFlags flags) const {
 	const QRectF pageRect = d->plot->dataRect();
-	const bool noPageClipping = pageRect.isNull() || (flags & MappingFlag::SuppressPageClipping);
-	const bool noPageClippingY = flags & MappingFlag::SuppressPageClippingY;
-	const bool limit = flags & MappingFlag::Limit;
 	const double xPage = pageRect.x(), yPage = pageRect.y();
-	const double w = pageRect.width(), h = pageRect.height();
 
 	const int numberOfPixelX = std::ceil(pageRect.width());
 	const int numberOfPixelY = std::ceil(pageRect.height());
@@ -257,7 +281,85 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
 	for (auto& col : scenePointsUsed)
 		col.resize(numberOfPixelY + 1);
 
-	// DEBUG(Q_FUNC_INFO << ", xScales/YScales size: " << d->xScales.size() << '/' << d->yScales.size())
+	mapPoints(this, indexAt, count, logicalPoints, flags, [&](qsizetype i, bool visible, double x, double y) {
+		if (!visible) {
+			visiblePoints[i] = false;
+			return;
+		}
+
+		// TODO: check
+		const int indexX = std::round(x - xPage);
+		const int indexY = std::round(y - yPage);
+		if (scenePointsUsed.at(indexX).at(indexY))
+			return;
+
+		scenePointsUsed[indexX][indexY] = true;
+		scenePoints.append(QPointF(x, y));
+		visiblePoints[i] = true;
+	});
+}
+
+/*!
+	Maps the \c x- and \c y-values of the points in logical coordinates to the scene coordinates \c sceneX and \c sceneY.
+	\c visible is set to 1 for the points inside of the current ranges and of the data rect of the plot (depending on \c flags) and to 0 otherwise,
+	the scene coordinates of the invisible points are undefined. All spans need to have the same size.
+
+	The points are mapped in blocks with the batch mapping of the scales (CartesianScale::map()), large numbers of points are mapped in parallel.
+ */
+void CartesianCoordinateSystem::mapLogicalToScene(std::span<const double> x,
+												  std::span<const double> y,
+												  std::span<double> sceneX,
+												  std::span<double> sceneY,
+												  std::span<quint8> visible,
+												  MappingFlags flags) const {
+	const QRectF pageRect = d->plot->dataRect();
+	const auto count = static_cast<qsizetype>(x.size());
+	if (count < parallelMappingMinSize) {
+		mapLogicalToSceneSerial(pageRect, x.data(), y.data(), sceneX.data(), sceneY.data(), visible.data(), count, flags);
+		return;
+	}
+
+	QVector<qsizetype> starts;
+	for (qsizetype start = 0; start < count; start += parallelMappingChunkSize)
+		starts << start;
+
+	QtConcurrent::blockingMap(starts, [&](qsizetype start) {
+		const qsizetype size = std::min(parallelMappingChunkSize, count - start);
+		mapLogicalToSceneSerial(pageRect,
+								x.data() + start,
+								y.data() + start,
+								sceneX.data() + start,
+								sceneY.data() + start,
+								visible.data() + start,
+								size,
+								flags);
+	});
+}
+
+/*!
+	maps the \c count points in the calling thread, see mapLogicalToScene() above.
+	For every pair of x- and y-scales the values are mapped in blocks of \c mappingBlockSize values without virtual calls per point,
+	a point is mapped with the first pair of scales containing it.
+ */
+void CartesianCoordinateSystem::mapLogicalToSceneSerial(const QRectF& pageRect,
+														const double* x,
+														const double* y,
+														double* sceneX,
+														double* sceneY,
+														quint8* visible,
+														qsizetype count,
+														MappingFlags flags) const {
+	const bool noPageClipping = pageRect.isNull() || (flags & MappingFlag::SuppressPageClipping);
+	const bool noPageClippingY = flags & MappingFlag::SuppressPageClippingY;
+	const bool limit = flags & MappingFlag::Limit;
+	const double xPage = pageRect.x(), yPage = pageRect.y();
+	const double w = pageRect.width(), h = pageRect.height();
+
+	std::fill_n(visible, count, 0);
+
+	const qsizetype blockSize = std::min(count, mappingBlockSize);
+	std::vector<double> mappedX(blockSize), mappedY(blockSize);
+	std::vector<quint8> valid(blockSize);
 
 	for (const auto* xScale : d->xScales) {
 		if (!xScale)
@@ -267,39 +369,35 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
 			if (!yScale)
 				continue;
 
-			for (int i = startIndex; i <= endIndex; i++) {
-				const QPointF& point = logicalPoints.at(i);
+			for (qsizetype start = 0; start < count; start += blockSize) {
+				const qsizetype size = std::min(blockSize, count - start);
 
-				double x = point.x(), y = point.y();
-				if (!xScale->contains(x) || !yScale->contains(y))
-					continue;
-				if (!xScale->map(&x) || !yScale->map(&y))
-					continue;
+				// only map the points not already mapped with another pair of scales
+				for (qsizetype i = 0; i < size; ++i)
+					valid[i] = !visible[start + i];
+				xScale->map(x + start, mappedX.data(), valid.data(), size);
+				yScale->map(y + start, mappedY.data(), valid.data(), size);
 
-				if (limit) {
-					// set to max/min if passed over
-					x = qBound(xPage, x, xPage + w);
-					y = qBound(yPage, y, yPage + h);
-				}
+				for (qsizetype i = 0; i < size; ++i) {
+					if (!valid[i])
+						continue;
 
-				if (noPageClippingY)
-					y = yPage + h / 2.;
+					double sx = mappedX[i], sy = mappedY[i];
+					if (limit) {
+						// set to max/min if passed over
+						sx = qBound(xPage, sx, xPage + w);
+						sy = qBound(yPage, sy, yPage + h);
+					}
 
-				const QPointF mappedPoint(x, y);
-				// DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
-				if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint)) {
-					// TODO: check
-					const int indexX = std::round(x - xPage);
-					const int indexY = std::round(y - yPage);
-					if (scenePointsUsed.at(indexX).at(indexY))
-						continue;
+					if (noPageClippingY)
+						sy = yPage + h / 2.;
 
-					scenePointsUsed[indexX][indexY] = true;
-					scenePoints.append(mappedPoint);
-					// DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
-					visiblePoints[i] = true;
-				} else
-					visiblePoints[i] = false;
+					if (noPageClipping || limit || rectContainsPoint(pageRect, QPointF(sx, sy))) {
+						sceneX[start + i] = sx;
+						sceneY[start + i] = sy;
+						visible[start + i] = 1;
+					}
+				}
 			}
 		}
 	}
@@ -13,6 +13,8 @@
 #include "CartesianScale.h"
 #include "backend/worksheet/plots/AbstractCoordinateSystem.h"
 
+#include <span>
+
 class CartesianCoordinateSystemPrivate;
 class CartesianCoordinateSystemSetScalePropertiesCmd;
 class CartesianPlot;
@@ -47,6 +49,17 @@ public:
 						   Points& scenePoints,
 						   std::vector<bool>& visiblePoints,
 						   MappingFlags flags = MappingFlag::DefaultMapping) const;
+	void mapLogicalToScene(const std::vector<int>& indices,
+						   const Points& logicalPoints,
+						   Points& scenePoints,
+						   std::vector<bool>& visiblePoints,
+						   MappingFlags flags = MappingFlag::DefaultMapping) const;
+	void mapLogicalToScene(std::span<const double> x,
+						   std::span<const double> y,
+						   std::span<double> sceneX,
+						   std::span<double> sceneY,
+						   std::span<quint8> visible,
+						   MappingFlags flags = MappingFlag::DefaultMapping) const;
 	QPointF mapLogicalToScene(QPointF, bool& visible, MappingFlags flags = MappingFlag::DefaultMapping) const override;
 	void mapLogicalToSceneDefaultMapping(Lines& lines) const;
 	Lines mapLogicalToScene(const Lines&, MappingFlags flags = MappingFlag::DefaultMapping) const override;
@@ -65,6 +78,16 @@ public:
 private:
 	void init();
 	bool rectContainsPoint(const QRectF&, QPointF) const;
+	void mapLogicalToSceneSerial(const QRectF& pageRect,
+								 const double* x,
+								 const double* y,
+								 double* sceneX,
+								 double* sceneY,
+								 quint8* visible,
+								 qsizetype count,
+								 MappingFlags) const;
+	template<typename IndexAt>
+	void mapLogicalToSceneUnique(IndexAt, int count, const Points&, Points&, std::vector<bool>&, MappingFlags) const;
 	CartesianCoordinateSystemPrivate* d;
 };
 
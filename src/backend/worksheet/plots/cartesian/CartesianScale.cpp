@@ -13,6 +13,29 @@
 
 #include <gsl/gsl_math.h>
 
+#include <algorithm>
+
+namespace {
+/*!
+ * maps the \c count values \c values with \c map (the mapping of a single value) to \c mapped and sets \c valid to 0 for the values
+ * not contained in \c range or not in the domain of the scale (\c inDomain), the other entries of \c valid are not modified.
+ * The mapping and the check of the values are done in two separate loops without branches and virtual calls,
+ * the mapping loop is vectorized by the compiler.
+ */
+template<typename Map, typename InDomain>
+void mapValues(const Range<double>& range, const double* values, double* mapped, quint8* valid, qsizetype count, Map map, InDomain inDomain) {
+	for (qsizetype i = 0; i < count; ++i)
+		mapped[i] = map(values[i]);
+
+	const double min = std::min(range.start(), range.end());
+	const double max = std::max(range.start(), range.end());
+	for (qsizetype i = 0; i < count; ++i) {
+		const double value = values[i];
+		valid[i] &= static_cast<quint8>((min <= value) & (value <= max) & inDomain(value));
+	}
+}
+}
+
 /**
  * \class CartesianScale
  * \brief Base class for cartesian coordinate system scales.
@@ -56,6 +79,22 @@ public:
 		return true;
 	}
 
+	void map(const double* values, double* mapped, quint8* valid, qsizetype count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(
+			m_range,
+			values,
+			mapped,
+			valid,
+			count,
+			[a, b](double value) {
+				return value * b + a;
+			},
+			[](double) {
+				return true;
+			});
+	}
+
 	bool inverseMap(double* value) const override {
 		*value = (*value - m_a) / m_b;
 		return true;
@@ -89,6 +128,22 @@ public:
 		return true;
 	}
 
+	void map(const double* values, double* mapped, quint8* valid, qsizetype count) const override {
+		const double a = m_a, b = m_b, logBase = log(m_c);
+		mapValues(
+			m_range,
+			values,
+			mapped,
+			valid,
+			count,
+			[a, b, logBase](double value) {
+				return log(value) / logBase * b + a;
+			},
+			[](double value) {
+				return value > 0;
+			});
+	}
+
 	bool inverseMap(double* value) const override {
 		*value = pow(m_c, (*value - m_a) / m_b);
 		return true;
@@ -118,6 +173,22 @@ public:
 		return true;
 	}
 
+	void map(const double* values, double* mapped, quint8* valid, qsizetype count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(
+			m_range,
+			values,
+			mapped,
+			valid,
+			count,
+			[a, b](double value) {
+				return sqrt(value) * b + a;
+			},
+			[](double value) {
+				return value >= 0;
+			});
+	}
+
 	bool inverseMap(double* value) const override {
 		*value = gsl_pow_2((*value - m_a) / m_b);
 		return true;
@@ -146,6 +217,22 @@ public:
 		return true;
 	}
 
+	void map(const double* values, double* mapped, quint8* valid, qsizetype count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(
+			m_range,
+			values,
+			mapped,
+			valid,
+			count,
+			[a, b](double value) {
+				return value * value * b + a;
+			},
+			[](double) {
+				return true;
+			});
+	}
+
 	bool inverseMap(double* value) const override {
 		*value = std::sqrt(std::abs((*value - m_a) / m_b));
 		return true;
@@ -176,6 +263,22 @@ public:
 		return true;
 	}
 
+	void map(const double* values, double* mapped, quint8* valid, qsizetype count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(
+			m_range,
+			values,
+			mapped,
+			valid,
+			count,
+			[a, b](double value) {
+				return b / value + a;
+			},
+			[](double value) {
+				return value != 0;
+			});
+	}
+
 	bool inverseMap(double* value) const override {
 		CHECK(*value != m_a)
 
@@ -45,6 +45,7 @@ public:
 	}
 
 	virtual bool map(double*) const = 0;
+	virtual void map(const double* values, double* mapped, quint8* valid, qsizetype count) const = 0;
 	virtual bool inverseMap(double*) const = 0;
 	virtual int direction() const = 0;
 
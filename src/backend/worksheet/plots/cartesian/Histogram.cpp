@@ -14,6 +14,7 @@
 #include "backend/core/Project.h"
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/macrosCurve.h"
@@ -913,12 +914,19 @@ void HistogramPrivate::recalc() {
 						gsl_histogram_increment(m_histogram, dataColumn->valueAt(row));
 				}
 				break;
-			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::DateTime: {
+				const auto values = dataColumn->dateTimeMSecs();
+				const auto timestamps = dataColumn->dateTimeNSecs();
 				for (int row = 0; row < dataColumn->rowCount(); ++row) {
-					if (dataColumn->isValid(row) && !dataColumn->isMasked(row))
-						gsl_histogram_increment(m_histogram, dataColumn->dateTimeAt(row).toMSecsSinceEpoch());
+					if (!dataColumn->isValid(row) || dataColumn->isMasked(row))
+						continue;
+					if (!timestamps.empty())
+						gsl_histogram_increment(m_histogram, DateTimeValues::toMSecsF(timestamps[row]));
+					else
+						gsl_histogram_increment(m_histogram, !values.empty() ? values[row] : dataColumn->dateTimeAt(row).toMSecsSinceEpoch());
 				}
 				break;
+			}
 			case AbstractColumn::ColumnMode::Text:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
@@ -14,12 +14,33 @@
 #include "backend/core/column/Column.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
+#include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/worksheet/plots/cartesian/Symbol.h"
 #include "backend/worksheet/plots/cartesian/Value.h"
 #include "backend/worksheet/plots/cartesian/XYFitCurve.h"
 #include "backend/worksheet/plots/cartesian/XYSmoothCurve.h"
 
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrentRun>
+
+// the columns of live data sources are only modified by appending new rows and removing the oldest rows
+static bool isLiveDataColumn(const AbstractColumn* column) {
+	const auto* parent = column ? column->parentAspect() : nullptr;
+	return parent && (parent->type() == AspectType::LiveDataSource || parent->type() == AspectType::MQTTTopic);
+}
+
+// the analyses on data sets with fewer rows are fast enough to be calculated synchronously
+static const int asyncRecalculationMinRows = 100000;
+
+// the asynchronous recalculations use their own pool so they don't block the threads used to read the data of the columns
+static QThreadPool* analysisThreadPool() {
+	static QThreadPool pool;
+	return &pool;
+}
+
 /*!
  * \class XYAnalysisCurve
  * \brief Base class for all analysis curves.
@@ -32,7 +53,10 @@ XYAnalysisCurve::XYAnalysisCurve(const QString& name, XYAnalysisCurvePrivate* dd
 
 // no need to delete the d-pointer here - it inherits from QGraphicsItem
 // and is deleted during the cleanup in QGraphicsScene
-XYAnalysisCurve::~XYAnalysisCurve() = default;
+XYAnalysisCurve::~XYAnalysisCurve() {
+	Q_D(XYAnalysisCurve);
+	d->cancelRecalculation();
+}
 
 void XYAnalysisCurve::init() {
 	Q_D(XYAnalysisCurve);
@@ -40,11 +64,59 @@ void XYAnalysisCurve::init() {
 	d->symbol->setStyle(Symbol::Style::NoSymbols);
 }
 
+/*!
+ * recalculates the curve, the results are available when the function returns.
+ */
 void XYAnalysisCurve::recalculate() {
 	Q_D(XYAnalysisCurve);
 	d->recalculate();
 }
 
+/*!
+ * recalculates the curve, large data sets are calculated in the background if supported by the analysis.
+ * The results are not available yet when the function returns if isRecalculating() is \c true,
+ * they are applied when recalculationFinished() is emitted, see also waitForRecalculation().
+ */
+void XYAnalysisCurve::recalculateAsync() {
+	Q_D(XYAnalysisCurve);
+	const AsyncRecalculation async(this);
+	d->recalculate();
+}
+
+/*!
+ * \class XYAnalysisCurve::AsyncRecalculation
+ * \brief The recalculations of the curve triggered while the object exists are done asynchronously for large data sets.
+ *
+ * Used for the changes done in the dock widgets, where the recalculation is triggered by the setters
+ * of the analysis settings. The recalculations triggered by changes of the source data are always asynchronous,
+ * see XYAnalysisCurve::handleSourceValuesChanged(). All other recalculations are synchronous.
+ */
+XYAnalysisCurve::AsyncRecalculation::AsyncRecalculation(XYAnalysisCurve* curve)
+	: m_curve(curve)
+	, m_async(curve->d_func()->asyncRecalculation) {
+	m_curve->d_func()->asyncRecalculation = true;
+}
+
+XYAnalysisCurve::AsyncRecalculation::~AsyncRecalculation() {
+	m_curve->d_func()->asyncRecalculation = m_async;
+}
+
+/*!
+ * returns \c true if the curve is being recalculated asynchronously in the background.
+ */
+bool XYAnalysisCurve::isRecalculating() const {
+	Q_D(const XYAnalysisCurve);
+	return d->job != nullptr;
+}
+
+/*!
+ * waits until the running asynchronous recalculation is finished and its results are available.
+ */
+void XYAnalysisCurve::waitForRecalculation() {
+	Q_D(XYAnalysisCurve);
+	d->waitForRecalculation();
+}
+
 bool XYAnalysisCurve::resultAvailable() const {
 	return result().available;
 }
@@ -79,19 +151,26 @@ QVector<const Plot*> XYAnalysisCurve::dependingPlots() const {
 // copy valid data from x/y data columns to x/y data vectors
 // for analysis functions
 // avgUniqueX: average y values for duplicate x values
+// startRow, endRow: range of rows to copy, all rows for endRow = -1
+// rows: if not null, the source rows of the copied values are written to it (without averaging only)
 void XYAnalysisCurve::copyData(QVector<double>& xData,
 							   QVector<double>& yData,
 							   const AbstractColumn* xDataColumn,
 							   const AbstractColumn* yDataColumn,
 							   double xMin,
 							   double xMax,
-							   bool avgUniqueX) {
+							   bool avgUniqueX,
+							   int startRow,
+							   int endRow,
+							   QVector<int>* rows) {
 	if (!xDataColumn || !yDataColumn)
 		return;
 
-	const int rowCount = std::min(xDataColumn->rowCount(), yDataColumn->rowCount());
+	int rowCount = std::min(xDataColumn->rowCount(), yDataColumn->rowCount());
+	if (endRow != -1)
+		rowCount = std::min(rowCount, endRow + 1);
 	bool uniqueX = true;
-	for (int row = 0; row < rowCount; ++row) {
+	for (int row = std::max(startRow, 0); row < rowCount; ++row) {
 		if (!xDataColumn->isValid(row) || xDataColumn->isMasked(row) || !yDataColumn->isValid(row) || yDataColumn->isMasked(row))
 			continue;
 
@@ -135,10 +214,13 @@ void XYAnalysisCurve::copyData(QVector<double>& xData,
 
 		// only when inside given range
 		if (x >= xMin && x <= xMax) {
-			if (xData.contains(x))
+			// only consecutive duplicates are averaged below, no need to search the whole vector
+			if (!xData.isEmpty() && xData.constLast() == x)
 				uniqueX = false;
 			xData.append(x);
 			yData.append(y);
+			if (rows)
+				rows->append(row);
 		}
 	}
 
@@ -285,6 +367,22 @@ void XYAnalysisCurve::handleSourceDataChanged() {
 	Q_EMIT sourceDataChanged();
 }
 
+/*!
+ * called when the values in the source columns were changed. The curve is recalculated immediately,
+ * for live data the recalculation is batched, see XYAnalysisCurvePrivate::scheduleRecalculation().
+ * Large data sets are recalculated in the background, nobody waits for the result here.
+ */
+void XYAnalysisCurve::handleSourceValuesChanged() {
+	Q_D(XYAnalysisCurve);
+	const AbstractColumn* tmpXDataColumn = nullptr;
+	const AbstractColumn* tmpYDataColumn = nullptr;
+	d->prepareTmpDataColumn(&tmpXDataColumn, &tmpYDataColumn);
+	if (isLiveDataColumn(tmpXDataColumn) && isLiveDataColumn(tmpYDataColumn))
+		d->scheduleRecalculation();
+	else
+		recalculateAsync();
+}
+
 void XYAnalysisCurve::xDataColumnAboutToBeRemoved(const AbstractAspect* aspect) {
 	Q_D(XYAnalysisCurve);
 	if (aspect == d->xDataColumn) {
@@ -412,7 +510,9 @@ XYAnalysisCurvePrivate::XYAnalysisCurvePrivate(XYAnalysisCurve* owner)
 
 // no need to delete xColumn and yColumn, they are deleted
 // when the parent aspect is removed
-XYAnalysisCurvePrivate::~XYAnalysisCurvePrivate() = default;
+XYAnalysisCurvePrivate::~XYAnalysisCurvePrivate() {
+	cancelRecalculation();
+}
 
 void XYAnalysisCurvePrivate::connectCurve(const XYCurve* curve) {
 	if (!curve)
@@ -426,9 +526,9 @@ void XYAnalysisCurvePrivate::connectCurve(const XYCurve* curve) {
 		return;
 
 	m_connections << q->connect(curve, &AbstractAspect::aspectDescriptionChanged, q, &XYAnalysisCurve::dataSourceCurveNameChanged);
-	m_connections << q->connect(curve, &XYCurve::dataChanged, q, &XYAnalysisCurve::recalculate);
-	m_connections << q->connect(curve, &XYCurve::xDataChanged, q, &XYAnalysisCurve::recalculate);
-	m_connections << q->connect(curve, &XYCurve::yDataChanged, q, &XYAnalysisCurve::recalculate);
+	m_connections << q->connect(curve, &XYCurve::dataChanged, q, &XYAnalysisCurve::handleSourceValuesChanged);
+	m_connections << q->connect(curve, &XYCurve::xDataChanged, q, &XYAnalysisCurve::handleSourceValuesChanged);
+	m_connections << q->connect(curve, &XYCurve::yDataChanged, q, &XYAnalysisCurve::handleSourceValuesChanged);
 	m_connections << q->connect(curve, &AbstractAspect::aspectAboutToBeRemoved, q, &XYAnalysisCurve::dataSourceCurveAboutToBeRemoved);
 	m_connections << q->connect(curve, &AbstractAspect::aspectAboutToBeRemoved, q, &XYAnalysisCurve::recalculate);
 
@@ -446,7 +546,7 @@ void XYAnalysisCurvePrivate::connectColumn(const AbstractColumn* column, Dimensi
 	if (!column || dataSourceType != XYAnalysisCurve::DataSourceType::Spreadsheet)
 		return;
 
-	m_connections << q->connect(column, &AbstractColumn::dataChanged, q, &XYAnalysisCurve::recalculate);
+	m_connections << q->connect(column, &AbstractColumn::dataChanged, q, &XYAnalysisCurve::handleSourceValuesChanged);
 	if (!second) {
 		switch (dim) {
 		case Dimension::X:
@@ -544,11 +644,81 @@ void XYAnalysisCurvePrivate::prepareTmpDataColumn(const AbstractColumn** tmpXDat
 }
 
 void XYAnalysisCurvePrivate::recalculate() {
+	if (job) {
+		// the curve is already being recalculated, cancel it and recalculate again on the current input once it's finished
+		if (asyncRecalculation) {
+			job->cancel();
+			recalculationPending = true;
+			return;
+		}
+
+		// the results of the running recalculation are not needed anymore, recalculate synchronously
+		cancelRecalculation();
+	}
+
+	// the source curve is being recalculated, this curve is recalculated when the new results of the source curve
+	// are available (dataChanged() of the source curve), this chains the calculations in the order of their dependencies.
+	// for the synchronous recalculation, wait for the source curve, its results trigger the recalculation of this curve
+	if (sourceCurveRecalculating()) {
+		if (!asyncRecalculation)
+			const_cast<XYAnalysisCurve*>(static_cast<const XYAnalysisCurve*>(dataSourceCurve))->waitForRecalculation();
+		return;
+	}
+
+	// only new rows were appended in the live data source, update the result incrementally if possible
+	if (incrementalRecalculation) {
+		incrementalRecalculation = false;
+		if (recalculateAppended())
+			return;
+	}
+
+	// calculate large data sets in the background if requested and supported by the analysis
+	if (asyncRecalculation && startAsyncRecalculation())
+		return;
+
+	QElapsedTimer timer;
+	timer.start();
+
 	// process all events first to close the context menu, if the new analysis curve is added via the context menu
 	QApplication::processEvents(QEventLoop::AllEvents, 0);
 	QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
-	// create filter result columns if not available yet, clear them otherwise
+	createResultColumns();
+	if (xVector)
+		xVector->clear();
+	if (yVector)
+		yVector->clear();
+
+	resetResults();
+
+	const AbstractColumn* tmpXDataColumn = nullptr;
+	const AbstractColumn* tmpYDataColumn = nullptr;
+	prepareTmpDataColumn(&tmpXDataColumn, &tmpYDataColumn);
+
+	sourceRowCount = 0;
+	if (!preparationValid(tmpXDataColumn, tmpYDataColumn)) {
+		sourceDataChangedSinceLastRecalc = false;
+		// recalcLogicalPoints(); TODO: needed?
+	} else {
+		bool result = recalculateSpecific(tmpXDataColumn, tmpYDataColumn);
+		sourceDataChangedSinceLastRecalc = false;
+
+		if (result) {
+			updateSourceState(tmpXDataColumn, tmpYDataColumn);
+
+			// redraw the curve
+			recalc();
+		}
+	}
+	recalculationTime = timer.elapsed();
+	Q_EMIT q->dataChanged();
+	QApplication::restoreOverrideCursor();
+}
+
+/*!
+ * creates the columns for the result of the analysis if not available yet, invalidates their properties otherwise.
+ */
+void XYAnalysisCurvePrivate::createResultColumns() {
 	if (!xColumn) {
 		xColumn = new Column(QStringLiteral("x"), AbstractColumn::ColumnMode::Double);
 		yColumn = new Column(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
@@ -567,32 +737,296 @@ void XYAnalysisCurvePrivate::recalculate() {
 	} else {
 		xColumn->invalidateProperties();
 		yColumn->invalidateProperties();
-		if (xVector)
-			xVector->clear();
-		if (yVector)
-			yVector->clear();
 	}
+}
 
-	resetResults();
+/*!
+ * prepares \c job for the asynchronous recalculation on the snapshot of the input data (\sa XYAnalysisCurveJob::snapshot()).
+ * Returns \c false if the analysis can only be calculated synchronously in recalculateSpecific(), the default.
+ */
+bool XYAnalysisCurvePrivate::prepareAsyncRecalculation(XYAnalysisCurveJob& /* job */, const AbstractColumn*, const AbstractColumn*) {
+	return false;
+}
 
+/*!
+ * starts the recalculation in a worker thread for large data sets, if supported by the analysis.
+ * The results are applied to the curve in finishAsyncRecalculation().
+ * Returns \c false if the curve needs to be recalculated synchronously.
+ */
+bool XYAnalysisCurvePrivate::startAsyncRecalculation() {
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
 	prepareTmpDataColumn(&tmpXDataColumn, &tmpYDataColumn);
+	if (!preparationValid(tmpXDataColumn, tmpYDataColumn))
+		return false;
 
-	if (!preparationValid(tmpXDataColumn, tmpYDataColumn)) {
-		sourceDataChangedSinceLastRecalc = false;
-		// recalcLogicalPoints(); TODO: needed?
-	} else {
-		bool result = recalculateSpecific(tmpXDataColumn, tmpYDataColumn);
+	const int rows = std::max(tmpXDataColumn ? tmpXDataColumn->rowCount() : 0, tmpYDataColumn ? tmpYDataColumn->rowCount() : 0);
+	if (rows < asyncRecalculationMinRows)
+		return false;
+
+	auto newJob = std::make_unique<XYAnalysisCurveJob>(q);
+	if (!prepareAsyncRecalculation(*newJob, tmpXDataColumn, tmpYDataColumn))
+		return false;
+
+	// the snapshots of the source data are used to detect the appended rows in live data sources
+	newJob->sourceX = newJob->snapshot(tmpXDataColumn);
+	newJob->sourceY = newJob->snapshot(tmpYDataColumn);
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", curve ") + q->name());
+	createResultColumns();
+
+	job = std::move(newJob);
+	jobWatcher = new QFutureWatcher<bool>();
+	QObject::connect(jobWatcher, &QFutureWatcher<bool>::finished, jobWatcher, [this]() {
+		finishAsyncRecalculation();
+	});
+
+	auto* runningJob = job.get();
+	jobWatcher->setFuture(QtConcurrent::run(analysisThreadPool(), [runningJob]() {
+		return runningJob->run();
+	}));
+
+	Q_EMIT q->recalculationStarted();
+	return true;
+}
+
+/*!
+ * applies the results of the finished asynchronous recalculation to the curve,
+ * the results of a canceled recalculation are discarded.
+ */
+void XYAnalysisCurvePrivate::finishAsyncRecalculation() {
+	if (!job)
+		return;
+
+	const auto finishedJob = std::move(job);
+	const bool result = jobWatcher->result();
+	jobWatcher->deleteLater();
+	jobWatcher = nullptr;
+
+	if (!finishedJob->isCancelled()) {
+		resetResults();
+		finishedJob->apply();
+		if (xVector && yVector) {
+			*xVector = std::move(finishedJob->xData);
+			*yVector = std::move(finishedJob->yData);
+		}
+		xColumn->invalidateProperties();
+		yColumn->invalidateProperties();
 		sourceDataChangedSinceLastRecalc = false;
 
+		sourceRowCount = 0;
 		if (result) {
-			// redraw the curve
+			updateSourceState(finishedJob->sourceX, finishedJob->sourceY);
 			recalc();
 		}
+
+		recalculationTime = finishedJob->timer.elapsed();
+		Q_EMIT q->dataChanged();
+	}
+
+	Q_EMIT q->recalculationFinished();
+
+	// the input was changed during the calculation
+	if (recalculationPending) {
+		recalculationPending = false;
+		q->recalculateAsync();
+	}
+}
+
+/*!
+ * cancels the running asynchronous recalculation and waits until the worker thread stopped using the job.
+ */
+void XYAnalysisCurvePrivate::cancelRecalculation() {
+	if (!job)
+		return;
+
+	job->cancel();
+	recalculationPending = false;
+	jobWatcher->disconnect();
+	jobWatcher->waitForFinished();
+	delete jobWatcher;
+	jobWatcher = nullptr;
+	job.reset();
+}
+
+void XYAnalysisCurvePrivate::waitForRecalculation() {
+	// finishing the current recalculation can start the pending one
+	while (job) {
+		jobWatcher->disconnect(); // finished here and not in the slot
+		jobWatcher->waitForFinished();
+		finishAsyncRecalculation();
+	}
+}
+
+/*!
+ * returns \c true if the source curve of this curve is an analysis curve being recalculated asynchronously.
+ */
+bool XYAnalysisCurvePrivate::sourceCurveRecalculating() const {
+	if (dataSourceType != XYAnalysisCurve::DataSourceType::Curve || !dataSourceCurve)
+		return false;
+
+	const auto* analysisCurve = dynamic_cast<const XYAnalysisCurve*>(dataSourceCurve);
+	return analysisCurve && analysisCurve->isRecalculating();
+}
+
+/*!
+ * schedules the recalculation after the data in the live data source was changed. All changes done in the same
+ * event loop iteration (new data in the x- and y-columns) result in one recalculation. Analyses that can be updated
+ * incrementally process only the new rows, the other ones are recalculated not more often than the duration of
+ * their last recalculation allows.
+ */
+void XYAnalysisCurvePrivate::scheduleRecalculation() {
+	if (!recalculationTimer) {
+		recalculationTimer = new QTimer(q);
+		recalculationTimer->setSingleShot(true);
+		QObject::connect(recalculationTimer, &QTimer::timeout, q, [this]() {
+			incrementalRecalculation = true;
+			q->recalculateAsync();
+		});
 	}
+
+	if (recalculationTimer->isActive())
+		return; // the new data is processed in the already scheduled recalculation
+
+	recalculationTimer->start(std::min(recalculationTime, qint64(1000)));
+}
+
+/*!
+ * updates the result after new rows were appended to the columns of the live data source
+ * (and the oldest rows were removed) without recalculating on the whole data.
+ * Returns \c false if this is not possible and the full recalculation is required.
+ */
+bool XYAnalysisCurvePrivate::recalculateAppended() {
+	if (!xColumn || !xVector || !yVector || sourceRowCount == 0 || !q->resultAvailable())
+		return false;
+
+	const AbstractColumn* tmpXDataColumn = nullptr;
+	const AbstractColumn* tmpYDataColumn = nullptr;
+	prepareTmpDataColumn(&tmpXDataColumn, &tmpYDataColumn);
+	if (!preparationValid(tmpXDataColumn, tmpYDataColumn))
+		return false;
+
+	int removedRows = 0;
+	int appendedRows = 0;
+	if (!detectAppendedRows(tmpXDataColumn, tmpYDataColumn, removedRows, appendedRows))
+		return false;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", appended rows: ") + QString::number(appendedRows));
+	if (removedRows > 0 || appendedRows > 0) {
+		if (!recalculateIncremental(tmpXDataColumn, tmpYDataColumn, removedRows, appendedRows))
+			return false;
+
+		xColumn->invalidateProperties();
+		yColumn->invalidateProperties();
+		recalc();
+	}
+
+	updateSourceState(tmpXDataColumn, tmpYDataColumn);
 	Q_EMIT q->dataChanged();
-	QApplication::restoreOverrideCursor();
+	return true;
+}
+
+/*!
+ * updates the result for \c removedRows rows removed at the beginning and \c appendedRows rows appended at the end
+ * of the source data. Returns \c false if the analysis cannot be updated incrementally, the default.
+ * The implementation must not modify the result if it returns \c false.
+ */
+bool XYAnalysisCurvePrivate::recalculateIncremental(const AbstractColumn*, const AbstractColumn*, int /* removedRows */, int /* appendedRows */) {
+	return false;
+}
+
+/*!
+ * determines the number of rows removed at the beginning and appended at the end of the source data since the last
+ * calculation. The source is searched backwards, starting at the row count of the last calculation, for the row
+ * with the x- and y-values of the last source point used in the last calculation. The rows after this row were appended,
+ * the difference of its position to the last position is the number of removed rows. If several rows have these values,
+ * the last of them is used. The other rows are not compared, modifications of them are not detected.
+ * Returns \c false if the row is not found.
+ */
+bool XYAnalysisCurvePrivate::detectAppendedRows(const AbstractColumn* tmpXDataColumn,
+												const AbstractColumn* tmpYDataColumn,
+												int& removedRows,
+												int& appendedRows) const {
+	if (std::isnan(sourceLastX) || std::isnan(sourceLastY))
+		return false;
+
+	const int rowCount = std::min(tmpXDataColumn->rowCount(), tmpYDataColumn->rowCount());
+	for (int row = std::min(rowCount, sourceRowCount) - 1; row >= 0; --row) {
+		if (tmpXDataColumn->valueAt(row) == sourceLastX && tmpYDataColumn->valueAt(row) == sourceLastY) {
+			removedRows = sourceRowCount - 1 - row;
+			appendedRows = rowCount - 1 - row;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void XYAnalysisCurvePrivate::updateSourceState(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	sourceRowCount = std::min(tmpXDataColumn->rowCount(), tmpYDataColumn->rowCount());
+	if (sourceRowCount > 0) {
+		sourceLastX = tmpXDataColumn->valueAt(sourceRowCount - 1);
+		sourceLastY = tmpYDataColumn->valueAt(sourceRowCount - 1);
+	} else {
+		sourceLastX = NAN;
+		sourceLastY = NAN;
+	}
+}
+
+/*!
+ * helper function for analyses where every result point depends only on the source points in the neighbourhood
+ * of \c margin points (finite differences, moving averages, etc.). After \c removedRows rows were removed at the beginning
+ * and new rows were appended at the end of the source data, only the result points at the borders are
+ * recalculated with \c calculate, the other points are kept. The result points in [0, margin) (if rows were removed)
+ * and starting at sourceRowCount - removedRows - margin are replaced.
+ */
+bool XYAnalysisCurvePrivate::updateLocalResult(const AbstractColumn* tmpXDataColumn,
+											   const AbstractColumn* tmpYDataColumn,
+											   int removedRows,
+											   double xMin,
+											   double xMax,
+											   int margin,
+											   bool avgUniqueX,
+											   const std::function<bool(QVector<double>&, QVector<double>&)>& calculate) {
+	// every source row needs to have a result point, otherwise the result points cannot be assigned to the rows
+	if (xVector->size() != sourceRowCount || yVector->size() != sourceRowCount)
+		return false;
+
+	const int keptRows = sourceRowCount - removedRows;
+	if (keptRows < 2 * margin)
+		return false;
+
+	// recalculate the end of the data incl. the appended rows,
+	// the first margin points of this window are only needed as the neighbourhood of the other points
+	const int tailStart = keptRows - 2 * margin;
+	QVector<double> xTail;
+	QVector<double> yTail;
+	XYAnalysisCurve::copyData(xTail, yTail, tmpXDataColumn, tmpYDataColumn, xMin, xMax, avgUniqueX, tailStart);
+	if (xTail.size() < 2 * margin || !calculate(xTail, yTail))
+		return false;
+
+	// rows were removed, recalculate the beginning of the data
+	QVector<double> xHead;
+	QVector<double> yHead;
+	if (removedRows > 0) {
+		XYAnalysisCurve::copyData(xHead, yHead, tmpXDataColumn, tmpYDataColumn, xMin, xMax, avgUniqueX, 0, 2 * margin - 1);
+		if (xHead.size() != 2 * margin || !calculate(xHead, yHead))
+			return false;
+	}
+
+	xVector->remove(0, removedRows);
+	yVector->remove(0, removedRows);
+	xVector->resize(tailStart + margin);
+	yVector->resize(tailStart + margin);
+	xVector->append(xTail.mid(margin));
+	yVector->append(yTail.mid(margin));
+
+	if (removedRows > 0) {
+		std::copy(xHead.cbegin(), xHead.cbegin() + margin, xVector->begin());
+		std::copy(yHead.cbegin(), yHead.cbegin() + margin, yVector->begin());
+	}
+
+	return true;
 }
 
 bool XYAnalysisCurvePrivate::preparationValid(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
@@ -659,3 +1093,88 @@ bool XYAnalysisCurve::load(XmlStreamReader* reader, bool preview) {
 
 	return true;
 }
+
+// ##############################################################################
+// ########################### Asynchronous recalculation #######################
+// ##############################################################################
+XYAnalysisCurveJob::XYAnalysisCurveJob(XYAnalysisCurve* curve)
+	: m_curve(curve) {
+	timer.start();
+}
+
+// the job is deleted in the main thread after the worker thread finished
+XYAnalysisCurveJob::~XYAnalysisCurveJob() {
+	for (const auto& snapshot : std::as_const(m_snapshots))
+		delete snapshot.second;
+}
+
+/*!
+ * creates a copy of the column \c column that can be safely accessed in the worker thread.
+ * Must be called in the main thread before the job is started.
+ */
+const AbstractColumn* XYAnalysisCurveJob::snapshot(const AbstractColumn* column) {
+	if (!column)
+		return nullptr;
+
+	for (const auto& snapshot : std::as_const(m_snapshots)) {
+		if (snapshot.first == column)
+			return snapshot.second;
+	}
+
+	auto* copy = new Column(column->name(), column->columnMode());
+	copy->copy(column);
+	m_snapshots << qMakePair(column, copy);
+	return copy;
+}
+
+/*!
+ * sets the function \c calculate doing the calculation in the worker thread and the function \c apply
+ * applying its results (except of \c xData and \c yData) to the curve in the main thread.
+ */
+void XYAnalysisCurveJob::setCalculation(Calculation calculate, std::function<void()> apply) {
+	m_calculate = std::move(calculate);
+	m_apply = std::move(apply);
+}
+
+bool XYAnalysisCurveJob::run() {
+	if (isCancelled() || !m_calculate)
+		return false;
+
+	setProgress(0);
+	const bool result = m_calculate(*this);
+	setProgress(100);
+	return result;
+}
+
+void XYAnalysisCurveJob::apply() const {
+	if (m_apply)
+		m_apply();
+}
+
+/*!
+ * cancels the job, the calculation should check \c isCancelled() and stop as early as possible.
+ */
+void XYAnalysisCurveJob::cancel() {
+	m_cancelled = true;
+}
+
+bool XYAnalysisCurveJob::isCancelled() const {
+	return m_cancelled;
+}
+
+/*!
+ * reports the progress of the calculation in percent, can be called in the worker thread.
+ */
+void XYAnalysisCurveJob::setProgress(int progress) {
+	if (m_progress.exchange(progress) == progress)
+		return;
+
+	// the curve waits for the job to finish before it's deleted
+	auto* curve = m_curve;
+	QMetaObject::invokeMethod(
+		curve,
+		[curve, progress]() {
+			Q_EMIT curve->recalculationProgress(progress);
+		},
+		Qt::QueuedConnection);
+}
@@ -76,9 +76,25 @@ public:
 						 const AbstractColumn* yDataColumn,
 						 double xMin,
 						 double xMax,
-						 bool avgUniqueX = false);
+						 bool avgUniqueX = false,
+						 int startRow = 0,
+						 int endRow = -1,
+						 QVector<int>* rows = nullptr);
+
+	class AsyncRecalculation {
+	public:
+		explicit AsyncRecalculation(XYAnalysisCurve*);
+		~AsyncRecalculation();
+
+	private:
+		XYAnalysisCurve* m_curve;
+		const bool m_async;
+	};
 
 	void recalculate();
+	void recalculateAsync();
+	bool isRecalculating() const;
+	void waitForRecalculation();
 	bool resultAvailable() const;
 	virtual const Result& result() const = 0;
 	bool usingColumn(const AbstractColumn*, bool indirect = true) const override;
@@ -114,6 +130,7 @@ private:
 
 public Q_SLOTS:
 	void handleSourceDataChanged();
+	void handleSourceValuesChanged();
 	void createDataSpreadsheet();
 
 private Q_SLOTS:
@@ -135,6 +152,9 @@ Q_SIGNALS:
 	void xDataColumnChanged(const AbstractColumn*);
 	void yDataColumnChanged(const AbstractColumn*);
 	void y2DataColumnChanged(const AbstractColumn*);
+	void recalculationStarted();
+	void recalculationProgress(int); // progress of the asynchronous recalculation in percent
+	void recalculationFinished();
 
 	friend class CommonAnalysisTest;
 	friend class FourierTest;
@@ -13,9 +13,55 @@
 #include "backend/worksheet/plots/cartesian/XYAnalysisCurve.h"
 #include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
 
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
 class XYAnalysisCurve;
 class Column;
 class AbstractColumn;
+class QTimer;
+
+/*!
+ * \brief Asynchronous recalculation of an analysis curve.
+ *
+ * The calculation runs in a worker thread on the snapshot of the input columns and writes the result into
+ * \c xData and \c yData. It must not access the curve, the other results are applied to the curve in the main
+ * thread after the calculation was finished.
+ */
+class XYAnalysisCurveJob {
+public:
+	using Calculation = std::function<bool(XYAnalysisCurveJob&)>;
+
+	explicit XYAnalysisCurveJob(XYAnalysisCurve*);
+	~XYAnalysisCurveJob();
+
+	const AbstractColumn* snapshot(const AbstractColumn*);
+	void setCalculation(Calculation calculate, std::function<void()> apply);
+	bool run();
+	void apply() const;
+
+	void cancel();
+	bool isCancelled() const;
+	void setProgress(int);
+
+	QVector<double> xData;
+	QVector<double> yData;
+	const AbstractColumn* sourceX{nullptr};
+	const AbstractColumn* sourceY{nullptr};
+	QElapsedTimer timer;
+
+private:
+	XYAnalysisCurve* m_curve;
+	Calculation m_calculate;
+	std::function<void()> m_apply;
+	QVector<QPair<const AbstractColumn*, Column*>> m_snapshots;
+	std::atomic<bool> m_cancelled{false};
+	std::atomic<int> m_progress{-1};
+};
 
 class XYAnalysisCurvePrivate : public XYCurvePrivate {
 public:
@@ -29,6 +75,23 @@ public:
 
 	void recalculate();
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) = 0;
+	virtual bool recalculateIncremental(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn, int removedRows, int appendedRows);
+	bool updateLocalResult(const AbstractColumn* tmpXDataColumn,
+						   const AbstractColumn* tmpYDataColumn,
+						   int removedRows,
+						   double xMin,
+						   double xMax,
+						   int margin,
+						   bool avgUniqueX,
+						   const std::function<bool(QVector<double>&, QVector<double>&)>& calculate);
+	void scheduleRecalculation();
+	virtual bool prepareAsyncRecalculation(XYAnalysisCurveJob&, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn);
+	bool startAsyncRecalculation();
+	void finishAsyncRecalculation();
+	void cancelRecalculation();
+	void waitForRecalculation();
+	bool sourceCurveRecalculating() const;
+	void createResultColumns();
 	virtual void prepareTmpDataColumn(const AbstractColumn** tmpXDataColumn, const AbstractColumn** tmpYDataColumn) const;
 	virtual void resetResults() = 0; // Clear the results of the previous calculation
 	virtual bool preparationValid(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn);
@@ -36,6 +99,9 @@ public:
 	void connectColumn(const AbstractColumn* column, Dimension dim, bool second);
 	void updateConnections();
 	void sourceChanged();
+	bool recalculateAppended();
+	bool detectAppendedRows(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn, int& removedRows, int& appendedRows) const;
+	void updateSourceState(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn);
 
 	const AbstractColumn* xDataColumn{nullptr}; //<! column storing the values for the input x-data for the analysis function
 	const AbstractColumn* yDataColumn{nullptr}; //<! column storing the values for the input y-data for the analysis function
@@ -53,6 +119,20 @@ public:
 
 	QVector<QMetaObject::Connection> m_connections;
 
+	// live data: state of the source data used in the last calculation to detect the appended rows
+	bool incrementalRecalculation{false};
+	int sourceRowCount{0}; //<! number of rows in the source columns used in the last calculation
+	double sourceLastX{NAN}; //<! x-value of the last row used in the last calculation
+	double sourceLastY{NAN}; //<! y-value of the last row used in the last calculation
+	qint64 recalculationTime{0}; //<! duration of the last full recalculation, in ms
+	QTimer* recalculationTimer{nullptr};
+
+	// asynchronous recalculation
+	std::unique_ptr<XYAnalysisCurveJob> job; //<! currently running recalculation
+	QFutureWatcher<bool>* jobWatcher{nullptr};
+	bool recalculationPending{false}; //<! the input was changed during the running recalculation, recalculate again when finished
+	bool asyncRecalculation{false}; //<! recalculate large data sets in the background, see XYAnalysisCurve::AsyncRecalculation
+
 	XYAnalysisCurve* const q;
 };
 
@@ -66,7 +66,18 @@ void XYBaselineCorrectionCurvePrivate::resetResults() {
 	baselineResult = XYBaselineCorrectionCurve::BaselineResult();
 }
 
-bool XYBaselineCorrectionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+/*!
+ * removes the baseline from the data in \c tmpXDataColumn and \c tmpYDataColumn
+ * and writes the result into \c xVector and \c yVector.
+ * Called in the worker thread for the asynchronous recalculation with \c job being set.
+ */
+static bool baselineCorrection(const XYBaselineCorrectionCurve::BaselineData& baselineData,
+							   const AbstractColumn* tmpXDataColumn,
+							   const AbstractColumn* tmpYDataColumn,
+							   QVector<double>& xVector,
+							   QVector<double>& yVector,
+							   XYBaselineCorrectionCurve::BaselineResult& baselineResult,
+							   XYAnalysisCurveJob* job = nullptr) {
 	QElapsedTimer timer;
 	timer.start();
 
@@ -93,6 +104,13 @@ bool XYBaselineCorrectionCurvePrivate::recalculateSpecific(const AbstractColumn*
 		return true;
 	}
 
+	// the input data is prepared, stop here if the asynchronous recalculation was canceled
+	if (job) {
+		if (job->isCancelled())
+			return false;
+		job->setProgress(10);
+	}
+
 	double* ydata = ydataVector.data();
 
 	int status = 0;
@@ -127,15 +145,15 @@ bool XYBaselineCorrectionCurvePrivate::recalculateSpecific(const AbstractColumn*
 	}
 
 	// write result into xVector/yVector (subtracted signal)
-	xVector->resize((int)n);
-	yVector->resize((int)n);
+	xVector.resize((int)n);
+	yVector.resize((int)n);
 	if (tmpXDataColumn) {
-		memcpy(xVector->data(), xdataVector.data(), n * sizeof(double));
+		memcpy(xVector.data(), xdataVector.data(), n * sizeof(double));
 	} else {
 		for (size_t i = 0; i < n; ++i)
-			xVector->data()[(int)i] = (double)i;
+			xVector.data()[(int)i] = (double)i;
 	}
-	memcpy(yVector->data(), ydata, n * sizeof(double));
+	memcpy(yVector.data(), ydata, n * sizeof(double));
 
 	baselineResult.available = true;
 	baselineResult.valid = (status == 0);
@@ -145,6 +163,24 @@ bool XYBaselineCorrectionCurvePrivate::recalculateSpecific(const AbstractColumn*
 	return true;
 }
 
+bool XYBaselineCorrectionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	return baselineCorrection(baselineData, tmpXDataColumn, tmpYDataColumn, *xVector, *yVector, baselineResult);
+}
+
+bool XYBaselineCorrectionCurvePrivate::prepareAsyncRecalculation(XYAnalysisCurveJob& job, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	const auto* x = job.snapshot(tmpXDataColumn);
+	const auto* y = job.snapshot(tmpYDataColumn);
+	auto result = std::make_shared<XYBaselineCorrectionCurve::BaselineResult>();
+	job.setCalculation(
+		[data = baselineData, x, y, result](XYAnalysisCurveJob& job) {
+			return baselineCorrection(data, x, y, job.xData, job.yData, *result, &job);
+		},
+		[this, result]() {
+			baselineResult = *result;
+		});
+	return true;
+}
+
 // Serialization/Deserialization
 void XYBaselineCorrectionCurve::save(QXmlStreamWriter* writer) const {
 	Q_D(const XYBaselineCorrectionCurve);
@@ -21,6 +21,7 @@ public:
 	~XYBaselineCorrectionCurvePrivate() override;
 
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	bool prepareAsyncRecalculation(XYAnalysisCurveJob&, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
 	virtual void resetResults() override;
 
 	XYBaselineCorrectionCurve::BaselineData baselineData;
@@ -90,20 +90,22 @@ bool XYConvolutionCurvePrivate::preparationValid(const AbstractColumn* tmpXDataC
 	return tmpYDataColumn != nullptr;
 }
 
-bool XYConvolutionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+/*!
+ * calculates the convolution of the data in \c tmpYDataColumn with the response in \c tmpY2DataColumn or with the kernel
+ * and writes the result into \c xVector and \c yVector.
+ * Called in the worker thread for the asynchronous recalculation with \c job being set.
+ */
+static bool convolution(const XYConvolutionCurve::ConvolutionData& convolutionData,
+						const AbstractColumn* tmpXDataColumn,
+						const AbstractColumn* tmpYDataColumn,
+						const AbstractColumn* tmpY2DataColumn,
+						QVector<double>& xVector,
+						QVector<double>& yVector,
+						XYConvolutionCurve::ConvolutionResult& convolutionResult,
+						XYAnalysisCurveJob* job = nullptr) {
 	QElapsedTimer timer;
 	timer.start();
 
-	// determine the data source columns
-	const AbstractColumn* tmpY2DataColumn = nullptr;
-	if (dataSourceType == XYAnalysisCurve::DataSourceType::Spreadsheet) {
-		// spreadsheet columns as data source
-		tmpY2DataColumn = y2DataColumn;
-	} else {
-		// curve columns as data source
-		// no y2 column: use standard kernel
-	}
-
 	// copy all valid data point for the convolution to temporary vectors
 	QVector<double> xdataVector;
 	QVector<double> ydataVector;
@@ -159,6 +161,13 @@ bool XYConvolutionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 		return true;
 	}
 
+	// the input data is prepared, stop here if the asynchronous recalculation was canceled
+	if (job) {
+		if (job->isCancelled())
+			return false;
+		job->setProgress(10);
+	}
+
 	double* xdata = xdataVector.data();
 	double* ydata = ydataVector.data();
 	double* y2data = y2dataVector.data();
@@ -193,22 +202,22 @@ bool XYConvolutionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 		if (type == nsl_conv_type_linear)
 			np = abs((int)(n - m)) + 1;
 
-	xVector->resize((int)np);
-	yVector->resize((int)np);
+	xVector.resize((int)np);
+	yVector.resize((int)np);
 	// take given x-axis values or use index
 	if (tmpXDataColumn != nullptr) {
 		int size = GSL_MIN(xdataVector.size(), (int)np);
-		memcpy(xVector->data(), xdata, size * sizeof(double));
-		double sampleInterval = (xVector->data()[size - 1] - xVector->data()[0]) / (xdataVector.size() - 1);
+		memcpy(xVector.data(), xdata, size * sizeof(double));
+		double sampleInterval = (xVector.data()[size - 1] - xVector.data()[0]) / (xdataVector.size() - 1);
 		DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
 		for (int i = size; i < (int)np; i++) // fill missing values
-			xVector->data()[i] = xVector->data()[size - 1] + (i - size + 1) * sampleInterval;
+			xVector.data()[i] = xVector.data()[size - 1] + (i - size + 1) * sampleInterval;
 	} else { // fill with index (starting with 0)
 		for (size_t i = 0; i < np; i++)
-			xVector->data()[i] = i * samplingInterval;
+			xVector.data()[i] = i * samplingInterval;
 	}
 
-	memcpy(yVector->data(), out, np * sizeof(double));
+	memcpy(yVector.data(), out, np * sizeof(double));
 	free(out);
 	///////////////////////////////////////////////////////////
 
@@ -221,6 +230,34 @@ bool XYConvolutionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 	return true;
 }
 
+bool XYConvolutionCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	return convolution(convolutionData, tmpXDataColumn, tmpYDataColumn, sourceY2DataColumn(), *xVector, *yVector, convolutionResult);
+}
+
+/*!
+ * returns the column with the response, no column is used for curves as data source (standard kernel).
+ */
+const AbstractColumn* XYConvolutionCurvePrivate::sourceY2DataColumn() const {
+	if (dataSourceType == XYAnalysisCurve::DataSourceType::Spreadsheet)
+		return y2DataColumn;
+	return nullptr;
+}
+
+bool XYConvolutionCurvePrivate::prepareAsyncRecalculation(XYAnalysisCurveJob& job, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	const auto* x = job.snapshot(tmpXDataColumn);
+	const auto* y = job.snapshot(tmpYDataColumn);
+	const auto* y2 = job.snapshot(sourceY2DataColumn());
+	auto result = std::make_shared<XYConvolutionCurve::ConvolutionResult>();
+	job.setCalculation(
+		[data = convolutionData, x, y, y2, result](XYAnalysisCurveJob& job) {
+			return convolution(data, x, y, y2, job.xData, job.yData, *result, &job);
+		},
+		[this, result]() {
+			convolutionResult = *result;
+		});
+	return true;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
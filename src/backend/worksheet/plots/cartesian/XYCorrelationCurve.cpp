@@ -90,21 +90,23 @@ bool XYCorrelationCurvePrivate::preparationValid(const AbstractColumn* tmpXDataC
 	return tmpYDataColumn != nullptr;
 }
 
-bool XYCorrelationCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+/*!
+ * calculates the correlation of the data in \c tmpYDataColumn and \c tmpY2DataColumn
+ * and writes the result into \c xVector and \c yVector.
+ * Called in the worker thread for the asynchronous recalculation with \c job being set.
+ */
+static bool correlation(const XYCorrelationCurve::CorrelationData& correlationData,
+						const AbstractColumn* tmpXDataColumn,
+						const AbstractColumn* tmpYDataColumn,
+						const AbstractColumn* tmpY2DataColumn,
+						QVector<double>& xVector,
+						QVector<double>& yVector,
+						XYCorrelationCurve::CorrelationResult& correlationResult,
+						XYAnalysisCurveJob* job = nullptr) {
 	DEBUG(Q_FUNC_INFO);
 	QElapsedTimer timer;
 	timer.start();
 
-	// determine the data source columns
-	const AbstractColumn* tmpY2DataColumn = nullptr;
-	if (dataSourceType == XYAnalysisCurve::DataSourceType::Spreadsheet) {
-		// spreadsheet columns as data source
-		tmpY2DataColumn = y2DataColumn;
-	} else {
-		// curve columns as data source (autocorrelation)
-		tmpY2DataColumn = dataSourceCurve->yColumn();
-	}
-
 	if (tmpY2DataColumn == nullptr) {
 		return true;
 	}
@@ -152,6 +154,13 @@ bool XYCorrelationCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 		return true;
 	}
 
+	// the input data is prepared, stop here if the asynchronous recalculation was canceled
+	if (job) {
+		if (job->isCancelled())
+			return false;
+		job->setProgress(10);
+	}
+
 	double* xdata = xdataVector.data();
 	double* ydata = ydataVector.data();
 	double* y2data = y2dataVector.data();
@@ -174,26 +183,26 @@ bool XYCorrelationCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 	double* out = (double*)malloc(np * sizeof(double));
 	int status = nsl_corr_correlation(ydata, n, y2data, m, type, norm, out);
 
-	xVector->resize((int)np);
-	yVector->resize((int)np);
+	xVector.resize((int)np);
+	yVector.resize((int)np);
 	// take given x-axis values or use index
 	if (tmpXDataColumn != nullptr) {
 		int size = GSL_MIN(xdataVector.size(), (int)np);
-		memcpy(xVector->data(), xdata, size * sizeof(double));
-		double sampleInterval = (xVector->data()[size - 1] - xVector->data()[0]) / (xdataVector.size() - 1);
+		memcpy(xVector.data(), xdata, size * sizeof(double));
+		double sampleInterval = (xVector.data()[size - 1] - xVector.data()[0]) / (xdataVector.size() - 1);
 		DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
 		for (int i = size; i < (int)np; i++) // fill missing values
-			xVector->data()[i] = xVector->data()[size - 1] + (i - size + 1) * sampleInterval;
+			xVector.data()[i] = xVector.data()[size - 1] + (i - size + 1) * sampleInterval;
 	} else { // fill with index (starting with 0)
 		if (type == nsl_corr_type_linear)
 			for (size_t i = 0; i < np; i++)
-				xVector->data()[i] = (int)(i - np / 2) * samplingInterval;
+				xVector.data()[i] = (int)(i - np / 2) * samplingInterval;
 		else
 			for (size_t i = 0; i < np; i++)
-				xVector->data()[i] = (int)i * samplingInterval;
+				xVector.data()[i] = (int)i * samplingInterval;
 	}
 
-	memcpy(yVector->data(), out, np * sizeof(double));
+	memcpy(yVector.data(), out, np * sizeof(double));
 	free(out);
 	///////////////////////////////////////////////////////////
 
@@ -206,6 +215,34 @@ bool XYCorrelationCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 	return true;
 }
 
+bool XYCorrelationCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	return correlation(correlationData, tmpXDataColumn, tmpYDataColumn, sourceY2DataColumn(), *xVector, *yVector, correlationResult);
+}
+
+/*!
+ * returns the column with the second signal, the y-data of the source curve is used for curves as data source (autocorrelation).
+ */
+const AbstractColumn* XYCorrelationCurvePrivate::sourceY2DataColumn() const {
+	if (dataSourceType == XYAnalysisCurve::DataSourceType::Spreadsheet)
+		return y2DataColumn;
+	return dataSourceCurve ? dataSourceCurve->yColumn() : nullptr;
+}
+
+bool XYCorrelationCurvePrivate::prepareAsyncRecalculation(XYAnalysisCurveJob& job, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	const auto* x = job.snapshot(tmpXDataColumn);
+	const auto* y = job.snapshot(tmpYDataColumn);
+	const auto* y2 = job.snapshot(sourceY2DataColumn());
+	auto result = std::make_shared<XYCorrelationCurve::CorrelationResult>();
+	job.setCalculation(
+		[data = correlationData, x, y, y2, result](XYAnalysisCurveJob& job) {
+			return correlation(data, x, y, y2, job.xData, job.yData, *result, &job);
+		},
+		[this, result]() {
+			correlationResult = *result;
+		});
+	return true;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
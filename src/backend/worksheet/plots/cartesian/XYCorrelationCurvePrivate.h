@@ -22,6 +22,8 @@ public:
 	~XYCorrelationCurvePrivate() override;
 
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	bool prepareAsyncRecalculation(XYAnalysisCurveJob&, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	const AbstractColumn* sourceY2DataColumn() const;
 	virtual void resetResults() override;
 	virtual bool preparationValid(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
 
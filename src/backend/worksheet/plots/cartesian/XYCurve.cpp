@@ -13,14 +13,19 @@
 #include "backend/core/Project.h"
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/DateTimeValues.h"
 #include "backend/gsl/errors.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/macrosCurve.h"
 #include "backend/lib/trace.h"
+extern "C" {
+#include "backend/nsl/nsl_geom_linesim.h"
+}
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/worksheet/Background.h"
 #include "backend/worksheet/Line.h"
+#include "backend/worksheet/Worksheet.h"
 #include "backend/worksheet/plots/cartesian/Symbol.h"
 #include "backend/worksheet/plots/cartesian/Value.h"
 #include "tools/ImageTools.h"
@@ -31,11 +36,15 @@
 #include <QPainter>
 #include <QScreen>
 #include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_spline.h>
 
+#include <numeric>
+
 #include <frontend/GuiTools.h>
 
 CURVE_COLUMN_CONNECT(XYCurve, X, x, recalc)
@@ -153,6 +162,8 @@ void XYCurve::init(bool loading) {
 	KConfig config;
 	KConfigGroup group = config.group(QStringLiteral("XYCurve"));
 
+	d->downsampling = (Downsampling)group.readEntry(QStringLiteral("Downsampling"), static_cast<int>(Downsampling::NoDownsampling));
+
 	// line
 	d->lineType = (LineType)group.readEntry(QStringLiteral("LineType"), static_cast<int>(LineType::Line));
 	d->lineIncreasingXOnly = group.readEntry(QStringLiteral("LineIncreasingXOnly"), false);
@@ -377,6 +388,7 @@ BASIC_SHARED_D_READER_IMPL(XYCurve, const AbstractColumn*, xColumn, xColumn)
 BASIC_SHARED_D_READER_IMPL(XYCurve, const AbstractColumn*, yColumn, yColumn)
 BASIC_SHARED_D_READER_IMPL(XYCurve, QString, xColumnPath, xColumnPath)
 BASIC_SHARED_D_READER_IMPL(XYCurve, QString, yColumnPath, yColumnPath)
+BASIC_SHARED_D_READER_IMPL(XYCurve, XYCurve::Downsampling, downsampling, downsampling)
 
 // line
 BASIC_SHARED_D_READER_IMPL(XYCurve, XYCurve::LineType, lineType, lineType)
@@ -560,6 +572,13 @@ void XYCurve::setYColumnPath(const QString& path) {
 	d->yColumnPath = path;
 }
 
+STD_SETTER_CMD_IMPL_F_S(XYCurve, SetDownsampling, XYCurve::Downsampling, downsampling, retransform)
+void XYCurve::setDownsampling(Downsampling downsampling) {
+	Q_D(XYCurve);
+	if (downsampling != d->downsampling)
+		exec(new XYCurveSetDownsamplingCmd(d, downsampling, ki18n("%1: set downsampling")));
+}
+
 // Line
 STD_SETTER_CMD_IMPL_F_S(XYCurve, SetLineType, XYCurve::LineType, lineType, updateLines)
 void XYCurve::setLineType(LineType type) {
@@ -638,6 +657,46 @@ void XYCurve::recalc() {
 	d->recalc();
 }
 
+/*!
+ * retransforms the curves \c curves in one step. The logical points of all curves are mapped to scene coordinates
+ * in parallel, the lines, symbols, values, etc. are updated one curve after another afterwards.
+ * Used by the worksheet to retransform the curves of all plots that were collected while the plots were retransformed,
+ * see Worksheet::deferRetransform().
+ */
+void XYCurve::retransformCurves(const QVector<XYCurve*>& curves) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", curves: ") + QString::number(curves.size()));
+
+	struct Mapping {
+		XYCurvePrivate* d;
+		int startIndex{0};
+		int endIndex{-1};
+		bool mapped{false};
+	};
+	std::vector<Mapping> mappings;
+	mappings.reserve(curves.size());
+	for (auto* curve : curves) {
+		auto* d = curve->d_func();
+		if (d->retransformSuppressed() || !d->q->plot() || !d->xColumn || !d->yColumn)
+			continue;
+
+		d->m_scenePointsDirty = true;
+		d->m_scenePoints.clear();
+		d->xColumn->properties(); // determine the properties of the x-column here, they are cached and used in the worker threads
+		mappings.push_back({d});
+	}
+
+	QtConcurrent::blockingMap(mappings, [](Mapping& mapping) {
+		mapping.mapped = mapping.d->mapScenePoints(false, mapping.startIndex, mapping.endIndex);
+	});
+
+	for (const auto& mapping : mappings) {
+		auto* d = mapping.d;
+		if (mapping.mapped)
+			Q_EMIT d->q->pointsUpdated(d->q, mapping.startIndex, mapping.endIndex, d->m_logicalPoints);
+		d->updatePaths();
+	}
+}
+
 /*!
  * if \c enable is set to true, enables the line optimization to reduce the total number of lines to be drawn,
  * disables it otherwise. On default, the line optimization is activated.
@@ -771,6 +830,21 @@ XYCurvePrivate::XYCurvePrivate(XYCurve* owner)
 void XYCurvePrivate::calculateScenePoints() {
 	if (!q->plot() || !m_scenePointsDirty || !xColumn)
 		return;
+
+	int startIndex, endIndex;
+	if (mapScenePoints(true, startIndex, endIndex))
+		Q_EMIT q->pointsUpdated(q, startIndex, endIndex, m_logicalPoints);
+}
+
+/*!
+ * maps the logical points to scene coordinates (see calculateScenePoints()), returns \c true if the points were mapped
+ * and \c startIndex and \c endIndex contain the range of the points considered.
+ *
+ * Neither the curve's graphics item nor the columns are modified here if the properties of the x-column are already determined,
+ * so the points of several curves can be mapped in parallel (see XYCurve::retransformCurves()). The sorted index of non-monotonic
+ * x-data is determined if \c determineSortedIndex is \c true only, otherwise it's only used if it's already available.
+ */
+bool XYCurvePrivate::mapScenePoints(bool determineSortedIndex, int& startIndex, int& endIndex) {
 #if PERFTRACE_CURVES
 	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", curve ") + name());
 #endif
@@ -793,35 +867,25 @@ void XYCurvePrivate::calculateScenePoints() {
 
 		if (numberOfPoints > 0) {
 			const auto dataRect{plot()->dataRect()};
-			// this is the old method considering DPI
 			DEBUG(Q_FUNC_INFO << ", plot->dataRect() width/height = " << dataRect.width() << '/' << dataRect.height());
-			DEBUG(Q_FUNC_INFO << ", logical DPI X/Y = " << QApplication::primaryScreen()->logicalDotsPerInchX() << '/'
-							  << QApplication::primaryScreen()->logicalDotsPerInchY())
-			DEBUG(Q_FUNC_INFO << ", physical DPI X/Y = " << QApplication::primaryScreen()->physicalDotsPerInchX() << '/'
-							  << QApplication::primaryScreen()->physicalDotsPerInchY())
 
-			// new method
 			const int numberOfPixelX = dataRect.width();
 			const int numberOfPixelY = dataRect.height();
 
 			if (numberOfPixelX <= 0 || numberOfPixelY <= 0) {
 				DEBUG(Q_FUNC_INFO << ", number of pixel X <= 0 or number of pixel Y <= 0!")
-				return;
+				return false;
 			}
 			DEBUG("	numberOfPixelX/numberOfPixelY = " << numberOfPixelX << '/' << numberOfPixelY)
 
-			// eliminate multiple scene points (size (numberOfPixelX + 1) * (numberOfPixelY + 1)) TODO: why "+1"
-			QVector<QVector<bool>> scenePointsUsed(numberOfPixelX + 1);
-			for (auto& col : scenePointsUsed)
-				col.resize(numberOfPixelY + 1);
-
 			const auto& columnProperties = xColumn->properties();
-			int startIndex, endIndex;
-			if (columnProperties == AbstractColumn::Properties::MonotonicDecreasing || columnProperties == AbstractColumn::Properties::MonotonicIncreasing) {
+			const bool monotonic =
+				(columnProperties == AbstractColumn::Properties::MonotonicDecreasing || columnProperties == AbstractColumn::Properties::MonotonicIncreasing);
+			if (monotonic) {
 				DEBUG(Q_FUNC_INFO << ", column monotonic")
 				if (!q->cSystem->isValid()) {
 					DEBUG(Q_FUNC_INFO << ", cSystem not valid!")
-					return;
+					return false;
 				}
 				double xMin = q->cSystem->mapSceneToLogical(dataRect.topLeft()).x();
 				double xMax = q->cSystem->mapSceneToLogical(dataRect.bottomRight()).x();
@@ -845,19 +909,154 @@ void XYCurvePrivate::calculateScenePoints() {
 				DEBUG(Q_FUNC_INFO << ", column not monotonic")
 				startIndex = 0;
 				endIndex = numberOfPoints - 1;
+
+				// only a small part of the unsorted data is visible (zoomed in): determine the visible points via the sorted index
+				// instead of mapping all points. The points are mapped in their original order as expected for the values, etc.
+				if (q->cSystem->isValid() && xColumn->columnMode() != AbstractColumn::ColumnMode::Text
+					&& (determineSortedIndex || static_cast<int>(m_logicalPointsSortedX.size()) == numberOfPoints)) {
+					double xMin = q->cSystem->mapSceneToLogical(dataRect.topLeft()).x();
+					double xMax = q->cSystem->mapSceneToLogical(dataRect.bottomRight()).x();
+					if (xMin > xMax)
+						qSwap(xMin, xMax);
+
+					const auto& sortedIndex = logicalPointsSortedX();
+					const auto lessX = [this](int index, double x) {
+						return m_logicalPoints.at(index).x() < x;
+					};
+					const auto greaterX = [this](double x, int index) {
+						return x < m_logicalPoints.at(index).x();
+					};
+					const auto first = std::lower_bound(sortedIndex.cbegin(), sortedIndex.cend(), xMin, lessX);
+					const auto last = std::upper_bound(first, sortedIndex.cend(), xMax, greaterX);
+					if (last - first < numberOfPoints / sortedIndexMinRatio
+						|| (downsampling != XYCurve::Downsampling::NoDownsampling && last - first > downsamplingPointsPerPixel * numberOfPixelX)) {
+						// the points are downsampled in the order of x
+						std::vector<int> indices(first, last);
+						downsample(indices, numberOfPixelX);
+						std::sort(indices.begin(), indices.end());
+						DEBUG(Q_FUNC_INFO << ", number of points in the x-range = " << indices.size())
+
+						m_pointVisible.assign(numberOfPoints, false);
+						q->cSystem->mapLogicalToScene(indices, m_logicalPoints, m_scenePoints, m_pointVisible);
+						m_scenePointsDirty = false;
+						return true;
+					}
+				}
 			}
 			//} // (symbolsStyle != Symbol::NoSymbols || value->type() != XYCurve::NoValues )
 
-			Q_EMIT q->pointsUpdated(q, startIndex, endIndex, m_logicalPoints);
+			m_pointVisible.assign(numberOfPoints, false);
+			// the downsampling requires the points to be sorted by x, non-monotonic data is only downsampled via the sorted index above
+			if (monotonic && downsampling != XYCurve::Downsampling::NoDownsampling
+				&& endIndex - startIndex + 1 > downsamplingPointsPerPixel * numberOfPixelX) {
+				std::vector<int> indices(endIndex - startIndex + 1);
+				std::iota(indices.begin(), indices.end(), startIndex);
+				downsample(indices, numberOfPixelX);
+				q->cSystem->mapLogicalToScene(indices, m_logicalPoints, m_scenePoints, m_pointVisible);
+				m_scenePointsDirty = false;
+				return true;
+			}
 
-			m_pointVisible.resize(numberOfPoints);
 			q->cSystem->mapLogicalToScene(startIndex, endIndex, m_logicalPoints, m_scenePoints, m_pointVisible);
 			// for (auto p : m_logicalPoints)
 			//	QDEBUG(Q_FUNC_INFO << ", logical points: " << QString::number(p.x(), 'g', 12) << " = " << QDateTime::fromMSecsSinceEpoch(p.x(), QTimeZone::UTC))
+			m_scenePointsDirty = false;
+			return true;
 		}
 	}
 	//} // (symbolsStyle != Symbol::Style::NoSymbols || value->type() != XYCurve::NoValues )
 	m_scenePointsDirty = false;
+	return false;
+}
+
+/*!
+ * reduces the logical points \c indices to at most downsamplingPointsPerPixel points per pixel of the plot width \c numberOfPixelX
+ * with the selected downsampling method. Only the remaining points are mapped to scene coordinates and shown
+ * with symbols, values and drop lines, the line is drawn for all points.
+ */
+void XYCurvePrivate::downsample(std::vector<int>& indices, int numberOfPixelX) const {
+	const size_t count = indices.size();
+	const size_t nout = static_cast<size_t>(downsamplingPointsPerPixel) * numberOfPixelX;
+	if (downsampling == XYCurve::Downsampling::NoDownsampling || count <= nout)
+		return;
+
+#if PERFTRACE_CURVES
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", curve ") + name());
+#endif
+	std::vector<double> xData(count);
+	std::vector<double> yData(count);
+	for (size_t i = 0; i < count; ++i) {
+		const auto& point = m_logicalPoints.at(indices.at(i));
+		xData[i] = point.x();
+		yData[i] = point.y();
+	}
+
+	std::vector<size_t> index(count);
+	size_t npoints = 0;
+	switch (downsampling) {
+	case XYCurve::Downsampling::NoDownsampling:
+		return;
+	case XYCurve::Downsampling::LTTB:
+		npoints = nsl_geom_linesim_lttb(xData.data(), yData.data(), count, nout, index.data());
+		break;
+	case XYCurve::Downsampling::MinMaxLTTB:
+		npoints = nsl_geom_linesim_minmax_lttb(xData.data(), yData.data(), count, nout, downsamplingMinMaxRatio, index.data());
+		break;
+	}
+	if (npoints == 0) // not enough memory, show all points
+		return;
+
+	// the indices are increasing, the reduced indices can be written in place
+	for (size_t i = 0; i < npoints; ++i)
+		indices[i] = indices.at(index.at(i));
+	indices.resize(npoints);
+	DEBUG(Q_FUNC_INFO << ", number of points after downsampling = " << npoints)
+}
+
+/*!
+ * returns the indices of the logical points sorted by x. For x-columns of type Column the sorted index cached
+ * in the column is used (shared between all curves using this column), otherwise the points are sorted here.
+ * Determined on the first use after the data was changed.
+ */
+const std::vector<int>& XYCurvePrivate::logicalPointsSortedX() {
+	const int numberOfPoints = m_logicalPoints.size();
+	if (static_cast<int>(m_logicalPointsSortedX.size()) == numberOfPoints)
+		return m_logicalPointsSortedX;
+
+#if PERFTRACE_CURVES
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", curve ") + name());
+#endif
+	m_logicalPointsSortedX.clear();
+	m_logicalPointsSortedX.reserve(numberOfPoints);
+
+	const auto* column = dynamic_cast<const Column*>(xColumn);
+	if (column && !column->sortedIndex().isEmpty()) {
+		const auto& sortedRows = column->sortedIndex();
+		// the sorted index of the column contains the rows, map them to the indices of the logical points.
+		// rows not used in the curve (invalid or masked y-values) are skipped.
+		const int rows = column->rowCount();
+		std::vector<int> logicalIndex(rows, -1);
+		for (int i = 0; i < numberOfPoints; ++i) {
+			const int row = validPointsIndicesLogical.at(i);
+			if (row < rows)
+				logicalIndex[row] = i;
+		}
+		for (const int row : sortedRows) {
+			const int index = row < rows ? logicalIndex.at(row) : -1;
+			if (index >= 0)
+				m_logicalPointsSortedX.push_back(index);
+		}
+	}
+
+	if (static_cast<int>(m_logicalPointsSortedX.size()) != numberOfPoints) {
+		m_logicalPointsSortedX.resize(numberOfPoints);
+		std::iota(m_logicalPointsSortedX.begin(), m_logicalPointsSortedX.end(), 0);
+		std::stable_sort(m_logicalPointsSortedX.begin(), m_logicalPointsSortedX.end(), [this](int a, int b) {
+			return m_logicalPoints.at(a).x() < m_logicalPoints.at(b).x();
+		});
+	}
+
+	return m_logicalPointsSortedX;
 }
 
 /*!
@@ -894,6 +1093,19 @@ void XYCurvePrivate::retransform() {
 		return;
 	}
 
+	// the curve is part of a worksheet being retransformed as a whole, the worksheet retransforms it together with the other curves
+	auto* worksheet = q->parent<Worksheet>();
+	if (worksheet && worksheet->deferRetransform(q))
+		return;
+
+	updatePaths();
+}
+
+/*!
+ * recalculates the paths of the lines, symbols, etc. after the retransformation,
+ * the scene points are determined on demand if they are not available yet.
+ */
+void XYCurvePrivate::updatePaths() {
 	suppressRecalc = true;
 	updateLines();
 	updateDropLines();
@@ -917,6 +1129,7 @@ void XYCurvePrivate::recalc() {
 	m_logicalPoints.clear();
 	connectedPointsLogical.clear();
 	validPointsIndicesLogical.clear();
+	m_logicalPointsSortedX.clear();
 
 	if (!xColumn || !yColumn)
 		return;
@@ -930,6 +1143,12 @@ void XYCurvePrivate::recalc() {
 	if (m_plot)
 		yOffset = m_plot->curveChildIndex(q) * m_plot->stackYOffset();
 
+	// milliseconds or nanoseconds since epoch of the date and time values, if available in this form no conversion from QDateTime is needed
+	const auto xDateTimes = xColumn->dateTimeMSecs();
+	const auto yDateTimes = yColumn->dateTimeMSecs();
+	const auto xTimestamps = xColumn->dateTimeNSecs();
+	const auto yTimestamps = yColumn->dateTimeNSecs();
+
 	// take only valid and non masked points
 	for (int row = 0; row < rows; row++) {
 		// DEBUG("row = " << row << " valid x/y = " << xColumn->isValid(row) << " " << yColumn->isValid(row))
@@ -947,7 +1166,10 @@ void XYCurvePrivate::recalc() {
 				tempPoint.setX(xColumn->bigIntAt(row));
 				break;
 			case AbstractColumn::ColumnMode::DateTime:
-				tempPoint.setX(xColumn->dateTimeAt(row).toMSecsSinceEpoch());
+				if (!xTimestamps.empty())
+					tempPoint.setX(DateTimeValues::toMSecsF(xTimestamps[row]));
+				else
+					tempPoint.setX(!xDateTimes.empty() ? xDateTimes[row] : xColumn->dateTimeAt(row).toMSecsSinceEpoch());
 				break;
 			case AbstractColumn::ColumnMode::Text:
 			case AbstractColumn::ColumnMode::Month:
@@ -966,7 +1188,10 @@ void XYCurvePrivate::recalc() {
 				tempPoint.setY(yColumn->bigIntAt(row) + (int)yOffset);
 				break;
 			case AbstractColumn::ColumnMode::DateTime:
-				tempPoint.setY(yColumn->dateTimeAt(row).toMSecsSinceEpoch());
+				if (!yTimestamps.empty())
+					tempPoint.setY(DateTimeValues::toMSecsF(yTimestamps[row]));
+				else
+					tempPoint.setY(!yDateTimes.empty() ? yDateTimes[row] : yColumn->dateTimeAt(row).toMSecsSinceEpoch());
 				break;
 			case AbstractColumn::ColumnMode::Text:
 			case AbstractColumn::ColumnMode::Month:
@@ -985,6 +1210,9 @@ void XYCurvePrivate::recalc() {
 	}
 
 	m_pointVisible.resize(m_logicalPoints.size());
+#if PERFTRACE_CURVES
+	PERFTRACE_COUNTER("curve rows processed", rows);
+#endif
 }
 
 /*!
@@ -2726,58 +2954,196 @@ void XYCurvePrivate::draw(QPainter* painter) {
 		for (const auto& polygon : std::as_const(m_fillPolygons))
 			background->draw(painter, polygon);
 
-	// draw lines
+	draw(painter, renderData());
+}
+
+/*!
+ * collects the current scene geometry and the style properties required to draw the curve
+ * (everything except for the filling) into an immutable snapshot.
+ */
+XYCurveRenderData XYCurvePrivate::renderData() {
+	XYCurveRenderData data;
+	data.boundingRect = m_boundingRectangle;
+
+	// lines
 	if (lineType != XYCurve::LineType::NoLine) {
-		painter->setOpacity(line->opacity());
-		painter->setPen(line->pen());
+		data.drawLines = true;
+		data.linePen = line->pen();
+		data.lineOpacity = line->opacity();
+		// Much faster than drawPath but has problems
+		// with different styles
+		// When exporting to svg or pdf, this creates for every line
+		// it's own path in the saved file which is not desired. We
+		// would like to have one complete path for a curve not many paths
+		data.drawLineSegments = (data.linePen.style() == Qt::SolidLine && !q->isPrinting());
+		if (data.drawLineSegments)
+			data.lines = m_lines;
+		else
+			data.linePath = linePath;
+	}
+
+	// drop lines
+	if (dropLine->dropLineType() != XYCurve::DropLineType::NoDropLine) {
+		data.drawDropLines = true;
+		data.dropLinePen = dropLine->pen();
+		data.dropLineOpacity = dropLine->opacity();
+		data.dropLinePath = dropLinePath;
+	}
+
+	// error bars
+	if ((errorBar->xErrorType() != ErrorBar::ErrorType::NoError) || (errorBar->yErrorType() != ErrorBar::ErrorType::NoError)) {
+		data.drawErrorBars = true;
+		data.errorBarPen = errorBar->line()->pen();
+		data.errorBarOpacity = errorBar->line()->opacity();
+		data.errorBarsPath = errorBarsPath;
+	}
+
+	// symbols
+	if (symbol->style() != Symbol::Style::NoSymbols) {
+		calculateScenePoints();
+		data.drawSymbols = !m_scenePoints.isEmpty();
+		data.symbolPen = symbol->pen();
+		data.symbolBrush = symbol->brush();
+		data.symbolOpacity = symbol->opacity();
+		QTransform trafo;
+		trafo.scale(symbol->size(), symbol->size());
+		if (symbol->rotationAngle() != 0)
+			trafo.rotate(-symbol->rotationAngle());
+		data.symbolPath = trafo.map(Symbol::stylePath(symbol->style()));
+		data.scenePoints = m_scenePoints;
+	}
+
+	// values
+	if (value->type() != Value::Type::NoValues) {
+		data.drawValues = true;
+		data.valueFont = value->font();
+		data.valueColor = value->color();
+		data.valueOpacity = value->opacity();
+		data.valueRotationAngle = value->rotationAngle();
+		data.valuePoints = m_valuePoints;
+		data.valueStrings = m_valueStrings;
+	}
+
+	// rug
+	if (rugEnabled) {
+		data.drawRug = true;
+		data.rugPen.setColor(symbol->brush().color());
+		data.rugPen.setWidthF(rugWidth);
+		data.rugOpacity = symbol->opacity();
+		data.rugPath = rugPath;
+	}
+
+	return data;
+}
+
+/*!
+ * draws the curve described by \c data on \c painter. Doesn't access any curve object and can be called in a worker thread.
+ * \c canceled is checked periodically, the drawing is stopped and \c false is returned if it returns \c true.
+ */
+bool XYCurvePrivate::draw(QPainter* painter, const XYCurveRenderData& data, const std::function<bool()>& canceled) {
+	static const int checkInterval = 4096; // number of primitives drawn between two checks of the cancel condition
+	const auto isCanceled = [&canceled]() {
+		return canceled && canceled();
+	};
+
+	// draw lines
+	if (data.drawLines) {
+		painter->setOpacity(data.lineOpacity);
+		painter->setPen(data.linePen);
 		painter->setBrush(Qt::NoBrush);
-		if (line->pen().style() == Qt::SolidLine && !q->isPrinting()) {
-			// Much faster than drawPath but has problems
-			// with different styles
-			// When exporting to svg or pdf, this creates for every line
-			// it's own path in the saved file which is not desired. We
-			// would like to have one complete path for a curve not many paths
-			for (auto& l : m_lines)
-				painter->drawLine(l);
+		if (data.drawLineSegments) {
+			for (int i = 0; i < data.lines.size(); ++i) {
+				if (i % checkInterval == 0 && isCanceled())
+					return false;
+				painter->drawLine(data.lines.at(i));
+			}
 		} else
-			painter->drawPath(linePath);
+			painter->drawPath(data.linePath);
 	}
 
 	// draw drop lines
-	if (dropLine->dropLineType() != XYCurve::DropLineType::NoDropLine) {
-		painter->setOpacity(dropLine->opacity());
-		painter->setPen(dropLine->pen());
+	if (data.drawDropLines) {
+		if (isCanceled())
+			return false;
+		painter->setOpacity(data.dropLineOpacity);
+		painter->setPen(data.dropLinePen);
 		painter->setBrush(Qt::NoBrush);
-		painter->drawPath(dropLinePath);
+		painter->drawPath(data.dropLinePath);
 	}
 
 	// draw error bars
-	if ((errorBar->xErrorType() != ErrorBar::ErrorType::NoError) || (errorBar->yErrorType() != ErrorBar::ErrorType::NoError))
-		errorBar->draw(painter, errorBarsPath);
+	if (data.drawErrorBars) {
+		if (isCanceled())
+			return false;
+		painter->setOpacity(data.errorBarOpacity);
+		painter->setPen(data.errorBarPen);
+		painter->setBrush(Qt::NoBrush);
+		painter->drawPath(data.errorBarsPath);
+	}
 
 	// draw symbols
-	if (symbol->style() != Symbol::Style::NoSymbols) {
-		calculateScenePoints();
-		symbol->draw(painter, m_scenePoints);
+	if (data.drawSymbols) {
+		painter->setOpacity(data.symbolOpacity);
+		painter->setPen(data.symbolPen);
+		painter->setBrush(data.symbolBrush);
+		for (int i = 0; i < data.scenePoints.size(); ++i) {
+			if (i % checkInterval == 0 && isCanceled())
+				return false;
+			painter->drawPath(data.symbolPath.translated(data.scenePoints.at(i)));
+		}
 	}
 
 	// draw values
-	if (value->type() != Value::Type::NoValues) {
-		painter->setOpacity(value->opacity());
-		painter->setPen(QPen(value->color()));
-		painter->setFont(value->font());
-		drawValues(painter);
+	if (data.drawValues) {
+		if (isCanceled())
+			return false;
+		painter->setOpacity(data.valueOpacity);
+		painter->setPen(QPen(data.valueColor));
+		painter->setFont(data.valueFont);
+		for (int i = 0; i < data.valuePoints.size(); ++i) {
+			const auto& point = data.valuePoints.at(i);
+			painter->translate(point);
+			if (data.valueRotationAngle != 0.)
+				painter->rotate(-data.valueRotationAngle);
+
+			painter->drawText(QPoint(0, 0), data.valueStrings.at(i));
+
+			if (data.valueRotationAngle != 0.)
+				painter->rotate(data.valueRotationAngle);
+			painter->translate(-point);
+		}
 	}
 
 	// draw rug
-	if (rugEnabled) {
-		QPen pen;
-		pen.setColor(symbol->brush().color());
-		pen.setWidthF(rugWidth);
-		painter->setPen(pen);
-		painter->setOpacity(symbol->opacity());
-		painter->drawPath(rugPath);
+	if (data.drawRug) {
+		painter->setPen(data.rugPen);
+		painter->setOpacity(data.rugOpacity);
+		painter->drawPath(data.rugPath);
 	}
+
+	return true;
+}
+
+/*!
+ * returns \c true if the pixmap of the curve is to be rendered in a worker thread.
+ * Only large curves without filling are rendered asynchronously, the filling
+ * is drawn via the Background object which cannot be accessed outside of the GUI thread.
+ */
+bool XYCurvePrivate::asyncRenderingEnabled() const {
+	if (q->isPrinting() || m_logicalPoints.size() < asyncRenderingMinPoints || background->position() != Background::Position::No)
+		return false;
+
+	const auto group = Settings::group(QStringLiteral("Settings_Worksheet"));
+	return group.readEntry<bool>("DoubleBuffering", true) && group.readEntry<bool>("AsyncRendering", true);
+}
+
+/*!
+ * thread pool used to render the curve pixmaps, separated from the global pool
+ * that is used for the column related tasks which are waited for in recalc().
+ */
+static QThreadPool* renderThreadPool() {
+	static QThreadPool pool;
+	return &pool;
 }
 
 void XYCurvePrivate::updatePixmap() {
@@ -2785,15 +3151,25 @@ void XYCurvePrivate::updatePixmap() {
 	if (suppressRecalc)
 		return;
 
+	// invalidate the pending asynchronous render requests, if available
+	++(*m_renderGeneration);
 	m_hoverEffectImageIsDirty = true;
 	m_selectionEffectImageIsDirty = true;
 	if (m_boundingRectangle.width() == 0 || m_boundingRectangle.height() == 0) {
 		DEBUG(Q_FUNC_INFO << ", boundingRectangle.width() or boundingRectangle.height() == 0");
 		m_pixmap = QPixmap();
+		m_pixmapOutdated = false;
+		return;
+	}
+
+	if (asyncRenderingEnabled()) {
+		updatePixmapAsync();
 		return;
 	}
+
 	m_pixmap = QPixmap(ceil(m_boundingRectangle.width()), ceil(m_boundingRectangle.height()));
 	m_pixmap.fill(Qt::transparent);
+	m_pixmapOutdated = false;
 	QPainter painter(&m_pixmap);
 	painter.setRenderHint(QPainter::Antialiasing);
 	painter.translate(-m_boundingRectangle.topLeft());
@@ -2805,6 +3181,51 @@ void XYCurvePrivate::updatePixmap() {
 	Q_EMIT q->changed();
 }
 
+/*!
+ * renders the pixmap of the curve in a worker thread based on the snapshot of the current geometry.
+ * The outdated pixmap is shown rescaled to the new bounding rectangle until the rendering is finished.
+ * The rendering of a snapshot is canceled if a newer render request is made in the meantime (zooming, resizing, etc.).
+ */
+void XYCurvePrivate::updatePixmapAsync() {
+	const auto generation = m_renderGeneration->load();
+	const auto data = renderData();
+	const auto generationCounter = m_renderGeneration;
+	const auto canceled = [generation, generationCounter]() {
+		return generationCounter->load() != generation;
+	};
+
+	m_pixmapOutdated = true;
+	update();
+
+	auto future = QtConcurrent::run(renderThreadPool(), [data, canceled]() {
+		if (canceled())
+			return QImage();
+
+		QImage image(ceil(data.boundingRect.width()), ceil(data.boundingRect.height()), QImage::Format_ARGB32_Premultiplied);
+		image.fill(Qt::transparent);
+		QPainter painter(&image);
+		painter.setRenderHint(QPainter::Antialiasing);
+		painter.translate(-data.boundingRect.topLeft());
+		const bool finished = draw(&painter, data, canceled);
+		painter.end();
+
+		return finished ? image : QImage();
+	});
+
+	// the continuation is executed in the GUI thread and is not executed anymore if the curve was deleted in the meantime
+	future.then(q, [this, canceled](const QImage& image) {
+		if (canceled() || image.isNull())
+			return; // outdated, the result of the newer render request will be used
+
+		m_pixmap = QPixmap::fromImage(image);
+		m_pixmapOutdated = false;
+		m_hoverEffectImageIsDirty = true;
+		m_selectionEffectImageIsDirty = true;
+		update();
+		Q_EMIT q->changed();
+	});
+}
+
 QVariant XYCurvePrivate::itemChange(GraphicsItemChange change, const QVariant& changeValue) {
 	// signalize, that the curve was selected. Will be used to create a new InfoElement (Marker)
 	if (change == QGraphicsItem::ItemSelectedChange) {
@@ -2827,15 +3248,28 @@ void XYCurvePrivate::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*
 	painter->setBrush(Qt::NoBrush);
 	painter->setRenderHint(QPainter::SmoothPixmapTransform);
 
-	if (!q->isPrinting() && Settings::group(QStringLiteral("Settings_Worksheet")).readEntry<bool>("DoubleBuffering", true))
-		painter->drawPixmap(m_boundingRectangle.topLeft(), m_pixmap); // draw the cached pixmap (fast)
-	else
+	// the new pixmap is being rendered in the background, show the outdated one and its effects scaled to the new geometry meanwhile
+	bool outdated = false;
+	if (!q->isPrinting() && Settings::group(QStringLiteral("Settings_Worksheet")).readEntry<bool>("DoubleBuffering", true)) {
+		outdated = m_pixmapOutdated;
+		if (!outdated)
+			painter->drawPixmap(m_boundingRectangle.topLeft(), m_pixmap); // draw the cached pixmap (fast)
+		else if (!m_pixmap.isNull())
+			painter->drawPixmap(m_boundingRectangle, m_pixmap, QRectF(m_pixmap.rect()));
+	} else
 		draw(painter); // draw directly again (slow)
 
 	// no need to handle the selection/hover effect if the cached pixmap is empty
 	if (m_pixmap.isNull())
 		return;
 
+	const auto drawEffect = [&](const QImage& image) {
+		if (outdated)
+			painter->drawImage(m_boundingRectangle, image, QRectF(m_pixmap.rect()));
+		else
+			painter->drawImage(m_boundingRectangle.topLeft(), image, m_pixmap.rect());
+	};
+
 	if (isHovered() && !isSelected() && !q->isPrinting()) {
 		if (m_hoverEffectImageIsDirty) {
 			QPixmap pix = m_pixmap;
@@ -2848,7 +3282,7 @@ void XYCurvePrivate::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*
 			m_hoverEffectImageIsDirty = false;
 		}
 
-		painter->drawImage(m_boundingRectangle.topLeft(), m_hoverEffectImage, m_pixmap.rect());
+		drawEffect(m_hoverEffectImage);
 		return;
 	}
 
@@ -2864,23 +3298,7 @@ void XYCurvePrivate::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*
 			m_selectionEffectImageIsDirty = false;
 		}
 
-		painter->drawImage(m_boundingRectangle.topLeft(), m_selectionEffectImage, m_pixmap.rect());
-	}
-}
-
-void XYCurvePrivate::drawValues(QPainter* painter) {
-	// QDEBUG(Q_FUNC_INFO << ", value strings = " << m_valueStrings)
-	int i = 0;
-	for (const auto& point : std::as_const(m_valuePoints)) {
-		painter->translate(point);
-		if (value->rotationAngle() != 0.)
-			painter->rotate(-value->rotationAngle());
-
-		painter->drawText(QPoint(0, 0), m_valueStrings.at(i++));
-
-		if (value->rotationAngle() != 0.)
-			painter->rotate(value->rotationAngle());
-		painter->translate(-point);
+		drawEffect(m_selectionEffectImage);
 	}
 }
 
@@ -2923,6 +3341,7 @@ void XYCurve::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("plotRangeIndex"), QString::number(m_cSystemIndex));
 	writer->writeAttribute(QStringLiteral("legendVisible"), QString::number(d->legendVisible));
 	writer->writeAttribute(QStringLiteral("visible"), QString::number(d->isVisible()));
+	writer->writeAttribute(QStringLiteral("downsampling"), QString::number(static_cast<int>(d->downsampling)));
 	writer->writeEndElement();
 
 	// Line
@@ -2997,6 +3416,10 @@ bool XYCurve::load(XmlStreamReader* reader, bool preview) {
 			else
 				d->setVisible(str.toInt());
 			READ_INT_VALUE_DIRECT("plotRangeIndex", m_cSystemIndex, int);
+
+			str = attribs.value(QStringLiteral("downsampling")).toString();
+			if (!str.isEmpty())
+				d->downsampling = static_cast<Downsampling>(str.toInt());
 		} else if (!preview && reader->name() == QLatin1String("lines")) {
 			attribs = reader->attributes();
 
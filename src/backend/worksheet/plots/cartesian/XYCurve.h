@@ -53,6 +53,7 @@ public:
 		SplineAkimaPeriodic
 	};
 	enum class DropLineType { NoDropLine, X, Y, XY, XZeroBaseline, XMinBaseline, XMaxBaseline };
+	enum class Downsampling { NoDownsampling, LTTB, MinMaxLTTB }; // downsampling of the points shown with symbols, values and drop lines
 
 	explicit XYCurve(const QString& name, AspectType type = AspectType::XYCurve, bool loading = false);
 	~XYCurve() override;
@@ -83,6 +84,7 @@ public:
 	POINTER_D_ACCESSOR_DECL(const AbstractColumn, yColumn, YColumn)
 	CLASS_D_ACCESSOR_DECL(QString, xColumnPath, XColumnPath)
 	CLASS_D_ACCESSOR_DECL(QString, yColumnPath, YColumnPath)
+	BASIC_D_ACCESSOR_DECL(Downsampling, downsampling, Downsampling)
 
 	BASIC_D_ACCESSOR_DECL(LineType, lineType, LineType)
 	BASIC_D_ACCESSOR_DECL(bool, lineSkipGaps, LineSkipGaps)
@@ -110,6 +112,7 @@ public:
 
 	void retransform() override;
 	void recalc() override;
+	static void retransformCurves(const QVector<XYCurve*>&);
 	void enableLineOptimization(bool);
 	void handleResize(double horizontalRatio, double verticalRatio, bool pageResize) override;
 	void updateLocale() override;
@@ -158,6 +161,7 @@ Q_SIGNALS:
 
 	void xColumnChanged(const AbstractColumn*);
 	void yColumnChanged(const AbstractColumn*);
+	void downsamplingChanged(XYCurve::Downsampling);
 
 	// Line-Tab
 	void lineTypeChanged(XYCurve::LineType);
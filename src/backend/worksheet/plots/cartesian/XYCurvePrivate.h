@@ -13,6 +13,13 @@
 #define XYCURVEPRIVATE_H
 
 #include "backend/worksheet/plots/cartesian/PlotPrivate.h"
+
+#include <QFont>
+#include <QPen>
+
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <vector>
 
 class Background;
@@ -22,11 +29,57 @@ class Symbol;
 class Value;
 class XYCurve;
 
+/*!
+ * immutable snapshot of the scene geometry and of the style properties that are required to draw the curve.
+ * Contains implicitly shared copies only and can be rendered in a worker thread without accessing the curve.
+ */
+struct XYCurveRenderData {
+	QRectF boundingRect;
+
+	bool drawLines{false};
+	bool drawLineSegments{false}; // draw m_lines instead of linePath (faster for solid lines)
+	QPen linePen;
+	double lineOpacity{1.};
+	QPainterPath linePath;
+	QVector<QLineF> lines;
+
+	bool drawDropLines{false};
+	QPen dropLinePen;
+	double dropLineOpacity{1.};
+	QPainterPath dropLinePath;
+
+	bool drawErrorBars{false};
+	QPen errorBarPen;
+	double errorBarOpacity{1.};
+	QPainterPath errorBarsPath;
+
+	bool drawSymbols{false};
+	QPainterPath symbolPath; // scaled and rotated symbol path centered at the origin
+	QPen symbolPen;
+	QBrush symbolBrush;
+	double symbolOpacity{1.};
+	QVector<QPointF> scenePoints;
+
+	bool drawValues{false};
+	QFont valueFont;
+	QColor valueColor;
+	double valueOpacity{1.};
+	double valueRotationAngle{0.};
+	QVector<QPointF> valuePoints;
+	QVector<QString> valueStrings;
+
+	bool drawRug{false};
+	QPen rugPen;
+	double rugOpacity{1.};
+	QPainterPath rugPath;
+};
+
 class XYCurvePrivate : public PlotPrivate {
 public:
 	explicit XYCurvePrivate(XYCurve*);
 
 	void retransform() override;
+	void updatePaths();
 	void recalc();
 	void updateLines(bool performanceOptimization = true);
 	void addLine(QPointF p,
@@ -68,6 +121,7 @@ public:
 	QString xColumnPath;
 	QString yColumnPath;
 	bool sourceDataChangedSinceLastRecalc{false};
+	XYCurve::Downsampling downsampling{XYCurve::Downsampling::NoDownsampling};
 
 	// line
 	XYCurve::LineType lineType{XYCurve::LineType::Line};
@@ -102,9 +156,15 @@ private:
 	QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
 	void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* widget = nullptr) override;
 
-	void drawValues(QPainter*);
 	void draw(QPainter*);
+	XYCurveRenderData renderData();
+	static bool draw(QPainter*, const XYCurveRenderData&, const std::function<bool()>& canceled = {});
+	bool asyncRenderingEnabled() const;
+	void updatePixmapAsync();
 	void calculateScenePoints();
+	bool mapScenePoints(bool determineSortedIndex, int& startIndex, int& endIndex);
+	const std::vector<int>& logicalPointsSortedX();
+	void downsample(std::vector<int>& indices, int numberOfPixelX) const;
 
 	// TODO: add m_
 	QPainterPath linePath;
@@ -123,8 +183,17 @@ private:
 	// TODO: QVector, rename, usage
 	std::vector<int> validPointsIndicesLogical; // original indices in the source columns for valid and non-masked values (size of m_logicalPoints)
 	std::vector<bool> connectedPointsLogical; // true for points connected with the consecutive point (size of m_logicalPoints)
+	std::vector<int> m_logicalPointsSortedX; // indices of m_logicalPoints sorted by x, determined on demand for non-monotonic x-data
 
 	QPointF mousePos;
+	static const int sortedIndexMinRatio = 8; // unsorted data is mapped via the sorted index if less than 1/8 of the points are in the x-range
+	static const int downsamplingPointsPerPixel = 2; // maximal number of points per pixel of the plot width shown with downsampling
+	static const int downsamplingMinMaxRatio = 4; // number of points preselected per shown point for MinMaxLTTB
+
+	// asynchronous rendering of the cached pixmap
+	static const int asyncRenderingMinPoints = 100000; // smaller curves are rendered synchronously
+	std::shared_ptr<std::atomic<quint64>> m_renderGeneration{std::make_shared<std::atomic<quint64>>(0)}; // incremented for every new render request
+	bool m_pixmapOutdated{false}; // true while a new pixmap is being rendered, the outdated one is shown rescaled meanwhile
 
 	friend class RetransformTest;
 	friend class XYCurveTest;
@@ -114,39 +114,14 @@ bool XYDifferentiationCurvePrivate::recalculateSpecific(const AbstractColumn* tm
 	double* xdata = xdataVector.data();
 	double* ydata = ydataVector.data();
 
-	// differentiation settings
-	const nsl_diff_deriv_order_type derivOrder = differentiationData.derivOrder;
-	const int accOrder = differentiationData.accOrder;
-
-	DEBUG(nsl_diff_deriv_order_name[derivOrder] << " derivative");
-	DEBUG("accuracy order: " << accOrder);
+	DEBUG(nsl_diff_deriv_order_name[differentiationData.derivOrder] << " derivative");
+	DEBUG("accuracy order: " << differentiationData.accOrder);
 	// WARN("DATA:")
 	// for (int i = 0; i < n; i++)
 	//	WARN(xdata[i] << "," << ydata[i])
 
 	///////////////////////////////////////////////////////////
-	int status = 0;
-
-	switch (derivOrder) {
-	case nsl_diff_deriv_order_first:
-		status = nsl_diff_first_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_second:
-		status = nsl_diff_second_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_third:
-		status = nsl_diff_third_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_fourth:
-		status = nsl_diff_fourth_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_fifth:
-		status = nsl_diff_fifth_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_sixth:
-		status = nsl_diff_sixth_deriv(xdata, ydata, n, accOrder);
-		break;
-	}
+	const int status = differentiate(xdata, ydata, n);
 
 	xVector->resize((int)n);
 	yVector->resize((int)n);
@@ -166,6 +141,57 @@ bool XYDifferentiationCurvePrivate::recalculateSpecific(const AbstractColumn* tm
 	return true;
 }
 
+/*!
+ * updates the derivative for the rows appended to the live data source, the finite differences
+ * depend only on the neighbouring points and only the points at the borders of the data are recalculated.
+ */
+bool XYDifferentiationCurvePrivate::recalculateIncremental(const AbstractColumn* tmpXDataColumn,
+														   const AbstractColumn* tmpYDataColumn,
+														   int removedRows,
+														   int /* appendedRows */) {
+	if (!differentiationResult.valid)
+		return false;
+
+	double xmin = -INFINITY;
+	double xmax = INFINITY;
+	if (!differentiationData.autoRange) {
+		xmin = differentiationData.xRange.first();
+		xmax = differentiationData.xRange.last();
+	}
+
+	// the stencils have up to seven points and up to four points at the borders are calculated with one-sided
+	// differences, a margin of eight points covers all of them
+	const int margin = 8;
+	return updateLocalResult(tmpXDataColumn, tmpYDataColumn, removedRows, xmin, xmax, margin, true, [this](QVector<double>& x, QVector<double>& y) {
+		return differentiate(x.constData(), y.data(), x.size()) == 0;
+	});
+}
+
+/*!
+ * calculates the derivative of \c ydata in place with the current differentiation settings, returns the status of the calculation.
+ */
+int XYDifferentiationCurvePrivate::differentiate(const double* xdata, double* ydata, size_t n) const {
+	const nsl_diff_deriv_order_type derivOrder = differentiationData.derivOrder;
+	const int accOrder = differentiationData.accOrder;
+
+	switch (derivOrder) {
+	case nsl_diff_deriv_order_first:
+		return nsl_diff_first_deriv(xdata, ydata, n, accOrder);
+	case nsl_diff_deriv_order_second:
+		return nsl_diff_second_deriv(xdata, ydata, n, accOrder);
+	case nsl_diff_deriv_order_third:
+		return nsl_diff_third_deriv(xdata, ydata, n, accOrder);
+	case nsl_diff_deriv_order_fourth:
+		return nsl_diff_fourth_deriv(xdata, ydata, n, accOrder);
+	case nsl_diff_deriv_order_fifth:
+		return nsl_diff_fifth_deriv(xdata, ydata, n, accOrder);
+	case nsl_diff_deriv_order_sixth:
+		return nsl_diff_sixth_deriv(xdata, ydata, n, accOrder);
+	}
+
+	return 0;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
@@ -23,7 +23,9 @@ public:
 	~XYDifferentiationCurvePrivate() override;
 
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	virtual bool recalculateIncremental(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn, int removedRows, int appendedRows) override;
 	virtual void resetResults() override;
+	int differentiate(const double* xdata, double* ydata, size_t n) const;
 
 	XYDifferentiationCurve::DifferentiationData differentiationData;
 	XYDifferentiationCurve::DifferentiationResult differentiationResult;
@@ -93,7 +93,18 @@ void XYFourierFilterCurvePrivate::resetResults() {
 	filterResult = XYFourierFilterCurve::FilterResult();
 }
 
-bool XYFourierFilterCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+/*!
+ * filters the data in \c tmpXDataColumn and \c tmpYDataColumn
+ * and writes the result into \c xVector and \c yVector.
+ * Called in the worker thread for the asynchronous recalculation with \c job being set.
+ */
+static bool fourierFilter(const XYFourierFilterCurve::FilterData& filterData,
+						  const AbstractColumn* tmpXDataColumn,
+						  const AbstractColumn* tmpYDataColumn,
+						  QVector<double>& xVector,
+						  QVector<double>& yVector,
+						  XYFourierFilterCurve::FilterResult& filterResult,
+						  XYAnalysisCurveJob* job = nullptr) {
 	QElapsedTimer timer;
 	timer.start();
 
@@ -168,6 +179,13 @@ bool XYFourierFilterCurvePrivate::recalculateSpecific(const AbstractColumn* tmpX
 		return true;
 	}
 
+	// the input data is prepared, stop here if the asynchronous recalculation was canceled
+	if (job) {
+		if (job->isCancelled())
+			return false;
+		job->setProgress(10);
+	}
+
 	// double* xdata = xdataVector.data();
 	double* ydata = ydataVector.data();
 
@@ -224,10 +242,10 @@ bool XYFourierFilterCurvePrivate::recalculateSpecific(const AbstractColumn* tmpX
 	gsl_set_error_handler_off();
 	int status = nsl_filter_fourier(ydata, n, type, form, order, cutindex, bandwidth);
 
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdataVector.data(), n * sizeof(double));
-	memcpy(yVector->data(), ydata, n * sizeof(double));
+	xVector.resize((int)n);
+	yVector.resize((int)n);
+	memcpy(xVector.data(), xdataVector.data(), n * sizeof(double));
+	memcpy(yVector.data(), ydata, n * sizeof(double));
 	///////////////////////////////////////////////////////////
 
 	// write the result
@@ -238,6 +256,24 @@ bool XYFourierFilterCurvePrivate::recalculateSpecific(const AbstractColumn* tmpX
 	return true;
 }
 
+bool XYFourierFilterCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	return fourierFilter(filterData, tmpXDataColumn, tmpYDataColumn, *xVector, *yVector, filterResult);
+}
+
+bool XYFourierFilterCurvePrivate::prepareAsyncRecalculation(XYAnalysisCurveJob& job, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	const auto* x = job.snapshot(tmpXDataColumn);
+	const auto* y = job.snapshot(tmpYDataColumn);
+	auto result = std::make_shared<XYFourierFilterCurve::FilterResult>();
+	job.setCalculation(
+		[data = filterData, x, y, result](XYAnalysisCurveJob& job) {
+			return fourierFilter(data, x, y, job.xData, job.yData, *result, &job);
+		},
+		[this, result]() {
+			filterResult = *result;
+		});
+	return true;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
@@ -22,6 +22,7 @@ public:
 	explicit XYFourierFilterCurvePrivate(XYFourierFilterCurve*);
 	~XYFourierFilterCurvePrivate() override;
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	bool prepareAsyncRecalculation(XYAnalysisCurveJob&, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
 	virtual void resetResults() override;
 
 	XYFourierFilterCurve::FilterData filterData;
@@ -16,6 +16,7 @@
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/macros.h"
+#include "backend/timeseriesanalysis/SpectralAnalysis.h"
 
 extern "C" {
 #include "backend/nsl/nsl_sf_poly.h"
@@ -85,7 +86,18 @@ void XYFourierTransformCurvePrivate::resetResults() {
 	transformResult = XYFourierTransformCurve::TransformResult();
 }
 
-bool XYFourierTransformCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+/*!
+ * calculates the Fourier transform of the data in \c tmpXDataColumn and \c tmpYDataColumn
+ * and writes the result into \c xVector and \c yVector.
+ * Called in the worker thread for the asynchronous recalculation with \c job being set.
+ */
+static bool fourierTransform(const XYFourierTransformCurve::TransformData& transformData,
+							 const AbstractColumn* tmpXDataColumn,
+							 const AbstractColumn* tmpYDataColumn,
+							 QVector<double>& xVector,
+							 QVector<double>& yVector,
+							 XYFourierTransformCurve::TransformResult& transformResult,
+							 XYAnalysisCurveJob* job = nullptr) {
 	QElapsedTimer timer;
 	timer.start();
 
@@ -95,8 +107,8 @@ bool XYFourierTransformCurvePrivate::recalculateSpecific(const AbstractColumn* t
 	double xmin = transformData.xRange.first();
 	double xmax = transformData.xRange.last();
 	if (transformData.autoRange) {
-		xmin = q->xDataColumn()->minimum();
-		xmax = q->xDataColumn()->maximum();
+		xmin = tmpXDataColumn->minimum();
+		xmax = tmpXDataColumn->maximum();
 	}
 
 	int rowCount = std::min(tmpXDataColumn->rowCount(), tmpYDataColumn->rowCount());
@@ -122,6 +134,13 @@ bool XYFourierTransformCurvePrivate::recalculateSpecific(const AbstractColumn* t
 		return true;
 	}
 
+	// the input data is prepared, stop here if the asynchronous recalculation was canceled
+	if (job) {
+		if (job->isCancelled())
+			return false;
+		job->setProgress(10);
+	}
+
 	double* xdata = xdataVector.data();
 	double* ydata = ydataVector.data();
 
@@ -185,16 +204,16 @@ bool XYFourierTransformCurvePrivate::recalculateSpecific(const AbstractColumn* t
 		out << ydata[i] << '(' << xdata[i] << ')';
 #endif
 
-	xVector->resize((int)N);
-	yVector->resize((int)N);
+	xVector.resize((int)N);
+	yVector.resize((int)N);
 	if (shifted) {
-		memcpy(xVector->data(), &xdata[n / 2], n / 2 * sizeof(double));
-		memcpy(&xVector->data()[n / 2], xdata, n / 2 * sizeof(double));
-		memcpy(yVector->data(), &ydata[n / 2], n / 2 * sizeof(double));
-		memcpy(&yVector->data()[n / 2], ydata, n / 2 * sizeof(double));
+		memcpy(xVector.data(), &xdata[n / 2], n / 2 * sizeof(double));
+		memcpy(&xVector.data()[n / 2], xdata, n / 2 * sizeof(double));
+		memcpy(yVector.data(), &ydata[n / 2], n / 2 * sizeof(double));
+		memcpy(&yVector.data()[n / 2], ydata, n / 2 * sizeof(double));
 	} else {
-		memcpy(xVector->data(), xdata, N * sizeof(double));
-		memcpy(yVector->data(), ydata, N * sizeof(double));
+		memcpy(xVector.data(), xdata, N * sizeof(double));
+		memcpy(yVector.data(), ydata, N * sizeof(double));
 	}
 	///////////////////////////////////////////////////////////
 
@@ -207,6 +226,87 @@ bool XYFourierTransformCurvePrivate::recalculateSpecific(const AbstractColumn* t
 	return true;
 }
 
+/*!
+ * calculates the power spectral density of the data in \c tmpXDataColumn and \c tmpYDataColumn with Welch's method.
+ * The data is read segment by segment directly from the columns, the memory doesn't depend on the length of the signal.
+ */
+static bool welchTransform(const XYFourierTransformCurve::TransformData& transformData,
+						   const AbstractColumn* tmpXDataColumn,
+						   const AbstractColumn* tmpYDataColumn,
+						   QVector<double>& xVector,
+						   QVector<double>& yVector,
+						   XYFourierTransformCurve::TransformResult& transformResult) {
+	QElapsedTimer timer;
+	timer.start();
+
+	SpectralAnalysis::Options options;
+	options.segmentLength = transformData.segmentLength;
+	options.overlap = transformData.overlap;
+	options.windowType = transformData.windowType;
+	if (!transformData.autoRange) {
+		options.xMin = transformData.xRange.first();
+		options.xMax = transformData.xRange.last();
+	}
+
+	SpectralAnalysis::Info info;
+	if (!SpectralAnalysis::welch(tmpXDataColumn, tmpYDataColumn, options, yVector, info)) {
+		transformResult.available = true;
+		transformResult.valid = false;
+		transformResult.status = i18n("No data points available.");
+		return true;
+	}
+
+	const int N = yVector.size();
+	const double df = info.samplingRate / info.segmentLength; // frequency resolution
+	xVector.resize(N);
+	for (int i = 0; i < N; i++) {
+		switch (transformData.xScale) {
+		case nsl_dft_xscale_frequency:
+			xVector[i] = i * df;
+			break;
+		case nsl_dft_xscale_index:
+			xVector[i] = i;
+			break;
+		case nsl_dft_xscale_period:
+			xVector[i] = 1. / ((i + 1) * df); // shifted by one bin as for the full transform
+			break;
+		}
+	}
+
+	transformResult.available = true;
+	transformResult.valid = true;
+	transformResult.status = i18n("Success, %1 segments", info.segments);
+	transformResult.elapsedTime = timer.elapsed();
+
+	return true;
+}
+
+bool XYFourierTransformCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	if (transformData.method == nsl_dft_method_welch)
+		return welchTransform(transformData, tmpXDataColumn, tmpYDataColumn, *xVector, *yVector, transformResult);
+
+	return fourierTransform(transformData, tmpXDataColumn, tmpYDataColumn, *xVector, *yVector, transformResult);
+}
+
+bool XYFourierTransformCurvePrivate::prepareAsyncRecalculation(XYAnalysisCurveJob& job, const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) {
+	// Welch's method streams over the source columns and parallelizes over the segments itself,
+	// a snapshot of the columns for the asynchronous recalculation would require a copy of the full signal
+	if (transformData.method == nsl_dft_method_welch)
+		return false;
+
+	const auto* x = job.snapshot(tmpXDataColumn);
+	const auto* y = job.snapshot(tmpYDataColumn);
+	auto result = std::make_shared<XYFourierTransformCurve::TransformResult>();
+	job.setCalculation(
+		[data = transformData, x, y, result](XYAnalysisCurveJob& job) {
+			return fourierTransform(data, x, y, job.xData, job.yData, *result, &job);
+		},
+		[this, result]() {
+			transformResult = *result;
+		});
+	return true;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
@@ -230,6 +330,9 @@ void XYFourierTransformCurve::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("shifted"), QString::number(d->transformData.shifted));
 	writer->writeAttribute(QStringLiteral("xScale"), QString::number(d->transformData.xScale));
 	writer->writeAttribute(QStringLiteral("windowType"), QString::number(d->transformData.windowType));
+	writer->writeAttribute(QStringLiteral("method"), QString::number(d->transformData.method));
+	writer->writeAttribute(QStringLiteral("segmentLength"), QString::number(d->transformData.segmentLength));
+	writer->writeAttribute(QStringLiteral("overlap"), QString::number(d->transformData.overlap));
 	writer->writeEndElement(); // transformData
 
 	// transform results (generated columns)
@@ -277,6 +380,11 @@ bool XYFourierTransformCurve::load(XmlStreamReader* reader, bool preview) {
 			READ_INT_VALUE("shifted", transformData.shifted, bool);
 			READ_INT_VALUE("xScale", transformData.xScale, nsl_dft_xscale);
 			READ_INT_VALUE("windowType", transformData.windowType, nsl_sf_window_type);
+			if (attribs.hasAttribute(QStringLiteral("method"))) { // available since 3.0
+				READ_INT_VALUE("method", transformData.method, nsl_dft_method);
+				READ_INT_VALUE("segmentLength", transformData.segmentLength, int);
+				READ_DOUBLE_VALUE("overlap", transformData.overlap);
+			}
 		} else if (!preview && reader->name() == QLatin1String("transformResult")) {
 			attribs = reader->attributes();
 			READ_INT_VALUE("available", transformResult.available, int);
@@ -36,6 +36,9 @@ public:
 		bool shifted{false};
 		nsl_dft_xscale xScale{nsl_dft_xscale_frequency};
 		nsl_sf_window_type windowType{nsl_sf_window_uniform};
+		nsl_dft_method method{nsl_dft_method_full};
+		int segmentLength{1024}; // number of samples per segment for Welch's method
+		double overlap{0.5}; // overlap of the segments for Welch's method
 		bool autoRange{true}; // use all data?
 		// TODO: use Range
 		QVector<double> xRange{0, 0}; // x range for transform
@@ -156,6 +156,68 @@ bool XYIntegrationCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDa
 	return true;
 }
 
+/*!
+ * updates the cumulative integral for the rows appended to the live data source. Only the appended rows are integrated
+ * and added to the last value, for removed rows the integral is shifted to start at zero again.
+ * Only available for the rectangle and trapezoid rules having one result point per source point.
+ */
+bool XYIntegrationCurvePrivate::recalculateIncremental(const AbstractColumn* tmpXDataColumn,
+													   const AbstractColumn* tmpYDataColumn,
+													   int removedRows,
+													   int /* appendedRows */) {
+	const nsl_int_method_type method = integrationData.method;
+	if (!integrationResult.valid || (method != nsl_int_method_rectangle && method != nsl_int_method_trapezoid))
+		return false;
+
+	// every source row needs to have a result point
+	if (xVector->size() != sourceRowCount || sourceRowCount - removedRows < 2)
+		return false;
+
+	double xmin = -INFINITY;
+	double xmax = INFINITY;
+	if (!integrationData.autoRange) {
+		xmin = integrationData.xRange.first();
+		xmax = integrationData.xRange.last();
+	}
+
+	// integrate starting at the last row of the previous calculation
+	QVector<double> xdataVector;
+	QVector<double> ydataVector;
+	const int lastRow = sourceRowCount - removedRows - 1;
+	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax, false, lastRow);
+	const size_t n = (size_t)xdataVector.size();
+	if (n < 1 || xdataVector.constFirst() != xVector->constLast())
+		return false;
+
+	if (n > 1) {
+		int status = 0;
+		if (method == nsl_int_method_rectangle)
+			status = nsl_int_rectangle(xdataVector.constData(), ydataVector.data(), n, integrationData.absolute);
+		else
+			status = nsl_int_trapezoid(xdataVector.constData(), ydataVector.data(), n, integrationData.absolute);
+		if (status != 0)
+			return false;
+	}
+
+	// the integral starts at the first remaining point
+	if (removedRows > 0) {
+		xVector->remove(0, removedRows);
+		yVector->remove(0, removedRows);
+		const double offset = yVector->constFirst();
+		for (auto& value : *yVector)
+			value -= offset;
+	}
+
+	const double offset = yVector->constLast();
+	for (size_t i = 1; i < n; ++i) {
+		xVector->append(xdataVector.at(i));
+		yVector->append(ydataVector.at(i) + offset);
+	}
+
+	integrationResult.value = yVector->constLast();
+	return true;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
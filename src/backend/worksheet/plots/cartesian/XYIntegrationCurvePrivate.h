@@ -22,6 +22,7 @@ public:
 	~XYIntegrationCurvePrivate() override;
 
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	virtual bool recalculateIncremental(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn, int removedRows, int appendedRows) override;
 	virtual void resetResults() override;
 
 	XYIntegrationCurve::IntegrationData integrationData;
@@ -83,6 +83,7 @@ XYLineSimplificationCurvePrivate::~XYLineSimplificationCurvePrivate() = default;
 
 void XYLineSimplificationCurvePrivate::resetResults() {
 	lineSimplificationResult = XYLineSimplificationCurve::LineSimplificationResult();
+	anchorRow = -1;
 }
 
 const XYAnalysisCurve::Result& XYLineSimplificationCurvePrivate::result() const {
@@ -107,7 +108,9 @@ bool XYLineSimplificationCurvePrivate::recalculateSpecific(const AbstractColumn*
 		xmax = lineSimplificationData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	QVector<int> rows;
+	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax, false, 0, -1, &rows);
+	anchorRow = -1;
 
 	// number of data points to use
 	const size_t n = (size_t)xdataVector.size();
@@ -118,24 +121,129 @@ bool XYLineSimplificationCurvePrivate::recalculateSpecific(const AbstractColumn*
 		return true;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
+	const double* xdata = xdataVector.constData();
+	const double* ydata = ydataVector.constData();
 
-	// lineSimplification settings
+	DEBUG(Q_FUNC_INFO << ", n = " << n);
+	DEBUG(Q_FUNC_INFO << ", type: " << nsl_geom_linesim_type_name[lineSimplificationData.type]);
+	DEBUG(Q_FUNC_INFO << ", tolerance/step: " << lineSimplificationData.tolerance);
+	DEBUG(Q_FUNC_INFO << ", tolerance2/repeat/maxtol/region: " << lineSimplificationData.tolerance2);
+
+	///////////////////////////////////////////////////////////
+	double calcTolerance = 0; // calculated tolerance from Douglas-Peucker and Visvalingam-Whyatt variants
+	size_t* index = (size_t*)malloc(n * sizeof(size_t));
+	const size_t npoints = simplify(xdata, ydata, n, index, calcTolerance);
+
+	DEBUG(Q_FUNC_INFO << ", npoints = " << npoints);
+	DEBUG(Q_FUNC_INFO << ", calculated tolerance = " << calcTolerance)
+
+	xVector->resize((int)npoints);
+	yVector->resize((int)npoints);
+	for (int i = 0; i < (int)npoints; i++) {
+		(*xVector)[i] = xdata[index[i]];
+		(*yVector)[i] = ydata[index[i]];
+	}
+
+	headPosError = 0.;
+	headAreaError = 0.;
+	headPoints = 0;
+	if (npoints > 0)
+		updateErrors(xdata, ydata, n, index, npoints);
+	if (npoints > 1)
+		anchorRow = rows.at((int)index[npoints - 2]);
+
+	free(index);
+
+	///////////////////////////////////////////////////////////
+
+	// write the result
+	lineSimplificationResult.available = true;
+	lineSimplificationResult.valid = npoints > 0;
+	if (npoints > 0)
+		lineSimplificationResult.status = QStringLiteral("OK");
+	else
+		lineSimplificationResult.status = QStringLiteral("FAILURE");
+	lineSimplificationResult.elapsedTime = timer.elapsed();
+	lineSimplificationResult.npoints = npoints;
+
+	return true;
+}
+
+/*!
+ * updates the result after new rows were appended to the source data. The data starting at the last but one point
+ * of the previous result is simplified again and replaces the end of the result, the points before are kept.
+ * The result is not necessarily identical to the simplification of the whole data but fulfills the same tolerance.
+ */
+bool XYLineSimplificationCurvePrivate::recalculateIncremental(const AbstractColumn* tmpXDataColumn,
+															  const AbstractColumn* tmpYDataColumn,
+															  int removedRows,
+															  int /* appendedRows */) {
+	// the methods with a given number of points or with a step depend on the whole data
 	const nsl_geom_linesim_type type = lineSimplificationData.type;
+	if (!lineSimplificationResult.valid || removedRows > 0 || type == nsl_geom_linesim_type_douglas_peucker_variant
+		|| type == nsl_geom_linesim_type_visvalingam_whyatt_variant || type == nsl_geom_linesim_type_nthpoint || type == nsl_geom_linesim_type_lttb
+		|| type == nsl_geom_linesim_type_minmax_lttb)
+		return false;
+
+	const int npoints = xVector->size();
+	if (npoints < 2 || yVector->size() != npoints)
+		return false;
+
+	double xmin = -INFINITY;
+	double xmax = INFINITY;
+	if (!lineSimplificationData.autoRange) {
+		xmin = lineSimplificationData.xRange.first();
+		xmax = lineSimplificationData.xRange.last();
+	}
+
+	// the source points after the last but one point of the result are simplified again
+	if (anchorRow < 0)
+		return false;
+
+	QVector<double> xdataVector;
+	QVector<double> ydataVector;
+	QVector<int> rows;
+	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax, false, anchorRow, -1, &rows);
+	const size_t n = (size_t)xdataVector.size();
+	if (n < 3 || rows.constFirst() != anchorRow || xdataVector.constFirst() != xVector->at(npoints - 2) || ydataVector.constFirst() != yVector->at(npoints - 2))
+		return false;
+
+	const double* xdata = xdataVector.constData();
+	const double* ydata = ydataVector.constData();
+	double calcTolerance = 0;
+	size_t* index = (size_t*)malloc(n * sizeof(size_t));
+	const size_t tailPoints = simplify(xdata, ydata, n, index, calcTolerance);
+	if (tailPoints < 2) {
+		free(index);
+		return false;
+	}
+
+	// the first point of the new part is the anchor, replace the last point
+	xVector->resize(npoints - 1);
+	yVector->resize(npoints - 1);
+	for (size_t i = 1; i < tailPoints; i++) {
+		xVector->append(xdata[index[i]]);
+		yVector->append(ydata[index[i]]);
+	}
+
+	updateErrors(xdata, ydata, n, index, tailPoints);
+	anchorRow = rows.at((int)index[tailPoints - 2]);
+	free(index);
+
+	lineSimplificationResult.npoints = xVector->size();
+	return true;
+}
+
+/*!
+ * simplifies the \c n data points with the current settings, the indices of the remaining points are written to \c index.
+ * Returns the number of remaining points.
+ */
+size_t XYLineSimplificationCurvePrivate::simplify(const double* xdata, const double* ydata, size_t n, size_t* index, double& calcTolerance) const {
 	const double tol = lineSimplificationData.tolerance;
 	const double tol2 = lineSimplificationData.tolerance2;
 
-	DEBUG(Q_FUNC_INFO << ", n = " << n);
-	DEBUG(Q_FUNC_INFO << ", type: " << nsl_geom_linesim_type_name[type]);
-	DEBUG(Q_FUNC_INFO << ", tolerance/step: " << tol);
-	DEBUG(Q_FUNC_INFO << ", tolerance2/repeat/maxtol/region: " << tol2);
-
-	///////////////////////////////////////////////////////////
 	size_t npoints = 0;
-	double calcTolerance = 0; // calculated tolerance from Douglas-Peucker variant
-	size_t* index = (size_t*)malloc(n * sizeof(size_t));
-	switch (type) {
+	switch (lineSimplificationData.type) {
 	case nsl_geom_linesim_type_douglas_peucker_variant: // tol used as number of points
 		npoints = size_t(tol);
 		calcTolerance = nsl_geom_linesim_douglas_peucker_variant(xdata, ydata, n, npoints, index);
@@ -167,41 +275,38 @@ bool XYLineSimplificationCurvePrivate::recalculateSpecific(const AbstractColumn*
 	case nsl_geom_linesim_type_lang: // tol2 used as region
 		npoints = nsl_geom_linesim_lang(xdata, ydata, n, tol, tol2, index);
 		break;
+	case nsl_geom_linesim_type_visvalingam_whyatt_variant: // tol used as number of points
+		npoints = std::min(std::max(size_t(tol), size_t(2)), n);
+		calcTolerance = nsl_geom_linesim_visvalingam_whyatt_variant(xdata, ydata, n, npoints, index);
+		break;
+	case nsl_geom_linesim_type_lttb: // tol used as number of points
+		npoints = nsl_geom_linesim_lttb(xdata, ydata, n, std::max(size_t(tol), size_t(2)), index);
+		break;
+	case nsl_geom_linesim_type_minmax_lttb: // tol used as number of points, tol2 as preselection ratio
+		npoints = nsl_geom_linesim_minmax_lttb(xdata, ydata, n, std::max(size_t(tol), size_t(2)), size_t(tol2), index);
+		break;
 	}
 
-	DEBUG(Q_FUNC_INFO << ", npoints = " << npoints);
-	if (type == nsl_geom_linesim_type_douglas_peucker_variant) {
-		DEBUG(Q_FUNC_INFO << ", calculated tolerance = " << calcTolerance)
-	} else
-		Q_UNUSED(calcTolerance);
+	return npoints;
+}
 
-	xVector->resize((int)npoints);
-	yVector->resize((int)npoints);
-	for (int i = 0; i < (int)npoints; i++) {
-		(*xVector)[i] = xdata[index[i]];
-		(*yVector)[i] = ydata[index[i]];
+/*!
+ * calculates the errors of the result for the \c n data points following the points already contained in headPosError
+ * and headAreaError and adds the errors of the points before the last but one result point to them.
+ */
+void XYLineSimplificationCurvePrivate::updateErrors(const double* xdata, const double* ydata, size_t n, const size_t* index, size_t npoints) {
+	// the errors are averaged over the points, sum them up again
+	const double posError = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index) * n;
+	const double areaError = nsl_geom_linesim_area_error(xdata, ydata, n, index) * n;
+	lineSimplificationResult.posError = (headPosError + posError) / (headPoints + n);
+	lineSimplificationResult.areaError = (headAreaError + areaError) / (headPoints + n);
+
+	if (npoints > 2) {
+		const size_t anchor = index[npoints - 2];
+		headPosError += nsl_geom_linesim_positional_squared_error(xdata, ydata, anchor + 1, index) * (anchor + 1);
+		headAreaError += nsl_geom_linesim_area_error(xdata, ydata, anchor + 1, index) * (anchor + 1);
+		headPoints += anchor;
 	}
-
-	const double posError = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
-	const double areaError = nsl_geom_linesim_area_error(xdata, ydata, n, index);
-
-	free(index);
-
-	///////////////////////////////////////////////////////////
-
-	// write the result
-	lineSimplificationResult.available = true;
-	lineSimplificationResult.valid = npoints > 0;
-	if (npoints > 0)
-		lineSimplificationResult.status = QStringLiteral("OK");
-	else
-		lineSimplificationResult.status = QStringLiteral("FAILURE");
-	lineSimplificationResult.elapsedTime = timer.elapsed();
-	lineSimplificationResult.npoints = npoints;
-	lineSimplificationResult.posError = posError;
-	lineSimplificationResult.areaError = areaError;
-
-	return true;
 }
 
 // ##############################################################################
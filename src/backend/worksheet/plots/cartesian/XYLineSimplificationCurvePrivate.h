@@ -23,13 +23,25 @@ public:
 	~XYLineSimplificationCurvePrivate() override;
 
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	virtual bool recalculateIncremental(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn, int removedRows, int appendedRows) override;
 	virtual void resetResults() override;
 	const XYAnalysisCurve::Result& result() const;
 
 	XYLineSimplificationCurve::LineSimplificationData lineSimplificationData;
 	XYLineSimplificationCurve::LineSimplificationResult lineSimplificationResult;
 
+	// squared positional and area errors summed over the data points before the last but one point of the result
+	// and the number of these points, used to update the errors after new data was appended
+	double headPosError{0.};
+	double headAreaError{0.};
+	size_t headPoints{0};
+	int anchorRow{-1}; // source row of the last but one point of the result, the data after it is simplified again
+
 	XYLineSimplificationCurve* const q;
+
+private:
+	size_t simplify(const double* xdata, const double* ydata, size_t n, size_t* index, double& calcTolerance) const;
+	void updateErrors(const double* xdata, const double* ydata, size_t n, const size_t* index, size_t npoints);
 };
 
 #endif
@@ -13,12 +13,18 @@
 #include "backend/core/column/Column.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
+#include "backend/lib/trace.h"
 
 #include <KLocalizedString>
 
 #include <QElapsedTimer>
 #include <QIcon>
+#include <QThread>
 #include <QThreadPool>
+#include <QtConcurrentMap>
+
+#include <numeric>
+#include <vector>
 
 extern "C" {
 #include "backend/nsl/nsl_sf_kernel.h"
@@ -144,51 +150,16 @@ bool XYSmoothCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataCol
 	double* ydataOriginal = new double[n];
 	memcpy(ydataOriginal, ydata, n * sizeof(double));
 
-	// smooth settings
-	const nsl_smooth_type type = smoothData.type;
-	const size_t points = smoothData.points;
-	const nsl_smooth_weight_type weight = smoothData.weight;
-	const double percentile = smoothData.percentile;
-	const int order = smoothData.order;
-	const nsl_smooth_pad_mode padMode = smoothData.mode;
-	const double lvalue = smoothData.lvalue;
-	const double rvalue = smoothData.rvalue;
-
-	DEBUG("	smooth type:" << nsl_smooth_type_name[type]);
-	DEBUG("	points = " << points);
-	DEBUG("	weight: " << nsl_smooth_weight_type_name[weight]);
-	DEBUG("	percentile = " << percentile);
-	DEBUG("	order = " << order);
-	DEBUG("	pad mode =	" << nsl_smooth_pad_mode_name[padMode]);
-	DEBUG("	const. values = " << lvalue << ' ' << rvalue);
+	DEBUG("	smooth type:" << nsl_smooth_type_name[smoothData.type]);
+	DEBUG("	points = " << smoothData.points);
+	DEBUG("	weight: " << nsl_smooth_weight_type_name[smoothData.weight]);
+	DEBUG("	percentile = " << smoothData.percentile);
+	DEBUG("	order = " << smoothData.order);
+	DEBUG("	pad mode =	" << nsl_smooth_pad_mode_name[smoothData.mode]);
+	DEBUG("	const. values = " << smoothData.lvalue << ' ' << smoothData.rvalue);
 
 	///////////////////////////////////////////////////////////
-	int status = 0;
-	gsl_set_error_handler_off();
-
-	switch (type) {
-	case nsl_smooth_type_moving_average:
-		status = nsl_smooth_moving_average(ydata, n, points, weight, padMode);
-		break;
-	case nsl_smooth_type_moving_average_lagged:
-		status = nsl_smooth_moving_average_lagged(ydata, n, points, weight, padMode);
-		break;
-	case nsl_smooth_type_percentile:
-		status = nsl_smooth_percentile(ydata, n, points, percentile, padMode);
-		break;
-	case nsl_smooth_type_savitzky_golay:
-		if (padMode == nsl_smooth_pad_constant)
-			nsl_smooth_pad_constant_set(lvalue, rvalue);
-		status = nsl_smooth_savgol(ydata, n, points, order, padMode);
-		break;
-	case nsl_smooth_type_lowess: {
-		const double span = smoothData.span;
-		const double delta = smoothData.delta;
-		const int iterations = smoothData.iterations;
-		status = nsl_smooth_lowess(xdata, ydata, n, span, delta, iterations);
-		break;
-	}
-	}
+	const int status = smooth(xdata, ydata, n);
 
 	xVector->resize((int)n);
 	yVector->resize((int)n);
@@ -215,6 +186,131 @@ bool XYSmoothCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataCol
 	return true;
 }
 
+/*!
+ * updates the smoothed data for the rows appended to the live data source. Apart from LOWESS, every smoothed point
+ * depends only on the neighbouring points within the window and only the points at the borders of the data are recalculated.
+ */
+bool XYSmoothCurvePrivate::recalculateIncremental(const AbstractColumn* tmpXDataColumn,
+												  const AbstractColumn* tmpYDataColumn,
+												  int removedRows,
+												  int /* appendedRows */) {
+	if (!smoothResult.valid || smoothData.type == nsl_smooth_type_lowess || !roughVector || roughVector->size() != yVector->size())
+		return false;
+
+	// the periodic padding uses the values at the other end of the data (see smoothInBlocks()):
+	// the appended rows change the result at the beginning and the new end can't be smoothed on its own
+	if (smoothData.mode == nsl_smooth_pad_periodic)
+		return false;
+
+	double xmin = -INFINITY;
+	double xmax = INFINITY;
+	if (!smoothData.autoRange) {
+		xmin = smoothData.xRange.first();
+		xmax = smoothData.xRange.last();
+	}
+
+	// the window and the padding at the borders cover at most the number of points used for the smoothing
+	const int margin = (int)smoothData.points + 1;
+	QVector<double> roughTail;
+	QVector<double> roughHead;
+	const bool rc = updateLocalResult(tmpXDataColumn, tmpYDataColumn, removedRows, xmin, xmax, margin, false, [&](QVector<double>& x, QVector<double>& y) {
+		const auto original = y;
+		if (smooth(x.constData(), y.data(), x.size()) != 0)
+			return false;
+
+		// rough values of the recalculated points, the first call is for the end of the data
+		auto& rough = roughTail.isEmpty() ? roughTail : roughHead;
+		rough.resize(y.size());
+		for (int i = 0; i < y.size(); ++i)
+			rough[i] = original.at(i) - y.at(i);
+		return true;
+	});
+
+	if (!rc)
+		return false;
+
+	// update the rough values for the same points as the smoothed values, see updateLocalResult()
+	const int tailStart = sourceRowCount - removedRows - 2 * margin;
+	roughVector->remove(0, removedRows);
+	roughVector->resize(tailStart + margin);
+	roughVector->append(roughTail.mid(margin));
+	if (removedRows > 0)
+		std::copy(roughHead.cbegin(), roughHead.cbegin() + margin, roughVector->begin());
+	roughColumn->setChanged();
+
+	return true;
+}
+
+/*!
+ * smoothes \c ydata in place with the current smooth settings, returns the status of the calculation.
+ */
+int XYSmoothCurvePrivate::smooth(const double* xdata, double* ydata, size_t n) const {
+	const size_t points = smoothData.points;
+	const nsl_smooth_pad_mode padMode = smoothData.mode;
+	// the values for the constant padding are passed explicitly, the curves and the blocks are smoothed concurrently
+	const double lvalue = smoothData.lvalue;
+	const double rvalue = smoothData.rvalue;
+
+	gsl_set_error_handler_off();
+
+	switch (smoothData.type) {
+	case nsl_smooth_type_moving_average:
+		return smoothInBlocks(ydata, n, points, points, [&](double* data, size_t size) {
+			return nsl_smooth_moving_average_padded(data, size, points, smoothData.weight, padMode, lvalue, rvalue);
+		});
+	case nsl_smooth_type_moving_average_lagged:
+		return smoothInBlocks(ydata, n, points, 0, [&](double* data, size_t size) {
+			return nsl_smooth_moving_average_lagged_padded(data, size, points, smoothData.weight, padMode, lvalue);
+		});
+	case nsl_smooth_type_percentile:
+		return smoothInBlocks(ydata, n, points, points, [&](double* data, size_t size) {
+			return nsl_smooth_percentile_padded(data, size, points, smoothData.percentile, padMode, lvalue, rvalue);
+		});
+	case nsl_smooth_type_savitzky_golay:
+		return nsl_smooth_savgol_padded(ydata, n, points, smoothData.order, padMode, lvalue, rvalue);
+	case nsl_smooth_type_lowess:
+		return nsl_smooth_lowess(xdata, ydata, n, smoothData.span, smoothData.delta, smoothData.iterations);
+	}
+
+	return 0;
+}
+
+/*!
+ * applies the moving window smoother \c smooth to \c ydata. Large data sets are split into blocks that are smoothed in parallel,
+ * the blocks overlap by \c leftMargin points on the left and \c rightMargin points on the right side so that the windows
+ * of all points of a block are complete and the result doesn't depend on the block borders.
+ */
+int XYSmoothCurvePrivate::smoothInBlocks(double* ydata, size_t n, size_t leftMargin, size_t rightMargin, const std::function<int(double*, size_t)>& smooth) const {
+	const size_t blockCount = std::max(1, QThread::idealThreadCount());
+	const size_t blockSize = (n + blockCount - 1) / blockCount;
+	// the periodic padding uses the values at the other end of the data
+	if (n < minParallelSmoothSize || blockCount == 1 || smoothData.mode == nsl_smooth_pad_periodic || blockSize < 4 * std::max(leftMargin, rightMargin))
+		return smooth(ydata, n);
+
+	PERFTRACE(QStringLiteral("smoothing in parallel blocks"));
+	std::vector<std::vector<double>> blocks(blockCount);
+	std::vector<int> status(blockCount, 0);
+	QVector<int> indices(blockCount);
+	std::iota(indices.begin(), indices.end(), 0);
+	QtConcurrent::blockingMap(indices, [&](int i) {
+		const size_t start = i * blockSize, end = std::min(n, start + blockSize);
+		if (start >= end)
+			return;
+		const size_t first = start > leftMargin ? start - leftMargin : 0, last = std::min(n, end + rightMargin);
+		std::vector<double> block(ydata + first, ydata + last);
+		status[i] = smooth(block.data(), block.size());
+		blocks[i].assign(block.cbegin() + (start - first), block.cbegin() + (end - first));
+	});
+
+	for (size_t i = 0; i < blockCount; ++i) {
+		if (status.at(i) != 0)
+			return status.at(i);
+		std::copy(blocks.at(i).cbegin(), blocks.at(i).cend(), ydata + i * blockSize);
+	}
+
+	return 0;
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
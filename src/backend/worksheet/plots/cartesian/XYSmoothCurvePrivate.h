@@ -14,6 +14,8 @@
 #include "backend/worksheet/plots/cartesian/XYAnalysisCurvePrivate.h"
 #include "backend/worksheet/plots/cartesian/XYSmoothCurve.h"
 
+#include <functional>
+
 class XYSmoothCurve;
 class Column;
 
@@ -23,7 +25,13 @@ public:
 	~XYSmoothCurvePrivate() override;
 
 	virtual bool recalculateSpecific(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn) override;
+	virtual bool recalculateIncremental(const AbstractColumn* tmpXDataColumn, const AbstractColumn* tmpYDataColumn, int removedRows, int appendedRows) override;
 	virtual void resetResults() override;
+	int smooth(const double* xdata, double* ydata, size_t n) const;
+	int smoothInBlocks(double* ydata, size_t n, size_t leftMargin, size_t rightMargin, const std::function<int(double*, size_t)>& smooth) const;
+
+	// minimal number of points for the moving window smoothers to run in parallel on blocks of the data
+	static constexpr size_t minParallelSmoothSize = 1000000;
 
 	XYSmoothCurve::SmoothData smoothData;
 	XYSmoothCurve::SmoothResult smoothResult;
@@ -275,6 +275,7 @@ void configureCLI(QCommandLineParser& parser) {
 	parser.addOption(QCommandLineOption(CLI_TITLE, i18n("Set the plot title."), i18n("text")));
 	parser.addOption(QCommandLineOption(CLI_XLABEL, i18n("Set the X-axis label."), i18n("text")));
 	parser.addOption(QCommandLineOption(CLI_YLABEL, i18n("Set the Y-axis label."), i18n("text")));
+	parser.addOption(QCommandLineOption(CLI_TRACE, i18n("Record a performance trace and write it in the Chrome trace format to the file at exit."), i18n("file")));
 	parser.addPositionalArgument(QStringLiteral("+[file]"), i18n("Input project file or data file to open."));
 }
 
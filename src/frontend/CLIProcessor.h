@@ -45,6 +45,7 @@ static const QString CLI_XLABEL = QStringLiteral("xlabel");
 static const QString CLI_YLABEL = QStringLiteral("ylabel");
 static const QString CLI_NO_SPLASH = QStringLiteral("no-splash");
 static const QString CLI_PRESENTER = QStringLiteral("presenter");
+static const QString CLI_TRACE = QStringLiteral("trace");
 
 void configureCLI(QCommandLineParser&);
 bool isHeadlessMode(const QCommandLineParser&);
@@ -12,6 +12,8 @@
 #include "backend/core/AbstractColumn.h"
 #include "backend/core/Settings.h"
 #include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+#include "backend/nsl/nsl_fft.h"
 #include "frontend/AboutDialog.h"
 #include "frontend/CLIProcessor.h"
 
@@ -40,6 +42,16 @@
 #include <windows.h>
 #endif
 
+static QString fftWisdomFile() {
+	return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/fftw_wisdom");
+}
+
+// save the FFTW plans measured in this session for the next start
+static void exportFFTWisdom() {
+	QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+	nsl_fft_export_wisdom(qPrintable(fftWisdomFile()));
+}
+
 int main(int argc, char* argv[]) {
 	// trigger initialisation of proper icon theme
 	KIconTheme::initTheme();
@@ -102,6 +114,10 @@ int main(int argc, char* argv[]) {
 	enableDebugTrace(group.readEntry<bool>(QLatin1String("DebugTrace"), false));
 	enablePerfTrace(group.readEntry<bool>(QLatin1String("PerfTrace"), false));
 
+	// record the performance trace for the export in the Chrome trace format, written to the file at exit
+	if (qEnvironmentVariableIsSet("LABPLOT_TRACE"))
+		PerfTrace::startRecording(qEnvironmentVariable("LABPLOT_TRACE"));
+
 #ifdef _WIN32
 	// enable debugging on console
 	if (AttachConsole(ATTACH_PARENT_PROCESS)) {
@@ -124,6 +140,18 @@ int main(int argc, char* argv[]) {
 	parser.process(app);
 	aboutData.processCommandLine(&parser);
 
+	if (parser.isSet(CLI_TRACE))
+		PerfTrace::startRecording(parser.value(CLI_TRACE));
+	if (PerfTrace::isRecording())
+		qAddPostRoutine(PerfTrace::finish);
+
+	// measure the FFT plans (slower planning, faster transforms) and reuse them via the saved wisdom
+	if (group.readEntry<bool>(QLatin1String("FFTWMeasure"), false)) {
+		nsl_fft_set_planner_mode(nsl_fft_planner_measure);
+		nsl_fft_import_wisdom(qPrintable(fftWisdomFile()));
+		qAddPostRoutine(exportFFTWisdom);
+	}
+
 	// check if we should run in headless mode (CLI-only, no GUI)
 	if (isHeadlessMode(parser))
 		return processCLI(parser); // exit with its return code of the processor in the headless mode
@@ -12,6 +12,7 @@
 #include "backend/core/AbstractFilter.h"
 #include "backend/core/AspectTreeModel.h"
 #include "backend/core/Project.h"
+#include "backend/core/ProjectDataContainer.h"
 #include "backend/core/Settings.h"
 #include "backend/core/Workbook.h"
 #include "backend/datasources/DatasetHandler.h"
@@ -75,6 +76,7 @@
 #include <QMenu>
 #include <QMimeData>
 #include <QStackedWidget>
+#include <QScopeGuard>
 #include <QStatusBar>
 #include <QTemporaryFile>
 #include "backend/lib/UndoStack.h"
@@ -800,6 +802,12 @@ bool MainWin::openProject(const QString& fileName) {
 	bool rc = false;
 	if (Project::isLabPlotProject(fileName)) {
 		WAIT_CURSOR_AUTO_RESET;
+		// worksheets that are not shown after the load are retransformed when they're shown for the first time
+		// only while loading, worksheets added or loaded later are retransformed as usual
+		m_project->setDeferWorksheetRetransform(true);
+		const auto resetDeferRetransform = qScopeGuard([this] {
+			m_project->setDeferWorksheetRetransform(false);
+		});
 		rc = m_project->load(fileName);
 	}
 #ifdef HAVE_LIBORIGIN
@@ -1031,8 +1039,12 @@ bool MainWin::save(const QString& fileName) {
 	tempFile.close();
 
 	QIODevice* file;
-	// if file ending is .lml, do xz compression or gzip compression in compatibility mode
-	if (fileName.endsWith(QLatin1String(".lml"))) {
+	// if file ending is .lml, do xz compression or gzip compression in compatibility mode.
+	// with a separate binary data section, the container format compresses the data itself.
+	const bool binaryData = fileName.endsWith(QLatin1String(".lml")) && m_project->saveBinaryData();
+	if (binaryData)
+		file = new QFile(tempFileName);
+	else if (fileName.endsWith(QLatin1String(".lml"))) {
 		if (m_project->fileCompression())
 			file = new KCompressionDevice(tempFileName, KCompressionDevice::Xz);
 		else
@@ -1086,18 +1098,32 @@ bool MainWin::save(const QString& fileName) {
 
 		m_project->setFileName(fileName);
 
-		QXmlStreamWriter writer(file);
-		m_project->save(thumbnail, &writer);
-		m_project->setChanged(false);
-		undoStackIndexLastSave = m_project->undoStack()->index();
+		bool rc = true;
+		if (binaryData) {
+			ProjectDataWriter dataWriter(file, m_project->fileCompression());
+			rc = m_project->save(thumbnail, &dataWriter);
+		} else {
+			QXmlStreamWriter writer(file);
+			m_project->save(thumbnail, &writer);
+		}
+		if (rc) {
+			m_project->setChanged(false);
+			undoStackIndexLastSave = m_project->undoStack()->index();
+		}
 		file->close();
 
-		// target file must not exist
-		if (QFile::exists(fileName))
-			QFile::remove(fileName);
+		// the column data that is still pending in the loaded project file is read into memory before the file is replaced
+		if (rc)
+			rc = m_project->releaseDataFile();
+
+		if (rc) {
+			// target file must not exist
+			if (QFile::exists(fileName))
+				QFile::remove(fileName);
 
-		// do not rename temp file. Qt still holds a handle (which fails renaming on Windows) and deletes it
-		bool rc = QFile::copy(tempFileName, fileName);
+			// do not rename temp file. Qt still holds a handle (which fails renaming on Windows) and deletes it
+			rc = QFile::copy(tempFileName, fileName);
+		}
 		if (rc) {
 			updateTitleBar();
 			statusBar()->showMessage(i18n("Project saved"));
@@ -27,6 +27,10 @@ SettingsGeneralPage::SettingsGeneralPage(QWidget* parent, const QLocale& locale)
 	KLocalization::setupSpinBoxFormatString(ui.sbAutoSaveInterval, ki18nc("@label:spinbox Suffix for the auto save interval", "%v min"));
 #ifdef NDEBUG
 	ui.chkDebugTrace->setVisible(false);
+#endif
+#ifndef HAVE_FFTW3
+	ui.lFFTWMeasure->setVisible(false);
+	ui.chkFFTWMeasure->setVisible(false);
 #endif
 	retranslateUi();
 
@@ -48,9 +52,11 @@ SettingsGeneralPage::SettingsGeneralPage(QWidget* parent, const QLocale& locale)
 	connect(ui.chkSaveCalculations, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkCompressed, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkSaveData, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
+	connect(ui.chkSaveBinaryData, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkInfoTrace, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkDebugTrace, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkPerfTrace, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
+	connect(ui.chkFFTWMeasure, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 
 #ifdef HAVE_CANTOR_LIBS
 	for (auto* backend : Cantor::Backend::availableBackends()) {
@@ -118,6 +124,7 @@ QList<Settings::Type> SettingsGeneralPage::applySettings() {
 	group.writeEntry(QLatin1String("SaveCalculations"), ui.chkSaveCalculations->isChecked());
 	group.writeEntry(QLatin1String("Compressed"), ui.chkCompressed->isChecked());
 	group.writeEntry(QLatin1String("SaveData"), ui.chkSaveData->isChecked());
+	group.writeEntry(QLatin1String("SaveBinaryData"), ui.chkSaveBinaryData->isChecked());
 	const bool infoTraceEnabled = ui.chkInfoTrace->isChecked();
 	group.writeEntry(QLatin1String("InfoTrace"), infoTraceEnabled);
 	enableInfoTrace(infoTraceEnabled);
@@ -127,6 +134,7 @@ QList<Settings::Type> SettingsGeneralPage::applySettings() {
 	const bool perfTraceEnabled = ui.chkPerfTrace->isChecked();
 	group.writeEntry(QLatin1String("PerfTrace"), perfTraceEnabled);
 	enablePerfTrace(perfTraceEnabled);
+	group.writeEntry(QLatin1String("FFTWMeasure"), ui.chkFFTWMeasure->isChecked()); // evaluated on startup only
 
 	Settings::writeDockPosBehavior(static_cast<Settings::DockPosBehavior>(ui.cbDockWindowPositionReopen->currentData().toInt()));
 
@@ -150,9 +158,11 @@ void SettingsGeneralPage::restoreDefaults() {
 	ui.chkSaveDockStates->setChecked(false);
 	ui.chkSaveCalculations->setChecked(true);
 	ui.chkCompressed->setChecked(false);
+	ui.chkSaveBinaryData->setChecked(false);
 	ui.chkInfoTrace->setChecked(false);
 	ui.chkDebugTrace->setChecked(false);
 	ui.chkPerfTrace->setChecked(false);
+	ui.chkFFTWMeasure->setChecked(false);
 	ui.cbDockWindowPositionReopen->setCurrentIndex(ui.cbDockWindowPositionReopen->findData(static_cast<int>(Settings::DockPosBehavior::AboveLastActive)));
 }
 
@@ -204,9 +214,11 @@ void SettingsGeneralPage::loadSettings() {
 	ui.chkSaveData->setChecked(group.readEntry<bool>(QLatin1String("SaveData"), true));
 	ui.chkSaveCalculations->setChecked(group.readEntry<bool>(QLatin1String("SaveCalculations"), true));
 	ui.chkCompressed->setChecked(group.readEntry<bool>(QLatin1String("Compressed"), !group.readEntry("CompatibleSave", false)));
+	ui.chkSaveBinaryData->setChecked(group.readEntry<bool>(QLatin1String("SaveBinaryData"), false));
 	ui.chkInfoTrace->setChecked(group.readEntry<bool>(QLatin1String("InfoTrace"), false));
 	ui.chkDebugTrace->setChecked(group.readEntry<bool>(QLatin1String("DebugTrace"), false));
 	ui.chkPerfTrace->setChecked(group.readEntry<bool>(QLatin1String("PerfTrace"), false));
+	ui.chkFFTWMeasure->setChecked(group.readEntry<bool>(QLatin1String("FFTWMeasure"), false));
 
 	m_changed = false;
 }
@@ -289,9 +301,23 @@ void SettingsGeneralPage::retranslateUi() {
 	ui.chkDebugTrace->setToolTip(i18n("Debug trace - helpful to diagnose the application, can have a negative impact on the performance."));
 	ui.chkPerfTrace->setToolTip(i18n("Performance trace - helpful to analyze performance relevant aspects and bottlenecks."));
 
+	msg = i18n(
+		"Let FFTW measure the fastest algorithm for every transform size. \n"
+		"The first transform of a new size becomes slower, repeated transforms of the same size become faster. \n"
+		"The measured plans are stored and reused in the next sessions. \n"
+		"The change is applied after restarting the application.");
+	ui.lFFTWMeasure->setToolTip(msg);
+	ui.chkFFTWMeasure->setToolTip(msg);
+
 	const auto saveDataToolTip = i18n("If enabled spreadsheet and matrix data is saved in the project file");
 	ui.lSaveData->setToolTip(saveDataToolTip);
 	ui.chkSaveData->setToolTip(saveDataToolTip);
+
+	const auto binaryDataToolTip = i18n(
+		"If enabled, the data of the columns is saved in a separate compressed binary section of the project file and is only loaded when accessed.\n"
+		"This speeds up saving and opening of large projects, but such project files cannot be opened with older versions of LabPlot.");
+	ui.lSaveBinaryData->setToolTip(binaryDataToolTip);
+	ui.chkSaveBinaryData->setToolTip(binaryDataToolTip);
 }
 
 void SettingsGeneralPage::loadOnStartChanged() {
@@ -51,8 +51,11 @@ SettingsWorksheetPage::SettingsWorksheetPage(QWidget* parent)
 	connect(ui.cbPreviewThumbnailSize, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsWorksheetPage::changed);
 	connect(ui.chkPresenterModeInteractive, &QCheckBox::toggled, this, &SettingsWorksheetPage::changed);
 	connect(ui.chkDoubleBuffering, &QCheckBox::toggled, this, &SettingsWorksheetPage::changed);
+	connect(ui.chkDoubleBuffering, &QCheckBox::toggled, ui.chkAsyncRendering, &QCheckBox::setEnabled);
+	connect(ui.chkAsyncRendering, &QCheckBox::toggled, this, &SettingsWorksheetPage::changed);
 	connect(ui.cbTexEngine, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsWorksheetPage::changed);
 	connect(ui.cbTexEngine, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsWorksheetPage::checkTeX);
+	connect(ui.pbClearTexCache, &QPushButton::clicked, this, &TeXRenderer::clearCache);
 
 	loadSettings();
 }
@@ -72,6 +75,7 @@ QList<Settings::Type> SettingsWorksheetPage::applySettings() {
 	group.writeEntry(QLatin1String("PreviewThumbnailSize"), ui.cbPreviewThumbnailSize->currentData().toInt());
 	group.writeEntry(QLatin1String("PresenterModeInteractive"), ui.chkPresenterModeInteractive->isChecked());
 	group.writeEntry(QLatin1String("DoubleBuffering"), ui.chkDoubleBuffering->isChecked());
+	group.writeEntry(QLatin1String("AsyncRendering"), ui.chkAsyncRendering->isChecked());
 	group.writeEntry(QLatin1String("LaTeXEngine"), ui.cbTexEngine->itemData(ui.cbTexEngine->currentIndex()));
 
 	changes << Settings::Type::Worksheet;
@@ -82,6 +86,7 @@ void SettingsWorksheetPage::restoreDefaults() {
 	m_cbThemes->setItemText(0, i18n("Default")); // default theme
 	ui.chkPresenterModeInteractive->setChecked(false);
 	ui.chkDoubleBuffering->setChecked(true);
+	ui.chkAsyncRendering->setChecked(true);
 	ui.cbPreviewThumbnailSize->setCurrentIndex(1); // medium
 
 	int index = ui.cbTexEngine->findData(QLatin1String("xelatex"));
@@ -101,6 +106,8 @@ void SettingsWorksheetPage::loadSettings() {
 	m_cbThemes->setItemText(0, group.readEntry(QLatin1String("Theme"), ""));
 	ui.chkPresenterModeInteractive->setChecked(group.readEntry(QLatin1String("PresenterModeInteractive"), false));
 	ui.chkDoubleBuffering->setChecked(group.readEntry(QLatin1String("DoubleBuffering"), true));
+	ui.chkAsyncRendering->setChecked(group.readEntry(QLatin1String("AsyncRendering"), true));
+	ui.chkAsyncRendering->setEnabled(ui.chkDoubleBuffering->isChecked());
 
 	int index = ui.cbPreviewThumbnailSize->findData(group.readEntry(QLatin1String("PreviewThumbnailSize"), 3));
 	if (index != -1)
@@ -14,6 +14,10 @@
 
 #include <KConfigGroup>
 
+#include <QComboBox>
+#include <QHeaderView>
+#include <QSpinBox>
+
 /*!
 	\class BinaryOptionsWidget
 	\brief Widget providing options for the import of binary data
@@ -47,6 +51,97 @@ BinaryOptionsWidget::BinaryOptionsWidget(QWidget* parent)
 	ui.lByteOrder->setWhatsThis(textByteOrder);
 	ui.cbByteOrder->setToolTip(textByteOrderShort);
 	ui.cbByteOrder->setWhatsThis(textByteOrder);
+
+	// record layout
+	ui.twFields->setColumnCount(3);
+	ui.twFields->setHorizontalHeaderLabels({i18n("Data Type"), i18n("Offset"), i18n("Byte Order")});
+	ui.twFields->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+	ui.twFields->verticalHeader()->setVisible(false);
+	ui.tbAddField->setIcon(QIcon::fromTheme(QStringLiteral("list-add")));
+	ui.tbRemoveField->setIcon(QIcon::fromTheme(QStringLiteral("list-remove")));
+	ui.tbAddField->setToolTip(i18n("Add field"));
+	ui.tbRemoveField->setToolTip(i18n("Remove the selected field"));
+
+	const QString textRecordLayout = i18n(
+		"The records in the file consist of fields with different data types and byte orders at arbitrary offsets (in bytes) in the record. "
+		"Every field is imported into one column.");
+	ui.chbRecordLayout->setToolTip(textRecordLayout);
+	ui.chbRecordLayout->setWhatsThis(textRecordLayout);
+	ui.twFields->setToolTip(textRecordLayout);
+
+	const QString textRecordSize = i18n("Size of the records in bytes including the padding after the last field, 0 - the end of the last field.");
+	ui.lRecordSize->setToolTip(textRecordSize);
+	ui.sbRecordSize->setToolTip(textRecordSize);
+
+	connect(ui.chbRecordLayout, &QCheckBox::toggled, this, &BinaryOptionsWidget::recordLayoutChanged);
+	connect(ui.tbAddField, &QToolButton::clicked, this, &BinaryOptionsWidget::addFieldClicked);
+	connect(ui.tbRemoveField, &QToolButton::clicked, this, &BinaryOptionsWidget::removeFieldClicked);
+	recordLayoutChanged(false);
+}
+
+/*!
+ * appends a field to the record layout.
+ */
+void BinaryOptionsWidget::addField(BinaryFilter::DataType type, int offset, QDataStream::ByteOrder byteOrder) const {
+	const int row = ui.twFields->rowCount();
+	ui.twFields->insertRow(row);
+
+	auto* cbType = new QComboBox(ui.twFields);
+	cbType->addItems(BinaryFilter::dataTypes());
+	cbType->setCurrentIndex(static_cast<int>(type));
+	ui.twFields->setCellWidget(row, 0, cbType);
+
+	auto* sbOffset = new QSpinBox(ui.twFields);
+	sbOffset->setMaximum(std::numeric_limits<int>::max());
+	sbOffset->setValue(offset);
+	ui.twFields->setCellWidget(row, 1, sbOffset);
+
+	auto* cbByteOrder = new QComboBox(ui.twFields);
+	cbByteOrder->addItem(i18n("Little endian"), QDataStream::LittleEndian);
+	cbByteOrder->addItem(i18n("Big endian"), QDataStream::BigEndian);
+	cbByteOrder->setCurrentIndex(cbByteOrder->findData(byteOrder));
+	ui.twFields->setCellWidget(row, 2, cbByteOrder);
+}
+
+void BinaryOptionsWidget::addFieldClicked() {
+	// the new field follows the last field, with the data type and the byte order of the last field
+	auto type = static_cast<BinaryFilter::DataType>(ui.cbDataType->currentIndex());
+	auto byteOrder = static_cast<QDataStream::ByteOrder>(ui.cbByteOrder->currentData().toInt());
+	int offset = 0;
+	const int rows = ui.twFields->rowCount();
+	if (rows > 0) {
+		type = static_cast<BinaryFilter::DataType>(static_cast<QComboBox*>(ui.twFields->cellWidget(rows - 1, 0))->currentIndex());
+		offset = static_cast<QSpinBox*>(ui.twFields->cellWidget(rows - 1, 1))->value() + BinaryFilter::dataSize(type);
+		byteOrder = static_cast<QDataStream::ByteOrder>(static_cast<QComboBox*>(ui.twFields->cellWidget(rows - 1, 2))->currentData().toInt());
+	}
+
+	addField(type, offset, byteOrder);
+}
+
+void BinaryOptionsWidget::removeFieldClicked() {
+	const int row = ui.twFields->currentRow();
+	if (row != -1)
+		ui.twFields->removeRow(row);
+}
+
+/*!
+ * the settings for the vectors of values of one data type are not used if the record layout is defined.
+ */
+void BinaryOptionsWidget::recordLayoutChanged(bool enabled) const {
+	ui.lVectors->setEnabled(!enabled);
+	ui.niVectors->setEnabled(!enabled);
+	ui.lDataType->setEnabled(!enabled);
+	ui.cbDataType->setEnabled(!enabled);
+	ui.lByteOrder->setEnabled(!enabled);
+	ui.cbByteOrder->setEnabled(!enabled);
+	ui.lSkipBytes->setEnabled(!enabled);
+	ui.sbSkipBytes->setEnabled(!enabled);
+
+	ui.twFields->setVisible(enabled);
+	ui.tbAddField->setVisible(enabled);
+	ui.tbRemoveField->setVisible(enabled);
+	ui.lRecordSize->setVisible(enabled);
+	ui.sbRecordSize->setVisible(enabled);
 }
 
 void BinaryOptionsWidget::applyFilterSettings(BinaryFilter* filter) const {
@@ -58,6 +153,18 @@ void BinaryOptionsWidget::applyFilterSettings(BinaryFilter* filter) const {
 	filter->setSkipBytes(ui.sbSkipBytes->value());
 	filter->setSkipStartBytes(ui.sbSkipStartBytes->value());
 	filter->setCreateIndexEnabled(ui.chbCreateIndex->isChecked());
+
+	QVector<BinaryFilter::Field> fields;
+	if (ui.chbRecordLayout->isChecked()) {
+		for (int row = 0; row < ui.twFields->rowCount(); ++row) {
+			BinaryFilter::Field field;
+			field.type = static_cast<BinaryFilter::DataType>(static_cast<QComboBox*>(ui.twFields->cellWidget(row, 0))->currentIndex());
+			field.offset = static_cast<QSpinBox*>(ui.twFields->cellWidget(row, 1))->value();
+			field.byteOrder = static_cast<QDataStream::ByteOrder>(static_cast<QComboBox*>(ui.twFields->cellWidget(row, 2))->currentData().toInt());
+			fields << field;
+		}
+	}
+	filter->setRecordLayout(fields, fields.isEmpty() ? 0 : ui.sbRecordSize->value());
 }
 
 void BinaryOptionsWidget::loadSettings() const {
@@ -79,6 +186,20 @@ void BinaryOptionsWidget::loadConfigFromTemplate(KConfig& config) const {
 	ui.sbSkipStartBytes->setValue(group.readEntry("SkipStartBytes", 0));
 	ui.sbSkipBytes->setValue(group.readEntry("SkipBytes", 0));
 	ui.chbCreateIndex->setChecked(group.readEntry("CreateIndex", false));
+
+	// record layout, every field is stored as "data type,offset,byte order"
+	ui.twFields->setRowCount(0);
+	const auto& fields = group.readEntry("RecordFields", QStringList());
+	for (const auto& field : fields) {
+		const auto& values = field.split(QLatin1Char(','));
+		if (values.size() != 3)
+			continue;
+		addField(static_cast<BinaryFilter::DataType>(values.at(0).toInt()),
+				 values.at(1).toInt(),
+				 static_cast<QDataStream::ByteOrder>(values.at(2).toInt()));
+	}
+	ui.sbRecordSize->setValue(group.readEntry("RecordSize", 0));
+	ui.chbRecordLayout->setChecked(group.readEntry("RecordLayout", false));
 }
 
 void BinaryOptionsWidget::saveConfigAsTemplate(KConfig& config) const {
@@ -90,4 +211,15 @@ void BinaryOptionsWidget::saveConfigAsTemplate(KConfig& config) const {
 	group.writeEntry("SkipStartBytes", ui.sbSkipStartBytes->value());
 	group.writeEntry("SkipBytes", ui.sbSkipBytes->value());
 	group.writeEntry("CreateIndex", ui.chbCreateIndex->isChecked());
+
+	QStringList fields;
+	for (int row = 0; row < ui.twFields->rowCount(); ++row) {
+		fields << QStringLiteral("%1,%2,%3")
+					  .arg(static_cast<QComboBox*>(ui.twFields->cellWidget(row, 0))->currentIndex())
+					  .arg(static_cast<QSpinBox*>(ui.twFields->cellWidget(row, 1))->value())
+					  .arg(static_cast<QComboBox*>(ui.twFields->cellWidget(row, 2))->currentData().toInt());
+	}
+	group.writeEntry("RecordLayout", ui.chbRecordLayout->isChecked());
+	group.writeEntry("RecordFields", fields);
+	group.writeEntry("RecordSize", ui.sbRecordSize->value());
 }
@@ -11,9 +11,9 @@
 #ifndef BINARYOPTIONSWIDGET_H
 #define BINARYOPTIONSWIDGET_H
 
+#include "backend/datasources/filters/BinaryFilter.h"
 #include "ui_binaryoptionswidget.h"
 
-class BinaryFilter;
 class KConfig;
 
 class BinaryOptionsWidget : public QWidget {
@@ -31,6 +31,13 @@ public:
 
 private:
 	Ui::BinaryOptionsWidget ui;
+
+	void addField(BinaryFilter::DataType, int offset, QDataStream::ByteOrder) const;
+
+private Q_SLOTS:
+	void recordLayoutChanged(bool) const;
+	void addFieldClicked();
+	void removeFieldClicked();
 };
 
 #endif
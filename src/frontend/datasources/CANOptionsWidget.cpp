@@ -12,8 +12,7 @@ CANOptionsWidget::CANOptionsWidget(QWidget* parent)
 
 	ui->cbImportMode->addItem(i18n("Use NAN"), (int)VectorBLFFilter::TimeHandling::ConcatNAN);
 	ui->cbImportMode->addItem(i18n("Use previous value"), (int)VectorBLFFilter::TimeHandling::ConcatPrevious);
-	// Not yet implemented
-	// ui->cbImportMode->addItem(i18n("Separate time columns"), (int)VectorBLFFilter::TimeHandling::Separate);
+	ui->cbImportMode->addItem(i18n("Separate time columns"), (int)VectorBLFFilter::TimeHandling::Separate);
 
 	loadSettings();
 }
@@ -33,6 +33,7 @@ ProjectDock::ProjectDock(QWidget* parent)
 	connect(ui.chkSaveCalculations, &QCheckBox::toggled, this, &ProjectDock::saveCalculationsChanged);
 	connect(ui.chkCompressFile, &QCheckBox::toggled, this, &ProjectDock::compressFileChanged);
 	connect(ui.chkSaveData, &QCheckBox::toggled, this, &ProjectDock::saveDataChanged);
+	connect(ui.chkSaveBinaryData, &QCheckBox::toggled, this, &ProjectDock::saveBinaryDataChanged);
 }
 
 void ProjectDock::setProject(Project* project) {
@@ -55,6 +56,7 @@ void ProjectDock::setProject(Project* project) {
 
 	ui.chkCompressFile->setChecked(project->fileCompression());
 	ui.chkSaveData->setChecked(project->saveData());
+	ui.chkSaveBinaryData->setChecked(project->saveBinaryData());
 
 	// resize the height of the comment field to fit the content (word wrap is ignored)
 	const double height = ui.teComment->document()->size().height() + ui.teComment->contentsMargins().top() * 2;
@@ -80,6 +82,12 @@ void ProjectDock::retranslateUi() {
 		"Uncheck this option to reduce the size of the project file at costs of the longer project load times.");
 	ui.lSaveCalculations->setToolTip(msg);
 	ui.chkSaveCalculations->setToolTip(msg);
+
+	msg = i18n(
+		"If checked, the data of the columns is saved in a separate compressed binary section of the project file and is only loaded when accessed.\n"
+		"This speeds up saving and opening of large projects, but such project files cannot be opened with older versions of LabPlot.");
+	ui.lSaveBinaryData->setToolTip(msg);
+	ui.chkSaveBinaryData->setToolTip(msg);
 }
 
 //************************************************************
@@ -110,6 +118,11 @@ void ProjectDock::saveDataChanged(bool save) {
 	m_project->setSaveData(save);
 }
 
+void ProjectDock::saveBinaryDataChanged(bool binary) {
+	CONDITIONAL_LOCK_RETURN;
+	m_project->setSaveBinaryData(binary);
+}
+
 //*************************************************************
 //******** SLOTs for changes triggered in Project   ***********
 //*************************************************************
@@ -35,6 +35,7 @@ private Q_SLOTS:
 	void saveCalculationsChanged(bool);
 	void compressFileChanged(bool);
 	void saveDataChanged(bool);
+	void saveBinaryDataChanged(bool);
 
 	// SLOTs for changes triggered in Project
 	void projectAuthorChanged(const QString&);
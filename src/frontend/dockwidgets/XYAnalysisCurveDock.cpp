@@ -24,6 +24,12 @@ XYAnalysisCurveDock::XYAnalysisCurveDock(QWidget* parent, RequiredDataSource req
  * show the result and details of the transform
  */
 void XYAnalysisCurveDock::showResult(const XYAnalysisCurve* curve, QTextEdit* teResult) {
+	m_teResult = teResult;
+	if (curve->isRecalculating()) {
+		teResult->setText(i18n("status: %1", i18n("calculating...")));
+		return;
+	}
+
 	const auto& result = curve->result();
 	if (!result.available) {
 		teResult->clear();
@@ -114,6 +120,9 @@ void XYAnalysisCurveDock::setAnalysisCurves(const QList<XYCurve*>& curves) {
 			m_cbAutoRecalculate->blockSignals(false);
 		}
 		connect(m_analysisCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYAnalysisCurveDock::curveAutoRecalculateChanged);
+		connect(m_analysisCurve, &XYAnalysisCurve::recalculationStarted, this, &XYAnalysisCurveDock::curveRecalculationStarted);
+		connect(m_analysisCurve, &XYAnalysisCurve::recalculationProgress, this, &XYAnalysisCurveDock::curveRecalculationProgress);
+		connect(m_analysisCurve, &XYAnalysisCurve::recalculationFinished, this, &XYAnalysisCurveDock::curveRecalculationFinished);
 	}
 
 	setModel();
@@ -296,3 +305,29 @@ void XYAnalysisCurveDock::curveAutoRecalculateChanged(bool value) {
 		m_cbAutoRecalculate->setChecked(value);
 	m_recalculateButton->setEnabled(!value);
 }
+
+/*!
+ * clears the status of the previous result while the curve is recalculated in the background.
+ */
+void XYAnalysisCurveDock::curveRecalculationStarted() {
+	Q_EMIT info(QString());
+	if (m_teResult)
+		m_teResult->setText(i18n("status: %1", i18n("calculating (%1%)", 0)));
+}
+
+void XYAnalysisCurveDock::curveRecalculationProgress(int progress) {
+	if (m_teResult)
+		m_teResult->setText(i18n("status: %1", i18n("calculating (%1%)", progress)));
+}
+
+/*!
+ * shows the results once the asynchronous recalculation of the curve is finished.
+ */
+void XYAnalysisCurveDock::curveRecalculationFinished() {
+	if (!m_analysisCurve)
+		return;
+
+	if (m_teResult)
+		showResult(m_analysisCurve, m_teResult);
+	Q_EMIT info(i18n("status: %1", m_analysisCurve->result().status));
+}
@@ -49,6 +49,7 @@ protected:
 	TreeViewComboBox* cbXDataColumn{nullptr};
 	TreeViewComboBox* cbYDataColumn{nullptr};
 	TreeViewComboBox* cbY2DataColumn{nullptr};
+	QTextEdit* m_teResult{nullptr};
 
 protected Q_SLOTS:
 	// SLOTs for changes triggered in the dock
@@ -65,6 +66,9 @@ protected Q_SLOTS:
 	void curveXDataColumnChanged(const AbstractColumn*);
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationStarted();
+	void curveRecalculationProgress(int);
+	void curveRecalculationFinished();
 };
 
 #endif // XYANALYSISCURVEDOCK_H
@@ -295,11 +295,17 @@ void XYBaselineCorrectionCurveDock::xRangeMaxDateTimeChanged(qint64 value) {
 
 void XYBaselineCorrectionCurveDock::recalculateClicked() {
 	CONDITIONAL_LOCK_RETURN;
-	for (auto* curve : m_curvesList)
-		static_cast<XYBaselineCorrectionCurve*>(curve)->setBaselineData(m_data);
+	for (auto* curve : m_curvesList) {
+		// large data sets are recalculated in the background, the result is shown when finished
+		auto* baselineCorrectionCurve = static_cast<XYBaselineCorrectionCurve*>(curve);
+		const XYAnalysisCurve::AsyncRecalculation async(baselineCorrectionCurve);
+		baselineCorrectionCurve->setBaselineData(m_data);
+	}
 
 	uiGeneralTab.pbRecalculate->setEnabled(false);
-	Q_EMIT info(i18n("Baseline correction status: %1", m_baselineCurve->baselineResult().status));
+	// the status of a recalculation running in the background is shown once it's finished
+	if (!m_baselineCurve->isRecalculating())
+		Q_EMIT info(i18n("Baseline correction status: %1", m_baselineCurve->baselineResult().status));
 }
 
 void XYBaselineCorrectionCurveDock::methodChanged(int index) {
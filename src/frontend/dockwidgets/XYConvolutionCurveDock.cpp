@@ -354,10 +354,17 @@ void XYConvolutionCurveDock::wrapChanged() {
 
 void XYConvolutionCurveDock::recalculateClicked() {
 	CONDITIONAL_LOCK_RETURN;
-	for (auto* curve : m_curvesList)
-		static_cast<XYConvolutionCurve*>(curve)->setConvolutionData(m_convolutionData);
+	for (auto* curve : m_curvesList) {
+		// large data sets are recalculated in the background, the result is shown when finished
+		auto* convolutionCurve = static_cast<XYConvolutionCurve*>(curve);
+		const XYAnalysisCurve::AsyncRecalculation async(convolutionCurve);
+		convolutionCurve->setConvolutionData(m_convolutionData);
+	}
 
 	uiGeneralTab.pbRecalculate->setEnabled(false);
+	// the status of a recalculation running in the background is shown once it's finished
+	if (m_convolutionCurve->isRecalculating())
+		return;
 	if (m_convolutionData.direction == nsl_conv_direction_forward)
 		Q_EMIT info(i18n("Convolution status: %1", m_convolutionCurve->convolutionResult().status));
 	else
@@ -268,11 +268,17 @@ void XYCorrelationCurveDock::normChanged() {
 
 void XYCorrelationCurveDock::recalculateClicked() {
 	CONDITIONAL_LOCK_RETURN;
-	for (auto* curve : m_curvesList)
-		static_cast<XYCorrelationCurve*>(curve)->setCorrelationData(m_correlationData);
+	for (auto* curve : m_curvesList) {
+		// large data sets are recalculated in the background, the result is shown when finished
+		auto* correlationCurve = static_cast<XYCorrelationCurve*>(curve);
+		const XYAnalysisCurve::AsyncRecalculation async(correlationCurve);
+		correlationCurve->setCorrelationData(m_correlationData);
+	}
 
 	uiGeneralTab.pbRecalculate->setEnabled(false);
-	Q_EMIT info(i18n("Correlation status: %1", m_correlationCurve->correlationResult().status));
+	// the status of a recalculation running in the background is shown once it's finished
+	if (!m_correlationCurve->isRecalculating())
+		Q_EMIT info(i18n("Correlation status: %1", m_correlationCurve->correlationResult().status));
 }
 
 /*!
@@ -143,9 +143,22 @@ void XYCurveDock::setupGeneral() {
 	cbYColumn = new TreeViewComboBox(generalTab);
 	gridLayout->addWidget(cbYColumn, 5, 2, 1, 1);
 
+	uiGeneralTab.cbDownsampling->addItem(i18n("None"));
+	uiGeneralTab.cbDownsampling->addItem(i18n("LTTB"));
+	uiGeneralTab.cbDownsampling->addItem(i18n("MinMaxLTTB"));
+	QString info = i18n("Reduce the number of points shown with symbols, values and drop lines to two points per pixel of the plot width:"
+						"<ul>"
+						"<li>LTTB - Largest-Triangle-Three-Buckets, keeps the points forming the largest triangles with their neighbours</li>"
+						"<li>MinMaxLTTB - LTTB on the minima and maxima of a preselection, faster for very large data sets</li>"
+						"</ul>"
+						"The line is always drawn for all points.");
+	uiGeneralTab.lDownsampling->setToolTip(info);
+	uiGeneralTab.cbDownsampling->setToolTip(info);
+
 	// General
 	connect(cbXColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYCurveDock::xColumnChanged);
 	connect(cbYColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYCurveDock::yColumnChanged);
+	connect(uiGeneralTab.cbDownsampling, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYCurveDock::downsamplingChanged);
 }
 
 void XYCurveDock::init() {
@@ -386,6 +399,7 @@ void XYCurveDock::initGeneralTab() {
 	cbXColumn->setEnabled(!m_curve->isFixed()); // don't allow to modify for internal/fixed curves
 	cbYColumn->setAspect(m_curve->yColumn(), m_curve->yColumnPath());
 	cbYColumn->setEnabled(!m_curve->isFixed());
+	uiGeneralTab.cbDownsampling->setCurrentIndex(static_cast<int>(m_curve->downsampling()));
 	uiGeneralTab.chkLegendVisible->setChecked(m_curve->legendVisible());
 	uiGeneralTab.chkVisible->setChecked(m_curve->isVisible());
 
@@ -394,6 +408,7 @@ void XYCurveDock::initGeneralTab() {
 	// Slots
 	connect(m_curve, &XYCurve::xColumnChanged, this, &XYCurveDock::curveXColumnChanged);
 	connect(m_curve, &XYCurve::yColumnChanged, this, &XYCurveDock::curveYColumnChanged);
+	connect(m_curve, &XYCurve::downsamplingChanged, this, &XYCurveDock::curveDownsamplingChanged);
 }
 
 void XYCurveDock::initTabs() {
@@ -496,6 +511,13 @@ void XYCurveDock::yColumnChanged(const QModelIndex& index) {
 		curve->setYColumn(column);
 }
 
+void XYCurveDock::downsamplingChanged(int index) {
+	CONDITIONAL_LOCK_RETURN;
+	const auto downsampling = static_cast<XYCurve::Downsampling>(index);
+	for (auto* curve : m_curvesList)
+		curve->setDownsampling(downsampling);
+}
+
 // "Line"-tab
 void XYCurveDock::lineTypeChanged(int index) {
 	const auto lineType = XYCurve::LineType(index);
@@ -618,6 +640,11 @@ void XYCurveDock::curveYColumnChanged(const AbstractColumn* column) {
 	cbYColumn->setAspect(column, m_curve->yColumnPath());
 }
 
+void XYCurveDock::curveDownsamplingChanged(XYCurve::Downsampling downsampling) {
+	CONDITIONAL_LOCK_RETURN;
+	uiGeneralTab.cbDownsampling->setCurrentIndex(static_cast<int>(downsampling));
+}
+
 // Line-Tab
 void XYCurveDock::curveLineTypeChanged(XYCurve::LineType type) {
 	CONDITIONAL_LOCK_RETURN;
@@ -72,6 +72,7 @@ private Q_SLOTS:
 	// SLOTs for changes triggered in XYCurveDock
 	void xColumnChanged(const QModelIndex&);
 	void yColumnChanged(const QModelIndex&);
+	void downsamplingChanged(int);
 
 	// Line-Tab
 	void lineTypeChanged(int);
@@ -91,6 +92,7 @@ private Q_SLOTS:
 	void curveDescriptionChanged(const AbstractAspect*);
 	void curveXColumnChanged(const AbstractColumn*);
 	void curveYColumnChanged(const AbstractColumn*);
+	void curveDownsamplingChanged(XYCurve::Downsampling);
 
 	// Line-Tab
 	void curveLineTypeChanged(XYCurve::LineType);
@@ -418,11 +418,17 @@ void XYFourierFilterCurveDock::recalculateClicked() {
 		return;
 	}
 
-	for (auto* curve : m_curvesList)
-		static_cast<XYFourierFilterCurve*>(curve)->setFilterData(m_filterData);
+	for (auto* curve : m_curvesList) {
+		// large data sets are recalculated in the background, the result is shown when finished
+		auto* fourierFilterCurve = static_cast<XYFourierFilterCurve*>(curve);
+		const XYAnalysisCurve::AsyncRecalculation async(fourierFilterCurve);
+		fourierFilterCurve->setFilterData(m_filterData);
+	}
 
 	uiGeneralTab.pbRecalculate->setEnabled(false);
-	Q_EMIT info(i18n("Fourier-Filter status: %1", m_filterCurve->filterResult().status));
+	// the status of a recalculation running in the background is shown once it's finished
+	if (!m_filterCurve->isRecalculating())
+		Q_EMIT info(i18n("Fourier-Filter status: %1", m_filterCurve->filterResult().status));
 }
 
 /*!
@@ -54,6 +54,9 @@ void XYFourierTransformCurveDock::setupGeneral() {
 	connect(uiGeneralTab.cbAutoRange, &QCheckBox::clicked, this, &XYFourierTransformCurveDock::autoRangeChanged);
 	connect(uiGeneralTab.leMin, &QLineEdit::textChanged, this, &XYFourierTransformCurveDock::xRangeMinChanged);
 	connect(uiGeneralTab.leMax, &QLineEdit::textChanged, this, &XYFourierTransformCurveDock::xRangeMaxChanged);
+	connect(uiGeneralTab.cbMethod, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYFourierTransformCurveDock::methodChanged);
+	connect(uiGeneralTab.sbSegmentLength, QOverload<int>::of(&QSpinBox::valueChanged), this, &XYFourierTransformCurveDock::segmentLengthChanged);
+	connect(uiGeneralTab.sbOverlap, QOverload<int>::of(&QSpinBox::valueChanged), this, &XYFourierTransformCurveDock::overlapChanged);
 	connect(uiGeneralTab.cbWindowType, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYFourierTransformCurveDock::windowTypeChanged);
 	connect(uiGeneralTab.cbType, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYFourierTransformCurveDock::typeChanged);
 	connect(uiGeneralTab.cbTwoSided, &QCheckBox::toggled, this, &XYFourierTransformCurveDock::twoSidedChanged);
@@ -75,6 +78,9 @@ void XYFourierTransformCurveDock::initGeneralTab() {
 	uiGeneralTab.leMax->setText(numberLocale.toString(m_transformData.xRange.last()));
 	this->autoRangeChanged();
 
+	uiGeneralTab.cbMethod->setCurrentIndex(m_transformData.method);
+	uiGeneralTab.sbSegmentLength->setValue(m_transformData.segmentLength);
+	uiGeneralTab.sbOverlap->setValue(qRound(m_transformData.overlap * 100.));
 	uiGeneralTab.cbWindowType->setCurrentIndex(m_transformData.windowType);
 	this->windowTypeChanged();
 	uiGeneralTab.cbType->setCurrentIndex(m_transformData.type);
@@ -85,6 +91,7 @@ void XYFourierTransformCurveDock::initGeneralTab() {
 	this->shiftedChanged();
 	uiGeneralTab.cbXScale->setCurrentIndex(m_transformData.xScale);
 	this->xScaleChanged();
+	this->methodChanged(); // enable/disable the widgets not relevant for the method
 	this->showTransformResult();
 
 	// enable the "recalculate"-button if the source data was changed since the last transform
@@ -171,6 +178,34 @@ void XYFourierTransformCurveDock::xRangeMaxChanged() {
 	SET_DOUBLE_FROM_LE_REC(m_transformData.xRange.last(), uiGeneralTab.leMax);
 }
 
+void XYFourierTransformCurveDock::methodChanged() {
+	const auto method = (nsl_dft_method)uiGeneralTab.cbMethod->currentIndex();
+	m_transformData.method = method;
+
+	// Welch's method always calculates the one-sided power spectral density
+	const bool welch = (method == nsl_dft_method_welch);
+	uiGeneralTab.lSegmentLength->setVisible(welch);
+	uiGeneralTab.sbSegmentLength->setVisible(welch);
+	uiGeneralTab.lOverlap->setVisible(welch);
+	uiGeneralTab.sbOverlap->setVisible(welch);
+	uiGeneralTab.lType->setEnabled(!welch);
+	uiGeneralTab.cbType->setEnabled(!welch);
+	uiGeneralTab.cbTwoSided->setEnabled(!welch);
+	uiGeneralTab.cbShifted->setEnabled(!welch && uiGeneralTab.cbTwoSided->isChecked());
+
+	enableRecalculate();
+}
+
+void XYFourierTransformCurveDock::segmentLengthChanged(int value) {
+	m_transformData.segmentLength = value;
+	enableRecalculate();
+}
+
+void XYFourierTransformCurveDock::overlapChanged(int value) {
+	m_transformData.overlap = value / 100.;
+	enableRecalculate();
+}
+
 void XYFourierTransformCurveDock::windowTypeChanged() {
 	auto windowType = (nsl_sf_window_type)uiGeneralTab.cbWindowType->currentIndex();
 	m_transformData.windowType = windowType;
@@ -215,11 +250,17 @@ void XYFourierTransformCurveDock::xScaleChanged() {
 
 void XYFourierTransformCurveDock::recalculateClicked() {
 	CONDITIONAL_LOCK_RETURN;
-	for (auto* curve : m_curvesList)
-		static_cast<XYFourierTransformCurve*>(curve)->setTransformData(m_transformData);
+	for (auto* curve : m_curvesList) {
+		// large data sets are recalculated in the background, the result is shown when finished
+		auto* fourierTransformCurve = static_cast<XYFourierTransformCurve*>(curve);
+		const XYAnalysisCurve::AsyncRecalculation async(fourierTransformCurve);
+		fourierTransformCurve->setTransformData(m_transformData);
+	}
 
 	uiGeneralTab.pbRecalculate->setEnabled(false);
-	Q_EMIT info(i18n("Fourier transformation status: %1", m_transformCurve->result().status));
+	// the status of a recalculation running in the background is shown once it's finished
+	if (!m_transformCurve->isRecalculating())
+		Q_EMIT info(i18n("Fourier transformation status: %1", m_transformCurve->result().status));
 }
 
 /*!
@@ -245,6 +286,10 @@ void XYFourierTransformCurveDock::curveTransformDataChanged(const XYFourierTrans
 void XYFourierTransformCurveDock::retranslateUi() {
 	XYAnalysisCurveDock::retranslateUi();
 
+	uiGeneralTab.cbMethod->clear();
+	for (int i = 0; i < NSL_DFT_METHOD_COUNT; i++)
+		uiGeneralTab.cbMethod->addItem(i18n(nsl_dft_method_name[i]));
+
 	uiGeneralTab.cbWindowType->clear();
 	for (int i = 0; i < NSL_SF_WINDOW_TYPE_COUNT; i++)
 		uiGeneralTab.cbWindowType->addItem(i18n(nsl_sf_window_type_name[i]));
@@ -39,6 +39,9 @@ private Q_SLOTS:
 	void autoRangeChanged();
 	void xRangeMinChanged();
 	void xRangeMaxChanged();
+	void methodChanged();
+	void segmentLengthChanged(int);
+	void overlapChanged(int);
 	void windowTypeChanged();
 	void typeChanged();
 	void twoSidedChanged();
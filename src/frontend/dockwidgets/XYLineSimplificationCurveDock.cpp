@@ -174,7 +174,6 @@ void XYLineSimplificationCurveDock::retranslateUi() {
 	uiGeneralTab.cbMethod->clear();
 	for (int i = 0; i < NSL_GEOM_LINESIM_TYPE_COUNT; ++i)
 		uiGeneralTab.cbMethod->addItem(i18n(nsl_geom_linesim_type_name[i]));
-	uiGeneralTab.cbMethod->setItemData(nsl_geom_linesim_type_visvalingam_whyatt, i18n("This method is much slower than any other"), Qt::ToolTipRole);
 
 	// tooltip texts
 	// note for the i18n-team: some algorithm are named after their creators like Douglas and Peucker, Visvalingam and Whyatt, Opheim, Lang
@@ -182,6 +181,9 @@ void XYLineSimplificationCurveDock::retranslateUi() {
 		"<ul>"
 		"<li>Douglas-Peucker - recursively divides the line and retains only those points that deviate more than a specified threshold from the line segment between the start and end points.</li>"
 		"<li>Visvalingam-Whyatt - iteratively removes the point that contributes the least effective area to the polygon's shape until a desired number of points or area threshold is reached.</li>"
+		"<li>Douglas-Peucker (Number), Visvalingam-Whyatt (Number) - keep the given number of the most significant points.</li>"
+		"<li>Largest-Triangle-Three-Buckets (Number) - divides the data into buckets with the same number of points and keeps the point of every bucket forming the largest triangle with the neighbouring buckets.</li>"
+		"<li>MinMaxLTTB (Number) - applies Largest-Triangle-Three-Buckets to the minimum and maximum points of smaller buckets only, much faster for large data sets.</li>"
 		"<li>Perpendicular Distance - measures the perpendicular distance of each point from a reference line and retains only those exceeding a threshold.</li>"
 		"<li>n-th Point - keeps every n-th point only.</li>"
 		"<li>Radial Distance - measures the distance of each point from the previous retained point and retains only those exceeding a threshold.</li>"
@@ -219,9 +221,17 @@ void XYLineSimplificationCurveDock::updateOptionsTexts() {
 		uiGeneralTab.sbTolerance->setToolTip(i18n("Maximum perpendicular distance from the line segment"));
 		break;
 	case nsl_geom_linesim_type_douglas_peucker_variant:
+	case nsl_geom_linesim_type_visvalingam_whyatt_variant:
+	case nsl_geom_linesim_type_lttb:
 		uiGeneralTab.lOption->setText(i18n("Number of points:"));
 		uiGeneralTab.sbTolerance->setToolTip(i18n("Target number of points in the simplified line"));
 		break;
+	case nsl_geom_linesim_type_minmax_lttb:
+		uiGeneralTab.lOption->setText(i18n("Number of points:"));
+		uiGeneralTab.lOption2->setText(i18n("Preselection ratio:"));
+		uiGeneralTab.sbTolerance->setToolTip(i18n("Target number of points in the simplified line"));
+		uiGeneralTab.sbTolerance2->setToolTip(i18n("Number of minimum and maximum points preselected per target point"));
+		break;
 	case nsl_geom_linesim_type_nthpoint:
 		uiGeneralTab.lOption->setText(i18n("Step size:"));
 		uiGeneralTab.sbTolerance->setToolTip(i18n("Keep every n-th point (n is the step size)"));
@@ -349,7 +359,8 @@ void XYLineSimplificationCurveDock::updateTolerance() {
 		m_lineSimplificationData.tolerance = 10. * nsl_geom_linesim_clip_diag_perpoint(xdataVector.data(), ydataVector.data(), (size_t)xdataVector.size());
 	else if (type == nsl_geom_linesim_type_visvalingam_whyatt)
 		m_lineSimplificationData.tolerance = 0.1 * nsl_geom_linesim_clip_area_perpoint(xdataVector.data(), ydataVector.data(), (size_t)xdataVector.size());
-	else if (type == nsl_geom_linesim_type_douglas_peucker_variant)
+	else if (type == nsl_geom_linesim_type_douglas_peucker_variant || type == nsl_geom_linesim_type_visvalingam_whyatt_variant
+			 || type == nsl_geom_linesim_type_lttb || type == nsl_geom_linesim_type_minmax_lttb)
 		m_lineSimplificationData.tolerance = xdataVector.size() / 10.; // reduction to 10%
 	else
 		m_lineSimplificationData.tolerance = 2. * nsl_geom_linesim_avg_dist_perpoint(xdataVector.data(), ydataVector.data(), xdataVector.size());
@@ -373,6 +384,8 @@ void XYLineSimplificationCurveDock::updateTolerance2() {
 		uiGeneralTab.sbTolerance2->setValue(5 * uiGeneralTab.sbTolerance->value());
 	else if (type == nsl_geom_linesim_type_lang)
 		uiGeneralTab.sbTolerance2->setValue(10);
+	else if (type == nsl_geom_linesim_type_minmax_lttb)
+		uiGeneralTab.sbTolerance2->setValue(4);
 }
 
 void XYLineSimplificationCurveDock::autoRangeChanged() {
@@ -451,6 +464,8 @@ void XYLineSimplificationCurveDock::methodChanged(int index) {
 			updateTolerance();
 		break;
 	case nsl_geom_linesim_type_douglas_peucker_variant:
+	case nsl_geom_linesim_type_visvalingam_whyatt_variant:
+	case nsl_geom_linesim_type_lttb:
 		uiGeneralTab.sbTolerance->setDecimals(0);
 		uiGeneralTab.sbTolerance->setMinimum(2);
 		uiGeneralTab.sbTolerance->setSingleStep(1);
@@ -509,6 +524,21 @@ void XYLineSimplificationCurveDock::methodChanged(int index) {
 		if (uiGeneralTab.chkAuto2->isChecked())
 			updateTolerance2();
 		break;
+	case nsl_geom_linesim_type_minmax_lttb: // number of points/preselection ratio
+		uiGeneralTab.sbTolerance->setDecimals(0);
+		uiGeneralTab.sbTolerance->setMinimum(2);
+		uiGeneralTab.sbTolerance->setSingleStep(1);
+		uiGeneralTab.lOption2->show();
+		uiGeneralTab.chkAuto2->show();
+		uiGeneralTab.sbTolerance2->show();
+		uiGeneralTab.sbTolerance2->setDecimals(0);
+		uiGeneralTab.sbTolerance2->setMinimum(1);
+		uiGeneralTab.sbTolerance2->setSingleStep(1);
+		if (uiGeneralTab.chkAuto->isChecked())
+			updateTolerance();
+		if (uiGeneralTab.chkAuto2->isChecked())
+			updateTolerance2();
+		break;
 	case nsl_geom_linesim_type_lang: // distance/region
 		uiGeneralTab.sbTolerance->setDecimals(6);
 		uiGeneralTab.sbTolerance->setMinimum(0);
@@ -24,7 +24,9 @@
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/StatisticsSpreadsheet.h"
 #include "backend/statistics/HypothesisTest.h"
+#include "backend/matrix/Matrix.h"
 #include "backend/timeseriesanalysis/SeasonalDecomposition.h"
+#include "backend/timeseriesanalysis/SpectralAnalysis.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include "frontend/spreadsheet/SpreadsheetHeaderView.h"
 
@@ -556,6 +558,7 @@ void SpreadsheetView::initActions() {
 
 	// time series analysis
 	tsaSeasonalDecompositionAction = new QAction(QIcon::fromTheme(QStringLiteral("preferences-system-time")), i18n("Seasonal Decomposition"), this);
+	tsaSpectrogramAction = new QAction(QIcon::fromTheme(QStringLiteral("labplot-xy-fourier-transform-curve")), i18n("Spectrogram"), this);
 
 	// statistical analysis
 	addHypothesisTestActionGroup = new QActionGroup(this);
@@ -638,6 +641,7 @@ void SpreadsheetView::initMenus() {
 	// time series analysis
 	m_timeSeriesAnalysisMenu = new QMenu(i18n("Time Series Analysis"), this);
 	m_timeSeriesAnalysisMenu->addAction(tsaSeasonalDecompositionAction);
+	m_timeSeriesAnalysisMenu->addAction(tsaSpectrogramAction);
 	m_columnMenu->addMenu(m_timeSeriesAnalysisMenu);
 
 	// column statistics releated actions
@@ -907,6 +911,7 @@ void SpreadsheetView::connectActions() {
 
 	// time series analysis
 	connect(tsaSeasonalDecompositionAction, &QAction::triggered, this, &SpreadsheetView::addSeasonalDecomposition);
+	connect(tsaSpectrogramAction, &QAction::triggered, this, &SpreadsheetView::addSpectrogram);
 
 	// statistical analysis
 	connect(addHypothesisTestActionGroup, &QActionGroup::triggered, [=, this](QAction* action) {
@@ -2374,6 +2379,48 @@ void SpreadsheetView::addSeasonalDecomposition() {
 	m_spreadsheet->parentAspect()->addChild(decomp);
 }
 
+/*!
+ * calculates the spectrogram of the first selected y-column and adds it as a new matrix to the project,
+ * the first selected x-column, if available, is used for the time axis.
+ */
+void SpreadsheetView::addSpectrogram() {
+	const auto& columns = selectedColumns(false);
+	if (columns.isEmpty())
+		return;
+
+	const AbstractColumn* colX{nullptr};
+	const AbstractColumn* colY{nullptr};
+	if (columns.size() == 1)
+		colY = columns.constFirst();
+	else {
+		for (auto* col : columns) {
+			if (!colX && col->plotDesignation() == AbstractColumn::PlotDesignation::X)
+				colX = col;
+			else if (!colY && col->plotDesignation() != AbstractColumn::PlotDesignation::X)
+				colY = col;
+		}
+	}
+
+	if (!colY || !colY->isNumeric())
+		return;
+
+	bool ok;
+	SpectralAnalysis::Options options;
+	options.segmentLength = QInputDialog::getInt(this, i18n("Spectrogram"), i18n("Segment length:"), options.segmentLength, 4, 1048576, 1, &ok);
+	if (!ok)
+		return;
+
+	WAIT_CURSOR;
+	auto* matrix = SpectralAnalysis::createSpectrogramMatrix(colX, colY, options);
+	RESET_CURSOR;
+	if (!matrix) {
+		KMessageBox::error(this, i18n("Not enough valid data points available to calculate the spectrogram."), i18n("Spectrogram"));
+		return;
+	}
+
+	m_spreadsheet->parentAspect()->addChild(matrix);
+}
+
 void SpreadsheetView::fillSelectedCellsWithRowNumbers() {
 	const auto& columns = selectedColumns(false);
 	if (columns.isEmpty())
@@ -227,6 +227,7 @@ private:
 
 	// time series analysis
 	QAction* tsaSeasonalDecompositionAction{nullptr};
+	QAction* tsaSpectrogramAction{nullptr};
 
 	// hypothesis testing
 	QActionGroup* addHypothesisTestActionGroup{nullptr};
@@ -307,6 +308,7 @@ private Q_SLOTS:
 	void plotDataDistributionFit(QAction*);
 
 	void addSeasonalDecomposition();
+	void addSpectrogram();
 
 	void fillSelectedCellsWithRowNumbers();
 	void fillSelectedCellsWithRandomNumbers();
@@ -73,6 +73,8 @@
 WorksheetView::WorksheetView(Worksheet* worksheet)
 	: QGraphicsView()
 	, m_worksheet(worksheet) {
+	// the elements were not retransformed after the project was loaded, do this before the worksheet is shown
+	m_worksheet->retransformDeferred();
 	setScene(m_worksheet->scene());
 
 	setRenderHint(QPainter::Antialiasing);
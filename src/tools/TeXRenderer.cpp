@@ -17,14 +17,22 @@
 #include <KConfigGroup>
 #include <KLocalizedString>
 
+#include <QCache>
 #include <QColor>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
 #include <QImage>
+#include <QMutex>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThreadPool>
+
+#include <mutex>
 
 #ifdef HAVE_POPPLER
 #include <poppler-qt6.h>
@@ -34,64 +42,68 @@
 	\class TeXRenderer
 	\brief Implements rendering of latex code to a PNG image.
 
-	Uses latex engine specified by the user (default xelatex) to render LaTeX text
+	Uses latex engine specified by the user (default xelatex) to render LaTeX text.
+
+	The rendered images are cached in memory and on disk, the key is the hash of the complete
+	LaTeX document (text, header, font, colors), of the engine and of the resolution, if relevant for the engine.
+	The rendering of many labels (e.g. on project load) is done in a bounded pool of threads, see \c threadPool().
 
 	\ingroup tools
 */
-QByteArray TeXRenderer::renderImageLaTeX(const QString& teXString, Result* res, const TeXRenderer::Formatting& format) {
-	const QColor& fontColor = format.fontColor;
-	const QColor& backgroundColor = format.backgroundColor;
-	const int fontSize = format.fontSize;
-	QString fontFamily = format.fontFamily;
-	const int dpi = format.dpi;
+namespace {
+// version of the cache, to be increased when the generated LaTeX document is changed
+constexpr char cacheVersion[] = "1";
+constexpr int memoryCacheSize = 32 * 1024; // in KiB
+constexpr qint64 diskCacheSize = 100 * 1024 * 1024; // in bytes
 
-	// determine the temp directory where the produced files are going to be created
-	QString tempPath;
-#ifdef Q_OS_LINUX
-	// on linux try to use shared memory device first if available
-	static bool useShm = QDir(QStringLiteral("/dev/shm/")).exists();
-	if (useShm)
-		tempPath = QStringLiteral("/dev/shm/");
-	else
-		tempPath = QDir::tempPath();
-#else
-	tempPath = QDir::tempPath();
-#endif
+QMutex cacheMutex;
+QCache<QByteArray, QByteArray> memoryCache(memoryCacheSize);
 
-	// make sure we have preview.sty available
-	if (!tempPath.contains(QStringLiteral("preview.sty"))) {
-		QString file = QStandardPaths::locate(QStandardPaths::AppDataLocation, QStringLiteral("latex/preview.sty"));
-		if (file.isEmpty()) {
-			QString err = i18n("Couldn't find preview.sty.");
-			WARN(err.toStdString());
-			res->successful = false;
-			res->errorMessage = std::move(err);
-			return {};
-		} else
-			QFile::copy(file, tempPath + QLatin1Char('/') + QStringLiteral("preview.sty"));
-	}
+QString diskCachePath() {
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/latex/");
+}
 
-	// create a temporary file
-	QTemporaryFile file(tempPath + QLatin1Char('/') + QStringLiteral("labplot_XXXXXX.tex"));
-	// enable to keep temp latex file
-	// file.setAutoRemove(false);
-	if (file.open()) {
-		DEBUG(Q_FUNC_INFO << ", temp file: " << file.fileName().toStdString());
-		QDir::setCurrent(tempPath);
-	} else {
-		QString err = i18n("Couldn't open the file") + QStringLiteral(" ") + file.fileName();
-		WARN(err.toStdString());
-		res->successful = false;
-		res->errorMessage = std::move(err);
-		return {};
+/*!
+ * removes the least recently used images from the disk cache if the size of the cache exceeds the limit.
+ */
+void trimDiskCache() {
+	QDir dir(diskCachePath());
+	const auto& files = dir.entryInfoList({QStringLiteral("*.pdf")}, QDir::Files, QDir::Time | QDir::Reversed); // oldest first
+	qint64 size = 0;
+	for (const auto& file : files)
+		size += file.size();
+
+	for (const auto& file : files) {
+		if (size <= diskCacheSize)
+			break;
+		size -= file.size();
+		QFile::remove(file.absoluteFilePath());
 	}
+}
 
-	// determine latex engine to be used
-	const auto& group = Settings::group(QStringLiteral("Settings_Worksheet"));
-	const auto& engine = group.readEntry(QStringLiteral("LaTeXEngine"), QStringLiteral("pdflatex"));
+QByteArray documentKey(const QString& document, const QString& engine, int dpi) {
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	hash.addData(cacheVersion);
+	hash.addData(engine.toUtf8());
+	// the resolution is only used when converting the DVI file produced by latex, the PDF files don't depend on it
+	if (engine == QLatin1String("latex"))
+		hash.addData(QByteArray::number(dpi));
+	hash.addData(document.toUtf8());
+	return hash.result().toHex();
+}
+
+/*!
+ * creates the complete LaTeX document for the text \c teXString.
+ */
+QString teXDocument(const QString& teXString, const TeXRenderer::Formatting& format, const QString& engine) {
+	const QColor& fontColor = format.fontColor;
+	const QColor& backgroundColor = format.backgroundColor;
+	const int fontSize = format.fontSize;
+	QString fontFamily = format.fontFamily;
 
 	// create latex code
-	QTextStream out(&file);
+	QString document;
+	QTextStream out(&document);
 	const int headerIndex = teXString.indexOf(QStringLiteral("\\begin{document}"));
 	QString body;
 	if (headerIndex != -1) {
@@ -147,12 +159,167 @@ QByteArray TeXRenderer::renderImageLaTeX(const QString& teXString, Result* res,
 	out << QStringLiteral("\\end{document}\n");
 	out.flush();
 
+	return document;
+}
+}
+
+/*!
+ * returns the key of the rendered image for the text \c teXString in the cache. The key depends on the complete
+ * LaTeX document created for the text and the formatting \c format, on the engine \c engine and,
+ * for the engine "latex" producing DVI files, on the resolution.
+ */
+QByteArray TeXRenderer::cacheKey(const QString& teXString, const TeXRenderer::Formatting& format, const QString& engine) {
+	return documentKey(teXDocument(teXString, format, engine), engine, format.dpi);
+}
+
+/*!
+ * returns the rendered image for the cache key \c key from the memory or from the disk cache,
+ * an empty array is returned if the image was not rendered yet.
+ */
+QByteArray TeXRenderer::cachedImage(const QByteArray& key) {
+	{
+		QMutexLocker locker(&cacheMutex);
+		if (const auto* data = memoryCache.object(key))
+			return *data;
+	}
+
+	QFile file(diskCachePath() + QLatin1String(key) + QStringLiteral(".pdf"));
+	if (!file.open(QIODevice::ReadOnly))
+		return {};
+
+	auto data = file.readAll();
+	file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime); // for the removal of the least recently used files
+	file.close();
+	if (data.isEmpty())
+		return {};
+
+	QMutexLocker locker(&cacheMutex);
+	memoryCache.insert(key, new QByteArray(data), std::max(1, static_cast<int>(data.size() / 1024)));
+	return data;
+}
+
+/*!
+ * stores the rendered image \c data for the cache key \c key in the memory and in the disk cache.
+ */
+void TeXRenderer::cacheImage(const QByteArray& key, const QByteArray& data) {
+	{
+		QMutexLocker locker(&cacheMutex);
+		memoryCache.insert(key, new QByteArray(data), std::max(1, static_cast<int>(data.size() / 1024)));
+	}
+
+	static std::once_flag trimmed;
+	std::call_once(trimmed, trimDiskCache);
+
+	const QString path = diskCachePath();
+	if (!QDir().mkpath(path))
+		return;
+
+	// the same label can be rendered in parallel, write atomically
+	QSaveFile file(path + QLatin1String(key) + QStringLiteral(".pdf"));
+	if (file.open(QIODevice::WriteOnly)) {
+		file.write(data);
+		file.commit();
+	}
+}
+
+QByteArray TeXRenderer::renderImageLaTeX(const QString& teXString, Result* res, const TeXRenderer::Formatting& format) {
+	// determine latex engine to be used
+	const auto& group = Settings::group(QStringLiteral("Settings_Worksheet"));
+	const auto& engine = group.readEntry(QStringLiteral("LaTeXEngine"), QStringLiteral("pdflatex"));
+
+	const QString& document = teXDocument(teXString, format, engine);
+	const auto& key = documentKey(document, engine, format.dpi);
+	auto data = cachedImage(key);
+	if (!data.isEmpty()) {
+		res->successful = true;
+		res->errorMessage = QString();
+		return data;
+	}
+
+	data = renderDocument(document, engine, format.dpi, res);
+	if (res->successful && !data.isEmpty())
+		cacheImage(key, data);
+
+	return data;
+}
+
+/*!
+ * runs the LaTeX engine (and the conversion tools) for the complete LaTeX document \c document
+ * and returns the content of the produced PDF file.
+ */
+QByteArray TeXRenderer::renderDocument(const QString& document, const QString& engine, int dpi, Result* res) {
+	// determine the temp directory where the produced files are going to be created
+	QString tempPath;
+#ifdef Q_OS_LINUX
+	// on linux try to use shared memory device first if available
+	static bool useShm = QDir(QStringLiteral("/dev/shm/")).exists();
+	if (useShm)
+		tempPath = QStringLiteral("/dev/shm/");
+	else
+		tempPath = QDir::tempPath();
+#else
+	tempPath = QDir::tempPath();
+#endif
+
+	// make sure we have preview.sty available
+	if (!tempPath.contains(QStringLiteral("preview.sty"))) {
+		QString file = QStandardPaths::locate(QStandardPaths::AppDataLocation, QStringLiteral("latex/preview.sty"));
+		if (file.isEmpty()) {
+			QString err = i18n("Couldn't find preview.sty.");
+			WARN(err.toStdString());
+			res->successful = false;
+			res->errorMessage = std::move(err);
+			return {};
+		} else
+			QFile::copy(file, tempPath + QLatin1Char('/') + QStringLiteral("preview.sty"));
+	}
+
+	// create a temporary file
+	QTemporaryFile file(tempPath + QLatin1Char('/') + QStringLiteral("labplot_XXXXXX.tex"));
+	// enable to keep temp latex file
+	// file.setAutoRemove(false);
+	if (file.open()) {
+		DEBUG(Q_FUNC_INFO << ", temp file: " << file.fileName().toStdString());
+		QDir::setCurrent(tempPath);
+	} else {
+		QString err = i18n("Couldn't open the file") + QStringLiteral(" ") + file.fileName();
+		WARN(err.toStdString());
+		res->successful = false;
+		res->errorMessage = std::move(err);
+		return {};
+	}
+
+	QTextStream out(&file);
+	out << document;
+	out.flush();
+
 	if (engine == QStringLiteral("latex"))
 		return imageFromDVI(file, dpi, res);
 	else
 		return imageFromPDF(file, engine, res);
 }
 
+/*!
+ * returns the pool of threads used for the rendering. The number of threads and with this the number of
+ * LaTeX processes running in parallel is limited to the number of cores.
+ */
+QThreadPool* TeXRenderer::threadPool() {
+	static QThreadPool pool;
+	return &pool;
+}
+
+/*!
+ * removes all rendered images from the memory and from the disk cache.
+ */
+void TeXRenderer::clearCache() {
+	{
+		QMutexLocker locker(&cacheMutex);
+		memoryCache.clear();
+	}
+
+	QDir(diskCachePath()).removeRecursively();
+}
+
 bool TeXRenderer::executeLatexProcess(const QString& engine,
 									  const QString& baseName,
 									  const QTemporaryFile& file,
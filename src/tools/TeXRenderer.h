@@ -15,6 +15,7 @@
 class QString;
 class QImage;
 class QTemporaryFile;
+class QThreadPool;
 
 class TeXRenderer {
 public:
@@ -35,11 +36,17 @@ public:
 	};
 
 	static QByteArray renderImageLaTeX(const QString&, Result*, const TeXRenderer::Formatting&);
+	static QByteArray renderDocument(const QString& document, const QString& engine, int dpi, Result*);
 	static bool executeLatexProcess(const QString& engine, const QString& baseName, const QTemporaryFile&, const QString& resultFileExtension, Result*);
 	static QByteArray imageFromPDF(const QTemporaryFile&, const QString& engine, Result*);
 	static QByteArray imageFromDVI(const QTemporaryFile&, const int dpi, Result*);
 	static bool enabled();
 	static bool executableExists(const QString&);
+	static QThreadPool* threadPool();
+	static QByteArray cacheKey(const QString&, const TeXRenderer::Formatting&, const QString& engine);
+	static QByteArray cachedImage(const QByteArray& key);
+	static void cacheImage(const QByteArray& key, const QByteArray& data);
+	static void clearCache();
 };
 
 #endif
@@ -311,6 +311,78 @@ void CommonAnalysisTest::saveRestoreWithoutCalculations() {
 	}
 }
 
+/*!
+ * test save and restore of the project with the deactivated option "save calculations" where an analysis curve
+ * takes its data from another analysis curve located after it in the plot. The source curve needs to be recalculated first.
+ */
+void CommonAnalysisTest::saveRestoreWithoutCalculationsDependentCurves() {
+	QString savePath;
+
+	// save
+	{
+		Project project;
+		project.setSaveCalculations(false);
+		auto* ws = new Worksheet(QStringLiteral("Worksheet"));
+		project.addChild(ws);
+
+		auto* plot = new CartesianPlot(QStringLiteral("plot"));
+		ws->addChild(plot);
+
+		auto* sheet = new Spreadsheet(QStringLiteral("sheet"));
+		project.addChild(sheet);
+		sheet->setColumnCount(2);
+		sheet->setRowCount(3);
+		for (int i = 0; i < 3; ++i) {
+			sheet->column(0)->setValueAt(i, i);
+			sheet->column(1)->setValueAt(i, 2 * i);
+		}
+
+		auto* fitCurve = new XYFitCurve(QStringLiteral("fit"));
+		plot->addChild(fitCurve);
+		fitCurve->setDataSourceType(XYAnalysisCurve::DataSourceType::Spreadsheet);
+		fitCurve->setXDataColumn(sheet->column(0));
+		fitCurve->setYDataColumn(sheet->column(1));
+
+		XYFitCurve::FitData fitData = fitCurve->fitData();
+		fitData.modelCategory = nsl_fit_model_basic;
+		fitData.modelType = nsl_fit_model_polynomial;
+		fitData.degree = 1;
+		XYFitCurve::initFitData(fitData);
+		fitCurve->setFitData(fitData);
+		fitCurve->recalculate();
+
+		// integrate the fit curve, the integration curve is placed before the fit curve
+		auto* integrationCurve = new XYIntegrationCurve(QStringLiteral("integration"));
+		plot->insertChildBefore(integrationCurve, fitCurve);
+		integrationCurve->setDataSourceType(XYAnalysisCurve::DataSourceType::Curve);
+		integrationCurve->setDataSourceCurve(fitCurve);
+		integrationCurve->recalculate();
+		QVERIFY(integrationCurve->result().available);
+
+		SAVE_PROJECT("saveRestoreWithoutCalculationsDependentCurves");
+	}
+
+	// load the project and verify both analysis curves were recalculated
+	{
+		Project project;
+		QCOMPARE(project.load(savePath), true);
+
+		const auto* ws = project.child<Worksheet>(0);
+		QVERIFY(ws);
+		const auto* plot = ws->child<CartesianPlot>(0);
+		QVERIFY(plot);
+		const auto* fitCurve = plot->child<XYFitCurve>(0);
+		QVERIFY(fitCurve);
+		const auto* integrationCurve = plot->child<XYIntegrationCurve>(0);
+		QVERIFY(integrationCurve);
+		QCOMPARE(integrationCurve->dataSourceCurve(), fitCurve);
+
+		QVERIFY(integrationCurve->yColumn());
+		const auto& yStatistics = static_cast<const Column*>(integrationCurve->yColumn())->statistics();
+		QCOMPARE_GT(yStatistics.size, 0);
+	}
+}
+
 void CommonAnalysisTest::dataImportRecalculationAnalysisCurveColumnDependency() {
 	Project project;
 	auto* ws = new Worksheet(QStringLiteral("Worksheet"));
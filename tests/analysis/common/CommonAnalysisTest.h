@@ -23,6 +23,7 @@ private Q_SLOTS:
 
 	void saveRestoreWithCalculations();
 	void saveRestoreWithoutCalculations();
+	void saveRestoreWithoutCalculationsDependentCurves();
 
 	void dataImportRecalculationAnalysisCurveColumnDependency();
 	void createDataSpreadsheet();
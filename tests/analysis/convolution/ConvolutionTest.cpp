@@ -12,6 +12,8 @@
 #include "backend/core/column/Column.h"
 #include "backend/worksheet/plots/cartesian/XYConvolutionCurve.h"
 
+#include <QSignalSpy>
+
 // ##############################################################################
 
 void ConvolutionTest::testLinear() {
@@ -1524,4 +1526,81 @@ void ConvolutionTest::testPerformance() {
 	QCOMPARE(np, N + 2);
 }
 
+/*!
+ * large data sets are convolved asynchronously if requested, the result needs to be the same as for the synchronous convolution
+ * and changing the settings during the calculation needs to restart it with the new settings.
+ * Without the request, the results need to be available after the setter.
+ */
+void ConvolutionTest::testAsync() {
+	const int N = 2e5;
+	QVector<double> yData;
+	for (int i = 0; i < N; i++)
+		yData.append(i % 100);
+	QVector<double> y2Data = {0, 1., .5};
+
+	Column yDataColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	Column y2DataColumn(QStringLiteral("y2"), AbstractColumn::ColumnMode::Double);
+	y2DataColumn.replaceValues(0, y2Data);
+
+	XYConvolutionCurve curve(QStringLiteral("convolution"));
+	curve.setYDataColumn(&yDataColumn);
+	curve.setY2DataColumn(&y2DataColumn);
+
+	QSignalSpy finishedSpy(&curve, &XYAnalysisCurve::recalculationFinished);
+	auto data = curve.convolutionData();
+	{
+		const XYAnalysisCurve::AsyncRecalculation async(&curve);
+		curve.setConvolutionData(data);
+		QVERIFY(curve.isRecalculating());
+
+		// change the settings while the convolution is running
+		data.type = nsl_conv_type_circular;
+		curve.setConvolutionData(data);
+	}
+
+	QTRY_VERIFY_WITH_TIMEOUT(!curve.isRecalculating(), 60000);
+	QVERIFY(finishedSpy.count() >= 1);
+
+	const auto& result = curve.convolutionResult();
+	QCOMPARE(result.available, true);
+	QCOMPARE(result.valid, true);
+
+	// circular convolution keeps the number of points
+	const auto* resultYDataColumn = curve.yColumn();
+	QCOMPARE(resultYDataColumn->rowCount(), N);
+
+	// compare with the synchronous convolution on the first points
+	Column ySmallColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	ySmallColumn.replaceValues(0, yData.mid(0, 1000));
+	XYConvolutionCurve referenceCurve(QStringLiteral("reference"));
+	referenceCurve.setYDataColumn(&ySmallColumn);
+	referenceCurve.setY2DataColumn(&y2DataColumn);
+	referenceCurve.setConvolutionData(data);
+	QVERIFY(!referenceCurve.isRecalculating());
+
+	// the first points of the circular convolution differ because of the wrap around
+	for (int i = 10; i < 900; i++)
+		FuzzyCompare(resultYDataColumn->valueAt(i), referenceCurve.yColumn()->valueAt(i), 1.e-9);
+
+	// synchronous recalculation of the large data set, also while an asynchronous one is running
+	data.type = nsl_conv_type_linear;
+	{
+		const XYAnalysisCurve::AsyncRecalculation async(&curve);
+		curve.setConvolutionData(data);
+	}
+	curve.recalculate();
+	QVERIFY(!curve.isRecalculating());
+	QCOMPARE(curve.convolutionResult().available, true);
+	QCOMPARE(curve.yColumn()->rowCount(), N + 2);
+
+	// changes of the source data are recalculated in the background
+	yDataColumn.setValueAt(0, 1.);
+	QVERIFY(curve.isRecalculating());
+	QTRY_VERIFY_WITH_TIMEOUT(!curve.isRecalculating(), 60000);
+	QCOMPARE(curve.convolutionResult().available, true);
+	QCOMPARE(curve.yColumn()->rowCount(), N + 2);
+}
+
 QTEST_MAIN(ConvolutionTest)
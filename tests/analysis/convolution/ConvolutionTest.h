@@ -52,6 +52,7 @@ private Q_SLOTS:
 	void testCircularDeconv2();
 	void testCircularDeconv_norm();
 
+	void testAsync();
 	void testPerformance();
 };
 #endif
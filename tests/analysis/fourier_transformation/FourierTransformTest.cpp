@@ -10,8 +10,10 @@
 
 #include "FourierTransformTest.h"
 #include "backend/core/column/Column.h"
+#include "backend/timeseriesanalysis/SpectralAnalysis.h"
 #include "backend/worksheet/plots/cartesian/XYFourierTransformCurve.h"
 
+#include <algorithm>
 #include <iostream>
 // #include <math.h>
 
@@ -82,4 +84,124 @@ void FourierTransformTest::fft() {
 	}
 }
 
+// power spectral density with Welch's method, the integral of the PSD is the power of the signal
+void FourierTransformTest::welch() {
+	constexpr int length_signal = 20000;
+	constexpr double fs = 1000.0; // [Hz]
+	constexpr double amplitude = 2.;
+
+	QVector<double> time(length_signal);
+	QVector<double> yData(length_signal);
+	for (int i = 0; i < length_signal; i++) {
+		const auto t = (double)i / fs;
+		time[i] = t;
+		yData[i] = amplitude * sin(2.0 * M_PI * 50.0 * t);
+	}
+
+	Column xDataColumn(QStringLiteral("time"), AbstractColumn::ColumnMode::Double);
+	xDataColumn.replaceValues(0, time);
+
+	Column yDataColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	XYFourierTransformCurve curve(QStringLiteral("fourier transform"));
+	curve.setXDataColumn(&xDataColumn);
+	curve.setYDataColumn(&yDataColumn);
+
+	auto data = curve.transformData();
+	data.method = nsl_dft_method_welch;
+	data.segmentLength = 200; // frequency resolution 5 Hz
+	data.overlap = 0.5;
+	curve.setTransformData(data);
+
+	curve.recalculate();
+	const auto& result = curve.result();
+	QCOMPARE(result.available, true);
+	QCOMPARE(result.valid, true);
+
+	const auto* resultXDataColumn = curve.xColumn();
+	const auto* resultYDataColumn = curve.yColumn();
+	const int np = resultXDataColumn->rowCount();
+	QCOMPARE(np, 100);
+	VALUES_EQUAL(resultXDataColumn->valueAt(1), 5.);
+
+	int peak = 0;
+	double power = 0.;
+	for (int i = 0; i < np; i++) {
+		if (resultYDataColumn->valueAt(i) > resultYDataColumn->valueAt(peak))
+			peak = i;
+		power += resultYDataColumn->valueAt(i) * 5.;
+	}
+	VALUES_EQUAL(resultXDataColumn->valueAt(peak), 50.);
+	QVERIFY(std::abs(power - amplitude * amplitude / 2.) < 0.05 * amplitude * amplitude / 2.);
+}
+
+// invalid segment lengths (set via the API or in a loaded project) are increased to the minimal length of four samples
+void FourierTransformTest::welchInvalidSegmentLength() {
+	QVector<double> yData(100);
+	for (int i = 0; i < yData.size(); i++)
+		yData[i] = 1. + sin(0.1 * i);
+
+	Column yDataColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	for (int length : {-5, 0, 1}) {
+		SpectralAnalysis::Options options;
+		options.segmentLength = length;
+
+		QVector<double> psd;
+		SpectralAnalysis::Info info;
+		QVERIFY(SpectralAnalysis::welch(nullptr, &yDataColumn, options, psd, info));
+		QCOMPARE(info.segmentLength, 4);
+		QCOMPARE(psd.size(), (qsizetype)2);
+		QVERIFY(std::isfinite(psd.at(0)));
+		QVERIFY(std::isfinite(psd.at(1)));
+	}
+
+	// not enough samples for a segment
+	Column shortColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	shortColumn.replaceValues(0, {1., 2., 3.});
+	SpectralAnalysis::Options options;
+	QVector<double> psd;
+	SpectralAnalysis::Info info;
+	QVERIFY(!SpectralAnalysis::welch(nullptr, &shortColumn, options, psd, info));
+}
+
+// spectrogram of a signal changing its frequency in the middle
+void FourierTransformTest::spectrogram() {
+	constexpr int length_signal = 100000;
+	constexpr double fs = 1000.0; // [Hz]
+
+	QVector<double> yData(length_signal);
+	for (int i = 0; i < length_signal; i++) {
+		const double f = (i < length_signal / 2) ? 50. : 200.;
+		yData[i] = sin(2.0 * M_PI * f * i / fs);
+	}
+
+	Column yDataColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	SpectralAnalysis::Options options;
+	options.segmentLength = 100; // frequency resolution 10 Hz (sampling rate 1 without x column)
+	options.overlap = 0.;
+
+	QVector<QVector<double>> psd;
+	SpectralAnalysis::Info info;
+	double tFirst, tLast;
+	QVERIFY(SpectralAnalysis::spectrogram(nullptr, &yDataColumn, options, 100, psd, info, tFirst, tLast));
+
+	// 1000 segments averaged into 100 time bins with 50 frequencies each
+	QCOMPARE(info.segments, (size_t)1000);
+	QCOMPARE(psd.size(), (qsizetype)100);
+	QCOMPARE(psd.constFirst().size(), (qsizetype)50);
+	VALUES_EQUAL(tFirst, 500.);
+	VALUES_EQUAL(tLast, 99500.);
+
+	auto peak = [](const QVector<double>& bin) {
+		return static_cast<int>(std::max_element(bin.cbegin(), bin.cend()) - bin.cbegin());
+	};
+	QCOMPARE(peak(psd.constFirst()), 5); // 50 Hz
+	QCOMPARE(peak(psd.constLast()), 20); // 200 Hz
+}
+
 QTEST_MAIN(FourierTransformTest)
@@ -17,5 +17,8 @@ class FourierTransformTest : public AnalysisTest {
 
 private Q_SLOTS:
 	void fft();
+	void welch();
+	void welchInvalidSegmentLength();
+	void spectrogram();
 };
 #endif
@@ -10,6 +10,7 @@
 
 #include "IntegrationTest.h"
 #include "backend/core/column/Column.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/worksheet/plots/cartesian/XYIntegrationCurve.h"
 
 // ##############################################################################
@@ -57,4 +58,59 @@ void IntegrationTest::testLinear() {
 	QCOMPARE(resultYDataColumn->valueAt(3), 7.5);
 }
 
+/*!
+ * integration of the data in a live data source where the oldest rows are removed and new rows are appended.
+ * The result is updated incrementally and needs to be the same as for the integration of the whole data.
+ */
+void IntegrationTest::testLiveData() {
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setColumnCount(2);
+	source.setRowCount(100);
+	auto* xColumn = source.column(0);
+	auto* yColumn = source.column(1);
+	for (int i = 0; i < 100; ++i) {
+		xColumn->setValueAt(i, i);
+		yColumn->setValueAt(i, 2. + sin(i / 10.));
+	}
+
+	XYIntegrationCurve integrationCurve(QStringLiteral("integration"));
+	integrationCurve.setXDataColumn(xColumn);
+	integrationCurve.setYDataColumn(yColumn);
+	auto integrationData = integrationCurve.integrationData();
+	integrationData.method = nsl_int_method_trapezoid;
+	integrationCurve.setIntegrationData(integrationData);
+	integrationCurve.recalculate();
+	QCOMPARE(integrationCurve.yColumn()->rowCount(), 100);
+
+	// remove the oldest 10 rows and append 20 new rows
+	source.removeRows(0, 10);
+	source.setRowCount(110);
+	for (int i = 90; i < 110; ++i) {
+		xColumn->setValueAt(i, i + 10);
+		yColumn->setValueAt(i, 2. + sin((i + 10) / 10.));
+	}
+	QTRY_COMPARE(integrationCurve.yColumn()->rowCount(), 110);
+
+	// reference - integration of the whole data
+	Column xRefColumn(QStringLiteral("x"), AbstractColumn::ColumnMode::Double);
+	Column yRefColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	for (int i = 0; i < 110; ++i) {
+		xRefColumn.setValueAt(i, xColumn->valueAt(i));
+		yRefColumn.setValueAt(i, yColumn->valueAt(i));
+	}
+
+	XYIntegrationCurve refCurve(QStringLiteral("reference"));
+	refCurve.setXDataColumn(&xRefColumn);
+	refCurve.setYDataColumn(&yRefColumn);
+	refCurve.setIntegrationData(integrationData);
+	refCurve.recalculate();
+
+	QCOMPARE(integrationCurve.xColumn()->rowCount(), refCurve.xColumn()->rowCount());
+	for (int i = 0; i < 110; ++i) {
+		QCOMPARE(integrationCurve.xColumn()->valueAt(i), refCurve.xColumn()->valueAt(i));
+		VALUES_EQUAL(integrationCurve.yColumn()->valueAt(i), refCurve.yColumn()->valueAt(i));
+	}
+	VALUES_EQUAL(integrationCurve.integrationResult().value, refCurve.integrationResult().value);
+}
+
 QTEST_MAIN(IntegrationTest)
@@ -17,6 +17,7 @@ class IntegrationTest : public AnalysisTest {
 
 private Q_SLOTS:
 	void testLinear();
+	void testLiveData();
 
 	//	void testPerformance();
 };
@@ -0,0 +1,87 @@
+/*
+	File                 : LineSimplificationTest.cpp
+	Project              : LabPlot
+	Description          : Tests for the line simplification
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "LineSimplificationTest.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/LiveDataSource.h"
+#include "backend/worksheet/plots/cartesian/XYLineSimplificationCurve.h"
+
+// ##############################################################################
+
+/*!
+ * line simplification of the data in a live data source where new rows are appended. The data goes back and forth
+ * along the x-axis, the values of the last but one point of the result are repeated in later rows.
+ * The result is updated incrementally starting at the row of this point and needs to be the same as for the whole data.
+ */
+void LineSimplificationTest::testLiveDataRepeatedValues() {
+	auto x = [](int i) {
+		return (i < 100) ? ((i % 8 < 4) ? i % 8 : 8 - i % 8) : 0; // 0, 1, 2, 3, 4, 3, 2, 1, 0, 1, ... and 0 for the appended rows
+	};
+	auto y = [](int i) {
+		return (i < 100) ? 0 : i - 99;
+	};
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setColumnCount(2);
+	source.setRowCount(100);
+	auto* xColumn = source.column(0);
+	auto* yColumn = source.column(1);
+	for (int i = 0; i < 100; ++i) {
+		xColumn->setValueAt(i, x(i));
+		yColumn->setValueAt(i, y(i));
+	}
+
+	XYLineSimplificationCurve curve(QStringLiteral("simplification"));
+	curve.setXDataColumn(xColumn);
+	curve.setYDataColumn(yColumn);
+	auto data = curve.lineSimplificationData();
+	data.type = nsl_geom_linesim_type_douglas_peucker;
+	data.autoTolerance = false;
+	data.tolerance = 0.1;
+	curve.setLineSimplificationData(data);
+	curve.recalculate();
+
+	// all points are on the x-axis, only the first (0, 0) and the last point are kept
+	QCOMPARE(curve.xColumn()->rowCount(), 2);
+	QCOMPARE(curve.xColumn()->valueAt(0), 0.);
+	QCOMPARE(curve.xColumn()->valueAt(1), 3.);
+
+	// reference - simplification of the whole data
+	Column xRefColumn(QStringLiteral("x"), AbstractColumn::ColumnMode::Double);
+	Column yRefColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	for (int i = 0; i < 120; ++i) {
+		xRefColumn.setValueAt(i, x(i));
+		yRefColumn.setValueAt(i, y(i));
+	}
+
+	XYLineSimplificationCurve refCurve(QStringLiteral("reference"));
+	refCurve.setXDataColumn(&xRefColumn);
+	refCurve.setYDataColumn(&yRefColumn);
+	refCurve.setLineSimplificationData(data);
+	refCurve.recalculate();
+	const int refPoints = refCurve.xColumn()->rowCount();
+	QVERIFY(refPoints > 3); // the points at x = 4 are kept
+
+	// append 20 new rows going up the y-axis
+	source.setRowCount(120);
+	for (int i = 100; i < 120; ++i) {
+		xColumn->setValueAt(i, x(i));
+		yColumn->setValueAt(i, y(i));
+	}
+	QTRY_COMPARE(curve.xColumn()->rowCount(), refPoints);
+
+	for (int i = 0; i < refPoints; ++i) {
+		QCOMPARE(curve.xColumn()->valueAt(i), refCurve.xColumn()->valueAt(i));
+		QCOMPARE(curve.yColumn()->valueAt(i), refCurve.yColumn()->valueAt(i));
+	}
+	QCOMPARE(curve.lineSimplificationResult().npoints, refCurve.lineSimplificationResult().npoints);
+}
+
+QTEST_MAIN(LineSimplificationTest)
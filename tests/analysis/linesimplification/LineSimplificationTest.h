@@ -0,0 +1,21 @@
+/*
+	File                 : LineSimplificationTest.h
+	Project              : LabPlot
+	Description          : Tests for the line simplification
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef LINESIMPLIFICATIONTEST_H
+#define LINESIMPLIFICATIONTEST_H
+
+#include <../AnalysisTest.h>
+
+class LineSimplificationTest : public AnalysisTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testLiveDataRepeatedValues();
+};
+#endif
@@ -10,6 +10,7 @@
 
 #include "SmoothTest.h"
 #include "backend/core/column/Column.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/worksheet/plots/cartesian/XYSmoothCurve.h"
 
 extern "C" {
@@ -64,4 +65,60 @@ void SmoothTest::testPercentile() {
 	}
 }
 
+/*!
+ * moving average of the data in a live data source where the oldest rows are removed and new rows are appended.
+ * The result is updated incrementally and needs to be the same as for the smoothing of the whole data.
+ */
+void SmoothTest::testLiveData() {
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setColumnCount(2);
+	source.setRowCount(100);
+	auto* xColumn = source.column(0);
+	auto* yColumn = source.column(1);
+	for (int i = 0; i < 100; ++i) {
+		xColumn->setValueAt(i, i);
+		yColumn->setValueAt(i, 2. + sin(i / 5.) + (i % 3) * 0.1);
+	}
+
+	XYSmoothCurve smoothCurve(QStringLiteral("smooth"));
+	smoothCurve.setXDataColumn(xColumn);
+	smoothCurve.setYDataColumn(yColumn);
+	auto smoothData = smoothCurve.smoothData();
+	smoothData.type = nsl_smooth_type_moving_average;
+	smoothData.points = 5;
+	smoothCurve.setSmoothData(smoothData);
+	smoothCurve.recalculate();
+	QCOMPARE(smoothCurve.yColumn()->rowCount(), 100);
+
+	// remove the oldest 10 rows and append 20 new rows
+	source.removeRows(0, 10);
+	source.setRowCount(110);
+	for (int i = 90; i < 110; ++i) {
+		xColumn->setValueAt(i, i + 10);
+		yColumn->setValueAt(i, 2. + sin((i + 10) / 5.) + ((i + 10) % 3) * 0.1);
+	}
+	QTRY_COMPARE(smoothCurve.yColumn()->rowCount(), 110);
+
+	// reference - smoothing of the whole data
+	Column xRefColumn(QStringLiteral("x"), AbstractColumn::ColumnMode::Double);
+	Column yRefColumn(QStringLiteral("y"), AbstractColumn::ColumnMode::Double);
+	for (int i = 0; i < 110; ++i) {
+		xRefColumn.setValueAt(i, xColumn->valueAt(i));
+		yRefColumn.setValueAt(i, yColumn->valueAt(i));
+	}
+
+	XYSmoothCurve refCurve(QStringLiteral("reference"));
+	refCurve.setXDataColumn(&xRefColumn);
+	refCurve.setYDataColumn(&yRefColumn);
+	refCurve.setSmoothData(smoothData);
+	refCurve.recalculate();
+
+	QCOMPARE(smoothCurve.xColumn()->rowCount(), refCurve.xColumn()->rowCount());
+	for (int i = 0; i < 110; ++i) {
+		QCOMPARE(smoothCurve.xColumn()->valueAt(i), refCurve.xColumn()->valueAt(i));
+		VALUES_EQUAL(smoothCurve.yColumn()->valueAt(i), refCurve.yColumn()->valueAt(i));
+		VALUES_EQUAL(smoothCurve.roughsColumn()->valueAt(i), refCurve.roughsColumn()->valueAt(i));
+	}
+}
+
 QTEST_MAIN(SmoothTest)
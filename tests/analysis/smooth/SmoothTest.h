@@ -17,6 +17,7 @@ class SmoothTest : public AnalysisTest {
 
 private Q_SLOTS:
 	void testPercentile();
+	void testLiveData();
 
 	//	void testPerformance();
 };
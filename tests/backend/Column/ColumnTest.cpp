@@ -12,6 +12,7 @@
 
 #include "ColumnTest.h"
 #include "backend/core/Project.h"
+#include "backend/core/ProjectDataContainer.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
 #include "backend/lib/XmlStreamReader.h"
@@ -20,6 +21,7 @@
 
 #include "backend/lib/UndoStack.h"
 #include <cmath>
+#include <limits>
 
 #define SETUP_C1_C2_COLUMNS(c1Vector, c2Vector)                                                                                                                \
 	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);                                                                                \
@@ -135,6 +137,88 @@ void ColumnTest::bigIntMaximum() {
 
 /////////////////////////////////////////////////////
 
+/*!
+ * the monotonicity is updated for the modified blocks of rows only, check it for modifications
+ * within and across the block boundaries and for appended rows.
+ */
+void ColumnTest::propertiesIncremental() {
+	const int rows = 3 * ColumnPrivate::propertiesBlockSize + 100;
+	QVector<double> values(rows);
+	for (int i = 0; i < rows; ++i)
+		values[i] = i;
+
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(-1, values);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// break the monotonicity at the first row of the second block and restore it again
+	const int row = ColumnPrivate::propertiesBlockSize;
+	c.setValueAt(row, -1.);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+	c.setValueAt(row, row);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// the last row of the first block, the violation is only visible at the block boundary
+	c.setValueAt(row - 1, row + 0.5);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+	c.setValueAt(row - 1, row - 1);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// append increasing and decreasing values
+	c.replaceValues(rows, {double(rows), double(rows + 1)});
+	QCOMPARE(c.rowCount(), rows + 2);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+	c.replaceValues(rows + 2, {0.});
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+
+	// remove the last row again
+	c.removeRows(rows + 2, 1);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// constant and decreasing
+	c.replaceValues(-1, QVector<double>(rows, 1.));
+	QCOMPARE(c.properties(), Column::Properties::Constant);
+	c.setValueAt(rows - 1, 0.);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicDecreasing);
+	c.setValueAt(0, 0.);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+}
+
+void ColumnTest::propertiesMasked() {
+	Column c(QStringLiteral("Integer column"), Column::ColumnMode::Integer);
+	c.setIntegers({1, 2, 3, 4, 5});
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	c.setMasked(0);
+	QCOMPARE(c.properties(), Column::Properties::No);
+
+	c.setMasked(0, false);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	Column d(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	d.setValues({1., NAN, 3.});
+	QCOMPARE(d.properties(), Column::Properties::No);
+	d.setValueAt(1, 2.);
+	QCOMPARE(d.properties(), Column::Properties::MonotonicIncreasing);
+}
+
+void ColumnTest::sortedIndex() {
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.setValues({3., 1., NAN, 2., 1., 5.});
+	QCOMPARE(c.sortedIndex(), QVector<int>({1, 4, 3, 0, 5})); // invalid rows are skipped, the same values keep their order
+
+	c.setMasked(3);
+	QCOMPARE(c.sortedIndex(), QVector<int>({1, 4, 0, 5}));
+
+	c.setValueAt(5, 0.);
+	QCOMPARE(c.sortedIndex(), QVector<int>({5, 1, 4, 0}));
+
+	Column t(QStringLiteral("Text column"), Column::ColumnMode::Text);
+	t.setTextAt(0, QStringLiteral("b"));
+	t.setTextAt(1, QStringLiteral("a"));
+	QVERIFY(t.sortedIndex().isEmpty());
+}
+
 void ColumnTest::statisticsDouble() {
 	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
 	c.setValues({1.0, 1.0, 2.0, 5.0});
@@ -761,6 +845,219 @@ void ColumnTest::testTextFrequencies() {
 	QCOMPARE(frequencies[QStringLiteral("no")], 2);
 }
 
+/*!
+ * texts with few distinct values are stored dictionary encoded, check the access to the texts, the frequencies,
+ * the dictionary and the ranks of the texts on the codes
+ */
+void ColumnTest::testTextDictionary() {
+	Column c(QStringLiteral("Text column"), Column::ColumnMode::Text);
+	const QVector<QString> categories{QStringLiteral("b"), QStringLiteral("a"), QString(), QStringLiteral("ü")};
+	QVector<QString> texts;
+	for (int i = 0; i < 2000; ++i)
+		texts << categories.at(i % 4);
+	c.setText(texts);
+
+	QVERIFY(c.compactTexts());
+	QVERIFY(c.isDictionaryEncoded());
+	QCOMPARE(c.rowCount(), 2000);
+	QCOMPARE(c.textAt(0), QStringLiteral("b"));
+	QCOMPARE(c.textAt(1), QStringLiteral("a"));
+	QCOMPARE(c.textAt(2), QString());
+	QCOMPARE(c.textAt(1999), QStringLiteral("ü"));
+	QCOMPARE(c.textAt(2000), QString());
+
+	const auto& frequencies = c.frequencies();
+	QCOMPARE(frequencies.size(), 3);
+	QCOMPARE(frequencies[QStringLiteral("a")], 500);
+	QCOMPARE(frequencies[QStringLiteral("b")], 500);
+	QCOMPARE(frequencies[QStringLiteral("ü")], 500);
+
+	QCOMPARE(c.dictionaryIndex(0), 0);
+	QCOMPARE(c.dictionaryIndex(1), 1);
+	QCOMPARE(c.dictionaryIndex(3), 2);
+	QCOMPARE(c.dictionaryIndex(2), 3); // empty text, not in the dictionary
+
+	const auto& ranks = c.textRanks();
+	QCOMPARE(ranks.size(), 2000);
+	QCOMPARE(ranks.at(0), 1);
+	QCOMPARE(ranks.at(1), 0);
+	QCOMPARE(ranks.at(2), -1);
+	QCOMPARE(ranks.at(3), 2);
+
+	// modifications restore the storage of one string per row
+	c.setTextAt(1, QStringLiteral("c"));
+	QVERIFY(!c.isDictionaryEncoded());
+	QCOMPARE(c.textAt(1), QStringLiteral("c"));
+	QCOMPARE(c.textAt(5), QStringLiteral("a"));
+	QCOMPARE(c.frequencies()[QStringLiteral("a")], 499);
+
+	// too many distinct values
+	Column c2(QStringLiteral("Text column"), Column::ColumnMode::Text);
+	texts.clear();
+	for (int i = 0; i < 2000; ++i)
+		texts << QString::number(i);
+	c2.setText(texts);
+	QVERIFY(!c2.compactTexts());
+	QCOMPARE(c2.textAt(1999), QStringLiteral("1999"));
+}
+
+/*!
+ * the data containers of the dictionary encoded columns are referenced in the undo commands,
+ * check that the texts are restored on undo/redo
+ */
+void ColumnTest::testTextDictionaryUndo() {
+	Project project;
+	auto* s = new Spreadsheet(QStringLiteral("MySpreadsheet"));
+	project.addChild(s);
+	s->setColumnCount(1);
+	s->setRowCount(2000);
+	auto* c = s->column(0);
+	c->setColumnMode(AbstractColumn::ColumnMode::Text);
+	QVector<QString> texts;
+	for (int i = 0; i < 2000; ++i)
+		texts << QString::number(i % 10);
+	c->setText(texts);
+
+	c->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(c->integerAt(13), 3);
+
+	project.undoStack()->undo();
+	QCOMPARE(c->columnMode(), AbstractColumn::ColumnMode::Text);
+	QVERIFY(c->compactTexts());
+
+	project.undoStack()->redo();
+	QCOMPARE(c->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(c->integerAt(13), 3);
+
+	project.undoStack()->undo();
+	QCOMPARE(c->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(c->rowCount(), 2000);
+	QCOMPARE(c->textAt(13), QStringLiteral("3"));
+	QCOMPARE(c->textAt(1999), QStringLiteral("9"));
+}
+
+/*!
+ * date and time values are stored as milliseconds since epoch, check the access to the values,
+ * the raw values used in the plots and the validity of the empty cells
+ */
+void ColumnTest::testDateTimeValues() {
+	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	const auto start = QDateTime(QDate(2024, 1, 1), QTime(12, 0), QTimeZone::UTC);
+	QVector<QDateTime> dateTimes;
+	for (int i = 0; i < 100; ++i)
+		dateTimes << ((i == 5) ? QDateTime() : start.addSecs((i % 10) * 60));
+	c.setDateTimes(dateTimes);
+
+	QVERIFY(c.compactDateTimes());
+	QCOMPARE(c.rowCount(), 100);
+	QCOMPARE(c.dateTimeAt(0), start);
+	QCOMPARE(c.dateTimeAt(0).timeRepresentation(), QTimeZone(QTimeZone::UTC));
+	QCOMPARE(c.dateTimeAt(3), start.addSecs(180));
+	QCOMPARE(c.dateAt(3), QDate(2024, 1, 1));
+	QCOMPARE(c.timeAt(3), QTime(12, 3));
+	QVERIFY(!c.dateTimeAt(5).isValid());
+	QVERIFY(!c.dateTimeAt(100).isValid());
+	QVERIFY(c.isValid(4));
+	QVERIFY(!c.isValid(5));
+	QVERIFY(!c.isValid(100));
+
+	const auto values = c.dateTimeMSecs();
+	QCOMPARE((int)values.size(), 100);
+	QCOMPARE(values[9], start.addSecs(540).toMSecsSinceEpoch());
+	QCOMPARE(values[5], std::numeric_limits<qint64>::min());
+
+	QCOMPARE(c.minimum(), (double)start.toMSecsSinceEpoch());
+	QCOMPARE(c.maximum(), (double)start.addSecs(540).toMSecsSinceEpoch());
+	QCOMPARE(c.valueAt(1), QDate(1900, 1, 1).daysTo(QDate(2024, 1, 1)) + (12 * 60 + 1) / 1440.); // days since 1900-01-01
+
+	// determining the properties doesn't expand the values to QDateTime objects
+	QCOMPARE(c.properties(), AbstractColumn::Properties::NonMonotonic);
+	QCOMPARE((int)c.dateTimeMSecs().size(), 100);
+
+	// modifications restore the storage of one QDateTime per row
+	c.setDateTimeAt(1, start.addDays(1));
+	QVERIFY(c.dateTimeMSecs().empty());
+	QCOMPARE(c.dateTimeAt(1), start.addDays(1));
+	QCOMPARE(c.dateTimeAt(9), start.addSecs(540));
+	QVERIFY(!c.isValid(5));
+
+	// values with different time representations are kept as QDateTime
+	Column c2(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	c2.setDateTimes({start, QDateTime(QDate(2024, 1, 1), QTime(12, 0), QTimeZone::fromSecondsAheadOfUtc(3600))});
+	QVERIFY(!c2.compactDateTimes());
+	QVERIFY(c2.dateTimeMSecs().empty());
+}
+
+void ColumnTest::testDateTimeNanoseconds() {
+	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	const auto start = QDateTime(QDate(2024, 1, 1), QTime(12, 0), QTimeZone::UTC);
+	const qint64 startNSecs = start.toMSecsSinceEpoch() * 1000000;
+	QVector<qint64> nsecs;
+	for (int i = 0; i < 8; ++i)
+		nsecs << startNSecs + i * 250000 + 1; // steps of 0.25 ms
+	c.setDateTimeNSecs(nsecs);
+
+	QCOMPARE(c.rowCount(), 8);
+	QVERIFY(c.dateTimeMSecs().empty());
+	const auto values = c.dateTimeNSecs();
+	QCOMPARE((int)values.size(), 8);
+	QCOMPARE(values[5], startNSecs + 1250001);
+	QCOMPARE(c.dateTimeAt(0), start);
+	QCOMPARE(c.dateTimeAt(5), start.addMSecs(1)); // rounded towards the past
+	QVERIFY(c.isValid(7));
+	QVERIFY(!c.isValid(8));
+
+	// the values within the same millisecond are still distinct
+	QCOMPARE(c.properties(), AbstractColumn::Properties::MonotonicIncreasing);
+	// determining the properties keeps the values with nanosecond resolution
+	QVERIFY(c.dateTimeMSecs().empty());
+	QCOMPARE((int)c.dateTimeNSecs().size(), 8);
+	QCOMPARE(c.dateTimeNSecs()[5], startNSecs + 1250001);
+	QCOMPARE(c.minimum(), DateTimeValues::toMSecsF(nsecs.first()));
+	QCOMPARE(c.maximum(), DateTimeValues::toMSecsF(nsecs.last()));
+	QCOMPARE(c.indexForValue(DateTimeValues::toMSecsF(nsecs.at(3)), false), 3);
+
+	// values closer than the precision of the fractional milliseconds are ordered by the exact nanoseconds
+	Column c3(QStringLiteral("Datetime 3 column"), Column::ColumnMode::DateTime);
+	c3.setDateTimeNSecs({startNSecs + 2, startNSecs, startNSecs + 1});
+	QCOMPARE(c3.properties(), AbstractColumn::Properties::NonMonotonic);
+	QCOMPARE(c3.sortedIndex(), QVector<int>({1, 2, 0}));
+	QCOMPARE(c3.minimum(), DateTimeValues::toMSecsF(startNSecs));
+	QCOMPARE(c3.maximum(), DateTimeValues::toMSecsF(startNSecs + 2));
+	QCOMPARE(c3.statistics().minimum, DateTimeValues::toMSecsF(startNSecs));
+	QCOMPARE(c3.statistics().size, 3);
+
+	// save and load keep the nanoseconds
+	QByteArray array;
+	QXmlStreamWriter writer(&array);
+	c.save(&writer);
+
+	Column c2(QStringLiteral("Datetime 2 column"), Column::ColumnMode::DateTime);
+	XmlStreamReader reader(array);
+	bool found = false;
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isStartElement() && reader.name() == QLatin1String("column")) {
+			found = true;
+			break;
+		}
+	}
+	QCOMPARE(found, true);
+	QCOMPARE(c2.load(&reader, false), true);
+	QThreadPool::globalInstance()->waitForDone();
+
+	const auto loadedValues = c2.dateTimeNSecs();
+	QCOMPARE((int)loadedValues.size(), 8);
+	for (int i = 0; i < 8; ++i)
+		QCOMPARE(loadedValues[i], nsecs.at(i));
+
+	// modifications fall back to milliseconds
+	c.setDateTimeAt(1, start.addDays(1));
+	QVERIFY(c.dateTimeNSecs().empty());
+	QCOMPARE(c.dateTimeAt(1), start.addDays(1));
+	QCOMPARE(c.dateTimeAt(7), start.addMSecs(1));
+}
+
 //////////////////////////////////////////////////
 
 void ColumnTest::saveLoadDateTime() {
@@ -2084,6 +2381,237 @@ void ColumnTest::testLoadSaveWithData() {
 	}
 }
 
+/*!
+ * save the project with the binary data section and check that all column modes are properly restored
+ */
+void ColumnTest::testLoadSaveBinaryData() {
+	QString savePath;
+	const QDateTime dateTime(QDate(2024, 5, 17), QTime(12, 30, 15, 100), QTimeZone::UTC);
+	{
+		Project project;
+		auto* s = new Spreadsheet(QStringLiteral("MySpreadsheet"));
+		project.addChild(s);
+		s->setColumnCount(5);
+		s->setRowCount(3);
+
+		auto* c = s->column(0);
+		c->setColumnMode(AbstractColumn::ColumnMode::Double);
+		c->replaceValues(0, {1.5, NAN, -3.});
+
+		c = s->column(1);
+		c->setColumnMode(AbstractColumn::ColumnMode::Integer);
+		c->replaceInteger(0, {1, 2, 3});
+		c->setValid(1, false);
+
+		c = s->column(2);
+		c->setColumnMode(AbstractColumn::ColumnMode::BigInt);
+		c->replaceBigInt(0, {-1, 1LL << 40, 3});
+
+		c = s->column(3);
+		c->setColumnMode(AbstractColumn::ColumnMode::Text);
+		c->replaceTexts(0, {QStringLiteral("a"), QString(), QStringLiteral("ü")});
+
+		c = s->column(4);
+		c->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+		c->replaceDateTimes(0, {dateTime, QDateTime(), dateTime.addDays(1)});
+
+		auto* tempFile = new QTemporaryFile(QStringLiteral("XXXXXX_testLoadSaveBinaryData.lml"), this);
+		QVERIFY(tempFile->open());
+		savePath = tempFile->fileName();
+		tempFile->close();
+
+		QFile file(savePath);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		ProjectDataWriter dataWriter(&file);
+		QVERIFY(project.save(QPixmap(), &dataWriter));
+		file.close();
+	}
+
+	QVERIFY(ProjectDataContainer::isContainer(savePath));
+
+	Project project;
+	QVERIFY(project.load(savePath));
+
+	const auto& spreadsheets = project.children<Spreadsheet>();
+	QCOMPARE(spreadsheets.size(), 1);
+	const auto& columns = spreadsheets.at(0)->children<Column>();
+	QCOMPARE(columns.size(), 5);
+	for (const auto* column : columns)
+		QCOMPARE(column->rowCount(), 3);
+
+	auto* c = columns.at(0);
+	QCOMPARE(c->valueAt(0), 1.5);
+	QVERIFY(std::isnan(c->valueAt(1)));
+	QCOMPARE(c->valueAt(2), -3.);
+
+	c = columns.at(1);
+	QCOMPARE(c->integerAt(0), 1);
+	QCOMPARE(c->integerAt(2), 3);
+	QCOMPARE(c->isValid(0), true);
+	QCOMPARE(c->isValid(1), false);
+
+	c = columns.at(2);
+	QCOMPARE(c->bigIntAt(0), qint64(-1));
+	QCOMPARE(c->bigIntAt(1), 1LL << 40);
+
+	c = columns.at(3);
+	QCOMPARE(c->textAt(0), QStringLiteral("a"));
+	QCOMPARE(c->textAt(1), QString());
+	QCOMPARE(c->textAt(2), QStringLiteral("ü"));
+
+	c = columns.at(4);
+	QCOMPARE(c->dateTimeAt(0), dateTime);
+	QVERIFY(!c->dateTimeAt(1).isValid());
+	QCOMPARE(c->dateTimeAt(2), dateTime.addDays(1));
+}
+
+/*!
+ * the column data still pending in the loaded project file is kept when the file is overwritten
+ */
+void ColumnTest::testLoadSaveBinaryDataOverwrite() {
+	QString savePath;
+	{
+		Project project;
+		auto* s = new Spreadsheet(QStringLiteral("MySpreadsheet"));
+		project.addChild(s);
+		s->setColumnCount(2);
+		s->setRowCount(3);
+		s->column(0)->replaceValues(0, {1., 2., 3.});
+		s->column(1)->replaceValues(0, {4., 5., 6.});
+
+		auto* tempFile = new QTemporaryFile(QStringLiteral("XXXXXX_testLoadSaveBinaryDataOverwrite.lml"), this);
+		QVERIFY(tempFile->open());
+		savePath = tempFile->fileName();
+		tempFile->close();
+
+		QFile file(savePath);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		ProjectDataWriter dataWriter(&file);
+		QVERIFY(project.save(QPixmap(), &dataWriter));
+		file.close();
+	}
+
+	Project project;
+	QVERIFY(project.load(savePath));
+	auto* s = project.child<Spreadsheet>(0);
+	QVERIFY(s);
+
+	// the removed column is only referenced in the undo history and is not saved, its data is still pending
+	auto* removed = s->column(1);
+	removed->remove();
+	QCOMPARE(s->columnCount(), 1);
+
+	// overwrite the project file
+	QVERIFY(project.releaseDataFile());
+	QVERIFY(QFile::remove(savePath));
+	QFile file(savePath);
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	ProjectDataWriter dataWriter(&file);
+	QVERIFY(project.save(QPixmap(), &dataWriter));
+	file.close();
+
+	project.undoStack()->undo();
+	QCOMPARE(s->columnCount(), 2);
+	QCOMPARE(removed->rowCount(), 3);
+	QCOMPARE(removed->valueAt(0), 4.);
+	QCOMPARE(removed->valueAt(2), 6.);
+	QCOMPARE(s->column(0)->valueAt(1), 2.);
+}
+
+/*!
+ * texts with few distinct values are kept dictionary encoded when loaded from the binary data section
+ */
+void ColumnTest::testLoadSaveTextDictionary() {
+	QString savePath;
+	{
+		Project project;
+		auto* s = new Spreadsheet(QStringLiteral("MySpreadsheet"));
+		project.addChild(s);
+		s->setColumnCount(1);
+		s->setRowCount(5000);
+
+		auto* c = s->column(0);
+		c->setColumnMode(AbstractColumn::ColumnMode::Text);
+		QVector<QString> texts;
+		for (int i = 0; i < 5000; ++i)
+			texts << ((i % 3 == 0) ? QString() : QStringLiteral("station %1").arg(i % 7));
+		c->setText(texts);
+		QVERIFY(c->compactTexts());
+
+		auto* tempFile = new QTemporaryFile(QStringLiteral("XXXXXX_testLoadSaveTextDictionary.lml"), this);
+		QVERIFY(tempFile->open());
+		savePath = tempFile->fileName();
+		tempFile->close();
+
+		QFile file(savePath);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		ProjectDataWriter dataWriter(&file);
+		QVERIFY(project.save(QPixmap(), &dataWriter));
+		file.close();
+	}
+
+	Project project;
+	QVERIFY(project.load(savePath));
+
+	const auto& columns = project.children<Column>(AbstractAspect::ChildIndexFlag::Recursive);
+	QCOMPARE(columns.size(), 1);
+	auto* c = columns.at(0);
+	QCOMPARE(c->rowCount(), 5000);
+	QCOMPARE(c->textAt(0), QString());
+	QCOMPARE(c->textAt(1), QStringLiteral("station 1"));
+	QCOMPARE(c->textAt(4999), QStringLiteral("station 1"));
+	QVERIFY(c->isDictionaryEncoded());
+	QCOMPARE(c->frequencies().size(), 7);
+}
+
+/*!
+ * the date and time values are read from the project file as milliseconds since epoch without creating QDateTime objects
+ */
+void ColumnTest::testLoadSaveDateTimeValues() {
+	const auto start = QDateTime(QDate(2020, 2, 29), QTime(23, 59, 59, 999), QTimeZone::UTC);
+	QString savePath;
+	{
+		Project project;
+		auto* s = new Spreadsheet(QStringLiteral("MySpreadsheet"));
+		project.addChild(s);
+		s->setColumnCount(1);
+		s->setRowCount(1000);
+
+		auto* c = s->column(0);
+		c->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+		QVector<QDateTime> dateTimes;
+		for (int i = 0; i < 1000; ++i)
+			dateTimes << ((i % 100 == 99) ? QDateTime() : start.addMSecs(i));
+		c->setDateTimes(dateTimes);
+		QVERIFY(c->compactDateTimes());
+
+		auto* tempFile = new QTemporaryFile(QStringLiteral("XXXXXX_testLoadSaveDateTimeValues.lml"), this);
+		QVERIFY(tempFile->open());
+		savePath = tempFile->fileName();
+		tempFile->close();
+
+		QFile file(savePath);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		ProjectDataWriter dataWriter(&file);
+		QVERIFY(project.save(QPixmap(), &dataWriter));
+		file.close();
+	}
+
+	Project project;
+	QVERIFY(project.load(savePath));
+
+	const auto& columns = project.children<Column>(AbstractAspect::ChildIndexFlag::Recursive);
+	QCOMPARE(columns.size(), 1);
+	auto* c = columns.at(0);
+	QCOMPARE(c->rowCount(), 1000);
+	QCOMPARE((int)c->dateTimeMSecs().size(), 1000);
+	QCOMPARE(c->dateTimeAt(0), start);
+	QCOMPARE(c->dateTimeAt(998), start.addMSecs(998));
+	QVERIFY(!c->isValid(99));
+	QVERIFY(!c->dateTimeAt(999).isValid());
+	QCOMPARE(c->maximum(), (double)start.addMSecs(998).toMSecsSinceEpoch());
+}
+
 // ======================================================================
 // Integer validity bitmap tests
 // ======================================================================
@@ -27,6 +27,11 @@ private Q_SLOTS:
 	void bigIntMinimum();
 	void bigIntMaximum();
 
+	// properties
+	void propertiesIncremental();
+	void propertiesMasked();
+	void sortedIndex();
+
 	// statistical properties for different column modes
 	void statisticsDouble(); // only positive double values
 	void statisticsDoubleNegative(); // contains negative values (> -100)
@@ -53,6 +58,10 @@ private Q_SLOTS:
 	// dictionary related tests for text columns
 	void testDictionaryIndex();
 	void testTextFrequencies();
+	void testTextDictionary();
+	void testTextDictionaryUndo();
+	void testDateTimeValues();
+	void testDateTimeNanoseconds();
 
 	// performance of save and load
 	void loadDoubleFromProject();
@@ -135,6 +144,10 @@ private Q_SLOTS:
 
 	void testLoadSaveNoData();
 	void testLoadSaveWithData();
+	void testLoadSaveBinaryData();
+	void testLoadSaveTextDictionary();
+	void testLoadSaveBinaryDataOverwrite();
+	void testLoadSaveDateTimeValues();
 
 	// integer validity bitmap tests
 	void integerValidityInitEmpty();
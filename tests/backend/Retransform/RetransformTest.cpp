@@ -174,6 +174,41 @@ void RetransformTest::TestResizeWindows() {
 		QCOMPARE(c.callCount(i.key()), 1);
 }
 
+/*!
+ * the curves of all plots are retransformed together at the end of the resize of the worksheet,
+ * the scene points have to be the same as when retransforming the curves one after another.
+ */
+void RetransformTest::TestResizeWindowsBatched() {
+	Project project;
+	project.load(QFINDTESTDATA(QLatin1String("data/p1.lml")));
+
+	const auto& worksheets = project.children(AspectType::Worksheet);
+	QCOMPARE(worksheets.count(), 1);
+	auto worksheet = static_cast<Worksheet*>(worksheets.at(0));
+	auto* view = static_cast<WorksheetView*>(worksheet->view());
+
+	view->resize(1000, 1000);
+	view->processResize();
+
+	// outside of the resize the curves are retransformed directly
+	const auto& curves = worksheet->children<XYCurve>(AbstractAspect::ChildIndexFlag::Recursive);
+	QCOMPARE(curves.count(), 4);
+	QVERIFY(!worksheet->deferRetransform(curves.first()));
+
+	for (auto* curve : curves) {
+		auto* d = curve->d_func();
+		d->calculateScenePoints(); // nothing to do, already done in the batch
+		const auto scenePoints = d->m_scenePoints;
+		const auto pointVisible = d->m_pointVisible;
+		QVERIFY(!scenePoints.isEmpty());
+
+		curve->retransform();
+		d->calculateScenePoints();
+		QCOMPARE(d->m_scenePoints, scenePoints);
+		QVERIFY(d->m_pointVisible == pointVisible);
+	}
+}
+
 /*!
  * \brief RetransformTest::TestZoomSelectionAutoscale
  * Check that retransform and retransform scale is called correctly during zoom and autoscale. Check
@@ -21,6 +21,7 @@ private Q_SLOTS:
 	void TestLoadProject();
 	void TestLoadProject2();
 	void TestResizeWindows();
+	void TestResizeWindowsBatched();
 	void TestPadding();
 	void TestCopyPastePlot();
 	void TestAddCurve();
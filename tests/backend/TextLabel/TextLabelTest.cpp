@@ -10,10 +10,15 @@
 
 #include "TextLabelTest.h"
 #include "backend/core/Project.h"
+#include "backend/core/Settings.h"
 #include "backend/lib/trace.h"
 #include "backend/worksheet/TextLabel.h"
 #include "backend/worksheet/TextLabelPrivate.h"
+#include "backend/worksheet/Worksheet.h"
 #include "frontend/widgets/LabelWidget.h"
+#include "tools/TeXRenderer.h"
+
+#include <KConfigGroup>
 
 struct TextProperties {
 	QColor fontColor;
@@ -310,4 +315,100 @@ void TextLabelTest::multiLabelEditColorChangeSelection() {
 	}
 }
 
+// ##############################################################################
+// ############################### LaTeX cache ##################################
+// ##############################################################################
+
+/*!
+ * the key of the rendered image in the cache must change with every formatting property having influence on the image.
+ */
+void TextLabelTest::teXCacheKey() {
+	const QString text = QStringLiteral("\\alpha^2");
+	const TeXRenderer::Formatting format{Qt::black, Qt::transparent, 12, QStringLiteral("Latin Modern Roman"), 96};
+	const QString engine = QStringLiteral("xelatex");
+	const auto key = TeXRenderer::cacheKey(text, format, engine);
+
+	QCOMPARE(TeXRenderer::cacheKey(text, format, engine), key);
+	QVERIFY(TeXRenderer::cacheKey(QStringLiteral("\\beta^2"), format, engine) != key);
+	QVERIFY(TeXRenderer::cacheKey(text, format, QStringLiteral("lualatex")) != key);
+
+	// font
+	auto format2 = format;
+	format2.fontFamily = QStringLiteral("DejaVu Sans");
+	QVERIFY(TeXRenderer::cacheKey(text, format2, engine) != key);
+	format2 = format;
+	format2.fontSize = 14;
+	QVERIFY(TeXRenderer::cacheKey(text, format2, engine) != key);
+
+	// colors
+	format2 = format;
+	format2.fontColor = Qt::red;
+	QVERIFY(TeXRenderer::cacheKey(text, format2, engine) != key);
+	format2 = format;
+	format2.backgroundColor = Qt::yellow;
+	QVERIFY(TeXRenderer::cacheKey(text, format2, engine) != key);
+
+	// the resolution is only relevant for the DVI files produced by latex
+	format2 = format;
+	format2.dpi = 300;
+	QCOMPARE(TeXRenderer::cacheKey(text, format2, engine), key);
+	QVERIFY(TeXRenderer::cacheKey(text, format2, QStringLiteral("latex")) != TeXRenderer::cacheKey(text, format, QStringLiteral("latex")));
+}
+
+/*!
+ * a cached image is returned without running the LaTeX engine.
+ */
+void TextLabelTest::teXCacheHit() {
+	QStandardPaths::setTestModeEnabled(true); // don't touch the cache of the user
+	TeXRenderer::clearCache();
+
+	const QString text = QStringLiteral("x_{cached}");
+	const TeXRenderer::Formatting format{Qt::black, Qt::transparent, 12, QString(), 96};
+	const auto& engine = Settings::group(QStringLiteral("Settings_Worksheet")).readEntry(QStringLiteral("LaTeXEngine"), QStringLiteral("pdflatex"));
+	const auto key = TeXRenderer::cacheKey(text, format, engine);
+	QVERIFY(TeXRenderer::cachedImage(key).isEmpty());
+
+	// not a valid image, the renderer must return it as it is
+	const QByteArray data("cached image data");
+	TeXRenderer::cacheImage(key, data);
+	QCOMPARE(TeXRenderer::cachedImage(key), data);
+	QVERIFY(QFile::exists(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/latex/") + QLatin1String(key)
+						  + QStringLiteral(".pdf")));
+
+	TeXRenderer::Result result;
+	QCOMPARE(TeXRenderer::renderImageLaTeX(text, &result, format), data);
+	QVERIFY(result.successful);
+	QVERIFY(result.errorMessage.isEmpty());
+
+	// the same image is returned for repeated requests
+	QCOMPARE(TeXRenderer::renderImageLaTeX(text, &result, format), data);
+
+	TeXRenderer::clearCache();
+	QVERIFY(TeXRenderer::cachedImage(key).isEmpty());
+}
+
+/*!
+ * the TeX image rendered in the background is applied in waitForTeXImage() and not a second time
+ * when the notification about the finished rendering arrives later.
+ */
+void TextLabelTest::teXWaitForImage() {
+	Project project;
+	auto* ws = new Worksheet(QStringLiteral("worksheet"));
+	project.addChild(ws);
+	ws->view(); // the zoom factor of the view is used for the image
+
+	auto* l = new TextLabel(QStringLiteral("Label"));
+	ws->addChild(l);
+	QSignalSpy spy(l, &TextLabel::teXImageUpdated);
+
+	l->setText(TextLabel::TextWrapper(QStringLiteral("x^2"), TextLabel::Mode::LaTeX, false));
+	l->waitForTeXImage();
+	QCOMPARE(spy.count(), 1);
+
+	// nothing pending anymore
+	l->waitForTeXImage();
+	QTest::qWait(50);
+	QCOMPARE(spy.count(), 1);
+}
+
 QTEST_MAIN(TextLabelTest)
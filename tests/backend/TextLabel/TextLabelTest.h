@@ -22,6 +22,10 @@ private Q_SLOTS:
 	void multiLabelEditColorChange();
 	void multiLabelEditTextChange();
 	void multiLabelEditColorChangeSelection();
+
+	void teXCacheKey();
+	void teXCacheHit();
+	void teXWaitForImage();
 };
 
 #endif
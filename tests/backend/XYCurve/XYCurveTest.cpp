@@ -24,6 +24,7 @@
 #include "backend/worksheet/plots/cartesian/XYEquationCurve.h"
 
 #include <QFile>
+#include <QPainter>
 
 #define GET_CURVE_PRIVATE(plot, child_index, column_name, curve_variable_name)                                                                                 \
 	auto* curve_variable_name = plot->child<XYCurve>(child_index);                                                                                             \
@@ -2501,6 +2502,194 @@ void XYCurveTest::lineMonotonicIncreasingPlotRangeDecreasing() {
 	QCOMPARE(callCounter, 1);
 }
 
+/*!
+ * large curves are rendered in a worker thread, the outdated pixmap is used until the rendering is finished
+ */
+void XYCurveTest::asyncRendering() {
+	Project project;
+
+	auto* worksheet = new Worksheet(QStringLiteral("Worksheet"));
+	project.addChild(worksheet);
+
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	worksheet->addChild(plot);
+	plot->setType(CartesianPlot::Type::TwoAxes); // Otherwise no axes are created
+
+	auto* sheet = new Spreadsheet(QStringLiteral("data"), false);
+	project.addChild(sheet);
+	sheet->setColumnCount(2);
+	const int rows = 200000;
+	sheet->setRowCount(rows);
+
+	const auto& columns = sheet->children<Column>();
+	QCOMPARE(columns.count(), 2);
+	Column* xColumn = columns.at(0);
+	Column* yColumn = columns.at(1);
+
+	QVector<double> xValues(rows);
+	QVector<double> yValues(rows);
+	for (int i = 0; i < rows; ++i) {
+		xValues[i] = i;
+		yValues[i] = std::sin(i / 1000.);
+	}
+	xColumn->replaceValues(-1, xValues);
+	yColumn->replaceValues(-1, yValues);
+
+	auto* curve = new XYCurve(QStringLiteral("curve"));
+	plot->addChild(curve);
+	curve->symbol()->setStyle(Symbol::Style::Circle);
+	curve->setXColumn(xColumn);
+	curve->setYColumn(yColumn);
+
+	auto* curvePrivate = curve->d_func();
+	QCOMPARE(curvePrivate->m_logicalPoints.size(), rows);
+	QVERIFY(curvePrivate->asyncRenderingEnabled());
+
+	// wait for the background rendering to finish
+	QTRY_VERIFY_WITH_TIMEOUT(!curvePrivate->m_pixmapOutdated, 30000);
+	QVERIFY(!curvePrivate->m_pixmap.isNull());
+	QCOMPARE(curvePrivate->m_pixmap.width(), (int)std::ceil(curvePrivate->m_boundingRectangle.width()));
+	QCOMPARE(curvePrivate->m_pixmap.height(), (int)std::ceil(curvePrivate->m_boundingRectangle.height()));
+
+	// trigger two consecutive retransforms, the first rendering is canceled and only the result of the last one is used
+	curve->retransform();
+	curve->retransform();
+	QVERIFY(curvePrivate->m_pixmapOutdated);
+
+	// the selection effect is drawn for the outdated pixmap while the new one is being rendered
+	curvePrivate->setSelected(true);
+	QVERIFY(curvePrivate->m_selectionEffectImageIsDirty);
+	QImage image(curvePrivate->m_pixmap.size(), QImage::Format_ARGB32_Premultiplied);
+	QPainter painter(&image);
+	curvePrivate->paint(&painter, nullptr);
+	painter.end();
+	QVERIFY(!curvePrivate->m_selectionEffectImageIsDirty);
+
+	QTRY_VERIFY_WITH_TIMEOUT(!curvePrivate->m_pixmapOutdated, 30000);
+	QVERIFY(!curvePrivate->m_pixmap.isNull());
+}
+
+/*!
+ * the points of large curves shown with symbols are reduced to at most two points per pixel of the plot width,
+ * the remaining points are data points spread over the whole x-range also for non-monotonic x-data.
+ */
+void XYCurveTest::downsamplingLargeCurve() {
+	Project project;
+
+	auto* worksheet = new Worksheet(QStringLiteral("Worksheet"));
+	project.addChild(worksheet);
+
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	worksheet->addChild(plot);
+	plot->setType(CartesianPlot::Type::TwoAxes); // Otherwise no axes are created
+
+	auto* sheet = new Spreadsheet(QStringLiteral("data"), false);
+	project.addChild(sheet);
+	sheet->setColumnCount(2);
+	const int rows = 200000;
+	sheet->setRowCount(rows);
+	Column* xColumn = sheet->column(0);
+	Column* yColumn = sheet->column(1);
+
+	auto* curve = new XYCurve(QStringLiteral("curve"));
+	plot->addChild(curve);
+	curve->symbol()->setStyle(Symbol::Style::Circle);
+	curve->setDownsampling(XYCurve::Downsampling::LTTB);
+	auto* curvePrivate = curve->d_func();
+
+	for (bool monotonic : {true, false}) {
+		QVector<double> xValues(rows);
+		QVector<double> yValues(rows);
+		for (int i = 0; i < rows; ++i) {
+			xValues[i] = monotonic ? i : (static_cast<qint64>(i) * 7919) % rows; // a permutation of 0 ... rows - 1
+			yValues[i] = std::sin(xValues.at(i) / 1000.);
+		}
+		xColumn->replaceValues(-1, xValues);
+		yColumn->replaceValues(-1, yValues);
+		curve->setXColumn(xColumn);
+		curve->setYColumn(yColumn);
+		QCOMPARE(xColumn->properties() == AbstractColumn::Properties::MonotonicIncreasing, monotonic);
+		QTRY_VERIFY_WITH_TIMEOUT(!curvePrivate->m_pixmapOutdated, 30000);
+
+		curvePrivate->m_scenePointsDirty = true;
+		curvePrivate->calculateScenePoints();
+		const auto& points = curvePrivate->m_scenePoints;
+		const int width = plot->dataRect().width();
+		QVERIFY(width > 0);
+		QVERIFY(points.size() > width);
+		QVERIFY(points.size() <= XYCurvePrivate::downsamplingPointsPerPixel * width);
+
+		// all shown points are data points and there are no large gaps in x
+		const auto* cSystem = plot->defaultCoordinateSystem();
+		std::vector<double> x;
+		for (const auto& point : points) {
+			const auto& logical = cSystem->mapSceneToLogical(point);
+			const double value = std::round(logical.x());
+			QVERIFY(std::abs(logical.x() - value) < 1.e-6);
+			QVERIFY(std::abs(logical.y() - std::sin(value / 1000.)) < 1.e-6);
+			x.push_back(value);
+		}
+		std::sort(x.begin(), x.end());
+		QCOMPARE(x.front(), 0.);
+		QCOMPARE(x.back(), rows - 1.);
+		const double maxGap = 3. * rows / points.size();
+		for (size_t i = 1; i < x.size(); ++i)
+			QVERIFY(x.at(i) - x.at(i - 1) <= maxGap);
+	}
+}
+
+void XYCurveTest::downsamplingSaveLoad() {
+	QString savePath;
+	{
+		Project project;
+		auto* worksheet = new Worksheet(QStringLiteral("Worksheet"));
+		project.addChild(worksheet);
+		auto* plot = new CartesianPlot(QStringLiteral("plot"));
+		worksheet->addChild(plot);
+		auto* curve = new XYCurve(QStringLiteral("curve"));
+		plot->addChild(curve);
+
+		curve->setDownsampling(XYCurve::Downsampling::MinMaxLTTB);
+		QCOMPARE(curve->downsampling(), XYCurve::Downsampling::MinMaxLTTB);
+
+		SAVE_PROJECT("downsamplingSaveLoad");
+	}
+
+	{
+		Project project;
+		QCOMPARE(project.load(savePath), true);
+
+		const auto* worksheet = project.child<Worksheet>(0);
+		QVERIFY(worksheet);
+		const auto* plot = worksheet->child<CartesianPlot>(0);
+		QVERIFY(plot);
+		const auto* curve = plot->child<XYCurve>(0);
+		QVERIFY(curve);
+		QCOMPARE(curve->downsampling(), XYCurve::Downsampling::MinMaxLTTB);
+	}
+}
+
+void XYCurveTest::downsamplingUndo() {
+	Project project;
+	auto* worksheet = new Worksheet(QStringLiteral("Worksheet"));
+	project.addChild(worksheet);
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	worksheet->addChild(plot);
+	auto* curve = new XYCurve(QStringLiteral("curve"));
+	plot->addChild(curve);
+
+	const auto initial = curve->downsampling();
+	const auto downsampling = (initial == XYCurve::Downsampling::LTTB) ? XYCurve::Downsampling::MinMaxLTTB : XYCurve::Downsampling::LTTB;
+	curve->setDownsampling(downsampling);
+	QCOMPARE(curve->downsampling(), downsampling);
+
+	curve->undoStack()->undo();
+	QCOMPARE(curve->downsampling(), initial);
+
+	curve->undoStack()->redo();
+	QCOMPARE(curve->downsampling(), downsampling);
+}
+
 // ############################################################################
 //  Hover tests
 // ############################################################################
@@ -73,6 +73,11 @@ private Q_SLOTS:
 
 	void lineMonotonicIncreasing();
 	void lineMonotonicIncreasingPlotRangeDecreasing();
+
+	void asyncRendering();
+	void downsamplingLargeCurve();
+	void downsamplingSaveLoad();
+	void downsamplingUndo();
 };
 
 #endif // XYCURVETEST_H
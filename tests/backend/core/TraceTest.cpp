@@ -0,0 +1,121 @@
+/*
+	File                 : TraceTest.cpp
+	Project              : LabPlot
+	Description          : Tests for the performance tracing
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "TraceTest.h"
+#include "backend/lib/trace.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QtConcurrentRun>
+
+namespace {
+// writes the recorded trace and returns the events with the name \c name
+QVector<QJsonObject> traceEvents(const QString& name) {
+	QTemporaryFile file;
+	if (!file.open() || !PerfTrace::writeTrace(file.fileName()))
+		return {};
+
+	const auto& document = QJsonDocument::fromJson(file.readAll());
+	QVector<QJsonObject> events;
+	for (const auto& value : document.object().value(QStringLiteral("traceEvents")).toArray()) {
+		const auto& event = value.toObject();
+		if (event.value(QStringLiteral("name")).toString() == name)
+			events << event;
+	}
+	return events;
+}
+}
+
+/*!
+ * the span has to cover the complete enclosing scope and not to be closed immediately.
+ */
+void TraceTest::scopedSpan() {
+	PerfTrace::startRecording();
+	{
+		PERFTRACE(QStringLiteral("scopedSpan"));
+		QThread::msleep(20);
+	}
+	PerfTrace::stopRecording();
+
+	const auto& events = traceEvents(QStringLiteral("scopedSpan"));
+	QCOMPARE(events.size(), 1);
+	QCOMPARE(events.first().value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+	QVERIFY(events.first().value(QStringLiteral("dur")).toDouble() >= 20000.); // in us
+}
+
+void TraceTest::nestedSpansAndCounters() {
+	PerfTrace::startRecording();
+	{
+		PERFTRACE(QStringLiteral("outerSpan"));
+		{
+			PERFTRACE(QStringLiteral("innerSpan"));
+			PERFTRACE_COUNTER("rows", 42);
+		}
+	}
+	PerfTrace::stopRecording();
+
+	// the counter macro is a single statement, the else branch belongs to the if at the call site
+	bool elseBranch = false;
+	if (PerfTrace::isRecording()) // false, the recording was stopped
+		PERFTRACE_COUNTER("rows", 0);
+	else
+		elseBranch = true;
+	QVERIFY(elseBranch);
+
+	const auto& outer = traceEvents(QStringLiteral("outerSpan"));
+	const auto& inner = traceEvents(QStringLiteral("innerSpan"));
+	QCOMPARE(outer.size(), 1);
+	QCOMPARE(inner.size(), 1);
+
+	// the inner span lies completely within the outer span
+	const double outerStart = outer.first().value(QStringLiteral("ts")).toDouble();
+	const double outerEnd = outerStart + outer.first().value(QStringLiteral("dur")).toDouble();
+	const double innerStart = inner.first().value(QStringLiteral("ts")).toDouble();
+	const double innerEnd = innerStart + inner.first().value(QStringLiteral("dur")).toDouble();
+	QVERIFY(innerStart >= outerStart);
+	QVERIFY(innerEnd <= outerEnd);
+
+	const auto& counters = traceEvents(QStringLiteral("rows"));
+	QCOMPARE(counters.size(), 1);
+	QCOMPARE(counters.first().value(QStringLiteral("ph")).toString(), QStringLiteral("C"));
+	QCOMPARE(counters.first().value(QStringLiteral("args")).toObject().value(QStringLiteral("value")).toInt(), 42);
+
+	// nothing is recorded if the recording is not active
+	{
+		PERFTRACE(QStringLiteral("notRecorded"));
+	}
+	QCOMPARE(traceEvents(QStringLiteral("notRecorded")).size(), 0);
+}
+
+/*!
+ * spans in different threads are recorded with different thread ids.
+ */
+void TraceTest::threads() {
+	PerfTrace::startRecording();
+	{
+		PERFTRACE(QStringLiteral("mainThreadSpan"));
+	}
+	auto future = QtConcurrent::run([]() {
+		PERFTRACE(QStringLiteral("workerThreadSpan"));
+	});
+	future.waitForFinished();
+	PerfTrace::stopRecording();
+
+	const auto& mainEvents = traceEvents(QStringLiteral("mainThreadSpan"));
+	const auto& workerEvents = traceEvents(QStringLiteral("workerThreadSpan"));
+	QCOMPARE(mainEvents.size(), 1);
+	QCOMPARE(workerEvents.size(), 1);
+	QVERIFY(mainEvents.first().value(QStringLiteral("tid")).toInt() != workerEvents.first().value(QStringLiteral("tid")).toInt());
+}
+
+QTEST_MAIN(TraceTest)
@@ -0,0 +1,25 @@
+/*
+	File                 : TraceTest.h
+	Project              : LabPlot
+	Description          : Tests for the performance tracing
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 The LabPlot Team
+
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef TRACETEST_H
+#define TRACETEST_H
+
+#include "../../CommonTest.h"
+
+class TraceTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void scopedSpan();
+	void nestedSpansAndCounters();
+	void threads();
+};
+
+#endif
@@ -195,4 +195,78 @@ void CartesianCoordinateSystemTest::testMapLogicalToSceneLinesPerformance() {
 	}
 }
 
+/*!
+ * compare the batch mapping of the points with separate x- and y-values (in parallel for this number of points)
+ * with the mapping of the single points for all types of scales, also for values outside of the ranges and of the domains of the scales
+ */
+void CartesianCoordinateSystemTest::testMapLogicalToScenePoints() {
+	const int count = 100000;
+	std::vector<double> x(count), y(count);
+	for (int i = 0; i < count; i++) {
+		x[i] = -2. + 14. * i / count;
+		y[i] = 4. + 7. * ((i * 7919) % count) / count;
+	}
+	x[count / 7] = 0.;
+
+	const Range<double> rangeX(0.5, 10.);
+	const Range<double> sceneRangeX(0., 100.);
+	const Range<double> logicalRangeX(0.5, 10.);
+	const Range<double> rangeY(5., 10.);
+	const Range<double> sceneRangeY(10., 100.);
+	const Range<double> logicalRangeY(5., 10.);
+
+	for (int type = 0; type < 5; type++) {
+		CartesianPlot plot(QStringLiteral("plot"));
+		CartesianCoordinateSystem cSystem(&plot);
+
+		CartesianScale* xScale = nullptr;
+		switch (type) {
+		case 0:
+			xScale = CartesianScale::createLinearScale(rangeX, sceneRangeX, logicalRangeX);
+			break;
+		case 1:
+			xScale = CartesianScale::createLogScale(rangeX, sceneRangeX, logicalRangeX, RangeT::Scale::Log10);
+			break;
+		case 2:
+			xScale = CartesianScale::createSqrtScale(rangeX, sceneRangeX, logicalRangeX);
+			break;
+		case 3:
+			xScale = CartesianScale::createSquareScale(rangeX, sceneRangeX, logicalRangeX);
+			break;
+		case 4:
+			xScale = CartesianScale::createInverseScale(rangeX, sceneRangeX, logicalRangeX);
+			break;
+		}
+
+		// Takes ownership of the scales!
+		cSystem.setScales(Dimension::X, {xScale});
+		cSystem.setScales(Dimension::Y, {CartesianScale::createLinearScale(rangeY, sceneRangeY, logicalRangeY)});
+		QVERIFY(cSystem.isValid());
+
+		std::vector<double> sceneX(count), sceneY(count);
+		std::vector<quint8> visible(count);
+		cSystem.mapLogicalToScene(x, y, sceneX, sceneY, visible);
+
+		int visibleCount = 0;
+		for (int i = 0; i < count; i++) {
+			bool pointVisible;
+			const auto point = cSystem.mapLogicalToScene(QPointF(x.at(i), y.at(i)), pointVisible);
+			QCOMPARE(bool(visible.at(i)), pointVisible);
+			if (!pointVisible)
+				continue;
+
+			VALUES_EQUAL(sceneX.at(i), point.x());
+			VALUES_EQUAL(sceneY.at(i), point.y());
+			visibleCount++;
+		}
+		QVERIFY(visibleCount > 0);
+		QVERIFY(visibleCount < count);
+
+		Points points;
+		for (int i = 0; i < count; i++)
+			points << QPointF(x.at(i), y.at(i));
+		QCOMPARE(cSystem.mapLogicalToScene(points).size(), visibleCount);
+	}
+}
+
 QTEST_MAIN(CartesianCoordinateSystemTest)
@@ -20,6 +20,7 @@ private Q_SLOTS:
 	void testMapLogicalToSceneLines();
 	void testMapLogicalToSceneLinesClipping();
 	void testMapLogicalToSceneLinesPerformance();
+	void testMapLogicalToScenePoints();
 };
 
 #endif // CARTESIANCOORDINATESYSTEMTEST_H
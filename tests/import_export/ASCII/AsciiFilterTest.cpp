@@ -11,6 +11,7 @@
 
 #include "AsciiFilterTest.h"
 #include "backend/core/Project.h"
+#include "backend/core/Time.h"
 #include "backend/core/column/Column.h"
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/datasources/filters/AsciiFilterPrivate.h"
@@ -24,6 +25,7 @@
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 
 #include <KCompressionDevice>
+#include <QTimeZone>
 #include <QXmlStreamWriter>
 
 #include <gsl/gsl_randist.h>
@@ -2506,6 +2508,49 @@ void AsciiFilterTest::testTimestamp() {
 	QCOMPARE(spreadsheet.column(3)->valueAt(7), 17.6);
 }
 
+void AsciiFilterTest::testTimestampNanoseconds() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	AsciiFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/timestamp_nanoseconds.csv"));
+
+	auto p = filter.properties();
+	p.automaticSeparatorDetection = false;
+	p.separator = QStringLiteral(",");
+	p.headerEnabled = true;
+	p.dataTypesString = QStringLiteral("TimestampUnix,TimestampWindows,Double");
+	filter.setProperties(p);
+
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+
+	// the timestamps are kept with nanosecond resolution
+	const qint64 start = 1706006400LL * 1000000000LL;
+	const auto unixValues = spreadsheet.column(0)->dateTimeNSecs();
+	QCOMPARE((int)unixValues.size(), 3);
+	QCOMPARE(unixValues[0], start + 1);
+	QCOMPARE(unixValues[1], start + 250500);
+	QCOMPARE(unixValues[2], start + 1500000);
+
+	const auto windowsValues = spreadsheet.column(1)->dateTimeNSecs();
+	QCOMPARE((int)windowsValues.size(), 3);
+	QCOMPARE(windowsValues[0], start + 100);
+	QCOMPARE(windowsValues[1], start + 250500);
+	QCOMPARE(windowsValues[2], start + 1500000);
+
+	// QDateTime only has milliseconds
+	const auto value = QDateTime(QDate(2024, 1, 23), QTime(10, 40), QTimeZone::UTC);
+	QCOMPARE(spreadsheet.column(0)->dateTimeAt(0), value);
+	QCOMPARE(spreadsheet.column(0)->dateTimeAt(2), value.addMSecs(1));
+	QCOMPARE(spreadsheet.column(1)->dateTimeAt(2), value.addMSecs(1));
+	QCOMPARE(spreadsheet.column(2)->valueAt(2), 3.);
+
+	// sub-millisecond formats
+	QCOMPARE(DateTime::toString(unixValues[1], QStringLiteral("hh:mm:ss.zzzzzzzzz")), QLatin1String("10:40:00.000250500"));
+	QCOMPARE(DateTime::toString(unixValues[1], QStringLiteral("ss.zzzzzz")), QLatin1String("00.000250"));
+}
+
 // Keep all values
 void AsciiFilterTest::testAppendRows() {
 	Spreadsheet spreadsheet(QStringLiteral("test"), false);
@@ -2651,6 +2696,125 @@ void AsciiFilterTest::keepLast() {
 	QCOMPARE(spreadsheet.column(1)->integerAt(3), 16);
 }
 
+// payloads of several messages read in one step like in MQTTTopic::read()
+void AsciiFilterTest::readFromBuffers() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	AsciiFilter filter;
+
+	auto p = filter.properties();
+	p.automaticSeparatorDetection = false;
+	p.separator = QStringLiteral(";");
+	p.headerEnabled = false;
+	p.columnNamesString = QStringLiteral("x, y");
+	p.intAsDouble = false;
+	filter.setProperties(p);
+
+	{
+		QStringList fileContent = {
+			QStringLiteral("1;5"),
+			QStringLiteral("2;6"),
+			QStringLiteral("3;7"),
+		};
+
+		QString savePath;
+		SAVE_FILE("testfile", fileContent);
+		filter.readDataFromFile(savePath, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	}
+
+	QCOMPARE(spreadsheet.rowCount(), 3);
+
+	const QVector<QByteArray> payloads{QByteArray("11;12\n13;14"), QByteArray(), QByteArray("15;16\n")};
+	filter.readFromBuffers(payloads, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append, 4);
+
+	QCOMPARE(spreadsheet.rowCount(), 4);
+	QCOMPARE(spreadsheet.columnCount(), 2);
+
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 3);
+	QCOMPARE(spreadsheet.column(0)->integerAt(1), 11);
+	QCOMPARE(spreadsheet.column(0)->integerAt(2), 13);
+	QCOMPARE(spreadsheet.column(0)->integerAt(3), 15);
+
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->integerAt(0), 7);
+	QCOMPARE(spreadsheet.column(1)->integerAt(1), 12);
+	QCOMPARE(spreadsheet.column(1)->integerAt(2), 14);
+	QCOMPARE(spreadsheet.column(1)->integerAt(3), 16);
+
+	// without limit all rows are appended
+	filter.readFromBuffers({QByteArray("17;18"), QByteArray("19;20")}, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append);
+
+	QCOMPARE(spreadsheet.rowCount(), 6);
+	QCOMPARE(spreadsheet.column(0)->integerAt(4), 17);
+	QCOMPARE(spreadsheet.column(1)->integerAt(5), 20);
+}
+
+// payloads parsed in a worker thread and appended afterwards like in MQTTTopic::read()
+void AsciiFilterTest::readParsedBuffers() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	AsciiFilter filter;
+
+	auto p = filter.properties();
+	p.automaticSeparatorDetection = false;
+	p.separator = QStringLiteral(";");
+	p.headerEnabled = false;
+	p.columnNamesString = QStringLiteral("x, s");
+	p.intAsDouble = false;
+	filter.setProperties(p);
+
+	// the columns are not created yet
+	QVERIFY(!filter.prepareParsing({QByteArray("0;a")}));
+
+	{
+		QStringList fileContent = {
+			QStringLiteral("1;a"),
+			QStringLiteral("2;b"),
+			QStringLiteral("3;c"),
+		};
+
+		QString savePath;
+		SAVE_FILE("testfile", fileContent);
+		filter.readDataFromFile(savePath, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	}
+
+	QCOMPARE(spreadsheet.rowCount(), 3);
+
+	const QVector<QByteArray> payloads{QByteArray("11;d\n13;e"), QByteArray(), QByteArray("15;f\n")};
+	auto parsedData = filter.prepareParsing(payloads);
+	QVERIFY(parsedData);
+	AsciiFilter::parse(*parsedData);
+
+	// nothing is appended before the parsed data is committed
+	QCOMPARE(spreadsheet.rowCount(), 3);
+
+	filter.appendParsedData(*parsedData, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append, 4);
+
+	QCOMPARE(spreadsheet.rowCount(), 4);
+	QCOMPARE(spreadsheet.columnCount(), 2);
+
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 3);
+	QCOMPARE(spreadsheet.column(0)->integerAt(1), 11);
+	QCOMPARE(spreadsheet.column(0)->integerAt(2), 13);
+	QCOMPARE(spreadsheet.column(0)->integerAt(3), 15);
+
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(1)->textAt(0), QStringLiteral("c"));
+	QCOMPARE(spreadsheet.column(1)->textAt(1), QStringLiteral("d"));
+	QCOMPARE(spreadsheet.column(1)->textAt(2), QStringLiteral("e"));
+	QCOMPARE(spreadsheet.column(1)->textAt(3), QStringLiteral("f"));
+
+	// without limit all rows are appended
+	parsedData = filter.prepareParsing({QByteArray("17;g"), QByteArray("19;h")});
+	QVERIFY(parsedData);
+	AsciiFilter::parse(*parsedData);
+	filter.appendParsedData(*parsedData, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append);
+
+	QCOMPARE(spreadsheet.rowCount(), 6);
+	QCOMPARE(spreadsheet.column(0)->integerAt(4), 17);
+	QCOMPARE(spreadsheet.column(1)->textAt(5), QStringLiteral("h"));
+}
+
 void AsciiFilterTest::testAppendColumns() {
 	Spreadsheet spreadsheet(QStringLiteral("test"), false);
 	{
@@ -110,12 +110,15 @@ private Q_SLOTS:
 	void testDateTimeAutodetect();
 	void testDateTimeHex();
 	void testTimestamp();
+	void testTimestampNanoseconds();
 
 	// matrix import
 	void testMatrixHeader();
 
 	void testAppendRows();
 	void keepLast();
+	void readFromBuffers();
+	void readParsedBuffers();
 
 	void testAppendColumns();
 	void testPrependColumns();
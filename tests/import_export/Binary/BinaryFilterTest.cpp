@@ -13,6 +13,10 @@
 #include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <KCompressionDevice>
+#include <QTemporaryDir>
+#include <QtEndian>
+
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
 
@@ -292,6 +296,166 @@ void BinaryFilterTest::importDoubleMatrixBE() {
 
 /////////////////////////////////////////////////////////////////
 
+// records with different data types and byte orders
+
+namespace {
+const int layoutRows = 100000;
+const size_t layoutHeaderSize = 10;
+const size_t layoutRecordSize = 16;
+const QVector<BinaryFilter::Field> layoutFields{{BinaryFilter::DataType::INT16, 0, QDataStream::LittleEndian},
+												{BinaryFilter::DataType::INT16, 2, QDataStream::LittleEndian},
+												{BinaryFilter::DataType::REAL64, 8, QDataStream::BigEndian}};
+
+// header followed by records of two int16 channels (little endian), four bytes padding and a double timestamp (big endian)
+void writeLayoutRecords(QIODevice& device) {
+	device.write(QByteArray(layoutHeaderSize, 'h'));
+	for (int i = 0; i < layoutRows; ++i) {
+		char record[layoutRecordSize] = {};
+		qToLittleEndian<qint16>(static_cast<qint16>(i % 30000), record);
+		qToLittleEndian<qint16>(static_cast<qint16>(-(i % 20000)), record + 2);
+		qToBigEndian<double>(i * 0.5, record + 8);
+		device.write(record, layoutRecordSize);
+	}
+}
+}
+
+void BinaryFilterTest::importRecordLayout() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	writeLayoutRecords(file);
+	file.close();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	filter.setRecordLayout(layoutFields, layoutRecordSize);
+	filter.setSkipStartBytes(layoutHeaderSize);
+	QCOMPARE(filter.recordSize(), layoutRecordSize);
+	filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), layoutRows);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Double);
+
+	for (int i : {0, 1, 12345, 65535, 65536, layoutRows - 1}) {
+		QCOMPARE(spreadsheet.column(0)->integerAt(i), i % 30000);
+		QCOMPARE(spreadsheet.column(1)->integerAt(i), -(i % 20000));
+		QCOMPARE(spreadsheet.column(2)->valueAt(i), i * 0.5);
+	}
+}
+
+void BinaryFilterTest::importRecordLayoutStartRow() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	writeLayoutRecords(file);
+	file.close();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	filter.setRecordLayout(layoutFields, layoutRecordSize);
+	filter.setSkipStartBytes(layoutHeaderSize);
+	filter.setStartRow(101);
+	filter.setEndRow(200);
+	filter.setCreateIndexEnabled(true);
+	filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.rowCount(), 100);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(1)->integerAt(0), 100);
+	QCOMPARE(spreadsheet.column(2)->integerAt(0), -100);
+	QCOMPARE(spreadsheet.column(3)->valueAt(0), 50.);
+	QCOMPARE(spreadsheet.column(0)->integerAt(99), 100);
+	QCOMPARE(spreadsheet.column(1)->integerAt(99), 199);
+	QCOMPARE(spreadsheet.column(3)->valueAt(99), 99.5);
+
+	// preview of the same rows
+	const auto& preview = filter.preview(file.fileName(), 2);
+	QCOMPARE(preview.size(), 2);
+	QCOMPARE(preview.at(1), (QStringList{QStringLiteral("2"), QStringLiteral("101"), QStringLiteral("-101"), QStringLiteral("50.5")}));
+}
+
+/*!
+ * only the records appended since the last read are read from a live file, incomplete records are read with the next update.
+ */
+void BinaryFilterTest::importLiveAppend() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	writeLayoutRecords(file);
+	file.flush();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	filter.setRecordLayout(layoutFields, layoutRecordSize);
+	filter.setSkipStartBytes(layoutHeaderSize);
+	filter.setCreateIndexEnabled(true);
+
+	QFile device(file.fileName());
+	qint64 bytesRead = filter.readFromLiveDevice(device, &spreadsheet, 0);
+	QCOMPARE(bytesRead, static_cast<qint64>(layoutHeaderSize + layoutRows * layoutRecordSize));
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.rowCount(), layoutRows);
+
+	// append one and a half records
+	char record[layoutRecordSize] = {};
+	qToLittleEndian<qint16>(42, record);
+	qToBigEndian<double>(-1., record + 8);
+	file.write(record, layoutRecordSize);
+	file.write(record, layoutRecordSize / 2);
+	file.flush();
+
+	bytesRead += filter.readFromLiveDevice(device, &spreadsheet, bytesRead);
+	QCOMPARE(bytesRead, static_cast<qint64>(layoutHeaderSize + (layoutRows + 1) * layoutRecordSize));
+	QCOMPARE(spreadsheet.rowCount(), layoutRows + 1);
+	QCOMPARE(spreadsheet.column(0)->integerAt(layoutRows), layoutRows + 1);
+	QCOMPARE(spreadsheet.column(1)->integerAt(layoutRows), 42);
+	QCOMPARE(spreadsheet.column(3)->valueAt(layoutRows), -1.);
+	QCOMPARE(spreadsheet.column(3)->valueAt(layoutRows - 1), (layoutRows - 1) * 0.5);
+
+	// complete the record, only the last 10 rows are kept
+	file.write(record + layoutRecordSize / 2, layoutRecordSize / 2);
+	file.flush();
+	bytesRead += filter.readFromLiveDevice(device, &spreadsheet, bytesRead, -1, 10);
+	QCOMPARE(bytesRead, static_cast<qint64>(layoutHeaderSize + (layoutRows + 2) * layoutRecordSize));
+	QCOMPARE(spreadsheet.rowCount(), 10);
+	QCOMPARE(spreadsheet.column(0)->integerAt(9), layoutRows + 2);
+	QCOMPARE(spreadsheet.column(1)->integerAt(9), 42);
+	QCOMPARE(spreadsheet.column(3)->valueAt(7), (layoutRows - 1) * 0.5);
+
+	// nothing new
+	QCOMPARE(filter.readFromLiveDevice(device, &spreadsheet, bytesRead), 0);
+	QCOMPARE(spreadsheet.rowCount(), 10);
+}
+
+void BinaryFilterTest::importRecordLayoutCompressed() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("records.bin.gz"));
+	{
+		KCompressionDevice file(fileName, KCompressionDevice::GZip);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		writeLayoutRecords(file);
+	}
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	filter.setRecordLayout(layoutFields, layoutRecordSize);
+	filter.setSkipStartBytes(layoutHeaderSize);
+	filter.setStartRow(3);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), layoutRows - 2);
+	for (int i : {0, 1, 12345, layoutRows - 3}) {
+		QCOMPARE(spreadsheet.column(0)->integerAt(i), (i + 2) % 30000);
+		QCOMPARE(spreadsheet.column(1)->integerAt(i), -((i + 2) % 20000));
+		QCOMPARE(spreadsheet.column(2)->valueAt(i), (i + 2) * 0.5);
+	}
+}
+
+/////////////////////////////////////////////////////////////////
+
 // INT data
 
 void BinaryFilterTest::benchIntImport_data() {
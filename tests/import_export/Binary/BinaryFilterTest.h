@@ -28,6 +28,11 @@ private Q_SLOTS:
 
 	void importDoubleMatrixBE();
 
+	void importRecordLayout();
+	void importRecordLayoutStartRow();
+	void importRecordLayoutCompressed();
+	void importLiveAppend();
+
 	void benchIntImport_data();
 	// this is called multiple times (warm-up of BENCHMARK)
 	// see https://stackoverflow.com/questions/36916962/qtest-executes-test-case-twic
@@ -750,6 +750,87 @@ BO_ 541 MSG2: 8 Vector__XXX
 	}
 }
 
+// Separate time column for every message, the signals are imported with their native rate
+void BLFFilterTest::testSeparateTimeLittleEndian() {
+	QTemporaryFile blfFileName(QStringLiteral("XXXXXX.blf"));
+	QVERIFY(blfFileName.open());
+	QVector<Vector::BLF::CanMessage2*> messages{
+		createCANMessage(337, 5, {0, 4, 252, 19, 0, 0, 0, 0}),
+		createCANMessage(541, 10, {7, 39, 118, 33, 250, 30, 76, 24}), // 99.91, 85.66, 79.3, 22.2
+		createCANMessage(337, 15, {47, 4, 60, 29, 0, 0, 0, 0}),
+		createCANMessage(337, 20, {57, 4, 250, 29, 0, 0, 0, 0}),
+		createCANMessage(541, 25, {7, 39, 118, 33, 250, 30, 76, 24}), // 99.91, 85.66, 79.3, 22.2
+	}; // time is in nanoseconds
+	createBLFFile(blfFileName.fileName(), messages);
+
+	QTemporaryFile dbcFile(QStringLiteral("XXXXXX.dbc"));
+	QVERIFY(dbcFile.open());
+	const auto dbcContent = R"(BO_ 337 STATUS: 8 Vector__XXX
+ SG_ Value6 : 27|3@1+ (1,0) [0|7] ""  Vector__XXX
+ SG_ Value5 : 16|11@1+ (0.1,-102) [-102|102] "%"  Vector__XXX
+ SG_ Value2 : 8|2@1+ (1,0) [0|2] ""  Vector__XXX
+ SG_ Value3 : 10|1@1+ (1,0) [0|1] ""  Vector__XXX
+ SG_ Value7 : 30|2@1+ (1,0) [0|3] ""  Vector__XXX
+ SG_ Value4 : 11|4@1+ (1,0) [0|3] ""  Vector__XXX
+ SG_ Value1 : 0|8@1+ (1,0) [0|204] "Km/h"  Vector__XXX"
+BO_ 541 MSG2: 8 Vector__XXX
+ SG_ MSG2Value4 : 48|16@1+ (0.01,-40) [-40|125] "C"  Vector__XXX
+ SG_ MSG2Value1 : 0|16@1+ (0.01,0) [0|100] "%"  Vector__XXX
+ SG_ MSG2Value3 : 32|16@1+ (0.01,0) [0|100] "%"  Vector__XXX
+ SG_ MSG2Value2 : 16|16@1+ (0.01,0) [0|100] "%"  Vector__XXX
+)";
+	createDBCFile(dbcFile.fileName(), dbcContent);
+
+	// Start Test
+
+	VectorBLFFilter filter;
+	filter.setConvertTimeToSeconds(true);
+	filter.setTimeHandlingMode(CANFilter::TimeHandling::Separate);
+	QCOMPARE(filter.isValid(blfFileName.fileName()), true);
+
+	// Valid blf and valid dbc
+	filter.setDBCFile(dbcFile.fileName());
+	Spreadsheet s(QStringLiteral("TestSpreadsheet"), false);
+	filter.readDataFromFile(blfFileName.fileName(), &s);
+	QCOMPARE(s.columnCount(), 13); // time + 7 * Msg1 + time + 4* Msg2
+
+	// number of rows is determined by the message with the most entries
+	const QVector<QString> names{QStringLiteral("STATUS_") + i18n("Time_s"),
+								 QStringLiteral("STATUS_Value6_"),
+								 QStringLiteral("STATUS_Value5_%"),
+								 QStringLiteral("STATUS_Value2_"),
+								 QStringLiteral("STATUS_Value3_"),
+								 QStringLiteral("STATUS_Value7_"),
+								 QStringLiteral("STATUS_Value4_"),
+								 QStringLiteral("STATUS_Value1_Km/h"),
+								 QStringLiteral("MSG2_") + i18n("Time_s"),
+								 QStringLiteral("MSG2_MSG2Value4_C"),
+								 QStringLiteral("MSG2_MSG2Value1_%"),
+								 QStringLiteral("MSG2_MSG2Value3_%"),
+								 QStringLiteral("MSG2_MSG2Value2_%")};
+	const QVector<QVector<double>> refData{{5e-9, 15e-9, 20e-9},
+										   {2., 3., 3.},
+										   {0., 32., 51.},
+										   {0., 0., 0.},
+										   {1., 1., 1.},
+										   {0., 0., 0.},
+										   {0., 0., 0.},
+										   {0., 47., 57.},
+										   {10e-9, 25e-9, std::nan("0")},
+										   {22.2, 22.2, std::nan("0")},
+										   {99.91, 99.91, std::nan("0")},
+										   {79.3, 79.3, std::nan("0")},
+										   {85.66, 85.66, std::nan("0")}};
+
+	for (int col = 0; col < s.columnCount(); col++) {
+		const auto* c = s.column(col);
+		QCOMPARE(c->name(), names.at(col));
+		QCOMPARE(c->rowCount(), 3);
+		for (int i = 0; i < c->rowCount(); i++)
+			VALUES_EQUAL(c->valueAt(i), refData.at(col).at(i));
+	}
+}
+
 // Use previous value if the current message does not contain no value for the signal
 void BLFFilterTest::testUsePreviousValueLittleEndian() {
 	QTemporaryFile blfFileName(QStringLiteral("XXXXXX.blf"));
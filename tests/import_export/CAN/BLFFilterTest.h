@@ -37,6 +37,8 @@ private Q_SLOTS:
 	void testUsePreviousValueLittleEndian();
 	void testBigNumberNotByteAlignedLittleEndian();
 
+	void testSeparateTimeLittleEndian();
+
 private:
 	// Helper functions
 	void createDBCFile(const QString& filename, const std::string& content);
@@ -29,11 +29,35 @@
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 #include "backend/worksheet/plots/cartesian/XYEquationCurve.h"
 
+#include <QDirIterator>
+
 // ##############################################################################
 // #####################  import of LabPlot projects ############################
 // ##############################################################################
 
-// TODO
+void ProjectImportTest::benchLoadExamples_data() {
+	QTest::addColumn<QString>("fileName");
+
+	const QString& examplesDir = QFINDTESTDATA(QLatin1String("../../../data/examples"));
+	QDirIterator it(examplesDir, {QStringLiteral("*.lml")}, QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext()) {
+		const auto& fileName = it.next();
+		QTest::newRow(qPrintable(QFileInfo(fileName).completeBaseName())) << fileName;
+	}
+}
+
+/*!
+ * measures the time needed to load the example projects, incl. the recalculation of the analysis curves
+ * and the retransform of all worksheets.
+ */
+void ProjectImportTest::benchLoadExamples() {
+	QFETCH(QString, fileName);
+
+	QBENCHMARK {
+		Project project;
+		QCOMPARE(project.load(fileName), true);
+	}
+}
 
 #ifdef HAVE_LIBORIGIN
 // ##############################################################################
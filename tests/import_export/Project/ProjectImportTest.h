@@ -17,7 +17,9 @@ class ProjectImportTest : public CommonMetaTest {
 	Q_OBJECT
 
 private Q_SLOTS:
-	// TODO: import of LabPlot projects
+	// import of LabPlot projects
+	void benchLoadExamples_data();
+	void benchLoadExamples();
 
 #ifdef HAVE_LIBORIGIN
 	// import of Origin projects
@@ -13,6 +13,7 @@
 
 #include <fstream>
 #include <limits>
+#include <vector>
 
 // ##############################################################################
 // #################  constant base lines
@@ -347,6 +348,115 @@ void NSLBaselineTest::testBaselineARPLSGSLXRD() {
 #endif
 }
 
+// Test the banded implementation directly
+void NSLBaselineTest::testBaselineARPLSBanded() {
+	double data[] = {1, 2, 3, 2, 4, 1, 3, 2, 3, 2};
+	double result[] = {-0.584754701668211,
+					   0.317884427391043,
+					   1.22052414120123,
+					   0.1231647075153,
+					   2.02580584286342,
+					   -1.07155285929594,
+					   0.831088187131071,
+					   -0.266270360209085,
+					   0.636371392929101,
+					   -0.460986392953193};
+
+	const size_t N = 10;
+
+	double tol = nsl_baseline_remove_arpls_banded(data, N, 1.e-3, 1.e6, 20);
+	WARN("TOL = " << tol)
+
+	FuzzyCompare(tol, 0.000877457831030427, 1.e-6);
+	for (size_t i = 0; i < N; ++i)
+		FuzzyCompare(data[i], result[i], 1.e-8);
+}
+
+// Test the banded implementation with spectrum data
+void NSLBaselineTest::testBaselineARPLSBandedSpectrum() {
+	std::ifstream d(QFINDTESTDATA(QLatin1String("data/spectrum.dat")).toStdString());
+	std::ifstream r(QFINDTESTDATA(QLatin1String("data/spectrum_arpls.dat")).toStdString());
+	const size_t N = 1000;
+
+	double data[N], result[N];
+	for (size_t i = 0; i < N; i++) {
+		d >> data[i];
+		r >> result[i];
+	}
+
+	double tol = nsl_baseline_remove_arpls_banded(data, N, 1.e-2, 1.e4, 10);
+	WARN("TOL = " << tol)
+
+	FuzzyCompare(tol, 0.108167623062361, 1.e-9); // GSL value
+	for (size_t i = 0; i < N; ++i)
+		FuzzyCompare(data[i], result[i], 2.e-5);
+}
+
+// Test the banded implementation with XRD data
+void NSLBaselineTest::testBaselineARPLSBandedXRD() {
+	std::ifstream d(QFINDTESTDATA(QLatin1String("data/XRD.dat")).toStdString());
+	std::ifstream r(QFINDTESTDATA(QLatin1String("data/XRD_arpls.dat")).toStdString());
+	const size_t N = 1764;
+
+	double data[N], result[N];
+	for (size_t i = 0; i < N; i++) {
+		d >> data[i];
+		r >> result[i];
+	}
+
+	double tol = nsl_baseline_remove_arpls_banded(data, N, 1.e-3, 1.e6, 20);
+	WARN("TOL = " << tol)
+
+	FuzzyCompare(tol, 0.0068956252520988, 1.e-6); // GSL value
+	for (size_t i = 0; i < N; ++i)
+		FuzzyCompare(data[i], result[i], 2.e-5);
+}
+
+// ##############################################################################
+// #################  performance
+// ##############################################################################
+
+// spectrum with peaks on a curved base line
+static std::vector<double> performanceData(size_t n) {
+	std::vector<double> data(n);
+	for (size_t i = 0; i < n; i++) {
+		const double x = (double)i / n;
+		data[i] = 10. * x * x + 2. * sin(3. * x) + (i % 1000 < 20 ? 5. : 0.);
+	}
+	return data;
+}
+
+void NSLBaselineTest::testPerformanceARPLSEigen3() {
+#ifdef HAVE_EIGEN3
+	const auto& data = performanceData(10000);
+
+	QBENCHMARK {
+		auto values = data;
+		QVERIFY(nsl_baseline_remove_arpls_Eigen3(values.data(), values.size(), 1.e-3, 1.e6, 10) >= 0.);
+	}
+#else
+	QSKIP("Eigen3 not available");
+#endif
+}
+
+void NSLBaselineTest::testPerformanceARPLSBanded() {
+	const auto& data = performanceData(10000);
+
+	QBENCHMARK {
+		auto values = data;
+		QVERIFY(nsl_baseline_remove_arpls_banded(values.data(), values.size(), 1.e-3, 1.e6, 10) >= 0.);
+	}
+}
+
+void NSLBaselineTest::testPerformanceARPLSBandedLarge() {
+	const auto& data = performanceData(1000000);
+
+	QBENCHMARK {
+		auto values = data;
+		QVERIFY(nsl_baseline_remove_arpls_banded(values.data(), values.size(), 1.e-3, 1.e6, 10) >= 0.);
+	}
+}
+
 // Test edge cases
 void NSLBaselineTest::testBaselineEmptyData() {
 	// Test empty data (n=0)
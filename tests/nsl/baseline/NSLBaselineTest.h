@@ -37,8 +37,13 @@ private Q_SLOTS:
 	void testBaselineARPLSGSL();
 	void testBaselineARPLSGSLSpectrum();
 	void testBaselineARPLSGSLXRD();
+	void testBaselineARPLSBanded();
+	void testBaselineARPLSBandedSpectrum();
+	void testBaselineARPLSBandedXRD();
 	// performance
-	// void testPerformance();
+	void testPerformanceARPLSEigen3();
+	void testPerformanceARPLSBanded();
+	void testPerformanceARPLSBandedLarge();
 
 	void testBaselineEmptyData();
 	void testBaselineSingleElement();
@@ -13,8 +13,11 @@
 
 extern "C" {
 #include "backend/nsl/nsl_dft.h"
+#include "backend/nsl/nsl_fft.h"
 }
 
+#include <QTemporaryFile>
+
 #define ONESIDED 0
 #define TWOSIDED 1
 const int N = 10;
@@ -290,6 +293,57 @@ void NSLDFTTest::testTwosided_normdB() {
 		QCOMPARE(data[i], result[i]);
 }
 
+// ##############################################################################
+// #################  plan cache
+// ##############################################################################
+
+// repeated transforms of the same size use the cached plan and give the same result
+void NSLDFTTest::testPlanCache() {
+	nsl_fft_cache_clear();
+	QCOMPARE(nsl_fft_cache_size(), (size_t)0);
+
+	const double result[] = {10, 2, -5.85410196624968, 2, 0.854101966249685};
+	for (int k = 0; k < 3; k++) {
+		double data[] = {1, 1, 3, 3, 1, -1, 0, 1, 1, 0};
+		nsl_dft_transform(data, 1, N, ONESIDED, nsl_dft_result_real);
+		for (unsigned int i = 0; i < N / 2; i++)
+			FuzzyCompare(data[i], result[i]);
+	}
+	const size_t cacheSize = nsl_fft_cache_size();
+	QVERIFY(cacheSize > 0);
+
+	// new size, new plan
+	double data[2 * N] = {1, 1, 3, 3, 1, -1, 0, 1, 1, 0, 1, 1, 3, 3, 1, -1, 0, 1, 1, 0};
+	nsl_dft_transform(data, 1, 2 * N, ONESIDED, nsl_dft_result_real);
+	QVERIFY(nsl_fft_cache_size() > cacheSize);
+
+	nsl_fft_cache_clear();
+	QCOMPARE(nsl_fft_cache_size(), (size_t)0);
+}
+
+// the plans created with FFTW_MEASURE give the same result and can be saved as wisdom
+void NSLDFTTest::testPlanCacheMeasure() {
+	nsl_fft_cache_clear();
+	nsl_fft_set_planner_mode(nsl_fft_planner_measure);
+
+	const double result[] = {10, 2, -5.85410196624968, 2, 0.854101966249685};
+	double data[] = {1, 1, 3, 3, 1, -1, 0, 1, 1, 0};
+	nsl_dft_transform(data, 1, N, ONESIDED, nsl_dft_result_real);
+	for (unsigned int i = 0; i < N / 2; i++)
+		FuzzyCompare(data[i], result[i]);
+
+#ifdef HAVE_FFTW3
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	const auto& fileName = file.fileName().toLocal8Bit();
+	QCOMPARE(nsl_fft_export_wisdom(fileName.constData()), 1);
+	QCOMPARE(nsl_fft_import_wisdom(fileName.constData()), 1);
+#endif
+
+	nsl_fft_set_planner_mode(nsl_fft_planner_estimate);
+	nsl_fft_cache_clear();
+}
+
 // ##############################################################################
 // #################  performance
 // ##############################################################################
@@ -326,4 +380,35 @@ void NSLDFTTest::testPerformance_twosided() {
 	delete[] data;
 }
 
+/* many transforms of the same small size, the typical case for the spectra of live data.
+ * _uncached clears the plan cache before every transform, corresponding to the creation
+ * of the plan/wavetable in every call before the plan cache was introduced. */
+const int NR = 4096;
+const int REPEAT = 1000;
+
+void NSLDFTTest::testPerformance_repeated() {
+	QVector<double> data(NR);
+
+	QBENCHMARK {
+		for (int k = 0; k < REPEAT; k++) {
+			for (int i = 0; i < NR; i++)
+				data[i] = i % 10;
+			nsl_dft_transform(data.data(), 1, NR, ONESIDED, nsl_dft_result_magnitude);
+		}
+	}
+}
+
+void NSLDFTTest::testPerformance_repeated_uncached() {
+	QVector<double> data(NR);
+
+	QBENCHMARK {
+		for (int k = 0; k < REPEAT; k++) {
+			for (int i = 0; i < NR; i++)
+				data[i] = i % 10;
+			nsl_fft_cache_clear();
+			nsl_dft_transform(data.data(), 1, NR, ONESIDED, nsl_dft_result_magnitude);
+		}
+	}
+}
+
 QTEST_MAIN(NSLDFTTest)
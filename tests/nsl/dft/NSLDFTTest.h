@@ -38,9 +38,14 @@ private Q_SLOTS:
 	void testTwosided_squaremagnitude();
 	void testTwosided_squareamplitude();
 	void testTwosided_normdB();
+	// plan cache
+	void testPlanCache();
+	void testPlanCacheMeasure();
 	// performance
 	void testPerformance_onesided();
 	void testPerformance_twosided();
+	void testPerformance_repeated();
+	void testPerformance_repeated_uncached();
 
 private:
 	QString m_dataDir;
@@ -165,6 +165,50 @@ void NSLGeomTest::testLineSim() {
 	for (i = 0; i < std::min(nout, (size_t)6uL); ++i)
 		QCOMPARE(index[i], result3[i]);
 
+	printf("* number of points (Visvalingam-Whyatt variant)\n");
+	const double areaout = nsl_geom_linesim_visvalingam_whyatt_variant(xdata, ydata, n, 6, index);
+	perr = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
+	aerr = nsl_geom_linesim_area_error(xdata, ydata, n, index);
+	printf("area = %.15g, pos. error = %.15g, area error = %.15g\n", areaout, perr, aerr);
+	QCOMPARE(areaout, 1.5);
+	QCOMPARE(perr, 0.1725);
+	QCOMPARE(aerr, 0.2);
+
+	for (i = 0; i < 6; ++i)
+		QCOMPARE(index[i], result3[i]);
+
+	const size_t result6[] = {0, 2, 3, 6, 7, 9};
+	printf("* number of points (Largest-Triangle-Three-Buckets)\n");
+	nout = nsl_geom_linesim_lttb(xdata, ydata, n, 6, index);
+	perr = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
+	aerr = nsl_geom_linesim_area_error(xdata, ydata, n, index);
+	printf("pos. error = %.15g, area error = %.15g\n", perr, aerr);
+	QCOMPARE(nout, 6uL);
+	QCOMPARE(perr, 0.0378688524590164);
+	QCOMPARE(aerr, 0.25);
+
+	for (i = 0; i < nout; ++i)
+		QCOMPARE(index[i], result6[i]);
+
+	const size_t result7[] = {0, 1, 5, 9};
+	printf("* number of points (MinMaxLTTB)\n");
+	nout = nsl_geom_linesim_minmax_lttb(xdata, ydata, n, 4, 1, index);
+	perr = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
+	aerr = nsl_geom_linesim_area_error(xdata, ydata, n, index);
+	printf("pos. error = %.15g, area error = %.15g\n", perr, aerr);
+	QCOMPARE(nout, 4uL);
+	QCOMPARE(perr, 0.269855351976856);
+	QCOMPARE(aerr, 1.25);
+
+	for (i = 0; i < nout; ++i)
+		QCOMPARE(index[i], result7[i]);
+
+	// all points are preselected for the small data set, the result is the same as for LTTB
+	nout = nsl_geom_linesim_minmax_lttb(xdata, ydata, n, 6, 4, index);
+	QCOMPARE(nout, 6uL);
+	for (i = 0; i < nout; ++i)
+		QCOMPARE(index[i], result6[i]);
+
 	const size_t result5[] = {0, 2, 3, 5, 6, 7, 9};
 	printf("* Perp. distance (Reumann-Witkam)\n");
 	nout = nsl_geom_linesim_reumann_witkam(xdata, ydata, n, tol3, index);
@@ -206,6 +250,31 @@ void NSLGeomTest::testLineSim() {
 		QCOMPARE(index[i], result4[i]);
 }
 
+// data with many points having the same distance, the first of them is taken like in the implementation scanning all points
+void NSLGeomTest::testLineSimTies() {
+	const size_t n = 300;
+	double xdata[n], ydata[n];
+	for (size_t i = 0; i < n; ++i) {
+		xdata[i] = i % 17;
+		ydata[i] = (i * 3) % 11;
+	}
+	size_t index[n];
+
+	printf("* Perp. distance (Douglas-Peucker) with ties\n");
+	const size_t result[] = {0, 16, 51, 67, 136, 139, 152, 154, 161, 169, 172, 176, 186, 187, 203, 238, 299};
+	size_t nout = nsl_geom_linesim_douglas_peucker(xdata, ydata, n, 8.5, index);
+	QCOMPARE(nout, 17uL);
+	for (size_t i = 0; i < nout; ++i)
+		QCOMPARE(index[i], result[i]);
+
+	printf("* number of points (Douglas-Peucker variant) with ties\n");
+	const size_t result2[] = {0, 16, 51, 67, 187, 299};
+	const double tolout = nsl_geom_linesim_douglas_peucker_variant(xdata, ydata, n, 6, index);
+	QCOMPARE(tolout, 16.);
+	for (size_t i = 0; i < 6; ++i)
+		QCOMPARE(index[i], result2[i]);
+}
+
 #ifdef _MSC_VER // crashes on Windows
 void NSLGeomTest::testLineSimMorse() {
 }
@@ -263,6 +332,20 @@ void NSLGeomTest::testLineSimMorse() {
 	printf("maxtol = %.15g (pos. error = %.15g, area error = %.15g)\n", tolout, perr, aerr);
 	QCOMPARE(perr, 11.9586266895937);
 	QCOMPARE(aerr, 17.558046450762);
+
+	printf("* Simplification (Visvalingam-Whyatt variant) nout = %d\n", NOUT);
+
+	double areaout;
+	QBENCHMARK {
+		areaout = nsl_geom_linesim_visvalingam_whyatt_variant(xdata.data(), ydata.data(), N, NOUT, index);
+		QCOMPARE(areaout, 57.9716100000078);
+	}
+
+	perr = nsl_geom_linesim_positional_squared_error(xdata.data(), ydata.data(), N, index);
+	aerr = nsl_geom_linesim_area_error(xdata.data(), ydata.data(), N, index);
+	printf("maxarea = %.15g (pos. error = %.15g, area error = %.15g)\n", areaout, perr, aerr);
+	QCOMPARE(perr, 15.8664022962252);
+	QCOMPARE(aerr, 13.6030973705424);
 }
 #endif
 
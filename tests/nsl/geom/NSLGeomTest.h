@@ -20,6 +20,7 @@ private Q_SLOTS:
 
 	void testDist();
 	void testLineSim();
+	void testLineSimTies();
 	void testLineSimMorse();
 	// performance
 	// void testPerformance();
@@ -12,8 +12,13 @@
 
 extern "C" {
 #include "backend/nsl/nsl_smooth.h"
+#include "backend/nsl/nsl_stats.h"
 }
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 // ##############################################################################
 // #################  moving average tests
 // ##############################################################################
@@ -182,6 +187,188 @@ void NSLSmoothTest::testPercentile_padperiodic() {
 		QCOMPARE(data[i], result[i]);
 }
 
+// ##############################################################################
+// #################  sliding window tests
+// ##############################################################################
+
+namespace {
+const nsl_smooth_pad_mode slidingModes[] = {nsl_smooth_pad_none, nsl_smooth_pad_interp, nsl_smooth_pad_mirror, nsl_smooth_pad_nearest, nsl_smooth_pad_constant, nsl_smooth_pad_periodic};
+const size_t slidingPoints[] = {1, 2, 3, 8, 51, 100};
+
+// random data with repeated values
+std::vector<double> slidingData(size_t n) {
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(0., 10.);
+	std::vector<double> data(n);
+	for (auto& value : data) {
+		value = distribution(generator);
+		if (value < 3.)
+			value = std::floor(value);
+	}
+	return data;
+}
+
+// value of the signal padded with the mode at the index (at most one window outside of the signal)
+double paddedValue(const std::vector<double>& data, int index, nsl_smooth_pad_mode mode) {
+	const int n = (int)data.size();
+	if (index >= 0 && index < n)
+		return data.at(index);
+
+	switch (mode) {
+	case nsl_smooth_pad_mirror:
+		index = index < 0 ? -index : 2 * (n - 1) - index;
+		break;
+	case nsl_smooth_pad_nearest:
+		index = index < 0 ? 0 : n - 1;
+		break;
+	case nsl_smooth_pad_constant:
+		return index < 0 ? nsl_smooth_pad_constant_lvalue : nsl_smooth_pad_constant_rvalue;
+	case nsl_smooth_pad_periodic:
+		index = index < 0 ? index + n : index - n;
+		break;
+	case nsl_smooth_pad_none:
+	case nsl_smooth_pad_interp:
+		break;
+	}
+	return data.at(index);
+}
+
+// start and number of points of the window of the point i
+void window(size_t i, size_t n, size_t points, nsl_smooth_pad_mode mode, bool lagged, int& start, size_t& np) {
+	// interpolating padding: the points at the edges use the nearest full window
+	if (mode == nsl_smooth_pad_interp) {
+		if (n < points)
+			mode = nsl_smooth_pad_none;
+		else if (lagged)
+			i = std::max(i, points - 1);
+		else
+			i = std::clamp(i, (points - 1) / 2, n - 1 - (points - 1 - (points - 1) / 2));
+	}
+
+	if (lagged) {
+		np = mode == nsl_smooth_pad_none ? std::min(points, i + 1) : points;
+		start = (int)i - (int)np + 1;
+	} else {
+		size_t half = (points - 1) / 2;
+		np = points;
+		if (mode == nsl_smooth_pad_none) {
+			half = std::min(std::min(half, i), n - i - 1);
+			np = 2 * half + 1;
+		}
+		start = (int)i - (int)half;
+	}
+}
+
+// moving average with uniform or triangular weights calculated point by point
+std::vector<double> movingAverage(const std::vector<double>& data, size_t points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode, bool lagged) {
+	const size_t n = data.size();
+	std::vector<double> result(n);
+	for (size_t i = 0; i < n; i++) {
+		int start;
+		size_t np;
+		window(i, n, points, mode, lagged, start, np);
+
+		double sum = 0.;
+		for (size_t j = 0; j < np; j++) {
+			double w = 1.;
+			if (weight == nsl_smooth_weight_triangular)
+				w = lagged ? j + 1. : std::min(j + 1, np - j);
+			sum += w * paddedValue(data, start + (int)j, mode);
+		}
+
+		// normalization used by nsl_smooth_moving_average() and nsl_smooth_moving_average_lagged()
+		double norm = np;
+		if (weight == nsl_smooth_weight_triangular)
+			norm = lagged ? np * (np + 1.) / 2. : gsl_pow_2((np + 1.) / 2.);
+		result[i] = sum / norm;
+	}
+	return result;
+}
+
+// percentile calculated point by point
+std::vector<double> movingPercentile(const std::vector<double>& data, size_t points, double percentile, nsl_smooth_pad_mode mode) {
+	const size_t n = data.size();
+	std::vector<double> result(n);
+	for (size_t i = 0; i < n; i++) {
+		int start;
+		size_t np;
+		window(i, n, points, mode, false, start, np);
+
+		std::vector<double> values(np);
+		for (size_t j = 0; j < np; j++)
+			values[j] = paddedValue(data, start + (int)j, mode);
+		result[i] = nsl_stats_quantile(values.data(), 1, np, percentile, nsl_stats_quantile_type7);
+	}
+	return result;
+}
+}
+
+void NSLSmoothTest::testMA_sliding() {
+	const auto& data = slidingData(1000);
+	nsl_smooth_pad_constant_set(1., 2.);
+
+	for (auto weight : {nsl_smooth_weight_uniform, nsl_smooth_weight_triangular}) {
+		for (auto mode : slidingModes) {
+			for (size_t points : slidingPoints) {
+				auto result = data;
+				int status = nsl_smooth_moving_average(result.data(), result.size(), points, weight, mode);
+				QCOMPARE(status, 0);
+
+				const auto& reference = movingAverage(data, points, weight, mode, false);
+				for (size_t i = 0; i < data.size(); i++)
+					FuzzyCompare(result.at(i), reference.at(i), 1.e-10);
+
+				// explicit padding values as used for the smoothing in parallel blocks
+				auto resultPadded = data;
+				status = nsl_smooth_moving_average_padded(resultPadded.data(), resultPadded.size(), points, weight, mode, 1., 2.);
+				QCOMPARE(status, 0);
+				QCOMPARE(resultPadded, result);
+			}
+		}
+	}
+	nsl_smooth_pad_constant_set(0., 0.);
+}
+
+void NSLSmoothTest::testMAL_sliding() {
+	const auto& data = slidingData(1000);
+	nsl_smooth_pad_constant_set(1., 2.);
+
+	for (auto weight : {nsl_smooth_weight_uniform, nsl_smooth_weight_triangular}) {
+		for (auto mode : slidingModes) {
+			for (size_t points : slidingPoints) {
+				auto result = data;
+				int status = nsl_smooth_moving_average_lagged(result.data(), result.size(), points, weight, mode);
+				QCOMPARE(status, 0);
+
+				const auto& reference = movingAverage(data, points, weight, mode, true);
+				for (size_t i = 0; i < data.size(); i++)
+					FuzzyCompare(result.at(i), reference.at(i), 1.e-10);
+			}
+		}
+	}
+	nsl_smooth_pad_constant_set(0., 0.);
+}
+
+void NSLSmoothTest::testPercentile_sliding() {
+	const auto& data = slidingData(1000);
+	nsl_smooth_pad_constant_set(1., 2.);
+
+	for (double p : {0., 0.1, 0.5, 0.75, 1.}) {
+		for (auto mode : slidingModes) {
+			for (size_t points : slidingPoints) {
+				auto result = data;
+				int status = nsl_smooth_percentile(result.data(), result.size(), points, p, mode);
+				QCOMPARE(status, 0);
+
+				const auto& reference = movingPercentile(data, points, p, mode);
+				for (size_t i = 0; i < data.size(); i++)
+					QCOMPARE(result.at(i), reference.at(i));
+			}
+		}
+	}
+	nsl_smooth_pad_constant_set(0., 0.);
+}
+
 // ##############################################################################
 // #################  Savitzky-Golay coeff tests
 // ##############################################################################
@@ -414,6 +601,28 @@ void NSLSmoothTest::testPerformance_periodic() {
 	}
 }
 
+void NSLSmoothTest::testPerformance_movingAverage() {
+	QScopedArrayPointer<double> data(new double[nn]);
+
+	QBENCHMARK {
+		for (int i = 0; i < nn; i++)
+			data[i] = i % 101;
+		int status = nsl_smooth_moving_average(data.data(), nn, 1001, nsl_smooth_weight_triangular, nsl_smooth_pad_mirror);
+		QCOMPARE(status, 0);
+	}
+}
+
+void NSLSmoothTest::testPerformance_percentile() {
+	QScopedArrayPointer<double> data(new double[nn]);
+
+	QBENCHMARK {
+		for (int i = 0; i < nn; i++)
+			data[i] = i % 101;
+		int status = nsl_smooth_percentile(data.data(), nn, 1001, 0.5, nsl_smooth_pad_mirror);
+		QCOMPARE(status, 0);
+	}
+}
+
 // ##############################################################################
 // #################  LOWESS tests
 // ##############################################################################
@@ -34,6 +34,10 @@ private Q_SLOTS:
 	void testPercentile_padnearest();
 	void testPercentile_padconstant();
 	void testPercentile_padperiodic();
+	// sliding window kernels against the calculation point by point
+	void testMA_sliding();
+	void testMAL_sliding();
+	void testPercentile_sliding();
 	// Savivitzky-Golay coeff tests
 	void testSG_coeff31();
 	void testSG_coeff51();
@@ -59,5 +63,7 @@ private Q_SLOTS:
 	void testPerformance_nearest();
 	void testPerformance_constant();
 	void testPerformance_periodic();
+	void testPerformance_movingAverage();
+	void testPerformance_percentile();
 };
 #endif
@@ -10,6 +10,10 @@ SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "NSLStatisticalTestTest.h"
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 extern "C" {
 #include "backend/nsl/nsl_statistical_test.h"
 }
@@ -504,6 +508,94 @@ void NSLStatisticalTestTest::testMannKendall05() {
 	QVERIFY(std::abs(result.p - expected_p) < epsilon);
 }
 
+/*!
+ * \brief Test Mann-Kendall trend test with tied values.
+ *
+ * The pairs of tied values don't contribute to S and the variance of S is corrected for the groups of ties.
+ */
+void NSLStatisticalTestTest::testMannKendallTies() {
+	const double sample[] = {1.0, 2.0, 2.0, 3.0, 3.0, 3.0, 4.0};
+	size_t n = 7;
+
+	mann_kendall_test_result result = nsl_stats_mann_kendall(sample, n, nsl_stats_tail_type_two);
+
+	// 21 pairs, 4 tied pairs, no decreasing pairs
+	// Var(S) = (7*6*19 - 2*1*9 - 3*2*11)/18 = 39.667
+	double expected_S = 17.0;
+	double expected_z = 2.5404;
+	double expected_slope = 0.5;
+
+	const double epsilon = 1e-3;
+
+	QVERIFY(std::abs(result.S - expected_S) < epsilon);
+	QVERIFY(std::abs(result.tau - 17.0 / 21.0) < epsilon);
+	QVERIFY(std::abs(result.z - expected_z) < epsilon);
+	QVERIFY(std::abs(result.slope - expected_slope) < epsilon);
+}
+
+/*!
+ * \brief Test the Theil-Sen slope (Sen's slope of the Mann-Kendall test) against the median of all pairwise slopes.
+ */
+void NSLStatisticalTestTest::testTheilSenSlope() {
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<double> dist(0., 1.);
+	for (size_t n : {2, 3, 10, 101, 1000, 2000}) {
+		std::vector<double> sample(n);
+		for (size_t i = 0; i < n; i++)
+			sample[i] = (i % 3 == 0) ? std::round(10 * dist(gen)) : dist(gen) + 0.01 * i; // with ties
+
+		std::vector<double> slopes;
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = i + 1; j < n; j++)
+				slopes.push_back((sample[j] - sample[i]) / (j - i));
+		std::sort(slopes.begin(), slopes.end());
+		const size_t size = slopes.size();
+		const double expected = (size % 2) ? slopes[size / 2] : (slopes[size / 2 - 1] + slopes[size / 2]) / 2.;
+
+		FuzzyCompare(nsl_stats_theil_sen_slope(sample.data(), n), expected, 1.e-12);
+	}
+
+	// (nearly) collinear data, the slopes differ only by rounding errors and the exact order statistic is required
+	for (size_t n : {1000, 3000}) {
+		std::vector<double> sample(n);
+		for (size_t i = 0; i < n; i++)
+			sample[i] = 0.1 * i + ((i % 2) ? 1.e-15 * dist(gen) : 0.);
+
+		std::vector<double> slopes;
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = i + 1; j < n; j++)
+				slopes.push_back((sample[j] - sample[i]) / (j - i));
+		std::sort(slopes.begin(), slopes.end());
+		const size_t size = slopes.size();
+		const double expected = (size % 2) ? slopes[size / 2] : (slopes[size / 2 - 1] + slopes[size / 2]) / 2.;
+
+		QCOMPARE(nsl_stats_theil_sen_slope(sample.data(), n), expected);
+	}
+
+	// few distinct values, most of the slopes are tied
+	for (size_t n : {1000, 3000}) {
+		std::vector<double> sample(n);
+		for (size_t i = 0; i < n; i++)
+			sample[i] = std::round(3 * dist(gen));
+
+		std::vector<double> slopes;
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = i + 1; j < n; j++)
+				slopes.push_back((sample[j] - sample[i]) / (j - i));
+		std::sort(slopes.begin(), slopes.end());
+		const size_t size = slopes.size();
+		const double expected = (size % 2) ? slopes[size / 2] : (slopes[size / 2 - 1] + slopes[size / 2]) / 2.;
+
+		QCOMPARE(nsl_stats_theil_sen_slope(sample.data(), n), expected);
+	}
+
+	// all slopes equal
+	std::vector<double> line(5000);
+	for (size_t i = 0; i < line.size(); i++)
+		line[i] = 2. * i + 1.;
+	QCOMPARE(nsl_stats_theil_sen_slope(line.data(), line.size()), 2.);
+}
+
 /*!
  * \brief Test Wald-Wolfowitz runs test with a random sequence.
  *
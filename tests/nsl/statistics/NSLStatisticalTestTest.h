@@ -35,6 +35,8 @@ private Q_SLOTS:
 	void testMannKendall03();
 	void testMannKendall04();
 	void testMannKendall05();
+	void testMannKendallTies();
+	void testTheilSenSlope();
 
 	void testWaldWolfowitzRuns01();
 	void testWaldWolfowitzRuns02();
@@ -13,6 +13,7 @@
 #include "backend/core/Project.h"
 #include "backend/core/column/ColumnStringIO.h"
 #include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/core/datatypes/Double2StringFilter.h"
 #include "backend/datasources/filters/VectorBLFFilter.h"
 #include "backend/lib/UndoStack.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -3124,6 +3125,53 @@ void SpreadsheetTest::testInsertColumnsSuppressUpdate() {
 	QCOMPARE(modelAboutToResetCounter, 1);
 }
 
+/*!
+ * \brief testModelFormattingCache
+ * the texts shown in the view are cached in blocks of rows, check that they are updated on changes
+ */
+void SpreadsheetTest::testModelFormattingCache() {
+	Project project;
+	auto* sheet = new Spreadsheet(QStringLiteral("test"), false);
+	project.addChild(sheet);
+	sheet->setColumnCount(2);
+	sheet->setRowCount(1000);
+
+	auto* column = sheet->column(0);
+	column->setColumnMode(AbstractColumn::ColumnMode::Double);
+	for (int i = 0; i < 1000; ++i)
+		column->setValueAt(i, i + 0.5);
+	auto* intColumn = sheet->column(1);
+	intColumn->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	intColumn->setIntegerAt(0, 42);
+
+	auto* model = new SpreadsheetModel(sheet);
+	const auto locale = QLocale();
+	QCOMPARE(model->data(model->index(0, 0), Qt::DisplayRole).toString(), locale.toString(0.5, 'g', 6));
+	QCOMPARE(model->data(model->index(999, 0), Qt::DisplayRole).toString(), locale.toString(999.5, 'g', 6));
+	QCOMPARE(model->data(model->index(0, 1), Qt::DisplayRole).toString(), locale.toString(42));
+
+	// changed values
+	column->setValueAt(1, NAN);
+	column->setValueAt(2, INFINITY);
+	column->setValueAt(999, 1.25);
+	QCOMPARE(model->data(model->index(1, 0), Qt::DisplayRole).toString(), QStringLiteral("-"));
+	QCOMPARE(model->data(model->index(2, 0), Qt::DisplayRole).toString(), UTF8_QSTRING("∞"));
+	QCOMPARE(model->data(model->index(999, 0), Qt::DisplayRole).toString(), locale.toString(1.25, 'g', 6));
+
+	// changed formatting
+	static_cast<Double2StringFilter*>(column->outputFilter())->setNumDigits(2);
+	QCOMPARE(model->data(model->index(3, 0), Qt::DisplayRole).toString(), locale.toString(3.5, 'g', 2));
+	QCOMPARE(model->data(model->index(500, 0), Qt::DisplayRole).toString(), locale.toString(500.5, 'g', 2));
+
+	// undo
+	sheet->undoStack()->undo();
+	QCOMPARE(model->data(model->index(3, 0), Qt::DisplayRole).toString(), locale.toString(3.5, 'g', 6));
+
+	// removed rows
+	sheet->setRowCount(10);
+	QCOMPARE(model->data(model->index(9, 0), Qt::DisplayRole).toString(), locale.toString(9.5, 'g', 6));
+}
+
 void SpreadsheetTest::testLinkSpreadsheetsUndoRedo() {
 #ifdef __FreeBSD__
 	return;
@@ -107,6 +107,8 @@ private Q_SLOTS:
 	void testInsertRowsSuppressUpdate();
 	void testInsertColumnsSuppressUpdate();
 
+	void testModelFormattingCache();
+
 	void testLinkSpreadsheetsUndoRedo();
 	void testLinkSpreadsheetDeleteAdd();
 	void testLinkSpreadsheetAddRow();